@@ -17,16 +17,16 @@
 #ifndef __BOR_BUCKETQ_H__
 #define __BOR_BUCKETQ_H__
 
-#include <boruvka/compiler.h>
+#include <boruvka/core.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
 
 /**
- * Number of buckets available in bucket-based queue.
- * Inserting key greater or equal then this constant will end up in program
- * termination.
+ * Initial number of buckets of bucket-based queue.
+ * The array of buckets grows when a greater key is inserted.
+ * Must be a multiple of 64.
  */
 #define BOR_BUCKETQ_SIZE 1024
 
@@ -52,10 +52,15 @@ typedef struct bor_bucketq_bucket bor_bucketq_bucket_t;
 
 /**
  * Bucket based priority queue.
+ * Non-empty buckets are tracked in a two-level bitmap, so the next
+ * non-empty bucket is found in a few word operations even if keys are
+ * sparse.
  */
 struct bor_bucketq {
     bor_bucketq_bucket_t *bucket; /*!< Array of buckets */
     int bucket_size;              /*!< Number of buckets */
+    uint64_t *bmap;               /*!< Bit per bucket, set if non-empty */
+    uint64_t *bmap_top;           /*!< Bit per non-zero word of bmap */
     int lowest_key;               /*!< Lowest key so far */
     int size;                     /*!< Number of elements stored in queue */
 };
@@ -73,7 +78,8 @@ void borBucketQFree(bor_bucketq_t *pq);
 
 /**
  * Inserts an element into queue.
- * If the key >= BOR_BUCKET_SIZE the program terminates.
+ * Buckets are added as needed, so memory grows linearly with the maximal
+ * key. If the key is negative the program terminates.
  */
 void borBucketQPush(bor_bucketq_t *pq, int key, TYPE value);
 
@@ -0,0 +1,141 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_RADIXQ_H__
+#define __BOR_RADIXQ_H__
+
+#include <boruvka/compiler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Radix heap for monotone priority queues, i.e., the popped keys never
+ * decrease. Keys are non-negative and they can use the whole range of
+ * long. Element with key k is stored in the bucket given by the highest
+ * bit in which k differs from the last popped key, so all operations take
+ * O(log C) amortized time where C is the maximal difference of keys.
+ *
+ * Pushing a key lower than the last popped key ends up in program
+ * termination.
+ */
+
+/**
+ * Number of buckets.
+ */
+#define BOR_RADIXQ_BUCKETS (8 * (int)sizeof(long) + 1)
+
+/**
+ * Initial size of one bucket.
+ */
+#define BOR_RADIXQ_BUCKET_INIT_SIZE 32
+
+/**
+ * Element of the queue.
+ */
+struct bor_radixq_el {
+    long key;
+    TYPE value;
+    int bucket; /*!< Bucket of the element or -1 if it is free */
+    int pos;    /*!< Position in the bucket or next free element */
+};
+typedef struct bor_radixq_el bor_radixq_el_t;
+
+/**
+ * Bucket storing elements with keys in one range.
+ */
+struct bor_radixq_bucket {
+    int *el;   /*!< Indexes of stored elements */
+    int size;  /*!< Number of stored elements */
+    int alloc; /*!< Size of the allocated array */
+};
+typedef struct bor_radixq_bucket bor_radixq_bucket_t;
+
+/**
+ * Radix heap.
+ */
+struct bor_radixq {
+    bor_radixq_bucket_t bucket[BOR_RADIXQ_BUCKETS];
+    bor_radixq_el_t *el; /*!< Elements, index to this array is handle */
+    int el_alloc;
+    int el_free;         /*!< The first free element or -1 */
+    long last;           /*!< The last popped key */
+    int size;            /*!< Number of elements stored in queue */
+};
+typedef struct bor_radixq bor_radixq_t;
+
+/**
+ * Initializes priority queue.
+ */
+void borRadixQInit(bor_radixq_t *pq);
+
+/**
+ * Frees allocated resources.
+ */
+void borRadixQFree(bor_radixq_t *pq);
+
+/**
+ * Removes all elements and resets the last popped key to zero. Allocated
+ * memory is kept for reuse.
+ */
+void borRadixQClear(bor_radixq_t *pq);
+
+/**
+ * Inserts an element into queue and returns its handle that can be used
+ * for borRadixQDecreaseKey() until the element is popped.
+ * If the key is lower than the last popped key the program terminates.
+ */
+int borRadixQPush(bor_radixq_t *pq, long key, TYPE value);
+
+/**
+ * Removes and returns the lowest element.
+ * If the queue is empty the program terminates.
+ */
+TYPE borRadixQPop(bor_radixq_t *pq, long *key);
+
+/**
+ * Decreases key of the element with the given handle.
+ * If the key is lower than the last popped key the program terminates.
+ */
+void borRadixQDecreaseKey(bor_radixq_t *pq, int handle, long key);
+
+/**
+ * Returns key of the element with the given handle.
+ */
+_bor_inline long borRadixQKey(const bor_radixq_t *pq, int handle);
+
+/**
+ * Returns true if the queue is empty.
+ */
+_bor_inline int borRadixQIsEmpty(const bor_radixq_t *pq);
+
+/**** INLINES ****/
+_bor_inline long borRadixQKey(const bor_radixq_t *pq, int handle)
+{
+    return pq->el[handle].key;
+}
+
+_bor_inline int borRadixQIsEmpty(const bor_radixq_t *pq)
+{
+    return pq->size == 0;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __BOR_RADIXQ_H__ */
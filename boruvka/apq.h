@@ -33,8 +33,8 @@ extern "C" {
 
 /**
  * Number of buckets available in bucket-based queue.
- * Inserting key greater or equal then this constant will end up in program
- * termination.
+ * Inserting key greater or equal then this constant switches the queue to
+ * heap. Must be a multiple of 64.
  */
 #define BOR_APQ_BUCKET_SIZE 1024
 
@@ -73,6 +73,8 @@ typedef struct _bor_apq_bucket_t bor_apq_bucket_t;
 struct _bor_apq_bucket_queue_t {
     bor_apq_bucket_t *bucket; /*!< Array of buckets */
     int bucket_size;          /*!< Number of buckets */
+    uint64_t *bmap;           /*!< Bit per bucket, set if non-empty */
+    uint64_t *bmap_top;       /*!< Bit per non-zero word of bmap */
     int lowest_key;           /*!< Lowest key so far */
     int size;                 /*!< Number of elements stored in queue */
 };
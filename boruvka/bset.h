@@ -0,0 +1,237 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_BSET_H__
+#define __BOR_BSET_H__
+
+#include <string.h>
+#include <boruvka/core.h>
+#include <boruvka/alloc.h>
+#include <boruvka/iset.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Bitset
+ * =======
+ *
+ * Set of non-negative integers stored as a bitmap that grows as needed.
+ * Element i is bit (i & 63) of the word i >> 6. Set operations work on
+ * whole words (two words at once with SSE instructions if compiled with
+ * USE_SSE=yes), iteration skips zero words and uses ctz to find bits.
+ *
+ * Words past .size are treated as zero, i.e., two sets with different
+ * numbers of words may be equal.
+ */
+struct bor_bset {
+    uint64_t *w; /*!< Words of the bitmap */
+    int size;    /*!< Number of used words */
+    int alloc;   /*!< Number of allocated words */
+};
+typedef struct bor_bset bor_bset_t;
+
+#define BOR_BSET_INIT { NULL, 0, 0 }
+#define BOR_BSET(NAME) bor_bset_t NAME = BOR_BSET_INIT
+
+/**
+ * Iterates over elements in increasing order, V must be int.
+ */
+#define BOR_BSET_FOR_EACH(S, V) \
+    for ((V) = borBSetNext((S), 0); (V) >= 0; (V) = borBSetNext((S), (V) + 1))
+
+/**
+ * Initialize the set.
+ */
+void borBSetInit(bor_bset_t *s);
+
+/**
+ * Frees allocated memory.
+ */
+void borBSetFree(bor_bset_t *s);
+
+/**
+ * Makes sure that the set has at least {words} words.
+ */
+void borBSetResize(bor_bset_t *s, int words);
+
+/**
+ * s = \emptyset
+ */
+_bor_inline void borBSetEmpty(bor_bset_t *s);
+
+/**
+ * Returns true if val \in s
+ */
+_bor_inline int borBSetIn(int val, const bor_bset_t *s);
+
+/**
+ * s = s \cup {val}
+ */
+_bor_inline void borBSetAdd(bor_bset_t *s, int val);
+
+/**
+ * s = s \setminus {val}
+ * Returns true if val was found in s.
+ */
+_bor_inline int borBSetRm(bor_bset_t *s, int val);
+
+/**
+ * Returns the smallest element greater or equal to {val} or -1 if there
+ * is none.
+ */
+_bor_inline int borBSetNext(const bor_bset_t *s, int val);
+
+/**
+ * Returns the number of elements.
+ */
+int borBSetSize(const bor_bset_t *s);
+
+/**
+ * Returns true if the set is empty.
+ */
+int borBSetIsEmpty(const bor_bset_t *s);
+
+/**
+ * Returns number of words without trailing zero words, i.e., the greatest
+ * element is smaller than 64 times the returned value.
+ */
+int borBSetUsedWords(const bor_bset_t *s);
+
+/**
+ * d = s
+ */
+void borBSetSet(bor_bset_t *d, const bor_bset_t *s);
+
+/**
+ * dst = dst \cup src
+ */
+void borBSetUnion(bor_bset_t *dst, const bor_bset_t *src);
+
+/**
+ * dst = s1 \cup s2
+ */
+void borBSetUnion2(bor_bset_t *dst, const bor_bset_t *s1,
+                   const bor_bset_t *s2);
+
+/**
+ * dst = dst \cap src
+ */
+void borBSetIntersect(bor_bset_t *dst, const bor_bset_t *src);
+
+/**
+ * dst = s1 \cap s2
+ */
+void borBSetIntersect2(bor_bset_t *dst, const bor_bset_t *s1,
+                       const bor_bset_t *s2);
+
+/**
+ * s1 = s1 \setminus s2
+ */
+void borBSetMinus(bor_bset_t *s1, const bor_bset_t *s2);
+
+/**
+ * d = s1 \setminus s2
+ */
+void borBSetMinus2(bor_bset_t *d, const bor_bset_t *s1,
+                   const bor_bset_t *s2);
+
+/**
+ * Return true if s1 \subseteq s2
+ */
+int borBSetIsSubset(const bor_bset_t *s1, const bor_bset_t *s2);
+
+/**
+ * Returns true if the sets are disjoint.
+ */
+int borBSetIsDisjoint(const bor_bset_t *s1, const bor_bset_t *s2);
+
+/**
+ * Returns size of s1 \cap s2.
+ */
+int borBSetIntersectionSize(const bor_bset_t *s1, const bor_bset_t *s2);
+
+/**
+ * Returns true if the sets are equal.
+ */
+int borBSetEq(const bor_bset_t *s1, const bor_bset_t *s2);
+
+/**
+ * d = s, all elements of s must be non-negative.
+ */
+void borBSetFromISet(bor_bset_t *d, const bor_iset_t *s);
+
+/**
+ * d = s
+ */
+void borBSetToISet(const bor_bset_t *s, bor_iset_t *d);
+
+
+/**** INLINES ****/
+_bor_inline void borBSetEmpty(bor_bset_t *s)
+{
+    if (s->size > 0)
+        memset(s->w, 0, sizeof(uint64_t) * s->size);
+}
+
+_bor_inline int borBSetIn(int val, const bor_bset_t *s)
+{
+    if ((val >> 6) >= s->size)
+        return 0;
+    return (s->w[val >> 6] >> (val & 63)) & 1u;
+}
+
+_bor_inline void borBSetAdd(bor_bset_t *s, int val)
+{
+    if ((val >> 6) >= s->size)
+        borBSetResize(s, (val >> 6) + 1);
+    s->w[val >> 6] |= (uint64_t)1 << (val & 63);
+}
+
+_bor_inline int borBSetRm(bor_bset_t *s, int val)
+{
+    uint64_t m = (uint64_t)1 << (val & 63);
+    int found;
+
+    if ((val >> 6) >= s->size)
+        return 0;
+    found = (s->w[val >> 6] & m) != 0;
+    s->w[val >> 6] &= ~m;
+    return found;
+}
+
+_bor_inline int borBSetNext(const bor_bset_t *s, int val)
+{
+    int w = val >> 6;
+    uint64_t m;
+
+    if (w >= s->size)
+        return -1;
+    m = s->w[w] & (~(uint64_t)0 << (val & 63));
+    while (m == 0){
+        if (++w >= s->size)
+            return -1;
+        m = s->w[w];
+    }
+    return (w << 6) + __builtin_ctzll(m);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_BSET_H__ */
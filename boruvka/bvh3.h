@@ -0,0 +1,146 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_BVH3_H__
+#define __BOR_BVH3_H__
+
+#include <boruvka/vec3.h>
+#include <boruvka/mesh3.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * BVH3 - Bounding Volume Hierarchy of Mesh Faces
+ * ===============================================
+ *
+ * Binary tree of axis aligned bounding boxes over faces of bor_mesh3_t.
+ * The tree is built top-down using binned surface area heuristic (SAH) and
+ * all nodes are stored in one array, both children of an inner node are
+ * stored next to each other. Faces are reordered so that each leaf refers
+ * to a continuous range of them.
+ *
+ * The tree refers to coordinates of vertices of the mesh, so if vertices
+ * are moved the tree can be updated by borBVH3Refit() instead of building
+ * it again. The topology of the mesh must not change.
+ *
+ * Example:
+ * ~~~~~~~~
+ *   bor_bvh3_t *bvh = borBVH3New(mesh, 4);
+ *   bor_mesh3_face_t *face;
+ *   bor_vec3_t w;
+ *   bor_real_t dist2;
+ *
+ *   dist2 = borBVH3ClosestPoint(bvh, &point, &w, &face);
+ *   ...
+ *   borBVH3Del(bvh);
+ */
+
+struct _bor_bvh3_node_t {
+    bor_real_t lo[3]; /*!< Lower corner of bounding box */
+    bor_real_t hi[3]; /*!< Upper corner of bounding box */
+    int first;        /*!< Index of the first face of leaf or index of the
+                           first child of inner node (the second one is
+                           first + 1) */
+    int len;          /*!< Number of faces in leaf, 0 for inner node */
+};
+typedef struct _bor_bvh3_node_t bor_bvh3_node_t;
+
+struct _bor_bvh3_t {
+    bor_bvh3_node_t *nodes;   /*!< Nodes, root is the first one */
+    int nodes_len;
+    int depth;                /*!< Maximal depth of a leaf */
+
+    bor_mesh3_face_t **faces; /*!< Faces in order of leaves */
+    const bor_vec3_t **tris;  /*!< Coordinates of vertices of faces, three
+                                   per face */
+    int faces_len;
+};
+typedef struct _bor_bvh3_t bor_bvh3_t;
+
+/**
+ * Callback for borBVH3Overlap(), returns 0 to continue or non-zero to
+ * stop the search.
+ */
+typedef int (*bor_bvh3_overlap_fn)(bor_mesh3_face_t *f1,
+                                   bor_mesh3_face_t *f2, void *data);
+
+/**
+ * Builds BVH over all faces of the mesh. If {num_threads} is greater than
+ * one, subtrees are built in parallel using bor_tasks_t.
+ */
+bor_bvh3_t *borBVH3New(bor_mesh3_t *mesh, int num_threads);
+
+/**
+ * Deletes BVH.
+ */
+void borBVH3Del(bor_bvh3_t *bvh);
+
+/**
+ * Recomputes bounding boxes after vertices of the mesh were moved.
+ * Structure of the tree stays the same, so its quality degrades when the
+ * vertices move a lot.
+ */
+void borBVH3Refit(bor_bvh3_t *bvh);
+
+/**
+ * Returns true if triangle (a, b, c) overlaps some face. The face is
+ * stored in {face} if it is non-NULL.
+ */
+int borBVH3TriOverlap(const bor_bvh3_t *bvh,
+                      const bor_vec3_t *a, const bor_vec3_t *b,
+                      const bor_vec3_t *c, bor_mesh3_face_t **face);
+
+/**
+ * Returns squared distance of point {p} from the closest face. The
+ * closest point and face are stored in {witness} and {face} if they are
+ * non-NULL. Returns BOR_REAL_MAX if there are no faces.
+ */
+bor_real_t borBVH3ClosestPoint(const bor_bvh3_t *bvh, const bor_vec3_t *p,
+                               bor_vec3_t *witness, bor_mesh3_face_t **face);
+
+/**
+ * Casts ray from {origin} in direction {dir} and finds the first face
+ * hit at distance (in multiples of {dir}) between 0 and {*t}. Returns true
+ * if such face was found, in which case {*t} is set to distance of the
+ * hit and the face is stored in {face} if it is non-NULL.
+ */
+int borBVH3Ray(const bor_bvh3_t *bvh, const bor_vec3_t *origin,
+               const bor_vec3_t *dir, bor_real_t *t,
+               bor_mesh3_face_t **face);
+
+/**
+ * Finds overlapping pairs of faces of two meshes and calls {fn} for each
+ * pair (if {fn} is non-NULL). Returns number of found pairs.
+ */
+int borBVH3Overlap(const bor_bvh3_t *bvh1, const bor_bvh3_t *bvh2,
+                   bor_bvh3_overlap_fn fn, void *data);
+
+/**
+ * Returns squared distance between two meshes, i.e., zero if they
+ * overlap. The closest points and faces are stored in {w1}, {w2} and {f1},
+ * {f2} if they are non-NULL. Returns BOR_REAL_MAX if any mesh is empty.
+ */
+bor_real_t borBVH3Dist2(const bor_bvh3_t *bvh1, const bor_bvh3_t *bvh2,
+                        bor_vec3_t *w1, bor_vec3_t *w2,
+                        bor_mesh3_face_t **f1, bor_mesh3_face_t **f2);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_BVH3_H__ */
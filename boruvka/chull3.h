@@ -19,6 +19,7 @@
 
 #include <boruvka/mesh3.h>
 #include <boruvka/list.h>
+#include <boruvka/pool.h>
 /* #include <boruvka/predicates.h> */
 
 #ifdef __cplusplus
@@ -33,6 +34,11 @@ struct _bor_chull3_t {
     bor_mesh3_t *mesh; /*!< Mesh representing convex hull */
     int coplanar;
 
+    bor_pool_t *verts_pool; /*!< Pools of vertices, edges and faces,
+                                 owned by .mesh */
+    bor_pool_t *edges_pool;
+    bor_pool_t *faces_pool;
+
     /* bor_pred_t pred; */
 };
 typedef struct _bor_chull3_t bor_chull3_t;
@@ -57,6 +63,32 @@ _bor_inline bor_mesh3_t *borCHull3Mesh(bor_chull3_t *h);
  */
 void borCHull3Add(bor_chull3_t *h, const bor_vec3_t *point);
 
+/**
+ * Creates new convex hull from {n} given points.
+ *
+ * Points are inserted in random order (with a fixed seed, so the result
+ * is reproducible) and each not yet inserted point is connected to one
+ * face of the current hull visible from it (conflict graph), so only
+ * faces around the new point are visited and only points from the
+ * removed faces are re-tested against new faces. Expected running time
+ * is O(n log n) compared to O(n h) of repeated borCHull3Add().
+ */
+bor_chull3_t *borCHull3Build(const bor_vec3_t *points, size_t n);
+
+/**
+ * Creates new convex hull from {n} given points using QuickHull running
+ * in {num_threads} threads.
+ *
+ * Extremal points and partitioning of points to outside sets of faces are
+ * computed in parallel. The hull is expanded in rounds, each round adds
+ * furthest points of all faces whose visible regions do not neighbour
+ * each other and then partitions points of removed faces in parallel.
+ * Visibility is decided by exact predicates (see predicates.h).
+ * If all points are coplanar, borCHull3Build() is used instead.
+ */
+bor_chull3_t *borCHull3BuildParallel(const bor_vec3_t *points, size_t n,
+                                     int num_threads);
+
 /**
  * Returns number of points on hull.
  */
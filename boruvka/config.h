@@ -0,0 +1,9 @@
+#ifndef __BOR_CONFIG_H__
+#define __BOR_CONFIG_H__
+
+#include <boruvka/config_endian.h>
+
+#define BOR_SINGLE
+#define BOR_TIMSORT
+
+#endif /* __BOR_CONFIG_H__ */
@@ -0,0 +1,4 @@
+#ifndef __BOR_CONFIG_ENDIAN_H__
+#define __BOR_CONFIG_ENDIAN_H__
+#define BOR_LITTLE_ENDIAN
+#endif /* __BOR_CONFIG_ENDIAN_H__ */
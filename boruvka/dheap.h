@@ -0,0 +1,188 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+
+#ifndef __BOR_DHEAP_H__
+#define __BOR_DHEAP_H__
+
+#include <boruvka/core.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * DHeap - Implicit d-ary Heap
+ * ============================
+ *
+ * Array-based heap where each node has {d} children (d is 2, 4 or 8).
+ * Keys are stored together with pointers to nodes in one array, so
+ * sifting through the heap does not touch the nodes and all children of a
+ * node share one cache line (two for d = 8). Each node remembers its
+ * position in the array which makes it possible to change its key or
+ * remove it from the heap.
+ *
+ * The operations are the same as those of bor_pairheap_t, except that the
+ * key is passed to the heap instead of being compared by a callback.
+ */
+
+/** vvvv */
+struct _bor_dheap_node_t {
+    int pos; /*!< Position in heap array, -1 if not in heap */
+};
+typedef struct _bor_dheap_node_t bor_dheap_node_t;
+
+struct _bor_dheap_el_t {
+    bor_real_t key;
+    bor_dheap_node_t *node;
+};
+typedef struct _bor_dheap_el_t bor_dheap_el_t;
+
+/**
+ * Callback for borDHeapClear() function.
+ */
+typedef void (*bor_dheap_clear)(bor_dheap_node_t *n, void *data);
+
+struct _bor_dheap_t {
+    bor_dheap_el_t *el;  /*!< Array of elements, root is el[0] */
+    bor_dheap_el_t *mem; /*!< Allocated memory */
+    int size;            /*!< Number of elements in heap */
+    int alloc;           /*!< Allocated number of elements */
+    int shift;           /*!< log2(d) */
+};
+typedef struct _bor_dheap_t bor_dheap_t;
+/** ^^^^ */
+
+
+/**
+ * Functions
+ * ----------
+ */
+
+/**
+ * Creates new empty heap with {d} children per node. {d} must be 2, 4 or
+ * 8, otherwise 4 is used.
+ */
+bor_dheap_t *borDHeapNew(int d);
+
+/**
+ * Deletes heap.
+ * Note that individual nodes are not disconnected from heap.
+ */
+void borDHeapDel(bor_dheap_t *h);
+
+/**
+ * Returns true if heap is empty.
+ */
+_bor_inline int borDHeapEmpty(const bor_dheap_t *h);
+
+/**
+ * Returns number of nodes in heap.
+ */
+_bor_inline int borDHeapSize(const bor_dheap_t *h);
+
+/**
+ * Returns minimal node (or NULL if heap is empty). If {key} is non-NULL it
+ * is filled with the key of the node.
+ */
+_bor_inline bor_dheap_node_t *borDHeapMin(const bor_dheap_t *h,
+                                          bor_real_t *key);
+
+/**
+ * Returns true if the node is in a heap.
+ */
+_bor_inline int borDHeapHas(const bor_dheap_node_t *n);
+
+/**
+ * Returns key of the node, the node must be in the heap.
+ */
+_bor_inline bor_real_t borDHeapKey(const bor_dheap_t *h,
+                                   const bor_dheap_node_t *n);
+
+/**
+ * Adds node with the given key to heap.
+ */
+void borDHeapAdd(bor_dheap_t *h, bor_dheap_node_t *n, bor_real_t key);
+
+/**
+ * Removes and returns minimal node from heap. If {key} is non-NULL it is
+ * filled with the key of the node.
+ */
+bor_dheap_node_t *borDHeapExtractMin(bor_dheap_t *h, bor_real_t *key);
+
+/**
+ * Decreases key of the node. If the key may be greater than the current
+ * one, call borDHeapUpdate() instead.
+ */
+void borDHeapDecreaseKey(bor_dheap_t *h, bor_dheap_node_t *n,
+                         bor_real_t key);
+
+/**
+ * Changes key of the node.
+ */
+void borDHeapUpdate(bor_dheap_t *h, bor_dheap_node_t *n, bor_real_t key);
+
+/**
+ * Removes node from heap.
+ */
+void borDHeapRemove(bor_dheap_t *h, bor_dheap_node_t *n);
+
+/**
+ * Removes all nodes from the heap and calls a given callback (if
+ * non-NULL) for each of them. There is no guarantee for any particular
+ * order of the removed nodes.
+ */
+void borDHeapClear(bor_dheap_t *h, bor_dheap_clear clear_fn,
+                   void *user_data);
+
+
+/**** INLINES ****/
+_bor_inline int borDHeapEmpty(const bor_dheap_t *h)
+{
+    return h->size == 0;
+}
+
+_bor_inline int borDHeapSize(const bor_dheap_t *h)
+{
+    return h->size;
+}
+
+_bor_inline bor_dheap_node_t *borDHeapMin(const bor_dheap_t *h,
+                                          bor_real_t *key)
+{
+    if (h->size == 0)
+        return NULL;
+    if (key)
+        *key = h->el[0].key;
+    return h->el[0].node;
+}
+
+_bor_inline int borDHeapHas(const bor_dheap_node_t *n)
+{
+    return n->pos >= 0;
+}
+
+_bor_inline bor_real_t borDHeapKey(const bor_dheap_t *h,
+                                   const bor_dheap_node_t *n)
+{
+    return h->el[n->pos].key;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_DHEAP_H__ */
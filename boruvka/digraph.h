@@ -51,6 +51,42 @@ struct bor_digraph {
 };
 typedef struct bor_digraph bor_digraph_t;
 
+/**
+ * Immutable form of bor_digraph_t created by borDigraphFreeze().
+ * Out-edges are stored in compressed sparse row form and in-edges in
+ * compressed sparse column form, both sorted by edge IDs, i.e., in the
+ * same order as .out and .in sets of bor_digraph_node_t.
+ * Labels are packed, the label of node i is
+ * node_label[node_label_start[i]], ..., node_label[node_label_start[i+1]-1]
+ * (edge labels are stored the same way).
+ * Node and edge IDs are the same as in the original graph and all arrays
+ * are stored in one memory block.
+ */
+struct bor_digraph_frozen {
+    int node_size;
+    int edge_size;
+
+    int *out_start; /*!< Out-edges of node i are stored on positions
+                         out_start[i], ..., out_start[i+1]-1 */
+    int *out_node;  /*!< Target node of each out-edge */
+    int *out_edge;  /*!< ID of each out-edge */
+    int *in_start;  /*!< Same as .out_start for in-edges */
+    int *in_node;   /*!< Source node of each in-edge */
+    int *in_edge;   /*!< ID of each in-edge */
+
+    int *edge_from;
+    int *edge_to;
+    int *node_color;
+    int *edge_color;
+    int *node_label_start;
+    int *node_label;
+    int *edge_label_start;
+    int *edge_label;
+
+    int *buf;       /*!< The memory block holding all arrays */
+};
+typedef struct bor_digraph_frozen bor_digraph_frozen_t;
+
 #define PDDL_DIGRAPH_FOR_EACH_NODE(G, N) \
     for (int __i = 0; __i < (G)->node_size && ((N) = (G)->node + __i); ++__i)
 #define PDDL_DIGRAPH_FOR_EACH_EDGE(G, N, E) \
@@ -178,6 +214,74 @@ void borDigraphSCC(bor_digraph_t *scc, const bor_digraph_t *g);
 void borDigraphDFS(const bor_digraph_t *g, const bor_iset_t *from_nodes,
                    const bor_iset_t *ignore, int *visited);
 
+
+/**
+ * Creates immutable CSR/CSC form of the graph.
+ */
+void borDigraphFreeze(bor_digraph_frozen_t *fg, const bor_digraph_t *g);
+
+/**
+ * Frees allocated memory.
+ */
+void borDigraphFrozenFree(bor_digraph_frozen_t *fg);
+
+/**
+ * Creates a (mutable) graph with the same nodes, edges, labels and colors
+ * as the frozen graph.
+ */
+void borDigraphThaw(bor_digraph_t *g, const bor_digraph_frozen_t *fg);
+
+/**
+ * Returns number of labels of the node and stores pointer to the sorted
+ * array of labels in {label}.
+ */
+_bor_inline int borDigraphFrozenNodeLabel(const bor_digraph_frozen_t *fg,
+                                          int node_id, const int **label)
+{
+    *label = fg->node_label + fg->node_label_start[node_id];
+    return fg->node_label_start[node_id + 1]
+                - fg->node_label_start[node_id];
+}
+
+/**
+ * Same as borDigraphFrozenNodeLabel() but for edges.
+ */
+_bor_inline int borDigraphFrozenEdgeLabel(const bor_digraph_frozen_t *fg,
+                                          int edge_id, const int **label)
+{
+    *label = fg->edge_label + fg->edge_label_start[edge_id];
+    return fg->edge_label_start[edge_id + 1]
+                - fg->edge_label_start[edge_id];
+}
+
+/**
+ * Same as borDigraphInduce() but the input and the output are frozen.
+ */
+void borDigraphFrozenInduce(bor_digraph_frozen_t *dst,
+                            const bor_digraph_frozen_t *g,
+                            const bor_iset_t *nodes,
+                            const bor_iset_t *edges);
+
+/**
+ * Same as borDigraphSCC() but for the frozen graph. The output is the
+ * same as from borDigraphSCC() on the original graph.
+ */
+void borDigraphFrozenSCC(bor_digraph_t *scc, const bor_digraph_frozen_t *g);
+
+/**
+ * Same as borDigraphDFS() but for the frozen graph.
+ */
+void borDigraphFrozenDFS(const bor_digraph_frozen_t *g,
+                         const bor_iset_t *from_nodes,
+                         const bor_iset_t *ignore, int *visited);
+
+/**
+ * Computes the number of edges on the shortest path from {src} to each
+ * node. {dist} must have g->node_size elements, unreachable nodes get -1.
+ * Returns number of reached nodes.
+ */
+int borDigraphFrozenBFS(const bor_digraph_frozen_t *g, int src, int *dist);
+
 void borDigraphPrintDebug(const bor_digraph_t *g, FILE *fout);
 void borDigraphPrintDot(const bor_digraph_t *g, FILE *fout,
                    void (*node_label)(const bor_digraph_t *g, FILE *fout,
@@ -20,6 +20,7 @@
 #include <boruvka/core.h>
 #include <boruvka/list.h>
 #include <boruvka/pairheap.h>
+#include <boruvka/pradixq.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,14 +48,23 @@ struct _bor_dij_node_t {
                           from start node */
     struct _bor_dij_node_t *prev; /*!< Pointer to previous node in path */
 
+    int bstate;       /*!< State of node in backward search of
+                           borDijRunBidir() */
+    bor_real_t bdist; /*!< Distance to end node found by backward search */
+    struct _bor_dij_node_t *next; /*!< Next node in path towards end node
+                                       found by backward search */
+
     bor_list_t _list; /*!< Internal connection into list of nodes.
                            See function borDijNodeAdd() and operation
                            expand() */
     bor_real_t _loc_dist; /*!< Local distance computed in last expand().
                                See function borDijNodeAdd() and operation
                                expand() */
+    bor_real_t _heur;     /*!< Cached value of heuristic */
+    bor_real_t _key;      /*!< Key in heap, i.e., dist + _heur */
 
-    bor_pairheap_node_t _heap; /*!< Internal connection into heap */
+    bor_pairheap_node_t _heap;  /*!< Internal connection into heap */
+    bor_pairheap_node_t _bheap; /*!< Connection into backward heap */
 };
 typedef struct _bor_dij_node_t bor_dij_node_t;
 
@@ -111,10 +121,24 @@ _bor_inline bor_dij_node_t *borDijNodeFromList(bor_list_t *item);
  */
 typedef void (*bor_dij_expand)(bor_dij_node_t *n, bor_list_t *list, void *);
 
+/**
+ * Returns lower bound of distance from {n} to {end}.
+ * The heuristic must be consistent, i.e., h(end) = 0 and
+ * h(u) <= w(u, v) + h(v) for every edge (u, v). Then no node needs to be
+ * reopened and the first time {end} is closed its distance is the
+ * shortest one. Inconsistent heuristic can produce suboptimal paths.
+ */
+typedef bor_real_t (*bor_dij_heuristic)(const bor_dij_node_t *n,
+                                        const bor_dij_node_t *end, void *);
+
 /** ^^^^ */
 
 struct _bor_dij_ops_t {
-    bor_dij_expand expand; /*!< Expands nodes */
+    bor_dij_expand expand;      /*!< Expands nodes */
+    bor_dij_expand expand_back; /*!< Fills list by predecessors of a node
+                                     with weights of edges from them,
+                                     required by borDijRunBidir() */
+    bor_dij_heuristic heuristic; /*!< If set, borDijRun() runs A* */
     void *data;
 };
 typedef struct _bor_dij_ops_t bor_dij_ops_t;
@@ -131,8 +155,11 @@ _bor_inline void borDijOpsInit(bor_dij_ops_t *ops);
  * -------------------
  */
 struct _bor_dij_t {
-    bor_dij_ops_t ops;    /*!< Operations */
-    bor_pairheap_t *heap; /*!< Priority heap */
+    bor_dij_ops_t ops;     /*!< Operations */
+    bor_pairheap_t *heap;  /*!< Priority heap */
+    bor_pairheap_t *bheap; /*!< Heap of backward search */
+    size_t settled;        /*!< Number of nodes closed in the last run
+                                (in both directions) */
 };
 typedef struct _bor_dij_t bor_dij_t;
 
@@ -149,22 +176,156 @@ void borDijDel(bor_dij_t *dij);
 
 /**
  * Runs dikstra algorithm.
+ * If ops.heuristic is set, nodes are ordered by dist + heuristic, i.e.,
+ * A* algorithm is run.
  * Returns 0 if path was found.
  */
 int borDijRun(bor_dij_t *dij, bor_dij_node_t *start,
                               bor_dij_node_t *end);
 
+/**
+ * Runs bidirectional Dijkstra: forward search from {start} using
+ * ops.expand and backward search from {end} using ops.expand_back are
+ * alternated and the algorithm terminates when sum of minimal keys of
+ * both heaps reaches length of the best path found so far. Heuristic is
+ * not used. All nodes must be initialized by borDijNodeInit().
+ *
+ * If path was found, 0 is returned and nodes on the path have .dist and
+ * .prev set as if borDijRun() was called, so borDijPath() can be used.
+ * If ops.expand_back is not set, nothing is searched and -1 is returned.
+ */
+int borDijRunBidir(bor_dij_t *dij, bor_dij_node_t *start,
+                                   bor_dij_node_t *end);
+
 /**
  * Fills given list by path which ends on endnode.
  */
 void borDijPath(bor_dij_node_t *endnode, bor_list_t *list);
 
 
+/**
+ * Dijkstra with Integer Weights
+ * ------------------------------
+ *
+ * Variant for non-negative integer weights intended for many queries over
+ * the same graph. Open nodes are kept in a radix heap (bor_pradixq_t)
+ * which stays allocated between runs. Nodes are not reinitialized before
+ * each run, instead bor_dij_int_t counts runs and a node whose generation
+ * differs from the current run is considered unknown. So
+ * borDijIntNodeInit() needs to be called only once per node.
+ *
+ * Example:
+ * ~~~~~~~~
+ *   bor_dij_int_t *dij = borDijIntNew(&ops);
+ *   for (...){
+ *       borDijIntRun(dij, &nodes[src].dij, targets, num_targets);
+ *       for (i = 0; i < num_targets; ++i)
+ *           ... borDijIntDist(dij, targets[i]) ...
+ *   }
+ *   borDijIntDel(dij);
+ */
+struct _bor_dij_int_node_t {
+    unsigned long gen; /*!< Run in which the node was last reached */
+    int state;         /*!< State of node valid in the run {gen} */
+    long dist;         /*!< Length of tentative shortest path */
+    struct _bor_dij_int_node_t *prev; /*!< Previous node in path */
+
+    bor_list_t _list;       /*!< Connection into list of expanded nodes */
+    long _loc_dist;         /*!< Local distance set by borDijIntNodeAdd() */
+    int _handle;            /*!< Handle to the queue */
+    unsigned long _target;  /*!< Run in which the node is a target */
+};
+typedef struct _bor_dij_int_node_t bor_dij_int_node_t;
+
+/**
+ * Fill given list by neighbor nodes of {n} using borDijIntNodeAdd().
+ */
+typedef void (*bor_dij_int_expand)(bor_dij_int_node_t *n, bor_list_t *list,
+                                   void *);
+
+struct _bor_dij_int_ops_t {
+    bor_dij_int_expand expand; /*!< Expands nodes */
+    void *data;
+};
+typedef struct _bor_dij_int_ops_t bor_dij_int_ops_t;
+
+struct _bor_dij_int_t {
+    bor_dij_int_ops_t ops;
+    bor_pradixq_t queue; /*!< Queue of open nodes */
+    unsigned long gen;   /*!< Number of the current run */
+};
+typedef struct _bor_dij_int_t bor_dij_int_t;
+
+/**
+ * Initializes node. Call it once when the node is created.
+ */
+_bor_inline void borDijIntNodeInit(bor_dij_int_node_t *n);
+
+/**
+ * Adds node into given list with weight {dist} of edge from the expanded
+ * node. Use this function in expand() operation.
+ */
+_bor_inline void borDijIntNodeAdd(bor_dij_int_node_t *n,
+                                  bor_list_t *list, long dist);
+
+/**
+ * Returns node stored in list.
+ */
+_bor_inline bor_dij_int_node_t *borDijIntNodeFromList(bor_list_t *item);
+
+/**
+ * Returns true if the node was closed in the last run, i.e., its distance
+ * is final.
+ */
+_bor_inline int borDijIntNodeClosed(const bor_dij_int_t *dij,
+                                    const bor_dij_int_node_t *n);
+
+/**
+ * Returns distance of the node from the start node found in the last run
+ * or -1 if the node was not reached. The distance is the shortest one only
+ * if the node is closed.
+ */
+_bor_inline long borDijIntDist(const bor_dij_int_t *dij,
+                               const bor_dij_int_node_t *n);
+
+/**
+ * Returns previous node on path found in the last run.
+ */
+_bor_inline bor_dij_int_node_t *borDijIntNodePrev(const bor_dij_int_t *dij,
+                                                  const bor_dij_int_node_t *n);
+
+/**
+ * Initialize operations struct.
+ */
+_bor_inline void borDijIntOpsInit(bor_dij_int_ops_t *ops);
+
+/**
+ * Creates new integer dij struct.
+ */
+bor_dij_int_t *borDijIntNew(const bor_dij_int_ops_t *ops);
+
+/**
+ * Deletes dij struct. Nodes are not touched.
+ */
+void borDijIntDel(bor_dij_int_t *dij);
+
+/**
+ * Runs Dijkstra algorithm from {start} and stops as soon as all
+ * {targets_len} nodes from {targets} are closed. If {targets_len} is
+ * zero, all reachable nodes are closed.
+ * Returns 0 if all targets were reached, -1 otherwise.
+ */
+int borDijIntRun(bor_dij_int_t *dij, bor_dij_int_node_t *start,
+                 bor_dij_int_node_t **targets, int targets_len);
+
+
 /**** INLINES ****/
 _bor_inline void borDijNodeInit(bor_dij_node_t *n)
 {
-    n->state = BOR_DIJ_STATE_UNKNOWN;
-    n->dist  = BOR_REAL_MAX;
+    n->state  = BOR_DIJ_STATE_UNKNOWN;
+    n->dist   = BOR_REAL_MAX;
+    n->bstate = BOR_DIJ_STATE_UNKNOWN;
+    n->bdist  = BOR_REAL_MAX;
 }
 
 _bor_inline int borDijNodeClosed(const bor_dij_node_t *n)
@@ -201,6 +362,51 @@ _bor_inline void borDijOpsInit(bor_dij_ops_t *ops)
     bzero(ops, sizeof(bor_dij_ops_t));
 }
 
+_bor_inline void borDijIntNodeInit(bor_dij_int_node_t *n)
+{
+    n->gen = 0;
+    n->_target = 0;
+}
+
+_bor_inline void borDijIntNodeAdd(bor_dij_int_node_t *n,
+                                  bor_list_t *list, long dist)
+{
+    borListAppend(list, &n->_list);
+    n->_loc_dist = dist;
+}
+
+_bor_inline bor_dij_int_node_t *borDijIntNodeFromList(bor_list_t *item)
+{
+    return BOR_LIST_ENTRY(item, bor_dij_int_node_t, _list);
+}
+
+_bor_inline int borDijIntNodeClosed(const bor_dij_int_t *dij,
+                                    const bor_dij_int_node_t *n)
+{
+    return n->gen == dij->gen && n->state == BOR_DIJ_STATE_CLOSED;
+}
+
+_bor_inline long borDijIntDist(const bor_dij_int_t *dij,
+                               const bor_dij_int_node_t *n)
+{
+    if (n->gen != dij->gen)
+        return -1;
+    return n->dist;
+}
+
+_bor_inline bor_dij_int_node_t *borDijIntNodePrev(const bor_dij_int_t *dij,
+                                                  const bor_dij_int_node_t *n)
+{
+    if (n->gen != dij->gen)
+        return NULL;
+    return n->prev;
+}
+
+_bor_inline void borDijIntOpsInit(bor_dij_int_ops_t *ops)
+{
+    bzero(ops, sizeof(bor_dij_int_ops_t));
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
@@ -0,0 +1,148 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_DT2_H__
+#define __BOR_DT2_H__
+
+#include <boruvka/vec2.h>
+#include <boruvka/vec3.h>
+#include <boruvka/poly2.h>
+#include <boruvka/mesh3.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * DT2 - 2D Delaunay Triangulation
+ * ================================
+ *
+ * Delaunay and constrained Delaunay triangulation of points in plane.
+ * Points and constrained segments (or whole polygons) are first added
+ * and then the triangulation is computed at once by borDT2Build().
+ *
+ * Points are inserted incrementally (Bowyer-Watson) in biased randomized
+ * order sorted along Hilbert curve in each round, the triangle containing
+ * inserted point is found by walking from the last created triangle.
+ * Segments are inserted afterwards by removing the triangles they cross
+ * and re-triangulating the resulting cavities. All decisions are made by
+ * exact predicates (see predicates.h).
+ *
+ * Example:
+ * ~~~~~~~~
+ *   bor_dt2_t *dt = borDT2New();
+ *   borDT2AddPoly2(dt, poly);
+ *   for (i = 0; i < n; i++)
+ *       borDT2AddPoint(dt, &pts[i]);
+ *   if (borDT2Build(dt, BOR_DT2_CLIP) == 0){
+ *       for (i = 0; i < dt->tris_len; i++)
+ *           ... dt->tris[i].v[0], dt->tris[i].v[1], dt->tris[i].v[2] ...
+ *   }
+ *   borDT2Del(dt);
+ */
+
+/**
+ * Remove triangles lying outside polygons formed by constrained segments
+ * (a triangle is kept if any path from it to the infinity crosses an odd
+ * number of segments, so holes are formed by nested polygons).
+ */
+#define BOR_DT2_CLIP 0x1
+
+/**
+ * Triangle of the triangulation.
+ */
+struct _bor_dt2_tri_t {
+    int v[3];  /*!< Indices of points in counter-clockwise order */
+    int nb[3]; /*!< nb[i] is neighbour triangle sharing edge opposite to
+                    v[i] or -1 if the edge lies on boundary */
+};
+typedef struct _bor_dt2_tri_t bor_dt2_tri_t;
+
+struct _bor_dt2_t {
+    bor_vec2_t *pts;     /*!< Added points */
+    int pts_len, pts_size;
+    int *segs;           /*!< Pairs of indices of constrained segments */
+    int segs_len, segs_size;
+
+    int *vert;           /*!< Each point refers to itself or to the point
+                              with same coordinates it was merged with */
+    bor_dt2_tri_t *tris; /*!< Triangles */
+    int tris_len;
+};
+typedef struct _bor_dt2_t bor_dt2_t;
+
+
+/**
+ * Creates an empty triangulation.
+ */
+bor_dt2_t *borDT2New(void);
+
+/**
+ * Deletes triangulation.
+ */
+void borDT2Del(bor_dt2_t *dt);
+
+/**
+ * Adds point and returns its index.
+ */
+int borDT2AddPoint(bor_dt2_t *dt, const bor_vec2_t *p);
+
+/**
+ * Adds {n} points and returns index of the first one.
+ */
+int borDT2AddPoints(bor_dt2_t *dt, const bor_vec2_t *p, int n);
+
+/**
+ * Adds constrained segment between points {a} and {b}. Segments may not
+ * cross each other, but they can touch in points.
+ */
+void borDT2AddSegment(bor_dt2_t *dt, int a, int b);
+
+/**
+ * Adds corners of polygon as points and its sides as constrained
+ * segments. Index of the first corner is returned.
+ */
+int borDT2AddPoly2(bor_dt2_t *dt, const bor_poly2_t *poly);
+
+/**
+ * Computes triangulation of all added points and segments, the result is
+ * stored in .tris. {flags} is zero or BOR_DT2_CLIP.
+ *
+ * Duplicate points are merged (see .vert) and segments passing through
+ * points are split. Returns 0 on success, -1 if all points are collinear
+ * or if some segments cross each other.
+ */
+int borDT2Build(bor_dt2_t *dt, unsigned int flags);
+
+/**
+ * Converts triangulation to Mesh3 with z = 0. Coordinates of vertices are
+ * stored in {coords} array that must have at least .pts_len elements and
+ * must not be freed before the mesh. Only points that are part of some
+ * triangle are added to the mesh.
+ * Use borDT2Mesh3Del() to delete the returned mesh.
+ */
+bor_mesh3_t *borDT2Mesh3(const bor_dt2_t *dt, bor_vec3_t *coords);
+
+/**
+ * Deletes mesh returned by borDT2Mesh3().
+ */
+void borDT2Mesh3Del(bor_mesh3_t *mesh);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_DT2_H__ */
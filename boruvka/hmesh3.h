@@ -0,0 +1,290 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_HMESH3_H__
+#define __BOR_HMESH3_H__
+
+#include <boruvka/vec3.h>
+#include <boruvka/mesh3.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * HMesh3 - Array-based half-edge triangle mesh
+ * =============================================
+ *
+ * Compact alternative to bor_mesh3_t. Everything is stored in arrays and
+ * referenced by 32-bit indices, no element is allocated separately.
+ *
+ * Each face f consists of three half-edges 3f, 3f + 1 and 3f + 2 in
+ * counter-clockwise order, so next/previous half-edge and face of a
+ * half-edge are computed and only origin vertex and opposite (twin)
+ * half-edge are stored. A vertex holds one of its outgoing half-edges; if
+ * the vertex lies on boundary it is the one without twin, so that all
+ * outgoing half-edges can be visited by borHMesh3HERotCCW() starting from
+ * it:
+ * ~~~~~
+ *   int h = borHMesh3VertexHE(m, v);
+ *   if (h >= 0){
+ *       do {
+ *           ... borHMesh3HETarget(m, h) is neighbour of v ...
+ *           h = borHMesh3HERotCCW(m, h);
+ *       } while (h >= 0 && h != borHMesh3VertexHE(m, v));
+ *   }
+ * ~~~~~
+ *
+ * The mesh is supposed to be 2-manifold (with boundary). Removed vertices
+ * and faces are kept in free-lists and reused by next additions, so
+ * indices of the other elements never change.
+ */
+
+/** Make orientation of faces consistent, see borHMesh3NewSoup() */
+#define BOR_HMESH3_ORIENT 0x1
+
+struct _bor_hmesh3_he_t {
+    int v;    /*!< Origin vertex, -1 if the face is removed */
+    int twin; /*!< Opposite half-edge or -1 on boundary */
+};
+typedef struct _bor_hmesh3_he_t bor_hmesh3_he_t;
+
+struct _bor_hmesh3_t {
+    bor_vec3_t *coords;  /*!< Coordinates of vertices */
+    int *vhe;            /*!< Outgoing half-edge of each vertex, -1 for
+                              isolated vertex, <= -2 for removed vertex */
+    int verts_len;       /*!< Number of vertices including removed ones */
+    int verts_size;
+    int verts_free;      /*!< Free-list of removed vertices */
+    int verts_num;       /*!< Number of vertices in the mesh */
+
+    bor_hmesh3_he_t *he; /*!< Half-edges, 3 per face */
+    int faces_len;       /*!< Number of faces including removed ones */
+    int faces_size;
+    int faces_free;      /*!< Free-list of removed faces */
+    int faces_num;       /*!< Number of faces in the mesh */
+};
+typedef struct _bor_hmesh3_t bor_hmesh3_t;
+
+
+/**
+ * Creates an empty mesh.
+ */
+bor_hmesh3_t *borHMesh3New(void);
+
+/**
+ * Creates mesh from triangle soup: {verts_len} vertices with {coords} and
+ * {tris_len} triangles, each given by three consecutive indices in {tris}.
+ * Twins are found in linear time using incidence of vertices.
+ *
+ * Triangles should be consistently oriented; if {flags} contain
+ * BOR_HMESH3_ORIENT, orientation of triangles is changed so that it is
+ * consistent with the first triangle of each connected component. Edges
+ * shared by more than two triangles and edges of inconsistently oriented
+ * triangles are left as boundary.
+ */
+bor_hmesh3_t *borHMesh3NewSoup(const bor_vec3_t *coords, int verts_len,
+                               const int *tris, int tris_len,
+                               unsigned int flags);
+
+/**
+ * Deletes mesh.
+ */
+void borHMesh3Del(bor_hmesh3_t *m);
+
+/**
+ * Adds vertex and returns its index.
+ */
+int borHMesh3AddVertex(bor_hmesh3_t *m, const bor_vec3_t *coords);
+
+/**
+ * Removes isolated vertex. Returns 0 on success, -1 if the vertex is
+ * incident with some face.
+ */
+int borHMesh3RemoveVertex(bor_hmesh3_t *m, int v);
+
+/**
+ * Adds face (a, b, c) and returns its index. The new face is connected
+ * with the existing ones sharing its edges in the opposite direction.
+ * Faces around each vertex have to be added so that they form one fan
+ * (as in a growing surface), use borHMesh3NewSoup() for arbitrary input.
+ */
+int borHMesh3AddFace(bor_hmesh3_t *m, int a, int b, int c);
+
+/**
+ * Removes face, its vertices stay in the mesh.
+ */
+void borHMesh3RemoveFace(bor_hmesh3_t *m, int f);
+
+/**
+ * Collapses edge of half-edge {h}: target vertex is merged into origin
+ * vertex (which keeps its coordinates) and faces incident with the edge
+ * are removed. Returns 0 on success or -1 if the collapse would break
+ * manifoldness of the mesh (link condition), in which case the mesh is
+ * not changed.
+ */
+int borHMesh3EdgeCollapse(bor_hmesh3_t *m, int h);
+
+/**
+ * Converts mesh from bor_mesh3_t. Note that ._id member of vertices of
+ * {mesh} is overwritten.
+ */
+bor_hmesh3_t *borHMesh3FromMesh3(bor_mesh3_t *mesh);
+
+/**
+ * Converts mesh to bor_mesh3_t. Coordinates of vertices are copied to
+ * {coords} array which must have at least .verts_len elements and must
+ * not be freed before the returned mesh. Use borHMesh3Mesh3Del() to delete
+ * the returned mesh.
+ */
+bor_mesh3_t *borHMesh3ToMesh3(const bor_hmesh3_t *m, bor_vec3_t *coords);
+
+/**
+ * Deletes mesh returned by borHMesh3ToMesh3().
+ */
+void borHMesh3Mesh3Del(bor_mesh3_t *mesh);
+
+
+/**
+ * Returns first outgoing half-edge of vertex (see above).
+ */
+_bor_inline int borHMesh3VertexHE(const bor_hmesh3_t *m, int v);
+
+/**
+ * Returns true if vertex is part of the mesh.
+ */
+_bor_inline int borHMesh3VertexAlive(const bor_hmesh3_t *m, int v);
+
+/**
+ * Returns true if face is part of the mesh.
+ */
+_bor_inline int borHMesh3FaceAlive(const bor_hmesh3_t *m, int f);
+
+/**
+ * Returns first half-edge of face.
+ */
+_bor_inline int borHMesh3FaceHE(int f);
+
+/**
+ * Returns face of half-edge.
+ */
+_bor_inline int borHMesh3HEFace(int h);
+
+/**
+ * Returns next half-edge in face.
+ */
+_bor_inline int borHMesh3HENext(int h);
+
+/**
+ * Returns previous half-edge in face.
+ */
+_bor_inline int borHMesh3HEPrev(int h);
+
+/**
+ * Returns opposite half-edge or -1.
+ */
+_bor_inline int borHMesh3HETwin(const bor_hmesh3_t *m, int h);
+
+/**
+ * Returns origin vertex of half-edge.
+ */
+_bor_inline int borHMesh3HEOrigin(const bor_hmesh3_t *m, int h);
+
+/**
+ * Returns target vertex of half-edge.
+ */
+_bor_inline int borHMesh3HETarget(const bor_hmesh3_t *m, int h);
+
+/**
+ * Returns next outgoing half-edge of the origin vertex in
+ * counter-clockwise order or -1 if boundary is reached.
+ */
+_bor_inline int borHMesh3HERotCCW(const bor_hmesh3_t *m, int h);
+
+/**
+ * Returns next outgoing half-edge of the origin vertex in clockwise order
+ * or -1 if boundary is reached.
+ */
+_bor_inline int borHMesh3HERotCW(const bor_hmesh3_t *m, int h);
+
+
+/**** INLINES ****/
+_bor_inline int borHMesh3VertexHE(const bor_hmesh3_t *m, int v)
+{
+    return m->vhe[v];
+}
+
+_bor_inline int borHMesh3VertexAlive(const bor_hmesh3_t *m, int v)
+{
+    return m->vhe[v] >= -1;
+}
+
+_bor_inline int borHMesh3FaceAlive(const bor_hmesh3_t *m, int f)
+{
+    return m->he[3 * f].v >= 0;
+}
+
+_bor_inline int borHMesh3FaceHE(int f)
+{
+    return 3 * f;
+}
+
+_bor_inline int borHMesh3HEFace(int h)
+{
+    return h / 3;
+}
+
+_bor_inline int borHMesh3HENext(int h)
+{
+    return (h % 3 == 2 ? h - 2 : h + 1);
+}
+
+_bor_inline int borHMesh3HEPrev(int h)
+{
+    return (h % 3 == 0 ? h + 2 : h - 1);
+}
+
+_bor_inline int borHMesh3HETwin(const bor_hmesh3_t *m, int h)
+{
+    return m->he[h].twin;
+}
+
+_bor_inline int borHMesh3HEOrigin(const bor_hmesh3_t *m, int h)
+{
+    return m->he[h].v;
+}
+
+_bor_inline int borHMesh3HETarget(const bor_hmesh3_t *m, int h)
+{
+    return m->he[borHMesh3HENext(h)].v;
+}
+
+_bor_inline int borHMesh3HERotCCW(const bor_hmesh3_t *m, int h)
+{
+    return m->he[borHMesh3HEPrev(h)].twin;
+}
+
+_bor_inline int borHMesh3HERotCW(const bor_hmesh3_t *m, int h)
+{
+    int t = m->he[h].twin;
+    return (t < 0 ? -1 : borHMesh3HENext(t));
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_HMESH3_H__ */
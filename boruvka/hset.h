@@ -0,0 +1,164 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_HSET_H__
+#define __BOR_HSET_H__
+
+#include <boruvka/iset.h>
+#include <boruvka/bset.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Hybrid Set
+ * ===========
+ *
+ * Set of non-negative integers stored either as a sorted array
+ * (bor_iset_t) or as a bitset (bor_bset_t), whichever takes less memory.
+ * A bitset of elements smaller than u takes u bits and an array takes 32
+ * bits per element, so the set is switched to the bitset once it has at
+ * least u/32 elements, where u is one plus the greatest element. It is
+ * switched back to the array once it has less than u/64 elements, so
+ * that it does not alternate between representations.
+ *
+ * Operations on two sets in different representations do not convert
+ * them, the elements of the array are looked up in the bitset instead.
+ */
+
+struct bor_hset {
+    bor_iset_t arr;  /*!< Elements if .dense is false */
+    bor_bset_t bits; /*!< Elements if .dense is true */
+    int dense;       /*!< True if the bitset is used */
+    int bits_size;   /*!< Number of elements in .bits */
+};
+typedef struct bor_hset bor_hset_t;
+
+/**
+ * Iterates over elements in increasing order, V must be int and __j is
+ * used as a helper variable.
+ */
+#define BOR_HSET_FOR_EACH(S, V) \
+    for (int __j = 0; \
+            (V) = ((S)->dense \
+                    ? borBSetNext(&(S)->bits, __j) \
+                    : (__j < (S)->arr.size ? (S)->arr.s[__j] : -1)), \
+            (V) >= 0; \
+            __j = ((S)->dense ? (V) + 1 : __j + 1))
+
+/**
+ * Initialize the set.
+ */
+void borHSetInit(bor_hset_t *s);
+
+/**
+ * Frees allocated memory.
+ */
+void borHSetFree(bor_hset_t *s);
+
+/**
+ * Returns size of the set.
+ */
+_bor_inline int borHSetSize(const bor_hset_t *s);
+
+/**
+ * Returns true if val \in s
+ */
+_bor_inline int borHSetIn(int val, const bor_hset_t *s);
+
+/**
+ * s = \emptyset
+ */
+void borHSetEmpty(bor_hset_t *s);
+
+/**
+ * s = s \cup {val}
+ */
+void borHSetAdd(bor_hset_t *s, int val);
+
+/**
+ * s = s \setminus {val}
+ * Returns true if val was found in s.
+ */
+int borHSetRm(bor_hset_t *s, int val);
+
+/**
+ * d = s
+ */
+void borHSetSet(bor_hset_t *d, const bor_hset_t *s);
+
+/**
+ * dst = dst \cup src
+ */
+void borHSetUnion(bor_hset_t *dst, const bor_hset_t *src);
+
+/**
+ * dst = dst \cap src
+ */
+void borHSetIntersect(bor_hset_t *dst, const bor_hset_t *src);
+
+/**
+ * s1 = s1 \setminus s2
+ */
+void borHSetMinus(bor_hset_t *s1, const bor_hset_t *s2);
+
+/**
+ * Return true if s1 \subseteq s2
+ */
+int borHSetIsSubset(const bor_hset_t *s1, const bor_hset_t *s2);
+
+/**
+ * Returns size of s1 \cap s2.
+ */
+int borHSetIntersectionSize(const bor_hset_t *s1, const bor_hset_t *s2);
+
+/**
+ * Returns true if the sets are equal.
+ */
+int borHSetEq(const bor_hset_t *s1, const bor_hset_t *s2);
+
+/**
+ * d = s, all elements of s must be non-negative.
+ */
+void borHSetFromISet(bor_hset_t *d, const bor_iset_t *s);
+
+/**
+ * d = s
+ */
+void borHSetToISet(const bor_hset_t *s, bor_iset_t *d);
+
+
+/**** INLINES ****/
+_bor_inline int borHSetSize(const bor_hset_t *s)
+{
+    if (s->dense)
+        return s->bits_size;
+    return s->arr.size;
+}
+
+_bor_inline int borHSetIn(int val, const bor_hset_t *s)
+{
+    if (s->dense)
+        return borBSetIn(val, &s->bits);
+    return borISetIn(val, &s->arr);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_HSET_H__ */
@@ -400,6 +400,47 @@ _bor_inline void borMat3Abs2(bor_mat3_t *dst, const bor_mat3_t *src);
 int borMat3Eigen(const bor_mat3_t *_m, bor_mat3_t *eigen,
                  bor_vec3_t *eigenvals);
 
+/**
+ * Computes eigenvalues and eigenvectors of a symmetric matrix.
+ * Only upper triangle of the matrix m is read.
+ * Eigenvalues are stored in ascending order into eigenvals and
+ * corresponding unit eigenvectors are stored as columns of eigen.
+ * Either of eigen or eigenvals can be NULL.
+ *
+ * Eigenvalues are computed analytically as roots of the characteristic
+ * polynomial and eigenvectors are obtained from cross products of rows of
+ * (m - l * I). Matrices with repeated eigenvalues are handled by reducing
+ * the problem to the orthogonal complement of the already found
+ * eigenvector, so no Jacobi-like iteration is needed. Computation is
+ * internally carried in double precision.
+ */
+void borMat3EigenSym(const bor_mat3_t *m, bor_mat3_t *eigen,
+                     bor_vec3_t *eigenvals);
+
+/**
+ * Same as borMat3EigenSym() but only the smallest eigenvalue and its
+ * eigenvector (e.g., normal of a covariance matrix) are computed.
+ * Either of eigenvec or eigenval can be NULL.
+ */
+void borMat3EigenSymMin(const bor_mat3_t *m, bor_vec3_t *eigenvec,
+                        bor_real_t *eigenval);
+
+/**
+ * Batch version of borMat3EigenSym().
+ * Decomposes len matrices from array m and stores results into the
+ * corresponding elements of eigen and eigenvals arrays (both can be NULL).
+ * Matrices are processed in small blocks using vectorizable code, so this
+ * is considerably faster than calling borMat3EigenSym() in a loop.
+ */
+void borMat3EigenSymBatch(const bor_mat3_t *m, size_t len,
+                          bor_mat3_t *eigen, bor_vec3_t *eigenvals);
+
+/**
+ * Batch version of borMat3EigenSymMin().
+ */
+void borMat3EigenSymMinBatch(const bor_mat3_t *m, size_t len,
+                             bor_vec3_t *eigenvec, bor_real_t *eigenval);
+
 /**
  * Computes dot product of r'th row of matrix m and c'th column of matrix n.
  */
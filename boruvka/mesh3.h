@@ -21,6 +21,7 @@
 #include <boruvka/core.h>
 #include <boruvka/vec3.h>
 #include <boruvka/list.h>
+#include <boruvka/pool.h>
 
 
 #ifdef __cplusplus
@@ -71,6 +72,10 @@ struct _bor_mesh3_face_t;
  *   ...
  * ~~~~~
  *
+ * Alternatively, elements can be allocated from pools owned by the mesh
+ * using borMesh3{Vertex,Edge,Face}Alloc(). Such elements need not be freed
+ * separately, all of them are released at once when the mesh is deleted.
+ *
  * NOTE: Don't access any struct's member directly instead use provided
  * inline functions.
  */
@@ -82,6 +87,11 @@ struct _bor_mesh3_t {
     size_t edges_len; /*!< Number of edges in list */
     bor_list_t faces; /*!< List of faces */
     size_t faces_len; /*!< Number of faces in list */
+
+    bor_pool_t *verts_pool; /*!< Pools of elements, see
+                                 borMesh3{Vertex,Edge,Face}Alloc() */
+    bor_pool_t *edges_pool;
+    bor_pool_t *faces_pool;
 };
 typedef struct _bor_mesh3_t bor_mesh3_t;
 
@@ -146,6 +156,19 @@ bor_mesh3_vertex_t *borMesh3VertexNew(void);
  */
 void borMesh3VertexDel(bor_mesh3_vertex_t *v);
 
+/**
+ * Allocates vertex from pool of mesh {m}. The vertex is not added to the
+ * mesh and it is released by borMesh3Del() or borMesh3Del2() (so it must
+ * not be deleted by borMesh3VertexDel()).
+ */
+bor_mesh3_vertex_t *borMesh3VertexAlloc(bor_mesh3_t *m);
+
+/**
+ * Returns vertex allocated by borMesh3VertexAlloc() back to pool of mesh {m}.
+ * The vertex must not be part of the mesh.
+ */
+void borMesh3VertexFree(bor_mesh3_t *m, bor_mesh3_vertex_t *v);
+
 
 /**
  * Sets pointer to user-defined vec3 coordinates.
@@ -208,6 +231,19 @@ bor_mesh3_edge_t *borMesh3EdgeNew(void);
  */
 void borMesh3EdgeDel(bor_mesh3_edge_t *e);
 
+/**
+ * Allocates edge from pool of mesh {m}. The edge is not added to the
+ * mesh and it is released by borMesh3Del() or borMesh3Del2() (so it must
+ * not be deleted by borMesh3EdgeDel()).
+ */
+bor_mesh3_edge_t *borMesh3EdgeAlloc(bor_mesh3_t *m);
+
+/**
+ * Returns edge allocated by borMesh3EdgeAlloc() back to pool of mesh {m}.
+ * The edge must not be part of the mesh.
+ */
+void borMesh3EdgeFree(bor_mesh3_t *m, bor_mesh3_edge_t *e);
+
 /**
  * Returns start or end point of edge.
  * Parameter i can be either 0 or 1 (no check is performed).
@@ -290,6 +326,19 @@ bor_mesh3_face_t *borMesh3FaceNew(void);
  */
 void borMesh3FaceDel(bor_mesh3_face_t *f);
 
+/**
+ * Allocates face from pool of mesh {m}. The face is not added to the
+ * mesh and it is released by borMesh3Del() or borMesh3Del2() (so it must
+ * not be deleted by borMesh3FaceDel()).
+ */
+bor_mesh3_face_t *borMesh3FaceAlloc(bor_mesh3_t *m);
+
+/**
+ * Returns face allocated by borMesh3FaceAlloc() back to pool of mesh {m}.
+ * The face must not be part of the mesh.
+ */
+void borMesh3FaceFree(bor_mesh3_t *m, bor_mesh3_face_t *f);
+
 /**
  * Returns incidenting edge.
  * Parameter i can be 0 or 1 or 2 since face has always exactly three
@@ -384,6 +433,10 @@ void borMesh3Del(bor_mesh3_t *m);
  * Before freeing a mesh, destructor iterates over all vertices. Each
  * vertex is first disconnected from mesh and then delvertex is called with
  * second argument vdata. Similarly are iterated edges and faces.
+ * Elements allocated from pools of the mesh are freed afterwards, so the
+ * callbacks must not delete them. If no callbacks are given and all
+ * elements come from the pools, they are released at once without
+ * iteration.
  */
 void borMesh3Del2(bor_mesh3_t *m,
                   void (*delvertex)(bor_mesh3_vertex_t *, void *), void *vdata,
@@ -481,6 +534,43 @@ void borMesh3DumpTriangles(bor_mesh3_t *m, FILE *out);
  */
 void borMesh3DumpPovray(bor_mesh3_t *m, FILE *out);
 
+/**
+ * Writes mesh as binary little endian PLY file (vertices with x, y, z
+ * coordinates and triangular faces). Edges that are not incident with any
+ * face are not stored, use borMesh3DumpBin() to keep them.
+ * Note that ._id member of vertices is overwritten.
+ * Returns 0 on success, -1 on write error.
+ */
+int borMesh3DumpPLY(bor_mesh3_t *m, FILE *out);
+
+/**
+ * Writes mesh in compact native binary format: header followed by
+ * coordinates of vertices, triples of vertex indices of faces and pairs
+ * of vertex indices of edges that are not incident with any face.
+ * Note that ._id member of vertices is overwritten.
+ * Returns 0 on success, -1 on write error.
+ */
+int borMesh3DumpBin(bor_mesh3_t *m, FILE *out);
+
+/**
+ * Loads mesh from binary little endian PLY file. Properties x, y, z of
+ * "vertex" element are used as coordinates and list property
+ * vertex_indices (or vertex_index) of "face" element as faces, other
+ * elements and properties are skipped. Polygons are triangulated as fans,
+ * degenerate faces and faces that would be third face of an edge are
+ * skipped.
+ *
+ * Coordinates of vertices are stored in array returned via {coords} which
+ * must be freed by borVec3ArrDel() after the mesh is deleted by
+ * borMesh3Del(). Returns NULL on error.
+ */
+bor_mesh3_t *borMesh3LoadPLY(const char *filename, bor_vec3_t **coords);
+
+/**
+ * Loads mesh written by borMesh3DumpBin(), see borMesh3LoadPLY().
+ */
+bor_mesh3_t *borMesh3LoadBin(const char *filename, bor_vec3_t **coords);
+
 
 
 /**** INLINES ****/
@@ -19,6 +19,7 @@
 
 #include <boruvka/core.h>
 #include <boruvka/list.h>
+#include <boruvka/pool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,11 +31,19 @@ extern "C" {
  * TODO
  */
 
+typedef struct _bor_net_csr_t bor_net_csr_t;
+
 struct _bor_net_t {
     bor_list_t nodes; /*!< List of nodes */
     size_t nodes_len; /*!< Number of nodes in list */
     bor_list_t edges; /*!< List of edges */
     size_t edges_len; /*!< Number of edges in list */
+
+    bor_pool_t *nodes_pool; /*!< Pools of nodes and edges, see
+                                 borNet{Node,Edge}Alloc() */
+    bor_pool_t *edges_pool;
+
+    bor_net_csr_t *csr; /*!< Attached CSR snapshot, see borNetToCSR() */
 };
 typedef struct _bor_net_t bor_net_t;
 
@@ -44,6 +53,7 @@ struct _bor_net_node_t {
 
     bor_list_t edges; /*!< List of all incidenting edgeections */
     size_t edges_len; /*!< Number of edgeections in list */
+    int _id;          /*!< Id of node in attached CSR snapshot or -1 */
 };
 typedef struct _bor_net_node_t bor_net_node_t;
 
@@ -78,6 +88,19 @@ bor_net_node_t *borNetNodeNew(void);
  */
 void borNetNodeDel(bor_net_node_t *v);
 
+/**
+ * Allocates node from pool of net {m}. The node is not added to the net
+ * and it is released by borNetDel() or borNetDel2() (so it must not be
+ * deleted by borNetNodeDel()).
+ */
+bor_net_node_t *borNetNodeAlloc(bor_net_t *m);
+
+/**
+ * Returns node allocated by borNetNodeAlloc() back to pool of net {m}.
+ * The node must not be part of the net.
+ */
+void borNetNodeFree(bor_net_t *m, bor_net_node_t *n);
+
 /**
  * Returns number of edgeections incidenting with given node.
  */
@@ -119,6 +142,19 @@ bor_net_edge_t *borNetEdgeNew(void);
  */
 void borNetEdgeDel(bor_net_edge_t *e);
 
+/**
+ * Allocates edge from pool of net {m}. The edge is not added to the net
+ * and it is released by borNetDel() or borNetDel2() (so it must not be
+ * deleted by borNetEdgeDel()).
+ */
+bor_net_edge_t *borNetEdgeAlloc(bor_net_t *m);
+
+/**
+ * Returns edge allocated by borNetEdgeAlloc() back to pool of net {m}.
+ * The edge must not be part of the net.
+ */
+void borNetEdgeFree(bor_net_t *m, bor_net_edge_t *e);
+
 /**
  * Returns start or end node of edge.
  * Parameter i can be either 0 or 1 (no check is performed).
@@ -180,6 +216,10 @@ void borNetDel(bor_net_t *m);
  * Before freeing a net, destructor iterates over all nodes. Each
  * node is first disedgeected from net and then delnode is called with
  * second argument ndata. Similarly are iterated edges.
+ * Nodes and edges allocated from pools of the net are freed afterwards,
+ * so the callbacks must not delete them. If no callbacks are given and all
+ * nodes and edges come from the pools, they are released at once without
+ * iteration.
  */
 void borNetDel2(bor_net_t *m,
                  void (*delnode)(bor_net_node_t *, void *), void *ndata,
@@ -245,6 +285,85 @@ void borNetTraverseEdge(bor_net_t *net,
                         void (*cb)(bor_net_t *net, bor_net_edge_t *e, void *data),
                         void *data);
 
+
+/**
+ * CSR Snapshot
+ * -------------
+ *
+ * Compressed sparse row representation of the net suitable for passes
+ * over the whole graph. Each node in the net gets an id (see
+ * borNetNodeId()) and the neighbors of the node with id {i} are
+ * .adj[.start[i]], ..., .adj[.start[i] + .deg[i] - 1]. The snapshot is
+ * attached to the net, so all changes of the net are recorded and the
+ * snapshot can be brought up to date by borNetCSRUpdate() which touches
+ * only the changed nodes. Until then the snapshot describes the net as it
+ * was at the time of the last update. Ids of nodes never change while the
+ * snapshot is attached, ids of removed nodes are reused for new nodes.
+ *
+ * See bor_net_csr_t.
+ */
+
+struct _bor_net_csr_t {
+    bor_net_t *net;         /*!< Net the snapshot is attached to or NULL */
+    int nodes_len;          /*!< Number of ids, some of them may be free */
+    int nodes_alloc;
+    bor_net_node_t **node;  /*!< Node of each id, NULL for free ids */
+    int *start;             /*!< Index of the first neighbor in .adj */
+    int *deg;               /*!< Number of neighbors */
+    int *cap;               /*!< Space reserved for neighbors in .adj */
+
+    int *adj;               /*!< Ids of neighbors */
+    int adj_len;            /*!< Used part of .adj */
+    int adj_alloc;
+    int adj_unused;         /*!< Number of unreachable elements of .adj */
+
+    int *dirty;             /*!< Ids of nodes changed since last update */
+    int dirty_len;
+    char *is_dirty;         /*!< 1 for changed nodes, 2 for removed nodes */
+    int *free_ids;          /*!< Ids that can be reused */
+    int free_len;
+};
+
+/**
+ * Creates CSR snapshot of the net and attaches it to the net. A snapshot
+ * previously attached to the net is detached.
+ */
+bor_net_csr_t *borNetToCSR(bor_net_t *net);
+
+/**
+ * Deletes snapshot (and detaches it from the net).
+ */
+void borNetCSRDel(bor_net_csr_t *csr);
+
+/**
+ * Updates snapshot according to changes of the net made since the last
+ * call of borNetToCSR() or borNetCSRUpdate().
+ */
+void borNetCSRUpdate(bor_net_csr_t *csr);
+
+/**
+ * Returns id of node in the attached snapshot or -1.
+ */
+_bor_inline int borNetNodeId(const bor_net_node_t *n);
+
+/**
+ * Computes breadth-first search from node {src}: dist[i] is set to number
+ * of edges on shortest path from {src} to node {i} or to -1 if the node
+ * is not reachable. {dist} must have .nodes_len elements. Levels are
+ * expanded by {num_threads} threads. Returns number of reached nodes.
+ */
+int borNetCSRBFS(const bor_net_csr_t *csr, int src, int *dist,
+                 int num_threads);
+
+/**
+ * Finds connected components: comp[i] is set to the component of the node
+ * {i} (numbered from zero in order of the smallest ids) or -1 for free
+ * ids. Returns number of components.
+ */
+int borNetCSRComponents(const bor_net_csr_t *csr, int *comp,
+                        int num_threads);
+
+
 #if 0
 /**
  * Dumps net as one object in SVT format.
@@ -327,6 +446,11 @@ _bor_inline bor_net_edge_t *borNetEdgeFromNodeList(bor_list_t *l)
 }
 
 
+_bor_inline int borNetNodeId(const bor_net_node_t *n)
+{
+    return n->_id;
+}
+
 _bor_inline size_t borNetNodesLen(const bor_net_t *n)
 {
     return n->nodes_len;
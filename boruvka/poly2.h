@@ -40,6 +40,36 @@ struct _bor_poly2_t {
 };
 typedef struct _bor_poly2_t bor_poly2_t;
 
+/**
+ * Grid index of polygon for fast point-in-polygon queries.
+ *
+ * The bounding box of the polygon is divided into uniform cells and each
+ * cell stores only edges passing through it. The edges completely on the
+ * left side of a cell are replaced by a precomputed parity and a (usually
+ * very short) list of y-coordinates of the vertices where these edges
+ * meet the edges of the cell. A query thus evaluates the same crossing
+ * test as borPoly2PointIn() but only over the edges of one cell.
+ *
+ * The index refers to the polygon, so the polygon must not be changed or
+ * deleted while the index is used.
+ */
+struct _bor_poly2_grid_t {
+    const bor_poly2_t *poly;
+    bor_real_t x0, y0;       /*!< Lower left corner of the grid */
+    bor_real_t x1, y1;       /*!< Upper right corner of the grid */
+    bor_real_t inv_w, inv_h; /*!< Inverse width and height of a cell */
+    int cols, rows;          /*!< Number of columns and rows of cells */
+
+    char *parity;            /*!< Parity of each cell */
+    int *cell;               /*!< Start of edges of i'th cell in .e* arrays
+                                  (cols * rows + 1 elements) */
+    bor_real_t *ey0, *ey1;   /*!< y-coordinates of end points of edges */
+    bor_real_t *emul, *econ; /*!< .multiple and .constant of edges */
+    int *vcell;              /*!< Start of vertices of i'th cell in .vy */
+    bor_real_t *vy;          /*!< y-coordinates of vertices */
+};
+typedef struct _bor_poly2_grid_t bor_poly2_grid_t;
+
 
 /**
  * Functions
@@ -75,6 +105,32 @@ void borPoly2Free(bor_poly2_t *);
  */
 int borPoly2PointIn(const bor_poly2_t *poly, const bor_vec2_t *v);
 
+/**
+ * Builds grid index of the polygon with approximately {cells} cells.
+ * If {cells} is zero or negative, twice the number of vertices is used.
+ */
+bor_poly2_grid_t *borPoly2GridNew(const bor_poly2_t *poly, int cells);
+
+/**
+ * Deletes grid index.
+ */
+void borPoly2GridDel(bor_poly2_grid_t *g);
+
+/**
+ * Returns true if the point v is inside the polygon. The result is the
+ * same as of borPoly2PointIn().
+ */
+int borPoly2GridPointIn(const bor_poly2_grid_t *g, const bor_vec2_t *v);
+
+/**
+ * Classifies {len} points: in[i] is set to true if pts[i] is inside the
+ * polygon. If {num_threads} is greater than one, the points are split
+ * between that many threads.
+ */
+void borPoly2GridPointsIn(const bor_poly2_grid_t *g,
+                          const bor_vec2_t *pts, int len, int *in,
+                          int num_threads);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
@@ -0,0 +1,107 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_POOL_H__
+#define __BOR_POOL_H__
+
+#include <boruvka/segmarr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Pool
+ * =====
+ *
+ * Allocator of elements of the same size. Elements are cut from segments
+ * of a segmented array (see segmarr.h), so they never move, and freed
+ * elements are kept in a free-list and reused by next allocations. All
+ * elements are released at once when the pool is deleted, which is much
+ * faster than freeing them one by one.
+ *
+ * Each element is aligned to 16 bytes.
+ *
+ * See bor_pool_t.
+ */
+
+struct _bor_pool_t {
+    bor_segmarr_t *arr; /*!< Storage of elements */
+    size_t used;        /*!< Number of elements taken from .arr */
+    void *free;         /*!< Free-list of released elements */
+    size_t len;         /*!< Number of allocated elements */
+};
+typedef struct _bor_pool_t bor_pool_t;
+
+/**
+ * Creates a new pool of elements of size {el_size} allocated in segments
+ * of {segment_size} bytes.
+ */
+bor_pool_t *borPoolNew(size_t el_size, size_t segment_size);
+
+/**
+ * Frees pool including all elements allocated from it.
+ */
+void borPoolDel(bor_pool_t *pool);
+
+/**
+ * Returns a new element. Memory is not initialized.
+ */
+_bor_inline void *borPoolAlloc(bor_pool_t *pool);
+
+/**
+ * Returns element back to the pool.
+ */
+_bor_inline void borPoolFree(bor_pool_t *pool, void *el);
+
+/**
+ * Returns number of allocated (not freed) elements.
+ */
+_bor_inline size_t borPoolLen(const bor_pool_t *pool);
+
+
+/**** INLINES ****/
+_bor_inline void *borPoolAlloc(bor_pool_t *pool)
+{
+    void *el;
+
+    if (pool->free){
+        el = pool->free;
+        pool->free = *(void **)el;
+    }else{
+        el = borSegmArrGet(pool->arr, pool->used++);
+    }
+    ++pool->len;
+    return el;
+}
+
+_bor_inline void borPoolFree(bor_pool_t *pool, void *el)
+{
+    *(void **)el = pool->free;
+    pool->free = el;
+    --pool->len;
+}
+
+_bor_inline size_t borPoolLen(const bor_pool_t *pool)
+{
+    return pool->len;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __BOR_POOL_H__ */
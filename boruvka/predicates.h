@@ -54,6 +54,15 @@ extern "C" {
  *
  * The former version of function is always the robus and exact one and the
  * latter one is approximate and nonrobust (but fast) version.
+ *
+ * Each of the robust predicates has also a batch version (e.g.,
+ * borPredOrient3dBatch()) that evaluates many tests sharing all points but
+ * the last one (e.g., many points against one triangle). The batch
+ * versions first apply a semi-static floating-point filter computed per
+ * block of points in a vectorizable loop and only the points that cannot
+ * be decided by the filter fall back to the adaptive exact predicate.
+ * The results are the same as from the robust predicates (at least the
+ * sign, which is always correct).
  */
 
 struct _bor_pred_t {
@@ -69,6 +78,19 @@ struct _bor_pred_t {
 };
 typedef struct _bor_pred_t bor_pred_t;
 
+/**
+ * Statistics gathered by batch predicates.
+ * Initialize it with zeros before first use, the batch functions only
+ * increment the counters.
+ */
+struct _bor_pred_stat_t {
+    unsigned long tests;    /*!< Number of evaluated tests */
+    unsigned long fallback; /*!< Number of tests undecided by the filter
+                                 that fell back to the adaptive exact
+                                 arithmetic */
+};
+typedef struct _bor_pred_stat_t bor_pred_stat_t;
+
 
 /**
  * Functions
@@ -176,6 +198,55 @@ bor_real_t borPredInSphere(const bor_pred_t *pred,
                            const bor_vec3_t *pd,
                            const bor_vec3_t *pe);
 
+
+/**
+ * Batch version of borPredOrient2d().
+ * Stores into res[i] result of borPredOrient2d(pred, pa, pb, &pc[i]) for
+ * each i in [0, len). If stat is non-NULL, statistics are added to it.
+ */
+void borPredOrient2dBatch(const bor_pred_t *pred,
+                          const bor_vec2_t *pa,
+                          const bor_vec2_t *pb,
+                          const bor_vec2_t *pc, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat);
+
+/**
+ * Batch version of borPredOrient3d().
+ * Stores into res[i] result of borPredOrient3d(pred, pa, pb, pc, &pd[i])
+ * for each i in [0, len). If stat is non-NULL, statistics are added to it.
+ */
+void borPredOrient3dBatch(const bor_pred_t *pred,
+                          const bor_vec3_t *pa,
+                          const bor_vec3_t *pb,
+                          const bor_vec3_t *pc,
+                          const bor_vec3_t *pd, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat);
+
+/**
+ * Batch version of borPredInCircle().
+ * Stores into res[i] result of borPredInCircle(pred, pa, pb, pc, &pd[i])
+ * for each i in [0, len). If stat is non-NULL, statistics are added to it.
+ */
+void borPredInCircleBatch(const bor_pred_t *pred,
+                          const bor_vec2_t *pa,
+                          const bor_vec2_t *pb,
+                          const bor_vec2_t *pc,
+                          const bor_vec2_t *pd, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat);
+
+/**
+ * Batch version of borPredInSphere().
+ * Stores into res[i] result of borPredInSphere(pred, pa, pb, pc, pd, &pe[i])
+ * for each i in [0, len). If stat is non-NULL, statistics are added to it.
+ */
+void borPredInSphereBatch(const bor_pred_t *pred,
+                          const bor_vec3_t *pa,
+                          const bor_vec3_t *pb,
+                          const bor_vec3_t *pc,
+                          const bor_vec3_t *pd,
+                          const bor_vec3_t *pe, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
@@ -97,6 +97,29 @@ void borQDelaunaySetPath(bor_qdelaunay_t *q, const char *path);
  */
 bor_qhull_mesh3_t *borQDelaunayMesh3(bor_qdelaunay_t *q, const bor_pc_t *pc);
 
+
+/**
+ * Delaunay - Native Delaunay triangulation
+ * -----------------------------------------
+ */
+
+/**
+ * Performs 3D delaunay triangulation on given point cloud without any
+ * external tool. The returned Mesh3 has same form as the one from
+ * borQDelaunayMesh3(), i.e., it contains all points as vertices (in the
+ * same order) and edges of Delaunay tetrahedra.
+ *
+ * Bowyer-Watson algorithm with points inserted in biased randomized order
+ * sorted along Morton curve in each round and with walking point
+ * location is used. All decisions are made by exact predicates (see
+ * predicates.h), duplicate points are left as isolated vertices.
+ * The insertion order is seeded by a fixed value, so the same input
+ * always gives the same triangulation, also for co-spherical points.
+ *
+ * NULL is returned if all points are coplanar.
+ */
+bor_qhull_mesh3_t *borDelaunayMesh3(const bor_pc_t *pc);
+
 /**** INLINES ****/
 _bor_inline bor_mesh3_t *borQHullMesh3(bor_qhull_mesh3_t *m)
 {
@@ -0,0 +1,128 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_REACH_H__
+#define __BOR_REACH_H__
+
+#include <stdint.h>
+#include <boruvka/digraph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Reachability Index
+ * ===================
+ *
+ * Answers queries "is there a path from u to v" on a digraph without
+ * traversing the graph. Strongly connected components are condensed
+ * first (all nodes of a component reach each other) and then the
+ * transitive closure of the condensation is computed.
+ *
+ * By default, the closure is stored as a bitset per component.
+ * Components are processed in topological order from sinks and the row
+ * of each component is the bitwise OR of rows of its successors (64
+ * components per word, the loop is vectorized by the compiler).
+ * Components with the same distance from sinks are independent, so they
+ * are divided between threads. Components are numbered so that each
+ * component reaches only components with lower numbers, therefore only
+ * the lower triangle of the matrix is stored, i.e., the index takes
+ * about c^2/16 bytes for c components. Queries are a single bit lookup.
+ *
+ * With BOR_REACH_INTERVAL, the closure is compressed using interval
+ * labeling: components are numbered in post-order of DFS over the
+ * condensation and each component stores the reachable numbers as a
+ * sorted list of disjoint intervals. Subtrees of the DFS forest form
+ * contiguous intervals, so the lists are usually short and the index
+ * takes much less memory for large sparse graphs. Queries use binary
+ * search over the intervals of one component.
+ *
+ * Each node reaches itself.
+ */
+
+/**
+ * Use compressed interval labeling instead of bitsets.
+ */
+#define BOR_REACH_INTERVAL 0x1u
+
+struct _bor_reach_t {
+    int node_size;
+    int *comp;          /*!< ID of component of each node */
+    int comp_size;      /*!< Number of components */
+
+    uint64_t *bits;     /*!< Rows of the closure (bitset mode) */
+    long *row;          /*!< Offset of the row of each component */
+
+    int *post;          /*!< Post-order number of each component */
+    int *ival_start;    /*!< Intervals of the component with post-order
+                             number p are stored in
+                             ival[2 * ival_start[p]], ...,
+                             ival[2 * ival_start[p + 1] - 1] */
+    int *ival;          /*!< Pairs of lower and upper bounds */
+};
+typedef struct _bor_reach_t bor_reach_t;
+
+/**
+ * Builds the index of the graph using {num_threads} threads.
+ * {flags} is either 0 or BOR_REACH_INTERVAL.
+ */
+void borReachInit(bor_reach_t *r, const bor_digraph_t *g,
+                  unsigned flags, int num_threads);
+
+/**
+ * Same as borReachInit() but for the frozen graph.
+ */
+void borReachInitFrozen(bor_reach_t *r, const bor_digraph_frozen_t *g,
+                        unsigned flags, int num_threads);
+
+/**
+ * Frees allocated memory.
+ */
+void borReachFree(bor_reach_t *r);
+
+/**
+ * Returns true if there is a path between the components (interval mode).
+ */
+int borReachCompInterval(const bor_reach_t *r, int from_comp, int to_comp);
+
+/**
+ * Returns true if there is a path from node {from} to node {to}.
+ */
+_bor_inline int borReach(const bor_reach_t *r, int from, int to);
+
+
+/**** INLINES ****/
+_bor_inline int borReach(const bor_reach_t *r, int from, int to)
+{
+    int cf = r->comp[from];
+    int ct = r->comp[to];
+
+    if (cf == ct)
+        return 1;
+    if (r->bits != NULL){
+        if (ct > cf)
+            return 0;
+        return (r->bits[r->row[cf] + (ct >> 6)] >> (ct & 63)) & 1u;
+    }
+    return borReachCompInterval(r, cf, ct);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_REACH_H__ */
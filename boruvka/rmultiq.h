@@ -0,0 +1,134 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_RMULTIQ_H__
+#define __BOR_RMULTIQ_H__
+
+#include <pthread.h>
+#include <boruvka/core.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * MultiQueue - Concurrent Relaxed Priority Queue
+ * ===============================================
+ *
+ * The queue consists of c * P binary heaps (P is number of threads), each
+ * protected by its own lock. Push inserts into a randomly chosen heap,
+ * pop looks at minimums of two randomly chosen heaps and removes from the
+ * better one. If a lock is held by other thread, another heap is chosen
+ * instead of waiting. Pop therefore does not return the global minimum,
+ * but an element whose rank is expected to be O(c * P).
+ *
+ * Each thread also has a small insertion buffer, elements are moved from
+ * the buffer to a heap in one batch when the buffer is full. Pop compares
+ * minimum of the buffer with the heaps, so elements pushed by a thread
+ * are always visible to the same thread, but other threads see them only
+ * after the buffer is flushed (see borRMultiQFlush()).
+ *
+ * All functions taking {tid} may be called concurrently as long as each
+ * thread uses its own {tid} from [0, num_threads).
+ */
+
+/**
+ * Number of elements in insertion buffer of each thread.
+ */
+#define BOR_RMULTIQ_BUF_SIZE 8
+
+/**
+ * Number of random attempts pop makes before checking all heaps.
+ */
+#define BOR_RMULTIQ_POP_TRIES 8
+
+struct bor_rmultiq_el {
+    bor_real_t key;
+    void *data;
+};
+typedef struct bor_rmultiq_el bor_rmultiq_el_t;
+
+/**
+ * Binary heap with a lock. Size and key of the minimum are readable
+ * without the lock.
+ */
+struct bor_rmultiq_heap {
+    pthread_mutex_t lock;
+    bor_rmultiq_el_t *el;
+    int alloc;
+    volatile int size;
+    volatile bor_real_t min;
+} bor_aligned(64);
+typedef struct bor_rmultiq_heap bor_rmultiq_heap_t;
+
+/**
+ * Thread local data.
+ */
+struct bor_rmultiq_thread {
+    bor_rmultiq_el_t buf[BOR_RMULTIQ_BUF_SIZE]; /*!< Insertion buffer */
+    int buf_len;
+    uint32_t rnd;                             /*!< State of xorshift */
+} bor_aligned(64);
+typedef struct bor_rmultiq_thread bor_rmultiq_thread_t;
+
+struct bor_rmultiq {
+    bor_rmultiq_heap_t *heap;
+    int heap_len;
+    bor_rmultiq_thread_t *thread;
+    int num_threads;
+};
+typedef struct bor_rmultiq bor_rmultiq_t;
+
+/**
+ * Creates a new queue for {num_threads} threads with {c} heaps per
+ * thread (c = 2 is a reasonable default).
+ */
+bor_rmultiq_t *borRMultiQNew(int num_threads, int c);
+
+/**
+ * Deletes the queue. Stored elements are not touched.
+ */
+void borRMultiQDel(bor_rmultiq_t *q);
+
+/**
+ * Inserts {data} with {key} into the insertion buffer of thread {tid}.
+ */
+void borRMultiQPush(bor_rmultiq_t *q, int tid, bor_real_t key, void *data);
+
+/**
+ * Removes an element with small key (not necessarily the minimal one).
+ * Returns 0 on success and the key and data are stored in {key} and
+ * {data} (if non-NULL). Returns -1 if all heaps and the insertion buffer
+ * of thread {tid} are empty.
+ */
+int borRMultiQPop(bor_rmultiq_t *q, int tid, bor_real_t *key, void **data);
+
+/**
+ * Moves elements from the insertion buffer of thread {tid} to a heap.
+ */
+void borRMultiQFlush(bor_rmultiq_t *q, int tid);
+
+/**
+ * Returns number of elements in heaps, i.e., without insertion buffers.
+ * The value is exact only if no other thread modifies the queue.
+ */
+int borRMultiQSize(const bor_rmultiq_t *q);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_RMULTIQ_H__ */
@@ -0,0 +1,138 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_SCC_INC_H__
+#define __BOR_SCC_INC_H__
+
+#include <boruvka/iarr.h>
+#include <boruvka/digraph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Incremental Strongly Connected Components
+ * ==========================================
+ *
+ * Maintains strongly connected components of a graph to which edges are
+ * only added. Each component is represented by one of its nodes
+ * (union-find) and components are kept in a topological order of the
+ * condensation (edges go from lower to higher positions).
+ *
+ * An edge x -> y that goes against the order is handled as in the
+ * algorithm of Pearce and Kelly: the forward search from y and the
+ * backward search from x are limited to the components between y and x
+ * in the order. Components found by both searches lie on a cycle with
+ * the new edge and they are merged into one component. The rest of the
+ * affected components is reordered using only their own positions. Edges
+ * that agree with the order cost O(1).
+ *
+ * borSCCIncAddEdges() first inserts all edges agreeing with the order.
+ * The remaining edges are inserted one by one unless their number times
+ * the average cost of such an insertion exceeds the size of the graph,
+ * in which case the components are recomputed by Tarjan's algorithm over
+ * the condensation.
+ */
+
+struct _bor_scc_inc_t {
+    int node_size;      /*!< Number of nodes */
+    int node_alloc;
+    int comp_size;      /*!< Number of components */
+    long edge_size;     /*!< Number of inserted edges */
+    int *parent;        /*!< Union-find forest of components */
+    int *size;          /*!< Number of nodes of the component (roots) */
+    int *member;        /*!< Circular list of nodes of each component */
+    int *ord;           /*!< Position of the component (roots) */
+    int *pos;           /*!< Component at each position or -1 */
+    int pos_size;       /*!< Number of used positions */
+    int pos_alloc;
+    bor_iarr_t *out;    /*!< Targets of edges leaving the component */
+    bor_iarr_t *in;     /*!< Sources of edges entering the component */
+
+    int *mark_fw;       /*!< Visited by the forward search if == stamp */
+    int *mark_bw;       /*!< Visited by the backward search if == stamp */
+    int stamp;
+    double insert_cost; /*!< Running average of the work done by one
+                             insertion of an edge against the order */
+    bor_iarr_t fw;      /*!< Components found by the forward search */
+    bor_iarr_t bw;      /*!< Components found by the backward search */
+    bor_iarr_t stack;
+    bor_iarr_t slot;    /*!< Positions of affected components */
+    bor_iarr_t back;    /*!< Postponed edges of a batch */
+};
+typedef struct _bor_scc_inc_t bor_scc_inc_t;
+
+/**
+ * Initializes the structure with {node_size} nodes and no edges.
+ */
+void borSCCIncInit(bor_scc_inc_t *inc, int node_size);
+
+/**
+ * Initializes the structure with nodes and edges of the graph.
+ */
+void borSCCIncInitDigraph(bor_scc_inc_t *inc, const bor_digraph_t *g);
+
+/**
+ * Frees allocated memory.
+ */
+void borSCCIncFree(bor_scc_inc_t *inc);
+
+/**
+ * Adds a new node forming its own component and returns its ID.
+ */
+int borSCCIncAddNode(bor_scc_inc_t *inc);
+
+/**
+ * Adds an edge and returns the number of components that disappeared
+ * because they were merged.
+ */
+int borSCCIncAddEdge(bor_scc_inc_t *inc, int from, int to);
+
+/**
+ * Adds edges from[i] -> to[i] for i = 0, ..., len - 1 and returns the
+ * number of components that disappeared because they were merged.
+ */
+int borSCCIncAddEdges(bor_scc_inc_t *inc, const int *from, const int *to,
+                      int len);
+
+/**
+ * Returns the representative node of the component containing {node}.
+ */
+int borSCCIncComp(bor_scc_inc_t *inc, int node);
+
+/**
+ * Returns the number of nodes of the component containing {node}.
+ */
+int borSCCIncCompSize(bor_scc_inc_t *inc, int node);
+
+/**
+ * Stores sorted IDs of nodes of the component containing {node} in
+ * {nodes} and returns their number (see borSCCIncCompSize()).
+ */
+int borSCCIncCompNodes(bor_scc_inc_t *inc, int node, int *nodes);
+
+/**
+ * Stores representatives of all components in topological order in
+ * {comp} (an array of .comp_size elements).
+ */
+void borSCCIncTopo(const bor_scc_inc_t *inc, int *comp);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_SCC_INC_H__ */
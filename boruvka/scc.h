@@ -26,8 +26,39 @@ extern "C" {
  * =============================
  *
  * See bor_scc_t.
+ *
+ * Components are found by Tarjan's algorithm implemented without
+ * recursion, so the depth of the graph is not limited by the size of the
+ * stack.
+ *
+ * With the flag BOR_SCC_PARALLEL, the graph is first read through the
+ * callbacks into an internal adjacency array and then:
+ *   1. nodes without incoming or outgoing edges are repeatedly trimmed
+ *      (each forms its own component),
+ *   2. the component containing the node with the highest product of
+ *      in- and out-degree is found as intersection of nodes reachable
+ *      from it forward and backward (forward-backward algorithm),
+ *   3. the remaining nodes are processed by Tarjan's algorithm.
+ * Steps 1 and 2 and reading of the graph are divided between threads, so
+ * the callbacks must be safe to be called concurrently.
+ *
+ * In both cases, components are stored in reverse topological order
+ * (i.e., a component is stored before all components having edge to it)
+ * and node IDs in each component are sorted. The output depends only on
+ * the graph, not on the number of threads or on the scheduling, but the
+ * parallel and the sequential algorithm may order components that are
+ * not connected by any path differently.
+ */
+
+/**
+ * Flags for borSCCInitFlags():
  */
 
+/**
+ * Use parallel trimming and forward-backward algorithm.
+ */
+#define BOR_SCC_PARALLEL 0x1u
+
 /**
  * Returns iterator over neighbors of the specified node.
  */
@@ -56,9 +87,13 @@ struct _bor_scc_t {
                                         nodes via iterator. */
     bor_scc_neighbor_next_fn next; /*!< Next callback for iterator */
     void *userdata;                /*!< Userdata argument for callbacks */
+    unsigned flags;                /*!< BOR_SCC_* flags */
+    int num_threads;               /*!< Number of threads for
+                                        BOR_SCC_PARALLEL */
 
     bor_scc_comp_t *comp; /*!< List of components */
     int comp_size;        /*!< Number of components */
+    int comp_alloc;       /*!< Allocated size of .comp */
 };
 typedef struct _bor_scc_t bor_scc_t;
 
@@ -71,6 +106,16 @@ void borSCCInit(bor_scc_t *scc, int node_size,
                 bor_scc_neighbor_next_fn next_fn,
                 void *userdata);
 
+/**
+ * Same as borSCCInit() but also sets the flags (see BOR_SCC_*) and the
+ * number of threads used if the flags contain BOR_SCC_PARALLEL.
+ */
+void borSCCInitFlags(bor_scc_t *scc, int node_size,
+                     bor_scc_neighbor_it_fn it_fn,
+                     bor_scc_neighbor_next_fn next_fn,
+                     void *userdata,
+                     unsigned flags, int num_threads);
+
 /**
  * Frees allocated resources.
  */
@@ -84,6 +129,7 @@ void borSCC(bor_scc_t *scc);
 /**
  * Finds only one strongly connected component that contains the specified
  * node.
+ * This function always uses the sequential algorithm.
  */
 void borSCC1(bor_scc_t *scc, int node);
 
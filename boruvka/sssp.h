@@ -0,0 +1,101 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR_SSSP_H__
+#define __BOR_SSSP_H__
+
+#include <boruvka/digraph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Single-Source Shortest Paths
+ * =============================
+ *
+ * Shortest distances from one node to all other nodes of a digraph with
+ * non-negative integer edge weights. The digraph is first converted to
+ * an immutable CSR (compressed sparse row) graph that is not connected
+ * with the original bor_digraph_t anymore, i.e., it can be queried
+ * repeatedly and from several threads while the digraph is modified or
+ * freed.
+ *
+ * borSSSPDeltaStep() implements delta-stepping of Meyer and Sanders.
+ * Nodes are kept in buckets of width {delta} according to their tentative
+ * distance. Buckets are settled in increasing order, light edges (weight
+ * <= delta) of nodes in the current bucket are relaxed repeatedly until
+ * the bucket stays empty and then the heavy edges of all removed nodes
+ * are relaxed once. Relaxations of one round are divided between threads
+ * and distances are lowered using atomic compare-and-swap, so the
+ * resulting distances are exactly the same as from Dijkstra's algorithm
+ * (borSSSPDijkstra()) regardless of the number of threads.
+ */
+
+struct _bor_sssp_edge_t {
+    int to;     /*!< Target node */
+    int weight; /*!< Weight of the edge */
+};
+typedef struct _bor_sssp_edge_t bor_sssp_edge_t;
+
+/**
+ * Immutable weighted CSR graph.
+ */
+struct _bor_sssp_graph_t {
+    int node_size;          /*!< Number of nodes */
+    int edge_size;          /*!< Number of edges */
+    int *start;             /*!< Out-edges of node i are
+                                 edge[start[i]], ..., edge[start[i+1]-1] */
+    bor_sssp_edge_t *edge;  /*!< Out-edges sorted by weight for each node */
+    int max_weight;         /*!< Maximal weight of an edge */
+};
+typedef struct _bor_sssp_graph_t bor_sssp_graph_t;
+
+/**
+ * Creates CSR graph from the digraph. {weight} is indexed by edge IDs of
+ * {dg}, if NULL all edges have weight 1.
+ * Negative weight ends up in program termination.
+ */
+void borSSSPGraphInit(bor_sssp_graph_t *g, const bor_digraph_t *dg,
+                      const int *weight);
+
+/**
+ * Frees allocated resources.
+ */
+void borSSSPGraphFree(bor_sssp_graph_t *g);
+
+/**
+ * Computes distances from {src} to all nodes using Dijkstra's algorithm
+ * with radix heap. {dist} must have g->node_size elements, unreachable
+ * nodes get -1. Returns number of reached nodes.
+ */
+int borSSSPDijkstra(const bor_sssp_graph_t *g, int src, long *dist);
+
+/**
+ * Computes distances from {src} to all nodes using delta-stepping with
+ * {num_threads} threads. If {delta} is not positive,
+ * max_weight / average out-degree is used.
+ * {dist} must have g->node_size elements, unreachable nodes get -1.
+ * Returns number of reached nodes.
+ */
+int borSSSPDeltaStep(const bor_sssp_graph_t *g, int src, int delta,
+                     int num_threads, long *dist);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR_SSSP_H__ */
@@ -0,0 +1,129 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#ifndef __BOR__BUCKETBMAP_H__
+#define __BOR__BUCKETBMAP_H__
+
+#include <string.h>
+#include "boruvka/core.h"
+#include "boruvka/alloc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Two-level occupancy bitmap over buckets of bucket-based queues.
+ * The first level has one bit per bucket, the second level one bit per
+ * non-zero word of the first level, so the next non-empty bucket is found
+ * using a few ctz instructions even if keys are very sparse.
+ * Number of buckets must be a multiple of 64.
+ */
+
+/**
+ * Number of words of the first and the second level for the given number
+ * of buckets.
+ */
+#define BOR_BUCKET_BMAP_WORDS(size) ((size) >> 6)
+#define BOR_BUCKET_BMAP_TOP_WORDS(size) ((((size) >> 6) + 63) >> 6)
+
+/**
+ * Resizes bitmap from {old_size} to {size} buckets, new buckets are
+ * marked as empty.
+ */
+_bor_inline void borBucketBmapResize(uint64_t **bmap, uint64_t **top,
+                                     int old_size, int size);
+
+/**
+ * Marks bucket {i} as non-empty.
+ */
+_bor_inline void borBucketBmapSet(uint64_t *bmap, uint64_t *top, int i);
+
+/**
+ * Marks bucket {i} as empty.
+ */
+_bor_inline void borBucketBmapUnset(uint64_t *bmap, uint64_t *top, int i);
+
+/**
+ * Returns the first non-empty bucket greater or equal to {i} or -1 if
+ * there is none. {size} is the number of buckets.
+ */
+_bor_inline int borBucketBmapNext(const uint64_t *bmap, const uint64_t *top,
+                                  int size, int i);
+
+
+/**** INLINES ****/
+_bor_inline void borBucketBmapResize(uint64_t **bmap, uint64_t **top,
+                                     int old_size, int size)
+{
+    int old_len, len;
+
+    old_len = BOR_BUCKET_BMAP_WORDS(old_size);
+    len = BOR_BUCKET_BMAP_WORDS(size);
+    *bmap = BOR_REALLOC_ARR(*bmap, uint64_t, len);
+    memset(*bmap + old_len, 0, sizeof(uint64_t) * (len - old_len));
+
+    old_len = BOR_BUCKET_BMAP_TOP_WORDS(old_size);
+    len = BOR_BUCKET_BMAP_TOP_WORDS(size);
+    *top = BOR_REALLOC_ARR(*top, uint64_t, len);
+    memset(*top + old_len, 0, sizeof(uint64_t) * (len - old_len));
+}
+
+_bor_inline void borBucketBmapSet(uint64_t *bmap, uint64_t *top, int i)
+{
+    bmap[i >> 6] |= 1ull << (i & 63);
+    top[i >> 12] |= 1ull << ((i >> 6) & 63);
+}
+
+_bor_inline void borBucketBmapUnset(uint64_t *bmap, uint64_t *top, int i)
+{
+    bmap[i >> 6] &= ~(1ull << (i & 63));
+    if (bmap[i >> 6] == 0)
+        top[i >> 12] &= ~(1ull << ((i >> 6) & 63));
+}
+
+_bor_inline int borBucketBmapNext(const uint64_t *bmap, const uint64_t *top,
+                                  int size, int i)
+{
+    uint64_t m;
+    int w, t, top_len;
+
+    w = i >> 6;
+    m = bmap[w] & (~0ull << (i & 63));
+    if (m != 0)
+        return (w << 6) + __builtin_ctzll(m);
+
+    ++w;
+    t = w >> 6;
+    top_len = BOR_BUCKET_BMAP_TOP_WORDS(size);
+    if (t >= top_len)
+        return -1;
+    m = top[t] & (~0ull << (w & 63));
+    while (m == 0){
+        if (++t >= top_len)
+            return -1;
+        m = top[t];
+    }
+
+    w = (t << 6) + __builtin_ctzll(m);
+    return (w << 6) + __builtin_ctzll(bmap[w]);
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR__BUCKETBMAP_H__ */
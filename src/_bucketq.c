@@ -15,13 +15,21 @@
  */
 
 #include <stdio.h>
+#include <limits.h>
 #include "boruvka/alloc.h"
 #include "boruvka/_bucketq.h"
+#include "_bucketbmap.h"
+
+/** Enlarges array of buckets so that it contains bucket {key} */
+static void grow(bor_bucketq_t *q, int key);
 
 void borBucketQInit(bor_bucketq_t *q)
 {
     q->bucket_size = BOR_BUCKETQ_SIZE;
     q->bucket = BOR_CALLOC_ARR(bor_bucketq_bucket_t, q->bucket_size);
+    q->bmap = NULL;
+    q->bmap_top = NULL;
+    borBucketBmapResize(&q->bmap, &q->bmap_top, 0, q->bucket_size);
     q->lowest_key = q->bucket_size;
     q->size = 0;
 }
@@ -36,19 +44,24 @@ void borBucketQFree(bor_bucketq_t *q)
     }
     if (q->bucket != NULL)
         BOR_FREE(q->bucket);
+    if (q->bmap != NULL)
+        BOR_FREE(q->bmap);
+    if (q->bmap_top != NULL)
+        BOR_FREE(q->bmap_top);
 }
 
 void borBucketQPush(bor_bucketq_t *q, int key, TYPE value)
 {
     bor_bucketq_bucket_t *bucket;
 
-    if (key >= q->bucket_size){
-        fprintf(stderr, "Error: borBucketQ: key %d is over a size of"
-                        " the bucket queue, which is %d.\n",
-                        key, BOR_BUCKETQ_SIZE);
+    if (key < 0){
+        fprintf(stderr, "Error: borBucketQ: negative key %d.\n", key);
         exit(-1);
     }
 
+    if (key >= q->bucket_size)
+        grow(q, key);
+
     bucket = q->bucket + key;
     if (bucket->value == NULL){
         bucket->alloc = BOR_BUCKETQ_BUCKET_INIT_SIZE;
@@ -59,6 +72,8 @@ void borBucketQPush(bor_bucketq_t *q, int key, TYPE value)
         bucket->value = BOR_REALLOC_ARR(bucket->value,
                                         TYPE, bucket->alloc);
     }
+    if (bucket->size == 0)
+        borBucketBmapSet(q->bmap, q->bmap_top, key);
     bucket->value[bucket->size++] = value;
     ++q->size;
 
@@ -77,13 +92,38 @@ TYPE borBucketQPop(bor_bucketq_t *q, int *key)
     }
 
     bucket = q->bucket + q->lowest_key;
-    while (bucket->size == 0){
-        ++q->lowest_key;
-        bucket += 1;
+    if (bucket->size == 0){
+        q->lowest_key = borBucketBmapNext(q->bmap, q->bmap_top,
+                                          q->bucket_size, q->lowest_key);
+        bucket = q->bucket + q->lowest_key;
     }
 
     val = bucket->value[--bucket->size];
+    if (bucket->size == 0)
+        borBucketBmapUnset(q->bmap, q->bmap_top, q->lowest_key);
     *key = q->lowest_key;
     --q->size;
     return val;
 }
+
+static void grow(bor_bucketq_t *q, int key)
+{
+    int size;
+
+    if (key > INT_MAX - 64){
+        fprintf(stderr, "Error: borBucketQ: key %d is too large.\n", key);
+        exit(-1);
+    }
+
+    size = q->bucket_size;
+    while (size <= key && size < (1 << 30))
+        size *= 2;
+    if (size <= key)
+        size = ((key >> 6) + 1) << 6;
+
+    q->bucket = BOR_REALLOC_ARR(q->bucket, bor_bucketq_bucket_t, size);
+    bzero(q->bucket + q->bucket_size,
+          sizeof(bor_bucketq_bucket_t) * (size - q->bucket_size));
+    borBucketBmapResize(&q->bmap, &q->bmap_top, q->bucket_size, size);
+    q->bucket_size = size;
+}
@@ -0,0 +1,53 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+
+#ifndef __BOR__NET_H__
+#define __BOR__NET_H__
+
+#include "boruvka/net.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * Assigns id to the node added to the net.
+ */
+void borNetCSRNodeAdded(bor_net_csr_t *csr, bor_net_node_t *n);
+
+/**
+ * Releases id of the node removed from the net.
+ */
+void borNetCSRNodeRemoved(bor_net_csr_t *csr, bor_net_node_t *n);
+
+/**
+ * Records change of neighbors of the node.
+ */
+_bor_inline void borNetCSRNodeChanged(bor_net_csr_t *csr,
+                                      bor_net_node_t *n)
+{
+    if (n->_id >= 0 && !csr->is_dirty[n->_id]){
+        csr->is_dirty[n->_id] = 1;
+        csr->dirty[csr->dirty_len++] = n->_id;
+    }
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif /* __cplusplus */
+
+#endif /* __BOR__NET_H__ */
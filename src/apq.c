@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <boruvka/alloc.h>
 #include <boruvka/apq.h>
+#include "_bucketbmap.h"
 
 static void borAPQBucketQueueInit(bor_apq_bucket_queue_t *q);
 static void borAPQBucketQueueFree(bor_apq_bucket_queue_t *q);
@@ -94,6 +95,9 @@ static void borAPQBucketQueueInit(bor_apq_bucket_queue_t *q)
 {
     q->bucket_size = BOR_APQ_BUCKET_SIZE;
     q->bucket = BOR_CALLOC_ARR(bor_apq_bucket_t, q->bucket_size);
+    q->bmap = NULL;
+    q->bmap_top = NULL;
+    borBucketBmapResize(&q->bmap, &q->bmap_top, 0, q->bucket_size);
     q->lowest_key = q->bucket_size;
     q->size = 0;
 }
@@ -107,6 +111,8 @@ static void borAPQBucketQueueFree(bor_apq_bucket_queue_t *q)
             BOR_FREE(q->bucket[i].el);
     }
     BOR_FREE(q->bucket);
+    BOR_FREE(q->bmap);
+    BOR_FREE(q->bmap_top);
 }
 
 static void borAPQBucketQueuePush(bor_apq_bucket_queue_t *q,
@@ -132,6 +138,8 @@ static void borAPQBucketQueuePush(bor_apq_bucket_queue_t *q,
                                      bucket->alloc);
 
     }
+    if (bucket->size == 0)
+        borBucketBmapSet(q->bmap, q->bmap_top, key);
     el->key = key;
     el->conn.bucket = bucket->size;
     bucket->el[bucket->size++] = el;
@@ -150,12 +158,15 @@ static bor_apq_el_t *borAPQBucketQueuePop(bor_apq_bucket_queue_t *q, int *key)
         return NULL;
 
     bucket = q->bucket + q->lowest_key;
-    while (bucket->size == 0){
-        ++q->lowest_key;
-        bucket += 1;
+    if (bucket->size == 0){
+        q->lowest_key = borBucketBmapNext(q->bmap, q->bmap_top,
+                                          q->bucket_size, q->lowest_key);
+        bucket = q->bucket + q->lowest_key;
     }
 
     el = bucket->el[--bucket->size];
+    if (bucket->size == 0)
+        borBucketBmapUnset(q->bmap, q->bmap_top, q->lowest_key);
     if (key)
         *key = q->lowest_key;
     --q->size;
@@ -170,6 +181,8 @@ static void borAPQBucketQueueUpdate(bor_apq_bucket_queue_t *q,
     bucket = q->bucket + el->key;
     bucket->el[el->conn.bucket] = bucket->el[--bucket->size];
     bucket->el[el->conn.bucket]->conn.bucket = el->conn.bucket;
+    if (bucket->size == 0)
+        borBucketBmapUnset(q->bmap, q->bmap_top, el->key);
     --q->size;
     if (q->size == 0)
         q->lowest_key = q->bucket_size;
@@ -192,6 +205,9 @@ static void borAPQBucketQueueToHeapQueue(bor_apq_bucket_queue_t *b,
         bucket->el = NULL;
         bucket->size = bucket->alloc = 0;
     }
+    bzero(b->bmap, sizeof(uint64_t) * BOR_BUCKET_BMAP_WORDS(b->bucket_size));
+    bzero(b->bmap_top,
+          sizeof(uint64_t) * BOR_BUCKET_BMAP_TOP_WORDS(b->bucket_size));
     b->size = 0;
 }
 
@@ -0,0 +1,363 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <boruvka/alloc.h>
+#include <boruvka/bset.h>
+
+/** d[i] = a[i] | b[i] for i < len, d may be the same as a */
+static void wordsOr(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                    int len);
+/** d[i] = a[i] & b[i] */
+static void wordsAnd(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                     int len);
+/** d[i] = a[i] & ~b[i] */
+static void wordsAndNot(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                        int len);
+/** Returns true if a[i] & ~b[i] == 0 for all i < len */
+static int wordsSubset(const uint64_t *a, const uint64_t *b, int len);
+/** Returns true if a[i] & b[i] == 0 for all i < len */
+static int wordsDisjoint(const uint64_t *a, const uint64_t *b, int len);
+/** Returns true if a[i] == 0 for all i < len */
+static int wordsZero(const uint64_t *a, int len);
+/** Returns number of bits set in a[0], ..., a[len - 1] */
+static int wordsPopcount(const uint64_t *a, int len);
+
+void borBSetInit(bor_bset_t *s)
+{
+    bzero(s, sizeof(*s));
+}
+
+void borBSetFree(bor_bset_t *s)
+{
+    if (s->w)
+        BOR_FREE(s->w);
+}
+
+void borBSetResize(bor_bset_t *s, int words)
+{
+    if (words <= s->size)
+        return;
+
+    if (words > s->alloc){
+        s->alloc = BOR_MAX(words, 2 * s->alloc);
+        s->w = BOR_REALLOC_ARR(s->w, uint64_t, s->alloc);
+    }
+    memset(s->w + s->size, 0, sizeof(uint64_t) * (words - s->size));
+    s->size = words;
+}
+
+int borBSetSize(const bor_bset_t *s)
+{
+    return wordsPopcount(s->w, s->size);
+}
+
+int borBSetIsEmpty(const bor_bset_t *s)
+{
+    return wordsZero(s->w, s->size);
+}
+
+int borBSetUsedWords(const bor_bset_t *s)
+{
+    int len = s->size;
+
+    while (len > 0 && s->w[len - 1] == 0)
+        --len;
+    return len;
+}
+
+void borBSetSet(bor_bset_t *d, const bor_bset_t *s)
+{
+    if (d == s)
+        return;
+
+    borBSetResize(d, s->size);
+    if (s->size > 0)
+        memcpy(d->w, s->w, sizeof(uint64_t) * s->size);
+    if (d->size > s->size)
+        memset(d->w + s->size, 0, sizeof(uint64_t) * (d->size - s->size));
+}
+
+void borBSetUnion(bor_bset_t *dst, const bor_bset_t *src)
+{
+    borBSetResize(dst, src->size);
+    wordsOr(dst->w, dst->w, src->w, src->size);
+}
+
+void borBSetUnion2(bor_bset_t *dst, const bor_bset_t *s1,
+                   const bor_bset_t *s2)
+{
+    if (dst == s2){
+        borBSetUnion(dst, s1);
+    }else{
+        borBSetSet(dst, s1);
+        borBSetUnion(dst, s2);
+    }
+}
+
+void borBSetIntersect(bor_bset_t *dst, const bor_bset_t *src)
+{
+    int len = BOR_MIN(dst->size, src->size);
+
+    wordsAnd(dst->w, dst->w, src->w, len);
+    if (dst->size > len)
+        memset(dst->w + len, 0, sizeof(uint64_t) * (dst->size - len));
+}
+
+void borBSetIntersect2(bor_bset_t *dst, const bor_bset_t *s1,
+                       const bor_bset_t *s2)
+{
+    if (dst == s2){
+        borBSetIntersect(dst, s1);
+    }else{
+        borBSetSet(dst, s1);
+        borBSetIntersect(dst, s2);
+    }
+}
+
+void borBSetMinus(bor_bset_t *s1, const bor_bset_t *s2)
+{
+    wordsAndNot(s1->w, s1->w, s2->w, BOR_MIN(s1->size, s2->size));
+}
+
+void borBSetMinus2(bor_bset_t *d, const bor_bset_t *s1,
+                   const bor_bset_t *s2)
+{
+    bor_bset_t tmp;
+
+    if (d == s2){
+        borBSetInit(&tmp);
+        borBSetMinus2(&tmp, s1, s2);
+        borBSetFree(d);
+        *d = tmp;
+    }else{
+        borBSetSet(d, s1);
+        borBSetMinus(d, s2);
+    }
+}
+
+int borBSetIsSubset(const bor_bset_t *s1, const bor_bset_t *s2)
+{
+    int len = BOR_MIN(s1->size, s2->size);
+
+    return wordsSubset(s1->w, s2->w, len)
+            && wordsZero(s1->w + len, s1->size - len);
+}
+
+int borBSetIsDisjoint(const bor_bset_t *s1, const bor_bset_t *s2)
+{
+    return wordsDisjoint(s1->w, s2->w, BOR_MIN(s1->size, s2->size));
+}
+
+int borBSetIntersectionSize(const bor_bset_t *s1, const bor_bset_t *s2)
+{
+    int len = BOR_MIN(s1->size, s2->size);
+    int i, size;
+
+    size = 0;
+    for (i = 0; i < len; ++i)
+        size += __builtin_popcountll(s1->w[i] & s2->w[i]);
+    return size;
+}
+
+int borBSetEq(const bor_bset_t *s1, const bor_bset_t *s2)
+{
+    int len = BOR_MIN(s1->size, s2->size);
+
+    if (len > 0 && memcmp(s1->w, s2->w, sizeof(uint64_t) * len) != 0)
+        return 0;
+    return wordsZero(s1->w + len, s1->size - len)
+            && wordsZero(s2->w + len, s2->size - len);
+}
+
+void borBSetFromISet(bor_bset_t *d, const bor_iset_t *s)
+{
+    int i, v;
+
+    borBSetEmpty(d);
+    if (s->size == 0)
+        return;
+
+    borBSetResize(d, (s->s[s->size - 1] >> 6) + 1);
+    for (i = 0; i < s->size; ++i){
+        v = s->s[i];
+        d->w[v >> 6] |= (uint64_t)1 << (v & 63);
+    }
+}
+
+void borBSetToISet(const bor_bset_t *s, bor_iset_t *d)
+{
+    uint64_t m;
+    int size, w;
+
+    size = borBSetSize(s);
+    if (size > d->alloc){
+        d->alloc = size;
+        d->s = BOR_REALLOC_ARR(d->s, int, d->alloc);
+    }
+
+    d->size = 0;
+    for (w = 0; w < s->size; ++w){
+        for (m = s->w[w]; m != 0; m &= m - 1)
+            d->s[d->size++] = (w << 6) + __builtin_ctzll(m);
+    }
+}
+
+
+#ifdef BOR_SSE
+# define LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+# define STORE(p, v) _mm_storeu_si128((__m128i *)(p), (v))
+/** True if all bits of v are zero */
+# define ISZERO(v) \
+    (_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_setzero_si128())) == 0xffff)
+
+static void wordsOr(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                    int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2)
+        STORE(d + i, _mm_or_si128(LOAD(a + i), LOAD(b + i)));
+    if (i < len)
+        d[i] = a[i] | b[i];
+}
+
+static void wordsAnd(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                     int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2)
+        STORE(d + i, _mm_and_si128(LOAD(a + i), LOAD(b + i)));
+    if (i < len)
+        d[i] = a[i] & b[i];
+}
+
+static void wordsAndNot(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                        int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2)
+        STORE(d + i, _mm_andnot_si128(LOAD(b + i), LOAD(a + i)));
+    if (i < len)
+        d[i] = a[i] & ~b[i];
+}
+
+static int wordsSubset(const uint64_t *a, const uint64_t *b, int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2){
+        if (!ISZERO(_mm_andnot_si128(LOAD(b + i), LOAD(a + i))))
+            return 0;
+    }
+    return i == len || (a[i] & ~b[i]) == 0;
+}
+
+static int wordsDisjoint(const uint64_t *a, const uint64_t *b, int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2){
+        if (!ISZERO(_mm_and_si128(LOAD(a + i), LOAD(b + i))))
+            return 0;
+    }
+    return i == len || (a[i] & b[i]) == 0;
+}
+
+static int wordsZero(const uint64_t *a, int len)
+{
+    int i;
+
+    for (i = 0; i + 2 <= len; i += 2){
+        if (!ISZERO(LOAD(a + i)))
+            return 0;
+    }
+    return i == len || a[i] == 0;
+}
+
+#else /* BOR_SSE */
+/* Plain loops are vectorized by the compiler except for the early exits */
+static void wordsOr(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                    int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i)
+        d[i] = a[i] | b[i];
+}
+
+static void wordsAnd(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                     int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i)
+        d[i] = a[i] & b[i];
+}
+
+static void wordsAndNot(uint64_t *d, const uint64_t *a, const uint64_t *b,
+                        int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i)
+        d[i] = a[i] & ~b[i];
+}
+
+static int wordsSubset(const uint64_t *a, const uint64_t *b, int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i){
+        if (a[i] & ~b[i])
+            return 0;
+    }
+    return 1;
+}
+
+static int wordsDisjoint(const uint64_t *a, const uint64_t *b, int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i){
+        if (a[i] & b[i])
+            return 0;
+    }
+    return 1;
+}
+
+static int wordsZero(const uint64_t *a, int len)
+{
+    int i;
+
+    for (i = 0; i < len; ++i){
+        if (a[i] != 0)
+            return 0;
+    }
+    return 1;
+}
+#endif /* BOR_SSE */
+
+static int wordsPopcount(const uint64_t *a, int len)
+{
+    int i, size;
+
+    size = 0;
+    for (i = 0; i < len; ++i)
+        size += __builtin_popcountll(a[i]);
+    return size;
+}
@@ -0,0 +1,945 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <boruvka/bvh3.h>
+#include <boruvka/tasks.h>
+#include <boruvka/alloc.h>
+#include <boruvka/dbg.h>
+
+/** Number of bins used for evaluation of SAH */
+#define BINS 16
+/** Maximal number of faces in leaf */
+#define LEAF_MAX 8
+/** Minimal number of faces of subtree built as separate task */
+#define TASK_MIN_FACES 4096
+/** Size of traversal stack allocated on stack */
+#define STACK_LOCAL 128
+
+struct _box_t {
+    bor_real_t lo[3], hi[3];
+};
+typedef struct _box_t box_t;
+
+struct _nodes_t {
+    bor_bvh3_node_t *node;
+    int len, size;
+    int depth;
+};
+typedef struct _nodes_t nodes_t;
+
+struct _job_t {
+    struct _build_t *b;
+    int node;    /*!< Node in top-level tree replaced by the subtree */
+    int start, len;
+    int depth;
+    nodes_t nodes;
+};
+typedef struct _job_t job_t;
+
+struct _build_t {
+    box_t *fbox;         /*!< Bounding box of each face */
+    bor_vec3_t *cent;    /*!< Centroid of bounding box of each face */
+    int *idx;            /*!< Permutation of faces */
+
+    nodes_t *top;        /*!< Top-level tree */
+    int task_faces;      /*!< Subtrees with at most this number of faces
+                              are built as separate tasks (0 for none) */
+    job_t *jobs;
+    int jobs_len, jobs_size;
+};
+typedef struct _build_t build_t;
+
+static void boxEmpty(box_t *b);
+_bor_inline void boxAdd(box_t *b, const box_t *b2);
+_bor_inline void boxAddPoint(box_t *b, const bor_real_t *p);
+_bor_inline bor_real_t boxArea(const box_t *b);
+/** Returns squared distance of point from node's box */
+_bor_inline bor_real_t nodePointDist2(const bor_bvh3_node_t *n,
+                                      const bor_vec3_t *p);
+/** Returns squared distance between boxes of nodes */
+_bor_inline bor_real_t nodeNodeDist2(const bor_bvh3_node_t *n1,
+                                     const bor_bvh3_node_t *n2);
+_bor_inline int nodeOverlap(const bor_bvh3_node_t *n, const box_t *b);
+_bor_inline int nodeNodeOverlap(const bor_bvh3_node_t *n1,
+                                const bor_bvh3_node_t *n2);
+_bor_inline bor_real_t nodeArea(const bor_bvh3_node_t *n);
+/** Computes bounding box of triangle */
+_bor_inline void triBox(const bor_vec3_t *a, const bor_vec3_t *b,
+                        const bor_vec3_t *c, box_t *box);
+/** Returns squared distance between two triangles */
+static bor_real_t triTriDist2(const bor_vec3_t **t1, const bor_vec3_t **t2,
+                              bor_vec3_t *w1, bor_vec3_t *w2);
+
+static int nodesAdd(nodes_t *n, int num);
+/** Builds subtree of faces idx[start], ..., idx[start + len - 1] with
+ *  root {node} */
+static void build(build_t *b, nodes_t *nodes, int node,
+                  int start, int len, int depth);
+/** Finds best split of faces, returns number of faces in the left child
+ *  or -1 if leaf should be created */
+static int buildSplit(build_t *b, int start, int len,
+                      const box_t *box, const box_t *cbox);
+static void buildJob(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Merges subtrees built by jobs into the top-level tree */
+static void buildMerge(build_t *b, nodes_t *nodes);
+
+/** Returns traversal stack of at least {size} elements */
+_bor_inline int *stackNew(int *local, int size);
+_bor_inline void stackDel(int *stack, int *local);
+
+bor_bvh3_t *borBVH3New(bor_mesh3_t *mesh, int num_threads)
+{
+    bor_bvh3_t *bvh;
+    build_t b;
+    nodes_t nodes;
+    bor_mesh3_face_t **faces, *f;
+    bor_mesh3_vertex_t *vs[3];
+    bor_list_t *item;
+    bor_tasks_t *tasks;
+    int i, j, len;
+
+    bvh = BOR_ALLOC(bor_bvh3_t);
+    len = borMesh3FacesLen(mesh);
+    bvh->faces_len = len;
+    bvh->faces = BOR_ALLOC_ARR(bor_mesh3_face_t *, BOR_MAX(len, 1));
+    bvh->tris = BOR_ALLOC_ARR(const bor_vec3_t *, 3 * BOR_MAX(len, 1));
+    bvh->nodes = NULL;
+    bvh->nodes_len = 0;
+    bvh->depth = 0;
+    if (len == 0)
+        return bvh;
+
+    faces = BOR_ALLOC_ARR(bor_mesh3_face_t *, len);
+    b.fbox = BOR_ALLOC_ARR(box_t, len);
+    b.cent = borVec3ArrNew(len);
+    b.idx = BOR_ALLOC_ARR(int, len);
+    i = 0;
+    BOR_LIST_FOR_EACH(&mesh->faces, item){
+        f = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+        borMesh3FaceVertices(f, vs);
+        faces[i] = f;
+        triBox(vs[0]->v, vs[1]->v, vs[2]->v, b.fbox + i);
+        borVec3Set(b.cent + i, b.fbox[i].lo[0] + b.fbox[i].hi[0],
+                               b.fbox[i].lo[1] + b.fbox[i].hi[1],
+                               b.fbox[i].lo[2] + b.fbox[i].hi[2]);
+        b.idx[i] = i;
+        ++i;
+    }
+
+    b.task_faces = 0;
+    b.jobs = NULL;
+    b.jobs_len = b.jobs_size = 0;
+    if (num_threads > 1 && len >= 2 * TASK_MIN_FACES)
+        b.task_faces = BOR_MAX(len / (4 * num_threads), TASK_MIN_FACES);
+
+    nodes.size = BOR_MAX(2 * len / LEAF_MAX, 16);
+    nodes.node = BOR_ALLOC_ARR(bor_bvh3_node_t, nodes.size);
+    nodes.len = 0;
+    nodes.depth = 0;
+    nodesAdd(&nodes, 1);
+    b.top = &nodes;
+    build(&b, &nodes, 0, 0, len, 0);
+
+    if (b.jobs_len > 0){
+        tasks = borTasksNew(num_threads);
+        borTasksRun(tasks);
+        for (i = 0; i < b.jobs_len; ++i){
+            b.jobs[i].b = &b;
+            borTasksAdd(tasks, buildJob, i, b.jobs + i);
+        }
+        borTasksBarrier(tasks);
+        borTasksDel(tasks);
+        buildMerge(&b, &nodes);
+    }
+
+    bvh->nodes = nodes.node;
+    bvh->nodes_len = nodes.len;
+    bvh->depth = nodes.depth;
+
+    for (i = 0; i < len; ++i){
+        f = faces[b.idx[i]];
+        borMesh3FaceVertices(f, vs);
+        bvh->faces[i] = f;
+        for (j = 0; j < 3; ++j)
+            bvh->tris[3 * i + j] = borMesh3VertexCoords(vs[j]);
+    }
+
+    BOR_FREE(faces);
+    BOR_FREE(b.fbox);
+    borVec3ArrDel(b.cent);
+    BOR_FREE(b.idx);
+    return bvh;
+}
+
+void borBVH3Del(bor_bvh3_t *bvh)
+{
+    if (bvh->nodes)
+        BOR_FREE(bvh->nodes);
+    BOR_FREE(bvh->faces);
+    BOR_FREE(bvh->tris);
+    BOR_FREE(bvh);
+}
+
+void borBVH3Refit(bor_bvh3_t *bvh)
+{
+    bor_bvh3_node_t *n, *c;
+    box_t box, tbox;
+    int i, j, k;
+
+    // children are always stored after their parent
+    for (i = bvh->nodes_len - 1; i >= 0; --i){
+        n = bvh->nodes + i;
+        if (n->len > 0){
+            boxEmpty(&box);
+            for (j = n->first; j < n->first + n->len; ++j){
+                triBox(bvh->tris[3 * j], bvh->tris[3 * j + 1],
+                       bvh->tris[3 * j + 2], &tbox);
+                boxAdd(&box, &tbox);
+            }
+        }else{
+            c = bvh->nodes + n->first;
+            for (k = 0; k < 3; ++k){
+                box.lo[k] = BOR_MIN(c[0].lo[k], c[1].lo[k]);
+                box.hi[k] = BOR_MAX(c[0].hi[k], c[1].hi[k]);
+            }
+        }
+
+        for (k = 0; k < 3; ++k){
+            n->lo[k] = box.lo[k];
+            n->hi[k] = box.hi[k];
+        }
+    }
+}
+
+int borBVH3TriOverlap(const bor_bvh3_t *bvh,
+                      const bor_vec3_t *a, const bor_vec3_t *b,
+                      const bor_vec3_t *c, bor_mesh3_face_t **face)
+{
+    int stack_local[STACK_LOCAL], *stack, stack_len;
+    const bor_bvh3_node_t *n;
+    const bor_vec3_t **t;
+    box_t box;
+    int i, ret = 0;
+
+    if (bvh->nodes_len == 0)
+        return 0;
+
+    triBox(a, b, c, &box);
+    stack = stackNew(stack_local, bvh->depth + 2);
+    stack[0] = 0;
+    stack_len = 1;
+    while (stack_len > 0 && !ret){
+        n = bvh->nodes + stack[--stack_len];
+        if (!nodeOverlap(n, &box))
+            continue;
+
+        if (n->len > 0){
+            for (i = n->first; i < n->first + n->len; ++i){
+                t = bvh->tris + 3 * i;
+                if (borVec3TriTriOverlap(a, b, c, t[0], t[1], t[2])){
+                    if (face)
+                        *face = bvh->faces[i];
+                    ret = 1;
+                    break;
+                }
+            }
+        }else{
+            stack[stack_len++] = n->first;
+            stack[stack_len++] = n->first + 1;
+        }
+    }
+
+    stackDel(stack, stack_local);
+    return ret;
+}
+
+bor_real_t borBVH3ClosestPoint(const bor_bvh3_t *bvh, const bor_vec3_t *p,
+                               bor_vec3_t *witness, bor_mesh3_face_t **face)
+{
+    int stack_local[STACK_LOCAL], *stack, stack_len;
+    const bor_bvh3_node_t *n;
+    const bor_vec3_t **t;
+    bor_vec3_t w;
+    bor_real_t best, dist, d0, d1;
+    int i;
+
+    best = BOR_REAL_MAX;
+    if (bvh->nodes_len == 0)
+        return best;
+
+    stack = stackNew(stack_local, bvh->depth + 2);
+    stack[0] = 0;
+    stack_len = 1;
+    while (stack_len > 0){
+        n = bvh->nodes + stack[--stack_len];
+        if (nodePointDist2(n, p) >= best)
+            continue;
+
+        if (n->len > 0){
+            for (i = n->first; i < n->first + n->len; ++i){
+                t = bvh->tris + 3 * i;
+                dist = borVec3PointTriDist2(p, t[0], t[1], t[2], &w);
+                if (dist < best){
+                    best = dist;
+                    if (witness)
+                        borVec3Copy(witness, &w);
+                    if (face)
+                        *face = bvh->faces[i];
+                }
+            }
+        }else{
+            // the closer child is processed first
+            d0 = nodePointDist2(bvh->nodes + n->first, p);
+            d1 = nodePointDist2(bvh->nodes + n->first + 1, p);
+            if (d0 < d1){
+                stack[stack_len++] = n->first + 1;
+                stack[stack_len++] = n->first;
+            }else{
+                stack[stack_len++] = n->first;
+                stack[stack_len++] = n->first + 1;
+            }
+        }
+    }
+
+    stackDel(stack, stack_local);
+    return best;
+}
+
+/** Returns distance of entry point of ray into box of node or -1 if the
+ *  box is not hit before {tmax} */
+_bor_inline bor_real_t rayNode(const bor_bvh3_node_t *n,
+                               const bor_real_t *o, const bor_real_t *inv,
+                               bor_real_t tmax)
+{
+    bor_real_t t0 = BOR_ZERO, t1 = tmax, ta, tb, tmp;
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        ta = (n->lo[k] - o[k]) * inv[k];
+        tb = (n->hi[k] - o[k]) * inv[k];
+        if (ta > tb)
+            BOR_SWAP(ta, tb, tmp);
+        t0 = BOR_MAX(t0, ta);
+        t1 = BOR_MIN(t1, tb);
+        if (t0 > t1)
+            return -BOR_ONE;
+    }
+    return t0;
+}
+
+/** Returns distance of intersection of ray with triangle or -1 */
+_bor_inline bor_real_t rayTri(const bor_vec3_t *o, const bor_vec3_t *dir,
+                              const bor_vec3_t **t)
+{
+    bor_vec3_t e1, e2, p, s, q;
+    bor_real_t det, inv, u, v;
+
+    borVec3Sub2(&e1, t[1], t[0]);
+    borVec3Sub2(&e2, t[2], t[0]);
+    borVec3Cross(&p, dir, &e2);
+    det = borVec3Dot(&e1, &p);
+    if (det == BOR_ZERO)
+        return -BOR_ONE;
+    inv = BOR_ONE / det;
+
+    borVec3Sub2(&s, o, t[0]);
+    u = borVec3Dot(&s, &p) * inv;
+    if (u < BOR_ZERO || u > BOR_ONE)
+        return -BOR_ONE;
+
+    borVec3Cross(&q, &s, &e1);
+    v = borVec3Dot(dir, &q) * inv;
+    if (v < BOR_ZERO || u + v > BOR_ONE)
+        return -BOR_ONE;
+
+    return borVec3Dot(&e2, &q) * inv;
+}
+
+int borBVH3Ray(const bor_bvh3_t *bvh, const bor_vec3_t *origin,
+               const bor_vec3_t *dir, bor_real_t *t,
+               bor_mesh3_face_t **face)
+{
+    int stack_local[STACK_LOCAL], *stack, stack_len;
+    const bor_bvh3_node_t *n;
+    bor_real_t o[3], inv[3], d, best, d0, d1;
+    int i, k, ret = 0;
+
+    if (bvh->nodes_len == 0)
+        return 0;
+
+    for (k = 0; k < 3; ++k){
+        o[k] = borVec3Get(origin, k);
+        d = borVec3Get(dir, k);
+        // avoid infinities, they are not safe with -ffast-math
+        if (BOR_FABS(d) < BOR_REAL(1E-20))
+            d = (d < BOR_ZERO ? BOR_REAL(-1E-20) : BOR_REAL(1E-20));
+        inv[k] = BOR_ONE / d;
+    }
+
+    best = *t;
+    stack = stackNew(stack_local, bvh->depth + 2);
+    stack[0] = 0;
+    stack_len = 1;
+    while (stack_len > 0){
+        n = bvh->nodes + stack[--stack_len];
+        if (rayNode(n, o, inv, best) < BOR_ZERO)
+            continue;
+
+        if (n->len > 0){
+            for (i = n->first; i < n->first + n->len; ++i){
+                d = rayTri(origin, dir, bvh->tris + 3 * i);
+                if (d >= BOR_ZERO && d <= best){
+                    best = d;
+                    ret = 1;
+                    if (face)
+                        *face = bvh->faces[i];
+                }
+            }
+        }else{
+            d0 = rayNode(bvh->nodes + n->first, o, inv, best);
+            d1 = rayNode(bvh->nodes + n->first + 1, o, inv, best);
+            if (d0 >= BOR_ZERO && d1 >= BOR_ZERO){
+                if (d0 < d1){
+                    stack[stack_len++] = n->first + 1;
+                    stack[stack_len++] = n->first;
+                }else{
+                    stack[stack_len++] = n->first;
+                    stack[stack_len++] = n->first + 1;
+                }
+            }else if (d0 >= BOR_ZERO){
+                stack[stack_len++] = n->first;
+            }else if (d1 >= BOR_ZERO){
+                stack[stack_len++] = n->first + 1;
+            }
+        }
+    }
+
+    stackDel(stack, stack_local);
+    if (ret)
+        *t = best;
+    return ret;
+}
+
+int borBVH3Overlap(const bor_bvh3_t *bvh1, const bor_bvh3_t *bvh2,
+                   bor_bvh3_overlap_fn fn, void *data)
+{
+    int stack_local[STACK_LOCAL], *stack, stack_len;
+    const bor_bvh3_node_t *n1, *n2;
+    const bor_vec3_t **t1, **t2;
+    int i, j, found = 0, stop = 0;
+
+    if (bvh1->nodes_len == 0 || bvh2->nodes_len == 0)
+        return 0;
+
+    stack = stackNew(stack_local, 2 * (bvh1->depth + bvh2->depth + 2));
+    stack[0] = stack[1] = 0;
+    stack_len = 2;
+    while (stack_len > 0 && !stop){
+        stack_len -= 2;
+        n1 = bvh1->nodes + stack[stack_len];
+        n2 = bvh2->nodes + stack[stack_len + 1];
+        if (!nodeNodeOverlap(n1, n2))
+            continue;
+
+        if (n1->len > 0 && n2->len > 0){
+            for (i = n1->first; i < n1->first + n1->len && !stop; ++i){
+                t1 = bvh1->tris + 3 * i;
+                for (j = n2->first; j < n2->first + n2->len; ++j){
+                    t2 = bvh2->tris + 3 * j;
+                    if (!borVec3TriTriOverlap(t1[0], t1[1], t1[2],
+                                              t2[0], t2[1], t2[2]))
+                        continue;
+
+                    ++found;
+                    if (fn && fn(bvh1->faces[i], bvh2->faces[j], data) != 0){
+                        stop = 1;
+                        break;
+                    }
+                }
+            }
+
+        }else if (n2->len > 0
+                    || (n1->len == 0 && nodeArea(n1) >= nodeArea(n2))){
+            stack[stack_len++] = n1->first;
+            stack[stack_len++] = n2 - bvh2->nodes;
+            stack[stack_len++] = n1->first + 1;
+            stack[stack_len++] = n2 - bvh2->nodes;
+        }else{
+            stack[stack_len++] = n1 - bvh1->nodes;
+            stack[stack_len++] = n2->first;
+            stack[stack_len++] = n1 - bvh1->nodes;
+            stack[stack_len++] = n2->first + 1;
+        }
+    }
+
+    stackDel(stack, stack_local);
+    return found;
+}
+
+bor_real_t borBVH3Dist2(const bor_bvh3_t *bvh1, const bor_bvh3_t *bvh2,
+                        bor_vec3_t *w1, bor_vec3_t *w2,
+                        bor_mesh3_face_t **f1, bor_mesh3_face_t **f2)
+{
+    int stack_local[STACK_LOCAL], *stack, stack_len;
+    const bor_bvh3_node_t *n1, *n2;
+    bor_vec3_t v1, v2;
+    bor_real_t best, dist, d0, d1;
+    int i, j, a[2], b[2];
+
+    best = BOR_REAL_MAX;
+    if (bvh1->nodes_len == 0 || bvh2->nodes_len == 0)
+        return best;
+
+    stack = stackNew(stack_local, 2 * (bvh1->depth + bvh2->depth + 2));
+    stack[0] = stack[1] = 0;
+    stack_len = 2;
+    while (stack_len > 0 && best > BOR_ZERO){
+        stack_len -= 2;
+        n1 = bvh1->nodes + stack[stack_len];
+        n2 = bvh2->nodes + stack[stack_len + 1];
+        if (nodeNodeDist2(n1, n2) >= best)
+            continue;
+
+        if (n1->len > 0 && n2->len > 0){
+            for (i = n1->first; i < n1->first + n1->len; ++i){
+                for (j = n2->first; j < n2->first + n2->len; ++j){
+                    dist = triTriDist2(bvh1->tris + 3 * i, bvh2->tris + 3 * j,
+                                       &v1, &v2);
+                    if (dist < best){
+                        best = dist;
+                        if (w1)
+                            borVec3Copy(w1, &v1);
+                        if (w2)
+                            borVec3Copy(w2, &v2);
+                        if (f1)
+                            *f1 = bvh1->faces[i];
+                        if (f2)
+                            *f2 = bvh2->faces[j];
+                    }
+                }
+            }
+            continue;
+        }
+
+        if (n2->len > 0 || (n1->len == 0 && nodeArea(n1) >= nodeArea(n2))){
+            a[0] = n1->first;
+            a[1] = n1->first + 1;
+            b[0] = b[1] = n2 - bvh2->nodes;
+        }else{
+            a[0] = a[1] = n1 - bvh1->nodes;
+            b[0] = n2->first;
+            b[1] = n2->first + 1;
+        }
+
+        // the closer pair is processed first
+        d0 = nodeNodeDist2(bvh1->nodes + a[0], bvh2->nodes + b[0]);
+        d1 = nodeNodeDist2(bvh1->nodes + a[1], bvh2->nodes + b[1]);
+        i = (d0 < d1 ? 1 : 0);
+        stack[stack_len++] = a[i];
+        stack[stack_len++] = b[i];
+        stack[stack_len++] = a[1 - i];
+        stack[stack_len++] = b[1 - i];
+    }
+
+    stackDel(stack, stack_local);
+    return best;
+}
+
+
+
+static void boxEmpty(box_t *b)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        b->lo[k] = BOR_REAL_MAX;
+        b->hi[k] = -BOR_REAL_MAX;
+    }
+}
+
+_bor_inline void boxAdd(box_t *b, const box_t *b2)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        b->lo[k] = BOR_MIN(b->lo[k], b2->lo[k]);
+        b->hi[k] = BOR_MAX(b->hi[k], b2->hi[k]);
+    }
+}
+
+_bor_inline void boxAddPoint(box_t *b, const bor_real_t *p)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        b->lo[k] = BOR_MIN(b->lo[k], p[k]);
+        b->hi[k] = BOR_MAX(b->hi[k], p[k]);
+    }
+}
+
+_bor_inline bor_real_t boxArea(const box_t *b)
+{
+    bor_real_t x, y, z;
+
+    x = b->hi[0] - b->lo[0];
+    y = b->hi[1] - b->lo[1];
+    z = b->hi[2] - b->lo[2];
+    return x * y + y * z + z * x;
+}
+
+_bor_inline bor_real_t nodePointDist2(const bor_bvh3_node_t *n,
+                                      const bor_vec3_t *p)
+{
+    bor_real_t dist = BOR_ZERO, v, d;
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        v = borVec3Get(p, k);
+        if (v < n->lo[k]){
+            d = n->lo[k] - v;
+            dist += d * d;
+        }else if (v > n->hi[k]){
+            d = v - n->hi[k];
+            dist += d * d;
+        }
+    }
+    return dist;
+}
+
+_bor_inline bor_real_t nodeNodeDist2(const bor_bvh3_node_t *n1,
+                                     const bor_bvh3_node_t *n2)
+{
+    bor_real_t dist = BOR_ZERO, d;
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        if (n1->hi[k] < n2->lo[k]){
+            d = n2->lo[k] - n1->hi[k];
+            dist += d * d;
+        }else if (n2->hi[k] < n1->lo[k]){
+            d = n1->lo[k] - n2->hi[k];
+            dist += d * d;
+        }
+    }
+    return dist;
+}
+
+_bor_inline int nodeOverlap(const bor_bvh3_node_t *n, const box_t *b)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        if (n->hi[k] < b->lo[k] || b->hi[k] < n->lo[k])
+            return 0;
+    }
+    return 1;
+}
+
+_bor_inline int nodeNodeOverlap(const bor_bvh3_node_t *n1,
+                                const bor_bvh3_node_t *n2)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        if (n1->hi[k] < n2->lo[k] || n2->hi[k] < n1->lo[k])
+            return 0;
+    }
+    return 1;
+}
+
+_bor_inline bor_real_t nodeArea(const bor_bvh3_node_t *n)
+{
+    bor_real_t x, y, z;
+
+    x = n->hi[0] - n->lo[0];
+    y = n->hi[1] - n->lo[1];
+    z = n->hi[2] - n->lo[2];
+    return x * y + y * z + z * x;
+}
+
+_bor_inline void triBox(const bor_vec3_t *a, const bor_vec3_t *b,
+                        const bor_vec3_t *c, box_t *box)
+{
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        box->lo[k] = BOR_MIN(BOR_MIN(borVec3Get(a, k), borVec3Get(b, k)),
+                             borVec3Get(c, k));
+        box->hi[k] = BOR_MAX(BOR_MAX(borVec3Get(a, k), borVec3Get(b, k)),
+                             borVec3Get(c, k));
+    }
+}
+
+static bor_real_t triTriDist2(const bor_vec3_t **t1, const bor_vec3_t **t2,
+                              bor_vec3_t *w1, bor_vec3_t *w2)
+{
+    bor_vec3_t s, t, v1, v2;
+    bor_real_t best, dist;
+    int i, j;
+
+    if (borVec3TriTriOverlap(t1[0], t1[1], t1[2], t2[0], t2[1], t2[2])
+            && borVec3TriTriIntersect(t1[0], t1[1], t1[2],
+                                      t2[0], t2[1], t2[2], &s, &t) == 1){
+        borVec3Copy(w1, &s);
+        borVec3Copy(w2, &s);
+        return BOR_ZERO;
+    }
+
+    // otherwise (or if the triangles are coplanar) the closest points lie
+    // on the boundary of one of the triangles
+    best = BOR_REAL_MAX;
+    for (i = 0; i < 3; ++i){
+        dist = borVec3PointTriDist2(t1[i], t2[0], t2[1], t2[2], &v2);
+        if (dist < best){
+            best = dist;
+            borVec3Copy(w1, t1[i]);
+            borVec3Copy(w2, &v2);
+        }
+
+        dist = borVec3PointTriDist2(t2[i], t1[0], t1[1], t1[2], &v1);
+        if (dist < best){
+            best = dist;
+            borVec3Copy(w1, &v1);
+            borVec3Copy(w2, t2[i]);
+        }
+    }
+
+    for (i = 0; i < 3; ++i){
+        for (j = 0; j < 3; ++j){
+            dist = borVec3SegmentSegmentDist2(t1[i], t1[(i + 1) % 3],
+                                              t2[j], t2[(j + 1) % 3],
+                                              &v1, &v2, NULL);
+            if (dist < best){
+                best = dist;
+                borVec3Copy(w1, &v1);
+                borVec3Copy(w2, &v2);
+            }
+        }
+    }
+
+    return best;
+}
+
+
+
+static int nodesAdd(nodes_t *n, int num)
+{
+    int i = n->len;
+
+    if (n->len + num > n->size){
+        n->size = BOR_MAX(2 * n->size, n->len + num);
+        n->node = BOR_REALLOC_ARR(n->node, bor_bvh3_node_t, n->size);
+    }
+    n->len += num;
+    return i;
+}
+
+static void build(build_t *b, nodes_t *nodes, int node,
+                  int start, int len, int depth)
+{
+    bor_bvh3_node_t *n;
+    box_t box, cbox;
+    job_t *job;
+    int i, k, left, child;
+
+    boxEmpty(&box);
+    boxEmpty(&cbox);
+    for (i = start; i < start + len; ++i){
+        boxAdd(&box, b->fbox + b->idx[i]);
+        boxAddPoint(&cbox, b->cent[b->idx[i]].f);
+    }
+
+    n = nodes->node + node;
+    for (k = 0; k < 3; ++k){
+        n->lo[k] = box.lo[k];
+        n->hi[k] = box.hi[k];
+    }
+    nodes->depth = BOR_MAX(nodes->depth, depth);
+
+    if (nodes == b->top && b->task_faces > 0
+            && len <= b->task_faces && node > 0){
+        // subtree is built later as separate task
+        if (b->jobs_len == b->jobs_size){
+            b->jobs_size = BOR_MAX(2 * b->jobs_size, 8);
+            b->jobs = BOR_REALLOC_ARR(b->jobs, job_t, b->jobs_size);
+        }
+        job = b->jobs + b->jobs_len++;
+        job->node = node;
+        job->start = start;
+        job->len = len;
+        job->depth = depth;
+        n->first = -1;
+        n->len = 0;
+        return;
+    }
+
+    left = buildSplit(b, start, len, &box, &cbox);
+    if (left < 0){
+        n->first = start;
+        n->len = len;
+        return;
+    }
+
+    child = nodesAdd(nodes, 2);
+    n = nodes->node + node;
+    n->first = child;
+    n->len = 0;
+    build(b, nodes, child, start, left, depth + 1);
+    build(b, nodes, child + 1, start + left, len - left, depth + 1);
+}
+
+static int buildSplit(build_t *b, int start, int len,
+                      const box_t *box, const box_t *cbox)
+{
+    box_t bin_box[BINS], acc;
+    int bin_len[BINS];
+    bor_real_t right_cost[BINS], cost, best_cost, ext, scale[3], area;
+    int i, j, k, bin, best_axis, best_bin, left_len, right_len, tmp;
+
+    if (len <= 2)
+        return -1;
+
+    best_cost = BOR_REAL_MAX;
+    best_axis = best_bin = -1;
+    for (k = 0; k < 3; ++k){
+        ext = cbox->hi[k] - cbox->lo[k];
+        scale[k] = BOR_ZERO;
+        if (ext <= BOR_ZERO)
+            continue;
+        scale[k] = (BINS * (BOR_ONE - BOR_REAL(1E-5))) / ext;
+
+        for (i = 0; i < BINS; ++i){
+            boxEmpty(bin_box + i);
+            bin_len[i] = 0;
+        }
+        for (i = start; i < start + len; ++i){
+            j = b->idx[i];
+            bin = (borVec3Get(b->cent + j, k) - cbox->lo[k]) * scale[k];
+            bin = BOR_MIN(BOR_MAX(bin, 0), BINS - 1);
+            ++bin_len[bin];
+            boxAdd(bin_box + bin, b->fbox + j);
+        }
+
+        // sweep from right and then from left
+        boxEmpty(&acc);
+        right_len = 0;
+        for (i = BINS - 1; i > 0; --i){
+            right_len += bin_len[i];
+            boxAdd(&acc, bin_box + i);
+            right_cost[i] = (right_len > 0 ? right_len * boxArea(&acc) : 0);
+        }
+        boxEmpty(&acc);
+        left_len = 0;
+        for (i = 0; i < BINS - 1; ++i){
+            left_len += bin_len[i];
+            boxAdd(&acc, bin_box + i);
+            if (left_len == 0 || left_len == len)
+                continue;
+            cost = left_len * boxArea(&acc) + right_cost[i + 1];
+            if (cost < best_cost){
+                best_cost = cost;
+                best_axis = k;
+                best_bin = i;
+            }
+        }
+    }
+
+    area = boxArea(box);
+    if (best_axis < 0){
+        // all centroids are the same
+        if (len <= LEAF_MAX)
+            return -1;
+        return len / 2;
+    }
+    if (len <= LEAF_MAX && best_cost >= (len - 1) * area)
+        return -1;
+
+    // partition faces according to the best split
+    i = start;
+    j = start + len - 1;
+    k = best_axis;
+    while (i <= j){
+        bin = (borVec3Get(b->cent + b->idx[i], k) - cbox->lo[k]) * scale[k];
+        if (bin <= best_bin){
+            ++i;
+        }else{
+            BOR_SWAP(b->idx[i], b->idx[j], tmp);
+            --j;
+        }
+    }
+
+    left_len = i - start;
+    if (left_len == 0 || left_len == len)
+        return len / 2;
+    return left_len;
+}
+
+static void buildJob(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    job_t *job = (job_t *)data;
+    build_t *b = job->b;
+
+    job->nodes.size = BOR_MAX(2 * job->len / LEAF_MAX, 16);
+    job->nodes.node = BOR_ALLOC_ARR(bor_bvh3_node_t, job->nodes.size);
+    job->nodes.len = 0;
+    job->nodes.depth = job->depth;
+    nodesAdd(&job->nodes, 1);
+    build(b, &job->nodes, 0, job->start, job->len, job->depth);
+}
+
+static void buildMerge(build_t *b, nodes_t *nodes)
+{
+    job_t *job;
+    bor_bvh3_node_t *n;
+    int i, j, off;
+
+    for (i = 0; i < b->jobs_len; ++i){
+        job = b->jobs + i;
+
+        // root of subtree replaces the placeholder and the rest is
+        // appended
+        off = nodesAdd(nodes, job->nodes.len - 1) - 1;
+        nodes->node[job->node] = job->nodes.node[0];
+        for (j = 1; j < job->nodes.len; ++j)
+            nodes->node[off + j] = job->nodes.node[j];
+
+        n = nodes->node + job->node;
+        if (n->len == 0)
+            n->first += off;
+        for (j = 1; j < job->nodes.len; ++j){
+            n = nodes->node + off + j;
+            if (n->len == 0)
+                n->first += off;
+        }
+
+        nodes->depth = BOR_MAX(nodes->depth, job->nodes.depth);
+        BOR_FREE(job->nodes.node);
+    }
+    BOR_FREE(b->jobs);
+}
+
+_bor_inline int *stackNew(int *local, int size)
+{
+    if (size <= STACK_LOCAL)
+        return local;
+    return BOR_ALLOC_ARR(int, size);
+}
+
+_bor_inline void stackDel(int *stack, int *local)
+{
+    if (stack != local)
+        BOR_FREE(stack);
+}
@@ -14,10 +14,19 @@
  *  See the License for more information.
  */
 
+#include <string.h>
 #include <boruvka/chull3.h>
 #include <boruvka/alloc.h>
 #include <boruvka/dbg.h>
 #include <boruvka/predicates.h>
+#include <boruvka/rand.h>
+#include <boruvka/tasks.h>
+
+/** Size of segments of pools of vertices, edges and faces */
+#define CHULL3_POOL_SEGM_SIZE (64 * 1024)
+/** Seed of the insertion order of borCHull3Build(), fixed so that the
+ *  resulting hull is reproducible */
+#define CHULL3_RAND_SEED 3145739
 
 struct _bor_chull3_vert_t {
     bor_vec3_t v;
@@ -39,9 +48,27 @@ struct _bor_chull3_face_t {
     bor_mesh3_face_t m;
     bor_chull3_vert_t *v[3];
     bor_list_t list;
+    bor_list_t conflicts; /*!< List of not yet processed points from
+                               which is this face visible (bor_chull3_pt_t) */
+    int visible;          /*!< Visibility mark used during search for
+                               visible faces: 1 visible, -1 not visible,
+                               0 not tested */
 };
 typedef struct _bor_chull3_face_t bor_chull3_face_t;
 
+/**
+ * Not yet processed input point of borCHull3Build(). Each point is
+ * connected to exactly one face of current hull that is visible from the
+ * point (i.e., it is in face's .conflicts list) or it lies inside the
+ * hull and .face is NULL.
+ */
+struct _bor_chull3_pt_t {
+    const bor_vec3_t *v;
+    bor_chull3_face_t *face;
+    bor_list_t list;
+};
+typedef struct _bor_chull3_pt_t bor_chull3_pt_t;
+
 /** Predicate that returns true if f is visible from v */
 _bor_inline int isVisible(const bor_chull3_t *h,
                           const bor_vec3_t *v,
@@ -66,14 +93,12 @@ _bor_inline int isCoplanar(const bor_chull3_t *h,
 static bor_chull3_vert_t *vertNew(bor_chull3_t *h, const bor_vec3_t *v);
 /** Delete vertex */
 static void vertDel(bor_chull3_t *h, bor_chull3_vert_t *v);
-static void vertDelMesh(bor_mesh3_vertex_t *, void *);
 
 /** Create new edge */
 static bor_chull3_edge_t *edgeNew(bor_chull3_t *h,
                                   bor_chull3_vert_t *v1, bor_chull3_vert_t *v2);
 /** Delete edge */
 static void edgeDel(bor_chull3_t *h, bor_chull3_edge_t *e);
-static void edgeDelMesh(bor_mesh3_edge_t *, void *);
 /** Fills v[] with vertices incidenting with edge */
 static void edgeVertices(bor_chull3_edge_t *e, bor_chull3_vert_t **v);
 
@@ -83,7 +108,6 @@ static bor_chull3_face_t *faceNew(bor_chull3_t *h,
                                   bor_chull3_edge_t *e3);
 /** Delete face */
 static void faceDel(bor_chull3_t *h, bor_chull3_face_t *f);
-static void faceDelMesh(bor_mesh3_face_t *, void *);
 /** Set triplet of bounding vertices in specified order */
 static void faceSetVertices(bor_chull3_t *h, bor_chull3_face_t *f,
                             bor_chull3_vert_t *v1, bor_chull3_vert_t *v2,
@@ -103,8 +127,129 @@ static void firstNonCoplanar(bor_chull3_t *h, const bor_vec3_t *v);
 /** Obtain border edges */
 static void findBorderEdges(bor_chull3_t *h, const bor_vec3_t *v,
                             bor_list_t *edges);
-/** Makes new cone connecting new point {v} with border edges */
-static void makeCone(bor_chull3_t *h, bor_list_t *edges, const bor_vec3_t *v);
+/** Removes given visible faces and obtains border edges. Conflicting
+ *  points of removed faces are moved to {conflicts} if non-NULL. */
+static void borderEdges(bor_chull3_t *h, const bor_vec3_t *v,
+                        bor_list_t *faces, bor_list_t *edges,
+                        bor_list_t *conflicts);
+/** Makes new cone connecting new point {v} with border edges.
+ *  If {new_faces} is non-NULL, newly created faces are appended there. */
+static void makeCone(bor_chull3_t *h, bor_list_t *edges, const bor_vec3_t *v,
+                     bor_list_t *new_faces);
+
+/** Finds indices of four points forming non-degenerate tetrahedron.
+ *  Returns -1 if all points are coplanar. */
+static int buildInitSimplex(const bor_vec3_t *points, size_t n,
+                            size_t *init);
+/** Finds all faces visible from point starting from {start} face.
+ *  Returns -1 if the point is duplicate of any hull's vertex. */
+static int buildVisibleFaces(bor_chull3_t *h, const bor_vec3_t *point,
+                             bor_chull3_face_t *start, bor_list_t *faces);
+/** Adds conflicting point to hull */
+static void buildAddPoint(bor_chull3_t *h, bor_chull3_pt_t *pt);
+/** Connects points from {conflicts} with one of visible new faces */
+static void buildRedistribute(bor_chull3_t *h, bor_list_t *conflicts,
+                              bor_list_t *new_faces);
+
+
+/**
+ * Parallel QuickHull
+ * -------------------
+ * Faces are stored in an array and refer to each other by indices, each
+ * face owns an array of outside points (points from which the face is
+ * visible). The hull is expanded in rounds: in each round the furthest
+ * points of as many faces as possible are selected so that their visible
+ * regions are not neighbouring, these are added to the hull one by one
+ * (that is cheap) and then all points from removed faces are
+ * partitioned to new faces in parallel (that is where the time is
+ * spent). Visibility is always decided by exact predicate.
+ */
+struct _qh_face_t {
+    int v[3];            /*!< Vertices (indices of points) ordered so that
+                              interior of hull is below the face */
+    int adj[3];          /*!< adj[i] is face sharing edge v[i]-v[i+1] */
+    int *out;            /*!< Outside points */
+    int out_len, out_size;
+    int far;             /*!< The furthest outside point */
+    bor_real_t far_dist; /*!< Distance of .far (scaled by face area) */
+    int alive;           /*!< True if face is part of hull */
+    int visit;           /*!< Mark used during search for visible faces */
+    int claim;           /*!< Round in which was face claimed by an apex */
+};
+typedef struct _qh_face_t qh_face_t;
+
+struct _qh_t {
+    const bor_vec3_t *pts;
+    size_t n;
+    bor_pred_t pred;
+
+    qh_face_t *faces;
+    int faces_len, faces_size;
+    int visit;                /*!< Current visit mark */
+
+    bor_tasks_t *tasks;       /*!< Thread pool or NULL if single thread */
+    int num_threads;
+};
+typedef struct _qh_t qh_t;
+
+/** Points to be partitioned: point[i] is tested against faces
+ *  [face_from[i], face_to[i]) */
+struct _qh_part_t {
+    int *point;
+    int *face_from, *face_to;
+    int *asg;           /*!< Assigned face or -1 */
+    bor_real_t *dist;   /*!< Distance from assigned face */
+    size_t len, size;
+};
+typedef struct _qh_part_t qh_part_t;
+
+/** Single job processed by a thread */
+struct _qh_job_t {
+    qh_t *qh;
+    qh_part_t *part;
+    size_t from, to;
+    int type;
+    const bor_vec3_t *a, *b, *c; /*!< Line or plane for QH_JOB_FAR_* */
+    size_t min[3], max[3];       /*!< Result of QH_JOB_EXTREMES */
+    size_t best;                 /*!< Result of QH_JOB_FAR_* */
+    bor_real_t best_val;
+};
+typedef struct _qh_job_t qh_job_t;
+
+#define QH_JOB_EXTREMES  0
+#define QH_JOB_FAR_LINE  1
+#define QH_JOB_FAR_PLANE 2
+#define QH_JOB_PARTITION 3
+
+/** Minimal number of points per job */
+#define QH_MIN_JOB 256
+/** Number of jobs per thread */
+#define QH_JOBS_PER_THREAD 4
+
+/** Runs jobs of given type over range [0, len) in parallel. Returns
+ *  number of jobs; jobs[] must be large enough. */
+static int qhRun(qh_t *qh, qh_job_t *jobs, int type, size_t len,
+                 qh_part_t *part, const bor_vec3_t *a,
+                 const bor_vec3_t *b, const bor_vec3_t *c);
+static void qhJob(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Finds initial tetrahedron, returns -1 if points are coplanar */
+static int qhInitSimplex(qh_t *qh, qh_job_t *jobs, int *init);
+/** Creates new face and returns its index */
+static int qhFaceNew(qh_t *qh, int v0, int v1, int v2);
+/** Appends point to outside set of face */
+static void qhFaceAddOut(qh_t *qh, int f, int p, bor_real_t dist);
+/** Returns true if face is visible from point */
+_bor_inline int qhVisible(const qh_t *qh, const qh_face_t *f, int p);
+/** Partitions points in {part} to faces in parallel */
+static void qhPartition(qh_t *qh, qh_job_t *jobs, qh_part_t *part);
+/** Adds point to part */
+static void qhPartAdd(qh_part_t *part, int p, int face_from, int face_to);
+/** Adds apex point to hull. Faces visible from apex are in vis[], new
+ *  faces are created and points of removed faces are added to {part}. */
+static void qhAddApex(qh_t *qh, int apex, int *vis, int vis_len,
+                      int *hmap, qh_part_t *part);
+/** Fills hull {h} with faces computed by QuickHull */
+static void qhToCHull(qh_t *qh, bor_chull3_t *h);
 
 bor_chull3_t *borCHull3New(void)
 {
@@ -113,6 +258,17 @@ bor_chull3_t *borCHull3New(void)
     h = BOR_ALLOC(bor_chull3_t);
     h->mesh = borMesh3New();
     h->coplanar = 1;
+    h->verts_pool = borPoolNew(sizeof(bor_chull3_vert_t),
+                               CHULL3_POOL_SEGM_SIZE);
+    h->edges_pool = borPoolNew(sizeof(bor_chull3_edge_t),
+                               CHULL3_POOL_SEGM_SIZE);
+    h->faces_pool = borPoolNew(sizeof(bor_chull3_face_t),
+                               CHULL3_POOL_SEGM_SIZE);
+    // the mesh takes over the pools, so borMesh3Del() releases all
+    // elements at once instead of disconnecting them one by one
+    h->mesh->verts_pool = h->verts_pool;
+    h->mesh->edges_pool = h->edges_pool;
+    h->mesh->faces_pool = h->faces_pool;
 
     //borPredInit(&h->pred);
 
@@ -122,10 +278,8 @@ bor_chull3_t *borCHull3New(void)
 
 void borCHull3Del(bor_chull3_t *h)
 {
-    borMesh3Del2(h->mesh,
-                 vertDelMesh, NULL,
-                 edgeDelMesh, NULL,
-                 faceDelMesh, NULL);
+    // all elements are released with pools owned by the mesh
+    borMesh3Del(h->mesh);
 
     BOR_FREE(h);
 }
@@ -150,7 +304,256 @@ void borCHull3Add(bor_chull3_t *h, const bor_vec3_t *point)
         return;
 
 
-    makeCone(h, &border_edges, point);
+    makeCone(h, &border_edges, point, NULL);
+}
+
+bor_chull3_t *borCHull3Build(const bor_vec3_t *points, size_t n)
+{
+    bor_chull3_t *h;
+    bor_chull3_pt_t *pts;
+    bor_list_t *list, *item;
+    bor_mesh3_face_t *mf;
+    bor_chull3_face_t *f;
+    bor_rand_t rnd;
+    size_t *perm, init[4], i, j, tmp;
+
+    h = borCHull3New();
+    if (n == 0)
+        return h;
+
+    // random order of insertion
+    perm = BOR_ALLOC_ARR(size_t, n);
+    for (i = 0; i < n; i++)
+        perm[i] = i;
+    borRandInitSeed(&rnd, CHULL3_RAND_SEED);
+    for (i = n - 1; i > 0; i--){
+        j = borRand(&rnd, 0, i + 1);
+        if (j > i)
+            j = i;
+        BOR_SWAP(perm[i], perm[j], tmp);
+    }
+
+    if (buildInitSimplex(points, n, init) != 0){
+        // all points are coplanar, use incremental algorithm
+        for (i = 0; i < n; i++)
+            borCHull3Add(h, &points[perm[i]]);
+        BOR_FREE(perm);
+        return h;
+    }
+
+    for (i = 0; i < 4; i++)
+        borCHull3Add(h, &points[init[i]]);
+
+    // connect all other points with faces of initial tetrahedron
+    pts = BOR_ALLOC_ARR(bor_chull3_pt_t, n);
+    list = borMesh3Faces(h->mesh);
+    for (i = 0; i < n; i++){
+        pts[i].v = &points[perm[i]];
+        pts[i].face = NULL;
+
+        if (perm[i] == init[0] || perm[i] == init[1]
+                || perm[i] == init[2] || perm[i] == init[3])
+            continue;
+
+        BOR_LIST_FOR_EACH(list, item){
+            mf = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+            f  = bor_container_of(mf, bor_chull3_face_t, m);
+            if (isVisible(h, pts[i].v, f)){
+                pts[i].face = f;
+                borListAppend(&f->conflicts, &pts[i].list);
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++){
+        if (pts[i].face != NULL)
+            buildAddPoint(h, &pts[i]);
+    }
+
+    BOR_FREE(pts);
+    BOR_FREE(perm);
+
+    return h;
+}
+
+bor_chull3_t *borCHull3BuildParallel(const bor_vec3_t *points, size_t n,
+                                     int num_threads)
+{
+    bor_chull3_t *h;
+    qh_t qh;
+    qh_job_t *jobs;
+    qh_part_t part;
+    qh_face_t *f;
+    int init[4], *hmap, *vis, vis_len, vis_size, *round, round_len;
+    int *next, next_len, cand_size, rnd, faces_start;
+    int i, j, k, fi, g, apex, conflict;
+    size_t pi;
+
+    qh.pts = points;
+    qh.n = n;
+    borPredInit(&qh.pred);
+    qh.faces = NULL;
+    qh.faces_len = qh.faces_size = 0;
+    qh.visit = 0;
+    qh.num_threads = BOR_MAX(num_threads, 1);
+    qh.tasks = NULL;
+    if (qh.num_threads > 1){
+        qh.tasks = borTasksNew(qh.num_threads);
+        borTasksRun(qh.tasks);
+    }
+    jobs = BOR_ALLOC_ARR(qh_job_t, qh.num_threads * QH_JOBS_PER_THREAD);
+
+    if (qhInitSimplex(&qh, jobs, init) != 0){
+        // degenerate input is handled by incremental algorithm
+        if (qh.tasks)
+            borTasksDel(qh.tasks);
+        BOR_FREE(jobs);
+        return borCHull3Build(points, n);
+    }
+
+    // initial tetrahedron, init[3] is below face init[0..2]
+    qhFaceNew(&qh, init[0], init[1], init[2]);
+    qhFaceNew(&qh, init[0], init[3], init[1]);
+    qhFaceNew(&qh, init[1], init[3], init[2]);
+    qhFaceNew(&qh, init[0], init[2], init[3]);
+    for (i = 0; i < 4; i++){
+        for (j = 0; j < 3; j++){
+            for (k = 0; k < 4; k++){
+                for (g = 0; g < 3; g++){
+                    if (qh.faces[k].v[g] == qh.faces[i].v[(j + 1) % 3]
+                            && qh.faces[k].v[(g + 1) % 3] == qh.faces[i].v[j])
+                        qh.faces[i].adj[j] = k;
+                }
+            }
+        }
+    }
+
+    // partition all points to the tetrahedron
+    memset(&part, 0, sizeof(part));
+    for (pi = 0; pi < n; pi++){
+        if ((int)pi != init[0] && (int)pi != init[1]
+                && (int)pi != init[2] && (int)pi != init[3])
+            qhPartAdd(&part, pi, 0, 4);
+    }
+    qhPartition(&qh, jobs, &part);
+
+    hmap = BOR_ALLOC_ARR(int, n);
+    for (pi = 0; pi < n; pi++)
+        hmap[pi] = -1;
+    vis_size = 64;
+    vis = BOR_ALLOC_ARR(int, vis_size);
+
+    // faces with non-empty outside set
+    cand_size = 4;
+    round = BOR_ALLOC_ARR(int, cand_size);
+    next  = BOR_ALLOC_ARR(int, cand_size);
+    round_len = 0;
+    for (i = 0; i < 4; i++){
+        if (qh.faces[i].out_len > 0)
+            round[round_len++] = i;
+    }
+
+    rnd = 0;
+    while (round_len > 0){
+        ++rnd;
+        next_len = 0;
+        part.len = 0;
+        faces_start = qh.faces_len;
+
+        for (i = 0; i < round_len; i++){
+            fi = round[i];
+            if (!qh.faces[fi].alive || qh.faces[fi].out_len == 0)
+                continue;
+
+            // find faces visible from the furthest point
+            apex = qh.faces[fi].far;
+            ++qh.visit;
+            qh.faces[fi].visit = qh.visit;
+            vis[0] = fi;
+            vis_len = 1;
+            conflict = 0;
+            for (j = 0; j < vis_len && !conflict; j++){
+                f = qh.faces + vis[j];
+                if (f->claim == rnd){
+                    conflict = 1;
+                    break;
+                }
+
+                for (k = 0; k < 3; k++){
+                    g = f->adj[k];
+                    if (qh.faces[g].visit == qh.visit)
+                        continue;
+                    qh.faces[g].visit = qh.visit;
+                    if (qhVisible(&qh, qh.faces + g, apex)){
+                        if (vis_len == vis_size){
+                            vis_size *= 2;
+                            vis = BOR_REALLOC_ARR(vis, int, vis_size);
+                        }
+                        vis[vis_len++] = g;
+                    }
+                }
+            }
+
+            if (conflict){
+                // neighbouring region was already changed in this
+                // round, try it again in the next one
+                next[next_len++] = fi;
+                continue;
+            }
+
+            // claim visible region and its neighbourhood
+            for (j = 0; j < vis_len; j++){
+                f = qh.faces + vis[j];
+                f->claim = rnd;
+                for (k = 0; k < 3; k++)
+                    qh.faces[f->adj[k]].claim = rnd;
+            }
+
+            qhAddApex(&qh, apex, vis, vis_len, hmap, &part);
+        }
+
+        // distribute points from removed faces to new faces
+        qhPartition(&qh, jobs, &part);
+
+        // next round processes deferred faces and new faces with
+        // non-empty outside set
+        if (cand_size < next_len + qh.faces_len - faces_start){
+            cand_size = 2 * (next_len + qh.faces_len - faces_start);
+            round = BOR_REALLOC_ARR(round, int, cand_size);
+            next  = BOR_REALLOC_ARR(next, int, cand_size);
+        }
+        round_len = 0;
+        for (i = 0; i < next_len; i++)
+            round[round_len++] = next[i];
+        for (i = faces_start; i < qh.faces_len; i++){
+            if (qh.faces[i].alive && qh.faces[i].out_len > 0)
+                round[round_len++] = i;
+        }
+    }
+
+    h = borCHull3New();
+    qhToCHull(&qh, h);
+
+    for (i = 0; i < qh.faces_len; i++){
+        if (qh.faces[i].out)
+            BOR_FREE(qh.faces[i].out);
+    }
+    BOR_FREE(qh.faces);
+    BOR_FREE(part.point);
+    BOR_FREE(part.face_from);
+    BOR_FREE(part.face_to);
+    BOR_FREE(part.asg);
+    BOR_FREE(part.dist);
+    BOR_FREE(hmap);
+    BOR_FREE(vis);
+    BOR_FREE(round);
+    BOR_FREE(next);
+    BOR_FREE(jobs);
+    if (qh.tasks)
+        borTasksDel(qh.tasks);
+
+    return h;
 }
 
 void borCHull3DumpSVT(bor_chull3_t *h, FILE *out, const char *name)
@@ -211,7 +614,7 @@ static bor_chull3_vert_t *vertNew(bor_chull3_t *h, const bor_vec3_t *v)
 {
     bor_chull3_vert_t *vert;
 
-    vert = BOR_ALLOC_ALIGN(bor_chull3_vert_t, 16);
+    vert = borPoolAlloc(h->verts_pool);
 
     // copy coordinates
     borVec3Copy(&vert->v, v);
@@ -230,14 +633,7 @@ static bor_chull3_vert_t *vertNew(bor_chull3_t *h, const bor_vec3_t *v)
 static void vertDel(bor_chull3_t *h, bor_chull3_vert_t *v)
 {
     borMesh3RemoveVertex(h->mesh, &v->m);
-    BOR_FREE(v);
-}
-static void vertDelMesh(bor_mesh3_vertex_t *_v, void *_)
-{
-    bor_chull3_vert_t *v;
-
-    v = bor_container_of(_v, bor_chull3_vert_t, m);
-    BOR_FREE(v);
+    borPoolFree(h->verts_pool, v);
 }
 
 
@@ -246,7 +642,7 @@ static bor_chull3_edge_t *edgeNew(bor_chull3_t *h,
 {
     bor_chull3_edge_t *e;
 
-    e = BOR_ALLOC(bor_chull3_edge_t);
+    e = borPoolAlloc(h->edges_pool);
     borMesh3AddEdge(h->mesh, &e->m, &v1->m, &v2->m);
     e->swap = 0;
     e->onedge = 0;
@@ -257,15 +653,7 @@ static bor_chull3_edge_t *edgeNew(bor_chull3_t *h,
 static void edgeDel(bor_chull3_t *h, bor_chull3_edge_t *e)
 {
     borMesh3RemoveEdge(h->mesh, &e->m);
-    BOR_FREE(e);
-}
-
-static void edgeDelMesh(bor_mesh3_edge_t *_e, void *_)
-{
-    bor_chull3_edge_t *e;
-
-    e = bor_container_of(_e, bor_chull3_edge_t, m);
-    BOR_FREE(e);
+    borPoolFree(h->edges_pool, e);
 }
 
 static void edgeVertices(bor_chull3_edge_t *e, bor_chull3_vert_t **v)
@@ -287,13 +675,15 @@ static bor_chull3_face_t *faceNew(bor_chull3_t *h,
 {
     bor_chull3_face_t *f;
 
-    f = BOR_ALLOC(bor_chull3_face_t);
+    f = borPoolAlloc(h->faces_pool);
     if (borMesh3AddFace(h->mesh, &f->m, &e1->m, &e2->m, &e3->m) != 0){
         DBG("Can't add face, %d", (int)borMesh3VerticesLen(h->mesh));
         // borCHull3DumpSVT(h, stdout, "Can't face");
     }
 
     f->v[0] = f->v[1] = f->v[2] = NULL;
+    borListInit(&f->conflicts);
+    f->visible = 0;
 
     return f;
 }
@@ -301,15 +691,7 @@ static bor_chull3_face_t *faceNew(bor_chull3_t *h,
 static void faceDel(bor_chull3_t *h, bor_chull3_face_t *f)
 {
     borMesh3RemoveFace(h->mesh, &f->m);
-    BOR_FREE(f);
-}
-
-static void faceDelMesh(bor_mesh3_face_t *_f, void *_)
-{
-    bor_chull3_face_t *f;
-
-    f = bor_container_of(_f, bor_chull3_face_t, m);
-    BOR_FREE(f);
+    borPoolFree(h->faces_pool, f);
 }
 
 static void faceSetVertices(bor_chull3_t *h, bor_chull3_face_t *f,
@@ -634,11 +1016,12 @@ static void firstNonCoplanar(bor_chull3_t *h, const bor_vec3_t *point)
         }
     }
 
-    makeCone(h, &border_edges, point);
+    makeCone(h, &border_edges, point, NULL);
 }
 
 static void updateBorderEdges(bor_chull3_t *h, bor_chull3_face_t *f,
-                              bor_list_t *edges, bor_list_t *wrong_vertices)
+                              bor_list_t *edges, bor_list_t *wrong_vertices,
+                              bor_list_t *conflicts)
 {
     bor_chull3_edge_t *e[3];
     bor_chull3_vert_t *v[2];
@@ -675,6 +1058,8 @@ static void updateBorderEdges(bor_chull3_t *h, bor_chull3_face_t *f,
     }
 
     // delete face
+    if (conflicts)
+        borListMove(&f->conflicts, conflicts);
     faceDel(h, f);
 
     // delete edges and vertices that were left alone 
@@ -703,7 +1088,8 @@ static void updateBorderEdges(bor_chull3_t *h, bor_chull3_face_t *f,
 static void correctBorderEdges(bor_chull3_t *h, const bor_vec3_t *point,
                                bor_chull3_vert_t *v,
                                bor_list_t *edges,
-                               bor_list_t *wrong_vertices)
+                               bor_list_t *wrong_vertices,
+                               bor_list_t *conflicts)
 {
     bor_list_t *list, *item;
     bor_mesh3_edge_t *me;
@@ -733,18 +1119,16 @@ static void correctBorderEdges(bor_chull3_t *h, const bor_vec3_t *point,
         }
     }
 
-    updateBorderEdges(h, best_f, edges, wrong_vertices);
+    updateBorderEdges(h, best_f, edges, wrong_vertices, conflicts);
 }
 
 static void findBorderEdges(bor_chull3_t *h, const bor_vec3_t *point,
                             bor_list_t *edges)
 {
-    bor_list_t *list, *item, *itemtmp, wrong_vertices, faces;
+    bor_list_t *list, *item, *itemtmp, faces;
     bor_mesh3_face_t *mf;
     bor_chull3_face_t *f;
-    bor_chull3_vert_t *v;
 
-    borListInit(&wrong_vertices);
     borListInit(&faces);
 
     list = borMesh3Faces(h->mesh);
@@ -765,24 +1149,38 @@ static void findBorderEdges(bor_chull3_t *h, const bor_vec3_t *point,
         }
     }
 
-    while (!borListEmpty(&faces)){
-        item = borListNext(&faces);
+    borderEdges(h, point, &faces, edges, NULL);
+}
+
+static void borderEdges(bor_chull3_t *h, const bor_vec3_t *point,
+                        bor_list_t *faces, bor_list_t *edges,
+                        bor_list_t *conflicts)
+{
+    bor_list_t *item, wrong_vertices;
+    bor_chull3_face_t *f;
+    bor_chull3_vert_t *v;
+
+    borListInit(&wrong_vertices);
+
+    while (!borListEmpty(faces)){
+        item = borListNext(faces);
         borListDel(item);
         f = BOR_LIST_ENTRY(item, bor_chull3_face_t, list);
 
-        updateBorderEdges(h, f, edges, &wrong_vertices);
+        updateBorderEdges(h, f, edges, &wrong_vertices, conflicts);
     }
 
     while (!borListEmpty(&wrong_vertices)){
         item = borListNext(&wrong_vertices);
         v = BOR_LIST_ENTRY(item, bor_chull3_vert_t, list);
 
-        correctBorderEdges(h, point, v, edges, &wrong_vertices);
+        correctBorderEdges(h, point, v, edges, &wrong_vertices, conflicts);
     }
 }
 
 
-static void makeCone(bor_chull3_t *h, bor_list_t *edges, const bor_vec3_t *point)
+static void makeCone(bor_chull3_t *h, bor_list_t *edges, const bor_vec3_t *point,
+                     bor_list_t *new_faces)
 {
     bor_chull3_edge_t *e1, *e2, *e3;
     bor_chull3_vert_t *v[3];
@@ -823,5 +1221,567 @@ static void makeCone(bor_chull3_t *h, bor_list_t *edges, const bor_vec3_t *point
         }else{
             faceSetVertices(h, f, v[0], v[1], v[2]);
         }
+
+        if (new_faces)
+            borListAppend(new_faces, &f->list);
+    }
+}
+
+
+static int buildInitSimplex(const bor_vec3_t *points, size_t n,
+                            size_t *init)
+{
+    size_t min[3], max[3], i;
+    bor_vec3_t dir, u, cross;
+    bor_real_t best, d;
+    int a, axis;
+
+    if (n < 4)
+        return -1;
+
+    // extremal points along all axes
+    for (a = 0; a < 3; a++)
+        min[a] = max[a] = 0;
+    for (i = 1; i < n; i++){
+        for (a = 0; a < 3; a++){
+            if (borVec3Get(&points[i], a) < borVec3Get(&points[min[a]], a))
+                min[a] = i;
+            if (borVec3Get(&points[i], a) > borVec3Get(&points[max[a]], a))
+                max[a] = i;
+        }
+    }
+
+    // first two points are extremes along the longest axis
+    axis = 0;
+    best = -BOR_ONE;
+    for (a = 0; a < 3; a++){
+        d = borVec3Get(&points[max[a]], a) - borVec3Get(&points[min[a]], a);
+        if (d > best){
+            best = d;
+            axis = a;
+        }
+    }
+    init[0] = min[axis];
+    init[1] = max[axis];
+    if (borVec3Eq(&points[init[0]], &points[init[1]]))
+        return -1;
+
+    // third point is the farthest one from line
+    borVec3Sub2(&dir, &points[init[1]], &points[init[0]]);
+    best = -BOR_ONE;
+    init[2] = 0;
+    for (i = 0; i < n; i++){
+        borVec3Sub2(&u, &points[i], &points[init[0]]);
+        borVec3Cross(&cross, &dir, &u);
+        d = borVec3Len2(&cross);
+        if (d > best){
+            best = d;
+            init[2] = i;
+        }
+    }
+    if (borVec3Collinear(&points[init[0]], &points[init[1]],
+                         &points[init[2]]))
+        return -1;
+
+    // fourth point is the farthest one from plane
+    best = -BOR_ONE;
+    init[3] = 0;
+    for (i = 0; i < n; i++){
+        d = borVec3Volume6(&points[init[0]], &points[init[1]],
+                           &points[init[2]], &points[i]);
+        d = BOR_FABS(d);
+        if (d > best){
+            best = d;
+            init[3] = i;
+        }
+    }
+    if (borIsZero(best))
+        return -1;
+
+    return 0;
+}
+
+static int buildVisibleFaces(bor_chull3_t *h, const bor_vec3_t *point,
+                             bor_chull3_face_t *start, bor_list_t *faces)
+{
+    bor_list_t tested, *item;
+    bor_mesh3_face_t *mf;
+    bor_chull3_face_t *f, *g;
+    bor_chull3_edge_t *e[3];
+    int i, dup;
+
+    borListInit(&tested);
+    dup = 0;
+
+    // breadth first search over faces starting from conflicting face
+    start->visible = 1;
+    borListAppend(faces, &start->list);
+    BOR_LIST_FOR_EACH(faces, item){
+        f = BOR_LIST_ENTRY(item, bor_chull3_face_t, list);
+        faceEdges(f, e);
+
+        for (i = 0; i < 3; i++){
+            mf = borMesh3EdgeOtherFace(&e[i]->m, &f->m);
+            if (mf == NULL)
+                continue;
+            g = bor_container_of(mf, bor_chull3_face_t, m);
+            if (g->visible != 0)
+                continue;
+
+            if (isVisible(h, point, g)){
+                g->visible = 1;
+                borListAppend(faces, &g->list);
+            }else{
+                g->visible = -1;
+                borListAppend(&tested, &g->list);
+
+                if (borVec3Eq(point, &g->v[0]->v)
+                        || borVec3Eq(point, &g->v[1]->v)
+                        || borVec3Eq(point, &g->v[2]->v)){
+                    dup = 1;
+                }
+            }
+        }
+    }
+
+    // reset marks
+    BOR_LIST_FOR_EACH(&tested, item){
+        f = BOR_LIST_ENTRY(item, bor_chull3_face_t, list);
+        f->visible = 0;
+    }
+
+    if (dup){
+        BOR_LIST_FOR_EACH(faces, item){
+            f = BOR_LIST_ENTRY(item, bor_chull3_face_t, list);
+            f->visible = 0;
+        }
+        borListInit(faces);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void buildAddPoint(bor_chull3_t *h, bor_chull3_pt_t *pt)
+{
+    bor_list_t faces, border_edges, conflicts, new_faces;
+    bor_chull3_face_t *start;
+
+    start = pt->face;
+    borListDel(&pt->list);
+    pt->face = NULL;
+
+    borListInit(&faces);
+    if (buildVisibleFaces(h, pt->v, start, &faces) != 0)
+        return;
+
+    borListInit(&border_edges);
+    borListInit(&conflicts);
+    borderEdges(h, pt->v, &faces, &border_edges, &conflicts);
+
+    borListInit(&new_faces);
+    if (!borListEmpty(&border_edges))
+        makeCone(h, &border_edges, pt->v, &new_faces);
+
+    buildRedistribute(h, &conflicts, &new_faces);
+}
+
+static void buildRedistribute(bor_chull3_t *h, bor_list_t *conflicts,
+                              bor_list_t *new_faces)
+{
+    bor_list_t *item, *fitem;
+    bor_chull3_pt_t *pt;
+    bor_chull3_face_t *f;
+
+    // If a point sees any face of the new hull and it has seen some of
+    // the removed faces, it must see some face of the new cone.
+    // Otherwise the point is inside hull and is thrown away.
+    while (!borListEmpty(conflicts)){
+        item = borListNext(conflicts);
+        borListDel(item);
+        pt = BOR_LIST_ENTRY(item, bor_chull3_pt_t, list);
+        pt->face = NULL;
+
+        BOR_LIST_FOR_EACH(new_faces, fitem){
+            f = BOR_LIST_ENTRY(fitem, bor_chull3_face_t, list);
+            if (isVisible(h, pt->v, f)){
+                pt->face = f;
+                borListAppend(&f->conflicts, &pt->list);
+                break;
+            }
+        }
+    }
+}
+
+
+static int qhRun(qh_t *qh, qh_job_t *jobs, int type, size_t len,
+                 qh_part_t *part, const bor_vec3_t *a,
+                 const bor_vec3_t *b, const bor_vec3_t *c)
+{
+    size_t step;
+    int i, num;
+
+    num = qh->num_threads * QH_JOBS_PER_THREAD;
+    if ((len + QH_MIN_JOB - 1) / QH_MIN_JOB < (size_t)num)
+        num = (len + QH_MIN_JOB - 1) / QH_MIN_JOB;
+    if (num < 1)
+        num = 1;
+    step = (len + num - 1) / num;
+
+    for (i = 0; i < num; i++){
+        jobs[i].qh = qh;
+        jobs[i].part = part;
+        jobs[i].type = type;
+        jobs[i].from = BOR_MIN(step * i, len);
+        jobs[i].to = BOR_MIN(step * (i + 1), len);
+        jobs[i].a = a;
+        jobs[i].b = b;
+        jobs[i].c = c;
+    }
+
+    if (qh->tasks == NULL || num == 1){
+        for (i = 0; i < num; i++)
+            qhJob(i, jobs + i, NULL);
+    }else{
+        for (i = 0; i < num; i++)
+            borTasksAdd(qh->tasks, qhJob, i, jobs + i);
+        borTasksBarrier(qh->tasks);
+    }
+
+    return num;
+}
+
+static void qhJob(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    qh_job_t *job = (qh_job_t *)data;
+    const bor_vec3_t *pts = job->qh->pts;
+    qh_part_t *part = job->part;
+    const qh_face_t *f;
+    bor_vec3_t dir, u, cross;
+    bor_real_t val;
+    size_t i;
+    int a, fi;
+
+    job->best = job->from;
+    job->best_val = -BOR_ONE;
+
+    if (job->type == QH_JOB_EXTREMES){
+        for (a = 0; a < 3; a++)
+            job->min[a] = job->max[a] = job->from;
+        for (i = job->from; i < job->to; i++){
+            for (a = 0; a < 3; a++){
+                if (borVec3Get(&pts[i], a) < borVec3Get(&pts[job->min[a]], a))
+                    job->min[a] = i;
+                if (borVec3Get(&pts[i], a) > borVec3Get(&pts[job->max[a]], a))
+                    job->max[a] = i;
+            }
+        }
+
+    }else if (job->type == QH_JOB_FAR_LINE){
+        borVec3Sub2(&dir, job->b, job->a);
+        for (i = job->from; i < job->to; i++){
+            borVec3Sub2(&u, &pts[i], job->a);
+            borVec3Cross(&cross, &dir, &u);
+            val = borVec3Len2(&cross);
+            if (val > job->best_val){
+                job->best_val = val;
+                job->best = i;
+            }
+        }
+
+    }else if (job->type == QH_JOB_FAR_PLANE){
+        for (i = job->from; i < job->to; i++){
+            val = borVec3Volume6(job->a, job->b, job->c, &pts[i]);
+            val = BOR_FABS(val);
+            if (val > job->best_val){
+                job->best_val = val;
+                job->best = i;
+            }
+        }
+
+    }else if (job->type == QH_JOB_PARTITION){
+        for (i = job->from; i < job->to; i++){
+            part->asg[i] = -1;
+            for (fi = part->face_from[i]; fi < part->face_to[i]; fi++){
+                f = job->qh->faces + fi;
+                if (qhVisible(job->qh, f, part->point[i])){
+                    part->asg[i] = fi;
+                    part->dist[i] = borVec3Volume6(&pts[f->v[0]],
+                                                   &pts[f->v[1]],
+                                                   &pts[f->v[2]],
+                                                   &pts[part->point[i]]);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static int qhInitSimplex(qh_t *qh, qh_job_t *jobs, int *init)
+{
+    const bor_vec3_t *pts = qh->pts;
+    size_t min[3], max[3];
+    bor_real_t best, d, o;
+    int i, a, axis, num, tmp;
+
+    if (qh->n < 4)
+        return -1;
+
+    // extremal points along all axes
+    num = qhRun(qh, jobs, QH_JOB_EXTREMES, qh->n, NULL, NULL, NULL, NULL);
+    for (a = 0; a < 3; a++){
+        min[a] = jobs[0].min[a];
+        max[a] = jobs[0].max[a];
+        for (i = 1; i < num; i++){
+            if (borVec3Get(&pts[jobs[i].min[a]], a) < borVec3Get(&pts[min[a]], a))
+                min[a] = jobs[i].min[a];
+            if (borVec3Get(&pts[jobs[i].max[a]], a) > borVec3Get(&pts[max[a]], a))
+                max[a] = jobs[i].max[a];
+        }
+    }
+
+    // first two points are extremes along the longest axis
+    axis = 0;
+    best = -BOR_ONE;
+    for (a = 0; a < 3; a++){
+        d = borVec3Get(&pts[max[a]], a) - borVec3Get(&pts[min[a]], a);
+        if (d > best){
+            best = d;
+            axis = a;
+        }
+    }
+    init[0] = min[axis];
+    init[1] = max[axis];
+    if (borVec3Eq(&pts[init[0]], &pts[init[1]]))
+        return -1;
+
+    // third point is the farthest one from line
+    num = qhRun(qh, jobs, QH_JOB_FAR_LINE, qh->n, NULL,
+                &pts[init[0]], &pts[init[1]], NULL);
+    for (i = 1; i < num; i++){
+        if (jobs[i].best_val > jobs[0].best_val){
+            jobs[0].best_val = jobs[i].best_val;
+            jobs[0].best = jobs[i].best;
+        }
     }
+    init[2] = jobs[0].best;
+    if (jobs[0].best_val <= BOR_ZERO)
+        return -1;
+
+    // fourth point is the farthest one from plane
+    num = qhRun(qh, jobs, QH_JOB_FAR_PLANE, qh->n, NULL,
+                &pts[init[0]], &pts[init[1]], &pts[init[2]]);
+    for (i = 1; i < num; i++){
+        if (jobs[i].best_val > jobs[0].best_val){
+            jobs[0].best_val = jobs[i].best_val;
+            jobs[0].best = jobs[i].best;
+        }
+    }
+    init[3] = jobs[0].best;
+
+    o = borPredOrient3d(&qh->pred, &pts[init[0]], &pts[init[1]],
+                        &pts[init[2]], &pts[init[3]]);
+    if (o == BOR_ZERO)
+        return -1;
+    if (o > BOR_ZERO){
+        // fourth point must be below the first face
+        BOR_SWAP(init[1], init[2], tmp);
+    }
+
+    return 0;
+}
+
+static int qhFaceNew(qh_t *qh, int v0, int v1, int v2)
+{
+    qh_face_t *f;
+
+    if (qh->faces_len == qh->faces_size){
+        qh->faces_size = BOR_MAX(2 * qh->faces_size, 16);
+        qh->faces = BOR_REALLOC_ARR(qh->faces, qh_face_t, qh->faces_size);
+    }
+
+    f = qh->faces + qh->faces_len;
+    f->v[0] = v0;
+    f->v[1] = v1;
+    f->v[2] = v2;
+    f->adj[0] = f->adj[1] = f->adj[2] = -1;
+    f->out = NULL;
+    f->out_len = f->out_size = 0;
+    f->far = -1;
+    f->far_dist = -BOR_ONE;
+    f->alive = 1;
+    f->visit = 0;
+    f->claim = 0;
+
+    return qh->faces_len++;
+}
+
+static void qhFaceAddOut(qh_t *qh, int fi, int p, bor_real_t dist)
+{
+    qh_face_t *f = qh->faces + fi;
+
+    if (f->out_len == f->out_size){
+        f->out_size = BOR_MAX(2 * f->out_size, 8);
+        f->out = BOR_REALLOC_ARR(f->out, int, f->out_size);
+    }
+    f->out[f->out_len++] = p;
+
+    if (dist > f->far_dist){
+        f->far_dist = dist;
+        f->far = p;
+    }
+}
+
+_bor_inline int qhVisible(const qh_t *qh, const qh_face_t *f, int p)
+{
+    return borPredOrient3d(&qh->pred, &qh->pts[f->v[0]], &qh->pts[f->v[1]],
+                           &qh->pts[f->v[2]], &qh->pts[p]) > BOR_ZERO;
+}
+
+static void qhPartition(qh_t *qh, qh_job_t *jobs, qh_part_t *part)
+{
+    size_t i;
+
+    if (part->len == 0)
+        return;
+
+    qhRun(qh, jobs, QH_JOB_PARTITION, part->len, part, NULL, NULL, NULL);
+
+    for (i = 0; i < part->len; i++){
+        if (part->asg[i] >= 0)
+            qhFaceAddOut(qh, part->asg[i], part->point[i], part->dist[i]);
+    }
+}
+
+static void qhPartAdd(qh_part_t *part, int p, int face_from, int face_to)
+{
+    if (part->len == part->size){
+        part->size = BOR_MAX(2 * part->size, 1024);
+        part->point = BOR_REALLOC_ARR(part->point, int, part->size);
+        part->face_from = BOR_REALLOC_ARR(part->face_from, int, part->size);
+        part->face_to = BOR_REALLOC_ARR(part->face_to, int, part->size);
+        part->asg = BOR_REALLOC_ARR(part->asg, int, part->size);
+        part->dist = BOR_REALLOC_ARR(part->dist, bor_real_t, part->size);
+    }
+
+    part->point[part->len] = p;
+    part->face_from[part->len] = face_from;
+    part->face_to[part->len] = face_to;
+    part->len++;
+}
+
+static void qhAddApex(qh_t *qh, int apex, int *vis, int vis_len,
+                      int *hmap, qh_part_t *part)
+{
+    qh_face_t *f, *g;
+    int faces_from, i, j, k, a, b, fi, gi, nf;
+
+    faces_from = qh->faces_len;
+
+    for (i = 0; i < vis_len; i++)
+        qh->faces[vis[i]].alive = 0;
+
+    // connect apex with horizon edges keeping orientation of removed
+    // faces, i.e., face (a, b, apex) replaces removed face (a, b, c)
+    for (i = 0; i < vis_len; i++){
+        for (k = 0; k < 3; k++){
+            fi = vis[i];
+            gi = qh->faces[fi].adj[k];
+            if (!qh->faces[gi].alive)
+                continue;
+
+            a = qh->faces[fi].v[k];
+            b = qh->faces[fi].v[(k + 1) % 3];
+            nf = qhFaceNew(qh, a, b, apex);
+
+            g = qh->faces + gi;
+            for (j = 0; j < 3; j++){
+                if (g->v[j] == b && g->v[(j + 1) % 3] == a)
+                    g->adj[j] = nf;
+            }
+            qh->faces[nf].adj[0] = gi;
+            hmap[a] = nf;
+        }
+    }
+
+    // connect new faces between themselves: edge (b, apex) of face
+    // (a, b, apex) is shared with face (b, x, apex)
+    for (nf = faces_from; nf < qh->faces_len; nf++){
+        f = qh->faces + nf;
+        f->adj[1] = hmap[f->v[1]];
+        qh->faces[f->adj[1]].adj[2] = nf;
+    }
+    for (nf = faces_from; nf < qh->faces_len; nf++)
+        hmap[qh->faces[nf].v[0]] = -1;
+
+    // points of removed faces will be partitioned to the new faces
+    for (i = 0; i < vis_len; i++){
+        f = qh->faces + vis[i];
+        for (j = 0; j < f->out_len; j++){
+            if (f->out[j] != apex)
+                qhPartAdd(part, f->out[j], faces_from, qh->faces_len);
+        }
+
+        if (f->out)
+            BOR_FREE(f->out);
+        f->out = NULL;
+        f->out_len = f->out_size = 0;
+    }
+}
+
+static void qhToCHull(qh_t *qh, bor_chull3_t *h)
+{
+    bor_chull3_vert_t **verts;
+    bor_chull3_edge_t **edges;
+    bor_chull3_face_t *face;
+    qh_face_t *f, *g;
+    int i, j, k;
+
+    verts = BOR_CALLOC_ARR(bor_chull3_vert_t *, qh->n);
+    edges = BOR_ALLOC_ARR(bor_chull3_edge_t *, 3 * qh->faces_len);
+
+    for (i = 0; i < qh->faces_len; i++){
+        f = qh->faces + i;
+        if (!f->alive)
+            continue;
+
+        for (k = 0; k < 3; k++){
+            if (verts[f->v[k]] == NULL)
+                verts[f->v[k]] = vertNew(h, &qh->pts[f->v[k]]);
+        }
+    }
+
+    for (i = 0; i < qh->faces_len; i++){
+        f = qh->faces + i;
+        if (!f->alive)
+            continue;
+
+        for (k = 0; k < 3; k++){
+            if (f->adj[k] < i)
+                continue;
+
+            edges[3 * i + k] = edgeNew(h, verts[f->v[k]],
+                                       verts[f->v[(k + 1) % 3]]);
+            g = qh->faces + f->adj[k];
+            for (j = 0; j < 3; j++){
+                if (g->v[j] == f->v[(k + 1) % 3] && g->v[(j + 1) % 3] == f->v[k])
+                    edges[3 * f->adj[k] + j] = edges[3 * i + k];
+            }
+        }
+    }
+
+    for (i = 0; i < qh->faces_len; i++){
+        f = qh->faces + i;
+        if (!f->alive)
+            continue;
+
+        face = faceNew(h, edges[3 * i], edges[3 * i + 1], edges[3 * i + 2]);
+        faceSetVertices(h, face, verts[f->v[0]], verts[f->v[1]],
+                        verts[f->v[2]]);
+    }
+
+    h->coplanar = 0;
+
+    BOR_FREE(verts);
+    BOR_FREE(edges);
 }
@@ -0,0 +1,208 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+
+#include <boruvka/alloc.h>
+#include <boruvka/dheap.h>
+
+/** Initial number of elements */
+#define DHEAP_INIT_SIZE 64
+
+/** Alignment of groups of children */
+#define DHEAP_ALIGN 64
+
+/** Index of the first child of i'th element */
+#define CHILD(h, i) (((i) << (h)->shift) + 1)
+/** Index of the parent of i'th element */
+#define PARENT(h, i) (((i) - 1) >> (h)->shift)
+
+/** Resizes array of elements */
+static void dheapResize(bor_dheap_t *h, int alloc);
+/** Moves element from position {i} towards the root */
+static void siftUp(bor_dheap_t *h, int i);
+/** Moves element from position {i} towards leaves */
+static void siftDown(bor_dheap_t *h, int i);
+
+bor_dheap_t *borDHeapNew(int d)
+{
+    bor_dheap_t *h;
+
+    h = BOR_ALLOC(bor_dheap_t);
+    if (d == 2){
+        h->shift = 1;
+    }else if (d == 8){
+        h->shift = 3;
+    }else{
+        h->shift = 2;
+    }
+
+    h->el = h->mem = NULL;
+    h->size = h->alloc = 0;
+    dheapResize(h, DHEAP_INIT_SIZE);
+    return h;
+}
+
+void borDHeapDel(bor_dheap_t *h)
+{
+    BOR_FREE(h->mem);
+    BOR_FREE(h);
+}
+
+void borDHeapAdd(bor_dheap_t *h, bor_dheap_node_t *n, bor_real_t key)
+{
+    if (h->size == h->alloc)
+        dheapResize(h, 2 * h->alloc);
+
+    h->el[h->size].key = key;
+    h->el[h->size].node = n;
+    n->pos = h->size++;
+    siftUp(h, n->pos);
+}
+
+bor_dheap_node_t *borDHeapExtractMin(bor_dheap_t *h, bor_real_t *key)
+{
+    bor_dheap_node_t *n;
+
+    if (h->size == 0)
+        return NULL;
+
+    n = h->el[0].node;
+    if (key)
+        *key = h->el[0].key;
+    n->pos = -1;
+
+    if (--h->size > 0){
+        h->el[0] = h->el[h->size];
+        h->el[0].node->pos = 0;
+        siftDown(h, 0);
+    }
+    return n;
+}
+
+void borDHeapDecreaseKey(bor_dheap_t *h, bor_dheap_node_t *n,
+                         bor_real_t key)
+{
+    h->el[n->pos].key = key;
+    siftUp(h, n->pos);
+}
+
+void borDHeapUpdate(bor_dheap_t *h, bor_dheap_node_t *n, bor_real_t key)
+{
+    bor_real_t old = h->el[n->pos].key;
+
+    h->el[n->pos].key = key;
+    if (key < old){
+        siftUp(h, n->pos);
+    }else{
+        siftDown(h, n->pos);
+    }
+}
+
+void borDHeapRemove(bor_dheap_t *h, bor_dheap_node_t *n)
+{
+    int i = n->pos;
+    bor_real_t old;
+
+    n->pos = -1;
+    if (i == --h->size)
+        return;
+
+    old = h->el[i].key;
+    h->el[i] = h->el[h->size];
+    h->el[i].node->pos = i;
+    if (h->el[i].key < old){
+        siftUp(h, i);
+    }else{
+        siftDown(h, i);
+    }
+}
+
+void borDHeapClear(bor_dheap_t *h, bor_dheap_clear clear_fn,
+                   void *user_data)
+{
+    int i;
+
+    for (i = 0; i < h->size; ++i){
+        h->el[i].node->pos = -1;
+        if (clear_fn)
+            clear_fn(h->el[i].node, user_data);
+    }
+    h->size = 0;
+}
+
+
+static void dheapResize(bor_dheap_t *h, int alloc)
+{
+    bor_dheap_el_t *mem;
+    int off;
+
+    /* Children of i'th element start at (i << shift) + 1, so the array
+     * is shifted by d - 1 elements to align each group of children. */
+    off = (1 << h->shift) - 1;
+    mem = BOR_ALLOC_ALIGN_ARR(bor_dheap_el_t, alloc + off, DHEAP_ALIGN);
+    if (h->size > 0)
+        memcpy(mem + off, h->el, sizeof(bor_dheap_el_t) * h->size);
+    if (h->mem)
+        BOR_FREE(h->mem);
+
+    h->mem = mem;
+    h->el = mem + off;
+    h->alloc = alloc;
+}
+
+static void siftUp(bor_dheap_t *h, int i)
+{
+    bor_dheap_el_t el = h->el[i];
+    int parent;
+
+    while (i > 0){
+        parent = PARENT(h, i);
+        if (!(el.key < h->el[parent].key))
+            break;
+        h->el[i] = h->el[parent];
+        h->el[i].node->pos = i;
+        i = parent;
+    }
+    h->el[i] = el;
+    el.node->pos = i;
+}
+
+static void siftDown(bor_dheap_t *h, int i)
+{
+    bor_dheap_el_t el = h->el[i];
+    int child, end, min, d = 1 << h->shift;
+
+    for (;;){
+        child = CHILD(h, i);
+        if (child >= h->size)
+            break;
+
+        end = BOR_MIN(child + d, h->size);
+        min = child;
+        for (++child; child < end; ++child){
+            if (h->el[child].key < h->el[min].key)
+                min = child;
+        }
+
+        if (!(h->el[min].key < el.key))
+            break;
+        h->el[i] = h->el[min];
+        h->el[i].node->pos = i;
+        i = min;
+    }
+    h->el[i] = el;
+    el.node->pos = i;
+}
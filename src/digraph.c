@@ -144,6 +144,244 @@ void borDigraphInduce(bor_digraph_t *dst,
 }
 
 
+static void frozenAlloc(bor_digraph_frozen_t *fg, int node_size,
+                        int edge_size, int node_label_size,
+                        int edge_label_size)
+{
+    long size;
+    int *p;
+
+    fg->node_size = node_size;
+    fg->edge_size = edge_size;
+    size = 4L * node_size + 3 + 8L * edge_size + 1
+            + node_label_size + edge_label_size;
+    p = fg->buf = BOR_ALLOC_ARR(int, size);
+
+    fg->out_start = p;
+    p += node_size + 1;
+    fg->in_start = p;
+    p += node_size + 1;
+    fg->node_label_start = p;
+    p += node_size + 1;
+    fg->node_color = p;
+    p += node_size;
+    fg->out_node = p;
+    p += edge_size;
+    fg->out_edge = p;
+    p += edge_size;
+    fg->in_node = p;
+    p += edge_size;
+    fg->in_edge = p;
+    p += edge_size;
+    fg->edge_from = p;
+    p += edge_size;
+    fg->edge_to = p;
+    p += edge_size;
+    fg->edge_color = p;
+    p += edge_size;
+    fg->edge_label_start = p;
+    p += edge_size + 1;
+    fg->node_label = p;
+    p += node_label_size;
+    fg->edge_label = p;
+}
+
+/** Fills CSR and CSC arrays from .edge_from and .edge_to */
+static void frozenBuildAdj(bor_digraph_frozen_t *fg)
+{
+    int i, e, pos;
+
+    bzero(fg->out_start, sizeof(int) * (fg->node_size + 1));
+    bzero(fg->in_start, sizeof(int) * (fg->node_size + 1));
+    for (e = 0; e < fg->edge_size; ++e){
+        ++fg->out_start[fg->edge_from[e] + 1];
+        ++fg->in_start[fg->edge_to[e] + 1];
+    }
+    for (i = 0; i < fg->node_size; ++i){
+        fg->out_start[i + 1] += fg->out_start[i];
+        fg->in_start[i + 1] += fg->in_start[i];
+    }
+
+    // Edges are traversed in order of IDs, so each node's out-edges and
+    // in-edges end up sorted. Starts are shifted during filling and
+    // restored at the end.
+    for (e = 0; e < fg->edge_size; ++e){
+        pos = fg->out_start[fg->edge_from[e]]++;
+        fg->out_node[pos] = fg->edge_to[e];
+        fg->out_edge[pos] = e;
+        pos = fg->in_start[fg->edge_to[e]]++;
+        fg->in_node[pos] = fg->edge_from[e];
+        fg->in_edge[pos] = e;
+    }
+    for (i = fg->node_size; i > 0; --i){
+        fg->out_start[i] = fg->out_start[i - 1];
+        fg->in_start[i] = fg->in_start[i - 1];
+    }
+    fg->out_start[0] = fg->in_start[0] = 0;
+}
+
+void borDigraphFreeze(bor_digraph_frozen_t *fg, const bor_digraph_t *g)
+{
+    int i, nlabel = 0, elabel = 0;
+
+    for (i = 0; i < g->node_size; ++i)
+        nlabel += borISetSize(&g->node[i].label);
+    for (i = 0; i < g->edge_size; ++i)
+        elabel += borISetSize(&g->edge[i].label);
+    frozenAlloc(fg, g->node_size, g->edge_size, nlabel, elabel);
+
+    fg->node_label_start[0] = 0;
+    for (i = 0; i < g->node_size; ++i){
+        const bor_iset_t *label = &g->node[i].label;
+        fg->node_color[i] = g->node[i].color;
+        memcpy(fg->node_label + fg->node_label_start[i], label->s,
+               sizeof(int) * label->size);
+        fg->node_label_start[i + 1] = fg->node_label_start[i] + label->size;
+    }
+
+    fg->edge_label_start[0] = 0;
+    for (i = 0; i < g->edge_size; ++i){
+        const bor_iset_t *label = &g->edge[i].label;
+        fg->edge_from[i] = g->edge[i].from;
+        fg->edge_to[i] = g->edge[i].to;
+        fg->edge_color[i] = g->edge[i].color;
+        memcpy(fg->edge_label + fg->edge_label_start[i], label->s,
+               sizeof(int) * label->size);
+        fg->edge_label_start[i + 1] = fg->edge_label_start[i] + label->size;
+    }
+
+    frozenBuildAdj(fg);
+}
+
+void borDigraphFrozenFree(bor_digraph_frozen_t *fg)
+{
+    BOR_FREE(fg->buf);
+}
+
+/** Returns read-only set over the packed array */
+_bor_inline bor_iset_t isetView(const int *s, int size)
+{
+    bor_iset_t set = { (int *)s, size, size };
+    return set;
+}
+
+void borDigraphThaw(bor_digraph_t *g, const bor_digraph_frozen_t *fg)
+{
+    bor_iset_t label;
+    const int *s;
+    int i, size;
+
+    borDigraphInit(g);
+    for (i = 0; i < fg->node_size; ++i){
+        borDigraphAddNode(g);
+        size = borDigraphFrozenNodeLabel(fg, i, &s);
+        label = isetView(s, size);
+        borISetSet(&g->node[i].label, &label);
+        g->node[i].color = fg->node_color[i];
+    }
+
+    for (i = 0; i < fg->edge_size; ++i){
+        borDigraphAddEdge(g, fg->edge_from[i], fg->edge_to[i]);
+        size = borDigraphFrozenEdgeLabel(fg, i, &s);
+        label = isetView(s, size);
+        borISetSet(&g->edge[i].label, &label);
+        g->edge[i].color = fg->edge_color[i];
+    }
+}
+
+void borDigraphFrozenInduce(bor_digraph_frozen_t *dst,
+                            const bor_digraph_frozen_t *g,
+                            const bor_iset_t *nodes,
+                            const bor_iset_t *edges)
+{
+    int *node_map, *edge_map, *node_rmap; // mappings between g and dst
+    char *edge_in;
+    int node, edge, node_size, edge_size, nlabel, elabel;
+    int i, e, len;
+
+    node_map = BOR_ALLOC_ARR(int, g->node_size + g->edge_size);
+    edge_map = node_map + g->node_size;
+    node_rmap = BOR_ALLOC_ARR(int, g->node_size);
+    for (i = 0; i < g->node_size; ++i)
+        node_map[i] = -1;
+
+    // Create nodes in the same order as borDigraphInduce()
+    node_size = 0;
+    if (nodes != NULL){
+        BOR_ISET_FOR_EACH(nodes, node){
+            node_rmap[node_size] = node;
+            node_map[node] = node_size++;
+        }
+    }else{
+        BOR_ISET_FOR_EACH(edges, edge){
+            if (node_map[g->edge_from[edge]] == -1){
+                node_rmap[node_size] = g->edge_from[edge];
+                node_map[g->edge_from[edge]] = node_size++;
+            }
+            if (node_map[g->edge_to[edge]] == -1){
+                node_rmap[node_size] = g->edge_to[edge];
+                node_map[g->edge_to[edge]] = node_size++;
+            }
+        }
+    }
+
+    edge_in = NULL;
+    if (edges != NULL){
+        edge_in = BOR_CALLOC_ARR(char, BOR_MAX(g->edge_size, 1));
+        BOR_ISET_FOR_EACH(edges, edge)
+            edge_in[edge] = 1;
+    }
+
+    edge_size = 0;
+    elabel = 0;
+    for (e = 0; e < g->edge_size; ++e){
+        edge_map[e] = -1;
+        if (edge_in != NULL && !edge_in[e])
+            continue;
+        if (node_map[g->edge_from[e]] >= 0 && node_map[g->edge_to[e]] >= 0){
+            edge_map[e] = edge_size++;
+            elabel += g->edge_label_start[e + 1] - g->edge_label_start[e];
+        }
+    }
+
+    nlabel = 0;
+    for (i = 0; i < node_size; ++i){
+        node = node_rmap[i];
+        nlabel += g->node_label_start[node + 1] - g->node_label_start[node];
+    }
+
+    frozenAlloc(dst, node_size, edge_size, nlabel, elabel);
+    dst->node_label_start[0] = 0;
+    for (i = 0; i < node_size; ++i){
+        node = node_rmap[i];
+        len = g->node_label_start[node + 1] - g->node_label_start[node];
+        memcpy(dst->node_label + dst->node_label_start[i],
+               g->node_label + g->node_label_start[node], sizeof(int) * len);
+        dst->node_label_start[i + 1] = dst->node_label_start[i] + len;
+        dst->node_color[i] = g->node_color[node];
+    }
+
+    dst->edge_label_start[0] = 0;
+    for (e = 0; e < g->edge_size; ++e){
+        if ((i = edge_map[e]) < 0)
+            continue;
+        dst->edge_from[i] = node_map[g->edge_from[e]];
+        dst->edge_to[i] = node_map[g->edge_to[e]];
+        dst->edge_color[i] = g->edge_color[e];
+        len = g->edge_label_start[e + 1] - g->edge_label_start[e];
+        memcpy(dst->edge_label + dst->edge_label_start[i],
+               g->edge_label + g->edge_label_start[e], sizeof(int) * len);
+        dst->edge_label_start[i + 1] = dst->edge_label_start[i] + len;
+    }
+    frozenBuildAdj(dst);
+
+    if (edge_in != NULL)
+        BOR_FREE(edge_in);
+    BOR_FREE(node_rmap);
+    BOR_FREE(node_map);
+}
+
+
 struct scc_dfs {
     int cur_index;
     int *index;
@@ -151,6 +389,9 @@ struct scc_dfs {
     int *in_stack;
     int *stack;
     int stack_size;
+    int *call;      /*!< Stack of nodes replacing recursion */
+    int *call_pos;  /*!< Position of the next out-edge of each node */
+    int call_size;
 };
 typedef struct scc_dfs scc_dfs_t;
 
@@ -178,47 +419,70 @@ static void sccTarjanExtract(bor_digraph_t *scc, int *scc_node_map,
     dfs->stack_size = i;
 }
 
-static void sccTarjanStrongconnect(bor_digraph_t *scc, int *scc_node_map,
-                                   const bor_digraph_t *g,
-                                   scc_dfs_t *dfs, int nid)
+_bor_inline void sccTarjanVisit(const bor_digraph_frozen_t *g,
+                                scc_dfs_t *dfs, int nid)
 {
-    int w, edge_id;
-    const bor_digraph_node_t *node = g->node + nid;
-
     dfs->index[nid] = dfs->lowlink[nid] = dfs->cur_index++;
     dfs->stack[dfs->stack_size++] = nid;
     dfs->in_stack[nid] = 1;
+    dfs->call[dfs->call_size] = nid;
+    dfs->call_pos[dfs->call_size++] = g->out_start[nid];
+}
 
-    BOR_ISET_FOR_EACH(&node->out, edge_id){
-        w = g->edge[edge_id].to;
-        if (dfs->index[w] == -1){
-            sccTarjanStrongconnect(scc, scc_node_map, g, dfs, w);
-            dfs->lowlink[nid] = BOR_MIN(dfs->lowlink[nid], dfs->lowlink[w]);
-        }else if (dfs->in_stack[w]){
-            dfs->lowlink[nid] = BOR_MIN(dfs->lowlink[nid], dfs->lowlink[w]);
+static void sccTarjanStrongconnect(bor_digraph_t *scc, int *scc_node_map,
+                                   const bor_digraph_frozen_t *g,
+                                   scc_dfs_t *dfs, int nid)
+{
+    int w, top, parent;
+
+    sccTarjanVisit(g, dfs, nid);
+    while (dfs->call_size > 0){
+        top = dfs->call_size - 1;
+        nid = dfs->call[top];
+
+        if (dfs->call_pos[top] < g->out_start[nid + 1]){
+            w = g->out_node[dfs->call_pos[top]++];
+            if (dfs->index[w] == -1){
+                sccTarjanVisit(g, dfs, w);
+            }else if (dfs->in_stack[w]){
+                dfs->lowlink[nid] = BOR_MIN(dfs->lowlink[nid],
+                                            dfs->lowlink[w]);
+            }
+            continue;
         }
-    }
 
-    if (dfs->index[nid] == dfs->lowlink[nid])
-        sccTarjanExtract(scc, scc_node_map, dfs, nid);
+        --dfs->call_size;
+        if (dfs->index[nid] == dfs->lowlink[nid])
+            sccTarjanExtract(scc, scc_node_map, dfs, nid);
+        if (dfs->call_size > 0){
+            parent = dfs->call[dfs->call_size - 1];
+            dfs->lowlink[parent] = BOR_MIN(dfs->lowlink[parent],
+                                           dfs->lowlink[nid]);
+        }
+    }
 }
 
 static void sccAddEdges(bor_digraph_t *scc, const int *scc_node_map,
-                        const bor_digraph_t *g)
+                        const bor_digraph_frozen_t *g)
 {
+    bor_iset_t label;
+    const int *s;
+    int size;
+
     for (int i = 0; i < g->edge_size; ++i){
-        const bor_digraph_edge_t *edge = g->edge + i;
-        int f = scc_node_map[edge->from];
-        int t = scc_node_map[edge->to];
+        int f = scc_node_map[g->edge_from[i]];
+        int t = scc_node_map[g->edge_to[i]];
         if (f != t){
             int e = borDigraphGetOrAddEdge(scc, f, t);
             bor_digraph_edge_t *dst = scc->edge + e;
-            borISetUnion(&dst->label, &edge->label);
+            size = borDigraphFrozenEdgeLabel(g, i, &s);
+            label = isetView(s, size);
+            borISetUnion(&dst->label, &label);
         }
     }
 }
 
-void borDigraphSCC(bor_digraph_t *scc, const bor_digraph_t *g)
+void borDigraphFrozenSCC(bor_digraph_t *scc, const bor_digraph_frozen_t *g)
 {
     scc_dfs_t dfs;
     int *scc_node_map;
@@ -227,11 +491,14 @@ void borDigraphSCC(bor_digraph_t *scc, const bor_digraph_t *g)
 
     // Initialize structure for Tarjan's algorithm
     dfs.cur_index = 0;
-    dfs.index    = BOR_ALLOC_ARR(int, 4 * g->node_size);
+    dfs.index    = BOR_ALLOC_ARR(int, 6 * g->node_size);
     dfs.lowlink  = dfs.index + g->node_size;
     dfs.in_stack = dfs.lowlink + g->node_size;
     dfs.stack    = dfs.in_stack + g->node_size;
+    dfs.call     = dfs.stack + g->node_size;
+    dfs.call_pos = dfs.call + g->node_size;
     dfs.stack_size = 0;
+    dfs.call_size = 0;
     for (int i = 0; i < g->node_size; ++i){
         dfs.index[i] = dfs.lowlink[i] = -1;
         dfs.in_stack[i] = 0;
@@ -256,32 +523,112 @@ void borDigraphSCC(bor_digraph_t *scc, const bor_digraph_t *g)
     BOR_FREE(dfs.index);
 }
 
-static void dfs(const bor_digraph_t *g, int from, const bor_iset_t *ignore,
-                int *visited)
+void borDigraphSCC(bor_digraph_t *scc, const bor_digraph_t *g)
 {
-    int edge_id;
-    const bor_digraph_node_t *node = g->node + from;
+    bor_digraph_frozen_t fg;
 
-    visited[from] = 1;
-    BOR_ISET_FOR_EACH(&node->out, edge_id){
-        const bor_digraph_edge_t *edge = g->edge + edge_id;
-        if (ignore != NULL && borISetIn(edge->to, ignore))
-            continue;
-        if (!visited[edge->to])
-            dfs(g, edge->to, ignore, visited);
-    }
+    borDigraphFreeze(&fg, g);
+    borDigraphFrozenSCC(scc, &fg);
+    borDigraphFrozenFree(&fg);
 }
 
 void borDigraphDFS(const bor_digraph_t *g, const bor_iset_t *from_nodes,
                    const bor_iset_t *ignore, int *visited)
 {
-    int node_id;
+    int *stack, stack_size, node_id, edge_id, to;
 
     bzero(visited, sizeof(int) * g->node_size);
+    stack = BOR_ALLOC_ARR(int, BOR_MAX(g->node_size, 1));
     BOR_ISET_FOR_EACH(from_nodes, node_id){
-        if (!visited[node_id])
-            dfs(g, node_id, ignore, visited);
+        if (visited[node_id])
+            continue;
+
+        visited[node_id] = 1;
+        stack[0] = node_id;
+        stack_size = 1;
+        while (stack_size > 0){
+            const bor_digraph_node_t *node = g->node + stack[--stack_size];
+            BOR_ISET_FOR_EACH(&node->out, edge_id){
+                to = g->edge[edge_id].to;
+                if (visited[to]
+                        || (ignore != NULL && borISetIn(to, ignore)))
+                    continue;
+                visited[to] = 1;
+                stack[stack_size++] = to;
+            }
+        }
     }
+    BOR_FREE(stack);
+}
+
+void borDigraphFrozenDFS(const bor_digraph_frozen_t *g,
+                         const bor_iset_t *from_nodes,
+                         const bor_iset_t *ignore, int *visited)
+{
+    int *stack, stack_size, node_id, node, i;
+
+    // Ignored nodes are marked as visited with a value that is cleared
+    // at the end unless they were expanded as starting nodes
+    bzero(visited, sizeof(int) * g->node_size);
+    if (ignore != NULL){
+        BOR_ISET_FOR_EACH(ignore, node_id)
+            visited[node_id] = -1;
+    }
+
+    stack = BOR_ALLOC_ARR(int, BOR_MAX(g->node_size, 1));
+    BOR_ISET_FOR_EACH(from_nodes, node_id){
+        if (visited[node_id] > 0)
+            continue;
+
+        visited[node_id] = 1;
+        stack[0] = node_id;
+        stack_size = 1;
+        while (stack_size > 0){
+            node = stack[--stack_size];
+            for (i = g->out_start[node]; i < g->out_start[node + 1]; ++i){
+                if (visited[g->out_node[i]] == 0){
+                    visited[g->out_node[i]] = 1;
+                    stack[stack_size++] = g->out_node[i];
+                }
+            }
+        }
+    }
+    BOR_FREE(stack);
+
+    if (ignore != NULL){
+        BOR_ISET_FOR_EACH(ignore, node_id){
+            if (visited[node_id] < 0)
+                visited[node_id] = 0;
+        }
+    }
+}
+
+int borDigraphFrozenBFS(const bor_digraph_frozen_t *g, int src, int *dist)
+{
+    int *queue, head, tail, node, i, to;
+
+    for (i = 0; i < g->node_size; ++i)
+        dist[i] = -1;
+    if (src < 0 || src >= g->node_size)
+        return 0;
+
+    queue = BOR_ALLOC_ARR(int, g->node_size);
+    head = tail = 0;
+    queue[tail++] = src;
+    dist[src] = 0;
+    while (head < tail){
+        node = queue[head++];
+        for (i = g->out_start[node]; i < g->out_start[node + 1]; ++i){
+            to = g->out_node[i];
+            if (dist[to] < 0){
+                dist[to] = dist[node] + 1;
+                queue[tail++] = to;
+            }
+        }
+    }
+    BOR_FREE(queue);
+
+    return tail;
 }
 
 void borDigraphPrintDebug(const bor_digraph_t *g, FILE *fout)
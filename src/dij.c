@@ -22,6 +22,17 @@
 static int heapLT(const bor_pairheap_node_t *n1,
                   const bor_pairheap_node_t *n2,
                   void *_);
+/** Compares two nodes of backward search */
+static int bheapLT(const bor_pairheap_node_t *n1,
+                   const bor_pairheap_node_t *n2,
+                   void *_);
+/** Closes the minimal node of forward search and relaxes its successors,
+ *  the best path found so far is updated in {mu} and {meet} */
+static void bidirForward(bor_dij_t *dij, bor_real_t *mu,
+                         bor_dij_node_t **meet);
+/** The same as bidirForward() in the opposite direction */
+static void bidirBackward(bor_dij_t *dij, bor_real_t *mu,
+                          bor_dij_node_t **meet);
 
 bor_dij_t *borDijNew(const bor_dij_ops_t *ops)
 {
@@ -31,6 +42,8 @@ bor_dij_t *borDijNew(const bor_dij_ops_t *ops)
     dij->ops   = *ops;
 
     dij->heap = NULL;
+    dij->bheap = NULL;
+    dij->settled = 0;
 
     return dij;
 }
@@ -39,6 +52,8 @@ void borDijDel(bor_dij_t *dij)
 {
     if (dij->heap)
         borPairHeapDel(dij->heap);
+    if (dij->bheap)
+        borPairHeapDel(dij->bheap);
     BOR_FREE(dij);
 }
 
@@ -60,7 +75,12 @@ int borDijRun(bor_dij_t *dij, bor_dij_node_t *start,
     start->dist = BOR_ZERO;
     start->prev = NULL;
     start->state = BOR_DIJ_STATE_OPEN;
+    start->_heur = BOR_ZERO;
+    if (dij->ops.heuristic)
+        start->_heur = dij->ops.heuristic(start, end, dij->ops.data);
+    start->_key = start->_heur;
     borPairHeapAdd(dij->heap, &start->_heap);
+    dij->settled = 0;
 
     // run algorithm
     while (!borPairHeapEmpty(dij->heap)){
@@ -70,6 +90,7 @@ int borDijRun(bor_dij_t *dij, bor_dij_node_t *start,
 
         // set state to CLOSED
         node->state = BOR_DIJ_STATE_CLOSED;
+        ++dij->settled;
 
         // we found end point - terminate algorithm
         if (node == end)
@@ -104,8 +125,16 @@ int borDijRun(bor_dij_t *dij, bor_dij_node_t *start,
                 // and update its position in heap or add it on heap if it
                 // is not already on heap
                 if (nextnode->state == BOR_DIJ_STATE_OPEN){
+                    nextnode->_key = dist + nextnode->_heur;
                     borPairHeapDecreaseKey(dij->heap, &nextnode->_heap);
                 }else{
+                    // heuristic is computed only once per node
+                    nextnode->_heur = BOR_ZERO;
+                    if (dij->ops.heuristic){
+                        nextnode->_heur = dij->ops.heuristic(nextnode, end,
+                                                             dij->ops.data);
+                    }
+                    nextnode->_key = dist + nextnode->_heur;
                     borPairHeapAdd(dij->heap, &nextnode->_heap);
                     nextnode->state = BOR_DIJ_STATE_OPEN;
                 }
@@ -116,6 +145,71 @@ int borDijRun(bor_dij_t *dij, bor_dij_node_t *start,
     return -1;
 }
 
+int borDijRunBidir(bor_dij_t *dij, bor_dij_node_t *start,
+                                   bor_dij_node_t *end)
+{
+    bor_dij_node_t *meet, *node, *fmin, *bmin;
+    bor_real_t mu;
+
+    if (dij->ops.expand_back == NULL)
+        return -1;
+
+    if (dij->heap)
+        borPairHeapDel(dij->heap);
+    if (dij->bheap)
+        borPairHeapDel(dij->bheap);
+    dij->heap = borPairHeapNew(heapLT, NULL);
+    dij->bheap = borPairHeapNew(bheapLT, NULL);
+    dij->settled = 0;
+
+    start->dist = BOR_ZERO;
+    start->prev = NULL;
+    start->state = BOR_DIJ_STATE_OPEN;
+    start->_key = BOR_ZERO;
+    borPairHeapAdd(dij->heap, &start->_heap);
+
+    end->bdist = BOR_ZERO;
+    end->next = NULL;
+    end->bstate = BOR_DIJ_STATE_OPEN;
+    borPairHeapAdd(dij->bheap, &end->_bheap);
+
+    mu = BOR_REAL_MAX;
+    meet = NULL;
+    if (start == end){
+        mu = BOR_ZERO;
+        meet = start;
+    }
+
+    while (!borPairHeapEmpty(dij->heap) && !borPairHeapEmpty(dij->bheap)){
+        fmin = bor_container_of(borPairHeapMin(dij->heap),
+                                bor_dij_node_t, _heap);
+        bmin = bor_container_of(borPairHeapMin(dij->bheap),
+                                bor_dij_node_t, _bheap);
+
+        // No path shorter than mu can be found anymore
+        if (fmin->dist + bmin->bdist >= mu)
+            break;
+
+        if (fmin->dist <= bmin->bdist){
+            bidirForward(dij, &mu, &meet);
+        }else{
+            bidirBackward(dij, &mu, &meet);
+        }
+    }
+
+    if (meet == NULL)
+        return -1;
+
+    // Connect the second half of the path so that it can be read by
+    // borDijPath() from the end node
+    for (node = meet; node->next != NULL; node = node->next){
+        node->next->prev = node;
+        node->next->dist = node->dist + (node->bdist - node->next->bdist);
+    }
+
+    return 0;
+}
+
 void borDijPath(bor_dij_node_t *endnode, bor_list_t *list)
 {
     bor_dij_node_t *node;
@@ -136,5 +230,175 @@ static int heapLT(const bor_pairheap_node_t *h1,
     n1 = bor_container_of(h1, bor_dij_node_t, _heap);
     n2 = bor_container_of(h2, bor_dij_node_t, _heap);
 
-    return n1->dist < n2->dist;
+    return n1->_key < n2->_key;
+}
+
+
+bor_dij_int_t *borDijIntNew(const bor_dij_int_ops_t *ops)
+{
+    bor_dij_int_t *dij;
+
+    dij = BOR_ALLOC(bor_dij_int_t);
+    dij->ops = *ops;
+    borPRadixQInit(&dij->queue);
+    dij->gen = 0;
+
+    return dij;
+}
+
+void borDijIntDel(bor_dij_int_t *dij)
+{
+    borPRadixQFree(&dij->queue);
+    BOR_FREE(dij);
+}
+
+int borDijIntRun(bor_dij_int_t *dij, bor_dij_int_node_t *start,
+                 bor_dij_int_node_t **targets, int targets_len)
+{
+    bor_dij_int_node_t *node, *nextnode;
+    bor_list_t list, *item;
+    unsigned long gen;
+    int i, remain;
+    long dist;
+
+    // start a new run, all nodes from previous runs become unknown
+    gen = ++dij->gen;
+    borPRadixQClear(&dij->queue);
+
+    remain = 0;
+    for (i = 0; i < targets_len; ++i){
+        if (targets[i]->_target != gen){
+            targets[i]->_target = gen;
+            ++remain;
+        }
+    }
+
+    start->gen = gen;
+    start->dist = 0;
+    start->prev = NULL;
+    start->state = BOR_DIJ_STATE_OPEN;
+    start->_handle = borPRadixQPush(&dij->queue, 0, start);
+
+    while (!borPRadixQIsEmpty(&dij->queue)){
+        node = borPRadixQPop(&dij->queue, &dist);
+        node->state = BOR_DIJ_STATE_CLOSED;
+
+        if (node->_target == gen && --remain == 0)
+            return 0;
+
+        borListInit(&list);
+        dij->ops.expand(node, &list, dij->ops.data);
+        BOR_LIST_FOR_EACH(&list, item){
+            nextnode = BOR_LIST_ENTRY(item, bor_dij_int_node_t, _list);
+            dist = node->dist + nextnode->_loc_dist;
+
+            if (nextnode->gen != gen){
+                // first time reached in this run
+                nextnode->gen = gen;
+                nextnode->dist = dist;
+                nextnode->prev = node;
+                nextnode->state = BOR_DIJ_STATE_OPEN;
+                nextnode->_handle = borPRadixQPush(&dij->queue, dist,
+                                                   nextnode);
+
+            }else if (nextnode->state == BOR_DIJ_STATE_OPEN
+                        && dist < nextnode->dist){
+                nextnode->dist = dist;
+                nextnode->prev = node;
+                borPRadixQDecreaseKey(&dij->queue, nextnode->_handle, dist);
+            }
+        }
+    }
+
+    return (remain == 0 ? 0 : -1);
+}
+
+static int bheapLT(const bor_pairheap_node_t *h1,
+                   const bor_pairheap_node_t *h2,
+                   void *_)
+{
+    bor_dij_node_t *n1, *n2;
+    n1 = bor_container_of(h1, bor_dij_node_t, _bheap);
+    n2 = bor_container_of(h2, bor_dij_node_t, _bheap);
+
+    return n1->bdist < n2->bdist;
+}
+
+static void bidirForward(bor_dij_t *dij, bor_real_t *mu,
+                         bor_dij_node_t **meet)
+{
+    bor_dij_node_t *node, *nextnode;
+    bor_list_t list, *item;
+    bor_real_t dist;
+
+    node = bor_container_of(borPairHeapExtractMin(dij->heap),
+                            bor_dij_node_t, _heap);
+    node->state = BOR_DIJ_STATE_CLOSED;
+    ++dij->settled;
+
+    borListInit(&list);
+    dij->ops.expand(node, &list, dij->ops.data);
+    BOR_LIST_FOR_EACH(&list, item){
+        nextnode = BOR_LIST_ENTRY(item, bor_dij_node_t, _list);
+        if (nextnode->state == BOR_DIJ_STATE_CLOSED)
+            continue;
+
+        dist = node->dist + nextnode->_loc_dist;
+        if (dist < nextnode->dist){
+            nextnode->dist = dist;
+            nextnode->prev = node;
+            nextnode->_key = dist;
+            if (nextnode->state == BOR_DIJ_STATE_OPEN){
+                borPairHeapDecreaseKey(dij->heap, &nextnode->_heap);
+            }else{
+                borPairHeapAdd(dij->heap, &nextnode->_heap);
+                nextnode->state = BOR_DIJ_STATE_OPEN;
+            }
+        }
+
+        if (nextnode->bstate != BOR_DIJ_STATE_UNKNOWN
+                && nextnode->dist + nextnode->bdist < *mu){
+            *mu = nextnode->dist + nextnode->bdist;
+            *meet = nextnode;
+        }
+    }
+}
+
+static void bidirBackward(bor_dij_t *dij, bor_real_t *mu,
+                          bor_dij_node_t **meet)
+{
+    bor_dij_node_t *node, *nextnode;
+    bor_list_t list, *item;
+    bor_real_t dist;
+
+    node = bor_container_of(borPairHeapExtractMin(dij->bheap),
+                            bor_dij_node_t, _bheap);
+    node->bstate = BOR_DIJ_STATE_CLOSED;
+    ++dij->settled;
+
+    borListInit(&list);
+    dij->ops.expand_back(node, &list, dij->ops.data);
+    BOR_LIST_FOR_EACH(&list, item){
+        nextnode = BOR_LIST_ENTRY(item, bor_dij_node_t, _list);
+        if (nextnode->bstate == BOR_DIJ_STATE_CLOSED)
+            continue;
+
+        dist = node->bdist + nextnode->_loc_dist;
+        if (dist < nextnode->bdist){
+            nextnode->bdist = dist;
+            nextnode->next = node;
+            if (nextnode->bstate == BOR_DIJ_STATE_OPEN){
+                borPairHeapDecreaseKey(dij->bheap, &nextnode->_bheap);
+            }else{
+                borPairHeapAdd(dij->bheap, &nextnode->_bheap);
+                nextnode->bstate = BOR_DIJ_STATE_OPEN;
+            }
+        }
+
+        if (nextnode->state != BOR_DIJ_STATE_UNKNOWN
+                && nextnode->dist + nextnode->bdist < *mu){
+            *mu = nextnode->dist + nextnode->bdist;
+            *meet = nextnode;
+        }
+    }
 }
@@ -0,0 +1,1037 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <string.h>
+#include <boruvka/alloc.h>
+#include <boruvka/dt2.h>
+#include <boruvka/predicates.h>
+#include <boruvka/sort.h>
+
+/** Vertex in infinity, ghost triangles have it always as v[2] */
+#define DT2_INF -1
+/** Mark of unused triangle */
+#define DT2_FREE -2
+
+/** Edge opposite to i'th vertex is constrained */
+#define DT2_CONSTR(i) (1u << (i))
+/** Triangle is part of cavity */
+#define DT2_CAVITY 0x8
+/** Triangle is not in conflict with inserted point */
+#define DT2_BOUND 0x10
+/** Triangle was reached by flood fill */
+#define DT2_VISITED 0x20
+/** Triangle lies inside polygons */
+#define DT2_INSIDE 0x40
+
+/** Number of bits per axis of Hilbert curve, the key must be exactly
+ *  representable by bor_real_t used in radix sort */
+#define DT2_HILBERT_BITS 12
+
+struct _dt2_hash_t {
+    int a, b;  /*!< Edge */
+    int tri;   /*!< Triangle and its edge */
+    int face;
+};
+typedef struct _dt2_hash_t dt2_hash_t;
+
+struct _dt2_t {
+    bor_vec2_t *pts;      /*!< Points in order of insertion */
+    int *id;              /*!< Original index of each point */
+    int *rank;            /*!< Inverse of .id */
+    int *vert;            /*!< Output merging of duplicates (see
+                               bor_dt2_t) */
+    bor_pred_t pred;
+
+    bor_dt2_tri_t *tris;
+    unsigned char *flags; /*!< DT2_* flags of each triangle */
+    int tris_len, tris_size;
+    int free;             /*!< List of unused triangles linked by .nb[0] */
+    int last;             /*!< Starting triangle for walk */
+    unsigned int walk;    /*!< State of generator choosing first edge */
+
+    int *cavity;          /*!< Triangles removed by current insertion */
+    int cavity_len, cavity_size;
+    int *bound;           /*!< Pairs (tri, edge) of boundary of cavity */
+    int bound_len, bound_size;
+    int *vstart;          /*!< New triangle starting at vertex */
+    int vstart_inf;
+    int *vtri;            /*!< Triangle incident with vertex */
+
+    int *left, *right;    /*!< Vertices left and right from segment */
+    int left_len, right_len, chain_size;
+    dt2_hash_t *hash;     /*!< Edges of new triangles waiting for
+                               neighbour */
+    int hash_size, hash_mask;
+};
+typedef struct _dt2_t dt2_t;
+
+static const int dt2_next[3] = { 1, 2, 0 };
+static const int dt2_prev[3] = { 2, 0, 1 };
+
+/** Orders points for insertion (BRIO with Hilbert order in rounds) */
+static void dt2InsertOrder(const bor_vec2_t *pts, int n, int *order);
+/** Creates initial triangle from three non-collinear points, their
+ *  indices are stored in {init}. Returns -1 if there are no such points. */
+static int dt2Init(dt2_t *dt, int n, int *init);
+/** Inserts point into triangulation */
+static void dt2Insert(dt2_t *dt, int p);
+/** Returns triangle in conflict with p or (-2 - v) if p equals to
+ *  vertex v */
+static int dt2Locate(dt2_t *dt, int p);
+/** Returns true if triangle is in conflict with point */
+static int dt2Conflict(dt2_t *dt, int t, int p);
+/** Inserts constrained segment, returns -1 if it crosses another one */
+static int dt2Segment(dt2_t *dt, int a, int b);
+/** Re-triangulates cavity formed by triangles crossed by segment (a, b) */
+static void dt2SegmentCavity(dt2_t *dt, int a, int b);
+/** Triangulates pseudo-polygon {a}, {b}, {chain} (reversed), returns the
+ *  triangle containing edge (a, b) */
+static int dt2Poly(dt2_t *dt, int a, int b, const int *chain, int len);
+/** Links all edges of new triangle using hash table of edges */
+static void dt2LinkTri(dt2_t *dt, int t);
+static void dt2HashPrepare(dt2_t *dt, int edges);
+static void dt2HashClear(dt2_t *dt);
+static void dt2HashLink(dt2_t *dt, int a, int b, int t, int face);
+/** Marks triangles inside polygons */
+static void dt2Clip(dt2_t *dt);
+/** Moves finished triangles to {out} */
+static void dt2Finalize(dt2_t *dt, bor_dt2_t *out, int clip);
+static void dt2Free(dt2_t *dt);
+static int dt2TriNew(dt2_t *dt);
+static void dt2TriDel(dt2_t *dt, int t);
+static void dt2CavityAdd(dt2_t *dt, int t);
+
+_bor_inline int dt2Eq(const bor_vec2_t *a, const bor_vec2_t *b)
+{
+    return borVec2X(a) == borVec2X(b) && borVec2Y(a) == borVec2Y(b);
+}
+
+_bor_inline int dt2TriVertex(const bor_dt2_tri_t *tri, int v)
+{
+    return (tri->v[0] == v ? 0 : (tri->v[1] == v ? 1 : 2));
+}
+
+_bor_inline int dt2TriNb(const bor_dt2_tri_t *tri, int t)
+{
+    return (tri->nb[0] == t ? 0 : (tri->nb[1] == t ? 1 : 2));
+}
+
+_bor_inline int *dt2VStart(dt2_t *dt, int v)
+{
+    if (v == DT2_INF)
+        return &dt->vstart_inf;
+    return dt->vstart + v;
+}
+
+_bor_inline void dt2SetConstr(dt2_t *dt, int t, int i)
+{
+    int n = dt->tris[t].nb[i];
+    dt->flags[t] |= DT2_CONSTR(i);
+    dt->flags[n] |= DT2_CONSTR(dt2TriNb(dt->tris + n, t));
+}
+
+
+bor_dt2_t *borDT2New(void)
+{
+    bor_dt2_t *dt;
+
+    dt = BOR_ALLOC(bor_dt2_t);
+    memset(dt, 0, sizeof(*dt));
+    return dt;
+}
+
+void borDT2Del(bor_dt2_t *dt)
+{
+    if (dt->pts)
+        BOR_FREE(dt->pts);
+    if (dt->segs)
+        BOR_FREE(dt->segs);
+    if (dt->vert)
+        BOR_FREE(dt->vert);
+    if (dt->tris)
+        BOR_FREE(dt->tris);
+    BOR_FREE(dt);
+}
+
+int borDT2AddPoint(bor_dt2_t *dt, const bor_vec2_t *p)
+{
+    return borDT2AddPoints(dt, p, 1);
+}
+
+int borDT2AddPoints(bor_dt2_t *dt, const bor_vec2_t *p, int n)
+{
+    int i, first;
+
+    if (dt->pts_len + n > dt->pts_size){
+        dt->pts_size = BOR_MAX(2 * dt->pts_size, dt->pts_len + n);
+        dt->pts = BOR_REALLOC_ARR(dt->pts, bor_vec2_t, dt->pts_size);
+    }
+
+    first = dt->pts_len;
+    for (i = 0; i < n; i++)
+        borVec2Copy(&dt->pts[dt->pts_len++], p + i);
+    return first;
+}
+
+void borDT2AddSegment(bor_dt2_t *dt, int a, int b)
+{
+    if (dt->segs_len + 2 > dt->segs_size){
+        dt->segs_size = BOR_MAX(2 * dt->segs_size, 16);
+        dt->segs = BOR_REALLOC_ARR(dt->segs, int, dt->segs_size);
+    }
+    dt->segs[dt->segs_len++] = a;
+    dt->segs[dt->segs_len++] = b;
+}
+
+int borDT2AddPoly2(bor_dt2_t *dt, const bor_poly2_t *poly)
+{
+    bor_vec2_t p;
+    int i, first;
+
+    first = dt->pts_len;
+    for (i = 0; i < poly->size; i++){
+        borVec2Set(&p, poly->px[i], poly->py[i]);
+        borDT2AddPoint(dt, &p);
+    }
+    for (i = 0; i < poly->size; i++)
+        borDT2AddSegment(dt, first + i, first + (i + 1) % poly->size);
+
+    return first;
+}
+
+int borDT2Build(bor_dt2_t *dt, unsigned int flags)
+{
+    dt2_t d;
+    int init[3], i, t, k, ret = 0;
+
+    if (dt->tris)
+        BOR_FREE(dt->tris);
+    dt->tris = NULL;
+    dt->tris_len = 0;
+
+    dt->vert = BOR_REALLOC_ARR(dt->vert, int, BOR_MAX(dt->pts_len, 1));
+    for (i = 0; i < dt->pts_len; i++)
+        dt->vert[i] = i;
+
+    memset(&d, 0, sizeof(d));
+    d.vert = dt->vert;
+    borPredInit(&d.pred);
+    d.free = -1;
+
+    // points are renumbered in order of insertion, so the points close in
+    // space are close in memory too
+    d.id = BOR_ALLOC_ARR(int, BOR_MAX(dt->pts_len, 1));
+    dt2InsertOrder(dt->pts, dt->pts_len, d.id);
+    d.pts = BOR_ALLOC_ARR(bor_vec2_t, BOR_MAX(dt->pts_len, 1));
+    for (i = 0; i < dt->pts_len; i++)
+        borVec2Copy(&d.pts[i], &dt->pts[d.id[i]]);
+
+    if (dt2Init(&d, dt->pts_len, init) != 0){
+        // all points are collinear
+        dt2Free(&d);
+        return -1;
+    }
+
+    d.vstart = BOR_ALLOC_ARR(int, dt->pts_len);
+    for (i = 0; i < dt->pts_len; i++){
+        if (i != init[0] && i != init[1] && i != init[2])
+            dt2Insert(&d, i);
+    }
+
+    if (dt->segs_len > 0){
+        d.rank = BOR_ALLOC_ARR(int, dt->pts_len);
+        for (i = 0; i < dt->pts_len; i++)
+            d.rank[d.id[i]] = i;
+
+        d.vtri = BOR_ALLOC_ARR(int, dt->pts_len);
+        for (t = 0; t < d.tris_len; t++){
+            if (d.tris[t].v[0] == DT2_FREE)
+                continue;
+            for (k = 0; k < 3; k++){
+                if (d.tris[t].v[k] != DT2_INF)
+                    d.vtri[d.tris[t].v[k]] = t;
+            }
+        }
+
+        for (i = 0; i < dt->segs_len && ret == 0; i += 2){
+            ret = dt2Segment(&d, d.rank[dt->vert[dt->segs[i]]],
+                                 d.rank[dt->vert[dt->segs[i + 1]]]);
+        }
+    }
+
+    if (ret == 0){
+        if (flags & BOR_DT2_CLIP)
+            dt2Clip(&d);
+        dt2Finalize(&d, dt, flags & BOR_DT2_CLIP);
+    }
+
+    dt2Free(&d);
+    return ret;
+}
+
+bor_mesh3_t *borDT2Mesh3(const bor_dt2_t *dt, bor_vec3_t *coords)
+{
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **verts;
+    bor_mesh3_edge_t **edges;
+    bor_mesh3_face_t *face;
+    const bor_dt2_tri_t *tri;
+    int t, k, v, n;
+
+    mesh = borMesh3New();
+    verts = BOR_CALLOC_ARR(bor_mesh3_vertex_t *, BOR_MAX(dt->pts_len, 1));
+    edges = BOR_ALLOC_ARR(bor_mesh3_edge_t *, BOR_MAX(3 * dt->tris_len, 1));
+
+    for (t = 0; t < dt->tris_len; t++){
+        tri = dt->tris + t;
+        for (k = 0; k < 3; k++){
+            v = tri->v[k];
+            if (verts[v])
+                continue;
+
+            borVec3Set(&coords[v], borVec2X(&dt->pts[v]),
+                                   borVec2Y(&dt->pts[v]), BOR_ZERO);
+            verts[v] = borMesh3VertexAlloc(mesh);
+            borMesh3VertexSetCoords(verts[v], &coords[v]);
+            borMesh3AddVertex(mesh, verts[v]);
+        }
+    }
+
+    for (t = 0; t < dt->tris_len; t++){
+        tri = dt->tris + t;
+        for (k = 0; k < 3; k++){
+            n = tri->nb[k];
+            if (n >= 0 && n < t){
+                edges[3 * t + k] = edges[3 * n + dt2TriNb(dt->tris + n, t)];
+            }else{
+                edges[3 * t + k] = borMesh3EdgeAlloc(mesh);
+                borMesh3AddEdge(mesh, edges[3 * t + k],
+                                verts[tri->v[dt2_next[k]]],
+                                verts[tri->v[dt2_prev[k]]]);
+            }
+        }
+
+        face = borMesh3FaceAlloc(mesh);
+        borMesh3AddFace(mesh, face, edges[3 * t], edges[3 * t + 1],
+                        edges[3 * t + 2]);
+    }
+
+    BOR_FREE(verts);
+    BOR_FREE(edges);
+    return mesh;
+}
+
+void borDT2Mesh3Del(bor_mesh3_t *mesh)
+{
+    borMesh3Del(mesh);
+}
+
+
+
+static unsigned long dt2Hilbert(unsigned long x, unsigned long y)
+{
+    unsigned long n, s, rx, ry, tmp;
+    unsigned long d = 0;
+
+    n = 1UL << DT2_HILBERT_BITS;
+    for (s = n / 2; s > 0; s /= 2){
+        rx = (x & s) > 0;
+        ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+
+        // rotate quadrant
+        if (ry == 0){
+            if (rx == 1){
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            BOR_SWAP(x, y, tmp);
+        }
+    }
+
+    return d;
+}
+
+static void dt2InsertOrder(const bor_vec2_t *pts, int n, int *order)
+{
+    bor_radix_sort_t *sort, *tmp_sort;
+    bor_real_t aabb[4], scale, range, x, y;
+    unsigned int rnd, *count;
+    int i, r, rounds;
+
+    if (n == 0)
+        return;
+
+    aabb[0] = aabb[1] = borVec2X(&pts[0]);
+    aabb[2] = aabb[3] = borVec2Y(&pts[0]);
+    for (i = 1; i < n; i++){
+        aabb[0] = BOR_MIN(aabb[0], borVec2X(&pts[i]));
+        aabb[1] = BOR_MAX(aabb[1], borVec2X(&pts[i]));
+        aabb[2] = BOR_MIN(aabb[2], borVec2Y(&pts[i]));
+        aabb[3] = BOR_MAX(aabb[3], borVec2Y(&pts[i]));
+    }
+    range = BOR_MAX(aabb[1] - aabb[0], aabb[3] - aabb[2]);
+    scale = BOR_ZERO;
+    if (range > BOR_ZERO)
+        scale = (bor_real_t)((1UL << DT2_HILBERT_BITS) - 1) / range;
+
+    // sort all points along Hilbert curve
+    sort = BOR_ALLOC_ARR(bor_radix_sort_t, n);
+    tmp_sort = BOR_ALLOC_ARR(bor_radix_sort_t, n);
+    for (i = 0; i < n; i++){
+        x = (borVec2X(&pts[i]) - aabb[0]) * scale;
+        y = (borVec2Y(&pts[i]) - aabb[2]) * scale;
+        sort[i].key = dt2Hilbert(x, y);
+        sort[i].val = i;
+    }
+    borRadixSort(sort, tmp_sort, n);
+    BOR_FREE(tmp_sort);
+
+    // biased randomized insertion order: each point is randomly assigned
+    // to one of the rounds of doubling size (the last round gets half of
+    // the points, the one before a quarter etc.) and the points are
+    // stably distributed to the rounds, so each round remains sorted
+    // along the curve
+    for (rounds = 1; (n >> rounds) > 128; rounds++);
+    count = BOR_CALLOC_ARR(unsigned int, rounds);
+    rnd = 2463534242u;
+    for (i = 0; i < n; i++){
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 17;
+        rnd ^= rnd << 5;
+        for (r = rounds - 1; r > 0 && (rnd & (1u << r)); r--);
+        sort[i].key = r;
+        count[r]++;
+    }
+    for (r = 0, i = 0; r < rounds; r++){
+        i += count[r];
+        count[r] = i - count[r];
+    }
+    for (i = 0; i < n; i++)
+        order[count[(int)sort[i].key]++] = sort[i].val;
+
+    BOR_FREE(count);
+    BOR_FREE(sort);
+}
+
+static int dt2Init(dt2_t *dt, int n, int *init)
+{
+    const bor_vec2_t *pts = dt->pts;
+    int ghost[3], found, i, j, t, tmp;
+    bor_dt2_tri_t *tri;
+
+    // find three non-collinear points
+    found = 0;
+    for (i = 0; i < n && found < 3; i++){
+        if (found == 1 && dt2Eq(&pts[i], &pts[init[0]]))
+            continue;
+        if (found == 2 && borPredOrient2d(&dt->pred, &pts[init[0]],
+                                          &pts[init[1]], &pts[i]) == BOR_ZERO)
+            continue;
+        init[found++] = i;
+    }
+
+    if (found < 3)
+        return -1;
+
+    if (borPredOrient2d(&dt->pred, &pts[init[0]], &pts[init[1]],
+                        &pts[init[2]]) < BOR_ZERO){
+        BOR_SWAP(init[0], init[1], tmp);
+    }
+
+    t = dt2TriNew(dt);
+    for (i = 0; i < 3; i++)
+        ghost[i] = dt2TriNew(dt);
+
+    tri = dt->tris + t;
+    for (i = 0; i < 3; i++){
+        tri->v[i] = init[i];
+        tri->nb[i] = ghost[i];
+    }
+
+    // ghost triangles connect the edges with infinity, ghost[i] is
+    // opposite to v[i] of the first triangle
+    for (i = 0; i < 3; i++){
+        tri = dt->tris + ghost[i];
+        tri->v[0] = init[dt2_prev[i]];
+        tri->v[1] = init[dt2_next[i]];
+        tri->v[2] = DT2_INF;
+        tri->nb[2] = t;
+    }
+    for (i = 0; i < 3; i++){
+        tri = dt->tris + ghost[i];
+        for (j = 0; j < 3; j++){
+            if (dt->tris[ghost[j]].v[0] == tri->v[1])
+                tri->nb[0] = ghost[j];
+            if (dt->tris[ghost[j]].v[1] == tri->v[0])
+                tri->nb[1] = ghost[j];
+        }
+    }
+
+    dt->last = t;
+    return 0;
+}
+
+static void dt2Insert(dt2_t *dt, int p)
+{
+    bor_dt2_tri_t *tri, *nt;
+    int start, ci, i, j, t, n, a, m, tmp;
+
+    start = dt2Locate(dt, p);
+    if (start < 0){
+        dt->vert[dt->id[p]] = dt->id[-start - 2];
+        return;
+    }
+
+    // find cavity: all triangles in conflict connected with start
+    dt->cavity_len = dt->bound_len = 0;
+    dt2CavityAdd(dt, start);
+    for (ci = 0; ci < dt->cavity_len; ci++){
+        t = dt->cavity[ci];
+        for (i = 0; i < 3; i++){
+            n = dt->tris[t].nb[i];
+            if (dt->flags[n] & DT2_CAVITY)
+                continue;
+
+            if (!(dt->flags[n] & DT2_BOUND) && dt2Conflict(dt, n, p)){
+                dt2CavityAdd(dt, n);
+            }else{
+                dt->flags[n] |= DT2_BOUND;
+                if (dt->bound_len + 2 > dt->bound_size){
+                    dt->bound_size = BOR_MAX(2 * dt->bound_size, 64);
+                    dt->bound = BOR_REALLOC_ARR(dt->bound, int,
+                                                dt->bound_size);
+                }
+                dt->bound[dt->bound_len++] = t;
+                dt->bound[dt->bound_len++] = i;
+            }
+        }
+    }
+
+    // connect p with each boundary edge (a, b) by triangle (a, b, p)
+    for (j = 0; j < dt->bound_len; j += 2){
+        m = dt2TriNew(dt);
+        t = dt->bound[j];
+        i = dt->bound[j + 1];
+        tri = dt->tris + t;
+        nt = dt->tris + m;
+
+        nt->v[0] = a = tri->v[dt2_next[i]];
+        nt->v[1] = tri->v[dt2_prev[i]];
+        nt->v[2] = p;
+        n = nt->nb[2] = tri->nb[i];
+        dt->tris[n].nb[dt2TriNb(dt->tris + n, t)] = m;
+        dt->flags[n] &= ~DT2_BOUND;
+
+        *dt2VStart(dt, a) = m;
+        dt->bound[j] = m;
+    }
+
+    // boundary of cavity is a cycle, so the triangle (a, b, p) neighbours
+    // with the triangle (b, c, p)
+    for (j = 0; j < dt->bound_len; j += 2){
+        t = dt->bound[j];
+        m = *dt2VStart(dt, dt->tris[t].v[1]);
+        dt->tris[t].nb[0] = m;
+        dt->tris[m].nb[1] = t;
+    }
+
+    for (ci = 0; ci < dt->cavity_len; ci++)
+        dt2TriDel(dt, dt->cavity[ci]);
+
+    // ghost triangles have the vertex in infinity always last
+    for (j = 0; j < dt->bound_len; j += 2){
+        nt = dt->tris + dt->bound[j];
+        if (nt->v[0] == DT2_INF){
+            nt->v[0] = nt->v[1];
+            nt->v[1] = p;
+            nt->v[2] = DT2_INF;
+            BOR_SWAP(nt->nb[0], nt->nb[1], tmp);
+            BOR_SWAP(nt->nb[1], nt->nb[2], tmp);
+
+        }else if (nt->v[1] == DT2_INF){
+            nt->v[1] = nt->v[0];
+            nt->v[0] = p;
+            nt->v[2] = DT2_INF;
+            BOR_SWAP(nt->nb[0], nt->nb[2], tmp);
+            BOR_SWAP(nt->nb[1], nt->nb[2], tmp);
+
+        }else{
+            dt->last = dt->bound[j];
+        }
+    }
+}
+
+static int dt2Locate(dt2_t *dt, int p)
+{
+    const bor_vec2_t *pts = dt->pts;
+    const bor_dt2_tri_t *tri;
+    int t, from, i, k, r;
+
+    t = dt->last;
+    from = -1;
+    while (1){
+        tri = dt->tris + t;
+        // walking steps to ghost triangle only if p lies outside of the
+        // hull edge, i.e., it is in conflict
+        if (tri->v[2] == DT2_INF)
+            return t;
+
+        dt->walk = dt->walk * 1103515245u + 12345u;
+        r = (dt->walk >> 16) % 3;
+        for (k = 0; k < 3; k++){
+            i = (r + k) % 3;
+            // p cannot lie behind the edge we came through
+            if (tri->nb[i] == from)
+                continue;
+            if (borPredOrient2d(&dt->pred, &pts[tri->v[dt2_next[i]]],
+                                &pts[tri->v[dt2_prev[i]]],
+                                &pts[p]) < BOR_ZERO)
+                break;
+        }
+
+        if (k == 3)
+            break;
+        from = t;
+        t = tri->nb[i];
+    }
+
+    // p lies inside or on boundary of triangle
+    for (i = 0; i < 3; i++){
+        if (dt2Eq(&pts[tri->v[i]], &pts[p]))
+            return -2 - tri->v[i];
+    }
+    return t;
+}
+
+static int dt2Conflict(dt2_t *dt, int t, int p)
+{
+    const bor_vec2_t *pts = dt->pts;
+    const bor_dt2_tri_t *tri = dt->tris + t;
+    bor_real_t o;
+
+    if (tri->v[2] != DT2_INF){
+        return borPredInCircle(&dt->pred, &pts[tri->v[0]], &pts[tri->v[1]],
+                               &pts[tri->v[2]], &pts[p]) > BOR_ZERO;
+    }
+
+    o = borPredOrient2d(&dt->pred, &pts[tri->v[0]], &pts[tri->v[1]],
+                        &pts[p]);
+    if (o != BOR_ZERO)
+        return o > BOR_ZERO;
+
+    // point is collinear with hull edge, it is in conflict if it lies
+    // inside the edge, i.e., inside circumcircle of the finite triangle
+    return dt2Conflict(dt, tri->nb[2], p);
+}
+
+static int dt2SameDir(const bor_vec2_t *a, const bor_vec2_t *u,
+                      const bor_vec2_t *b)
+{
+    return (borVec2X(u) > borVec2X(a)) == (borVec2X(b) > borVec2X(a))
+            && (borVec2X(u) < borVec2X(a)) == (borVec2X(b) < borVec2X(a))
+            && (borVec2Y(u) > borVec2Y(a)) == (borVec2Y(b) > borVec2Y(a))
+            && (borVec2Y(u) < borVec2Y(a)) == (borVec2Y(b) < borVec2Y(a));
+}
+
+static void dt2ChainAdd(dt2_t *dt, int **chain, int *len, int v)
+{
+    if (*len == dt->chain_size){
+        dt->chain_size = BOR_MAX(2 * dt->chain_size, 32);
+        dt->left = BOR_REALLOC_ARR(dt->left, int, dt->chain_size);
+        dt->right = BOR_REALLOC_ARR(dt->right, int, dt->chain_size);
+    }
+    (*chain)[(*len)++] = v;
+}
+
+static int dt2Segment(dt2_t *dt, int a, int b)
+{
+    const bor_vec2_t *pts = dt->pts;
+    const bor_dt2_tri_t *tri;
+    int t, t0, i, u, w, x, n, e, cross;
+    bor_real_t o;
+
+    while (a != b){
+        // rotate around a to find edge (a, b), edge (a, x) with x lying on
+        // the segment or triangle whose edge opposite to a is crossed by
+        // the segment
+        cross = -1;
+        t = t0 = dt->vtri[a];
+        do {
+            tri = dt->tris + t;
+            i = dt2TriVertex(tri, a);
+            u = tri->v[dt2_next[i]];
+            w = tri->v[dt2_prev[i]];
+            if (u == b){
+                dt2SetConstr(dt, t, dt2_prev[i]);
+                return 0;
+            }
+            if (w == b){
+                dt2SetConstr(dt, t, dt2_next[i]);
+                return 0;
+            }
+
+            if (u != DT2_INF){
+                o = borPredOrient2d(&dt->pred, &pts[a], &pts[u], &pts[b]);
+                if (o == BOR_ZERO && dt2SameDir(&pts[a], &pts[u], &pts[b])){
+                    dt2SetConstr(dt, t, dt2_prev[i]);
+                    cross = 0;
+                    break;
+                }
+
+                if (w != DT2_INF && o > BOR_ZERO
+                        && borPredOrient2d(&dt->pred, &pts[a], &pts[w],
+                                           &pts[b]) < BOR_ZERO){
+                    cross = 1;
+                    break;
+                }
+            }
+
+            t = tri->nb[dt2_next[i]];
+        } while (t != t0);
+
+        if (cross < 0)
+            return -1;
+        if (cross == 0){
+            a = u;
+            continue;
+        }
+
+        // walk along the segment and collect crossed triangles and
+        // vertices on both sides
+        dt->cavity_len = dt->left_len = dt->right_len = 0;
+        dt2CavityAdd(dt, t);
+        dt2ChainAdd(dt, &dt->left, &dt->left_len, w);
+        dt2ChainAdd(dt, &dt->right, &dt->right_len, u);
+        while (1){
+            if (dt->flags[t] & DT2_CONSTR(i))
+                return -1;
+
+            tri = dt->tris + t;
+            n = tri->nb[i];
+            x = dt->tris[n].v[dt2TriNb(dt->tris + n, t)];
+            dt2CavityAdd(dt, n);
+            if (x == b){
+                e = b;
+                break;
+            }
+
+            o = borPredOrient2d(&dt->pred, &pts[a], &pts[b], &pts[x]);
+            if (o == BOR_ZERO){
+                // the segment passes through x
+                e = x;
+                break;
+
+            }else if (o > BOR_ZERO){
+                dt2ChainAdd(dt, &dt->left, &dt->left_len, x);
+                i = dt2TriVertex(dt->tris + n, w);
+                w = x;
+
+            }else{
+                dt2ChainAdd(dt, &dt->right, &dt->right_len, x);
+                i = dt2TriVertex(dt->tris + n, u);
+                u = x;
+            }
+            t = n;
+        }
+
+        dt2SegmentCavity(dt, a, e);
+        a = e;
+    }
+
+    return 0;
+}
+
+static void dt2SegmentCavity(dt2_t *dt, int a, int b)
+{
+    const bor_dt2_tri_t *tri;
+    int ci, k, n, t, tl, tmp;
+
+    dt2HashPrepare(dt, 4 * dt->cavity_len + 2);
+
+    // edges on boundary of cavity wait for new triangles
+    for (ci = 0; ci < dt->cavity_len; ci++){
+        t = dt->cavity[ci];
+        tri = dt->tris + t;
+        for (k = 0; k < 3; k++){
+            n = tri->nb[k];
+            if (!(dt->flags[n] & DT2_CAVITY)){
+                dt2HashLink(dt, tri->v[dt2_next[k]], tri->v[dt2_prev[k]],
+                            n, dt2TriNb(dt->tris + n, t));
+            }
+        }
+    }
+
+    for (ci = 0; ci < dt->cavity_len; ci++)
+        dt2TriDel(dt, dt->cavity[ci]);
+
+    // vertices on the left lie on the left from (a, b) and vertices on
+    // the right lie on the left from (b, a) in the reversed order
+    for (k = 0; k < dt->right_len / 2; k++){
+        BOR_SWAP(dt->right[k], dt->right[dt->right_len - k - 1], tmp);
+    }
+    tl = dt2Poly(dt, a, b, dt->left, dt->left_len);
+    dt2Poly(dt, b, a, dt->right, dt->right_len);
+    dt2SetConstr(dt, tl, 2);
+
+    dt2HashClear(dt);
+}
+
+static int dt2Poly(dt2_t *dt, int a, int b, const int *chain, int len)
+{
+    const bor_vec2_t *pts = dt->pts;
+    bor_dt2_tri_t *tri;
+    int c, j, t;
+
+    if (len == 0)
+        return -1;
+
+    // choose vertex c so that circumcircle of (a, b, c) does not contain
+    // any other vertex of the polygon
+    c = 0;
+    for (j = 1; j < len; j++){
+        if (borPredInCircle(&dt->pred, &pts[a], &pts[b], &pts[chain[c]],
+                            &pts[chain[j]]) > BOR_ZERO)
+            c = j;
+    }
+
+    t = dt2TriNew(dt);
+    tri = dt->tris + t;
+    tri->v[0] = a;
+    tri->v[1] = b;
+    tri->v[2] = chain[c];
+    dt2LinkTri(dt, t);
+
+    dt2Poly(dt, a, chain[c], chain, c);
+    dt2Poly(dt, chain[c], b, chain + c + 1, len - c - 1);
+    return t;
+}
+
+static void dt2LinkTri(dt2_t *dt, int t)
+{
+    int k, v;
+
+    for (k = 0; k < 3; k++){
+        v = dt->tris[t].v[k];
+        dt->vtri[v] = t;
+        dt2HashLink(dt, dt->tris[t].v[dt2_next[k]],
+                    dt->tris[t].v[dt2_prev[k]], t, k);
+    }
+}
+
+static void dt2HashPrepare(dt2_t *dt, int edges)
+{
+    int i, size;
+
+    size = 16;
+    while (size < 2 * edges)
+        size *= 2;
+    if (size > dt->hash_size){
+        dt->hash_size = size;
+        dt->hash = BOR_REALLOC_ARR(dt->hash, dt2_hash_t, size);
+        for (i = 0; i < size; i++)
+            dt->hash[i].tri = -1;
+    }
+    dt->hash_mask = size - 1;
+}
+
+static void dt2HashClear(dt2_t *dt)
+{
+    int i;
+
+    for (i = 0; i <= dt->hash_mask; i++)
+        dt->hash[i].tri = -1;
+}
+
+static void dt2HashLink(dt2_t *dt, int a, int b, int t, int face)
+{
+    dt2_hash_t *h;
+    unsigned int key;
+    int tmp;
+
+    if (a > b)
+        BOR_SWAP(a, b, tmp);
+
+    key = ((unsigned int)a * 2654435761u) ^ ((unsigned int)b * 40503u);
+    key &= dt->hash_mask;
+    while (1){
+        h = dt->hash + key;
+        if (h->tri < 0){
+            h->a = a;
+            h->b = b;
+            h->tri = t;
+            h->face = face;
+            return;
+        }
+
+        if (h->a == a && h->b == b){
+            dt->tris[t].nb[face] = h->tri;
+            dt->tris[h->tri].nb[h->face] = t;
+            if (dt->flags[h->tri] & DT2_CONSTR(h->face))
+                dt->flags[t] |= DT2_CONSTR(face);
+            // mark as matched, table is cleared afterwards
+            h->a = h->b = DT2_FREE;
+            return;
+        }
+
+        key = (key + 1) & dt->hash_mask;
+    }
+}
+
+static void dt2Clip(dt2_t *dt)
+{
+    const bor_dt2_tri_t *tri;
+    int t, n, k, ci;
+    unsigned char in;
+
+    // flood fill from infinity, crossing of constrained edge toggles
+    // inside/outside
+    for (t = 0; t < dt->tris_len; t++){
+        tri = dt->tris + t;
+        if (tri->v[0] == DT2_FREE || tri->v[2] != DT2_INF)
+            continue;
+
+        n = tri->nb[2];
+        if (dt->flags[n] & DT2_VISITED)
+            continue;
+        in = (dt->flags[t] & DT2_CONSTR(2) ? DT2_INSIDE : 0);
+        dt->flags[n] |= DT2_VISITED | in;
+        dt->cavity_len = 0;
+        dt2CavityAdd(dt, n);
+        dt->flags[n] &= ~DT2_CAVITY;
+
+        for (ci = 0; ci < dt->cavity_len; ci++){
+            tri = dt->tris + dt->cavity[ci];
+            for (k = 0; k < 3; k++){
+                n = tri->nb[k];
+                if (dt->tris[n].v[2] == DT2_INF
+                        || (dt->flags[n] & DT2_VISITED))
+                    continue;
+
+                in = dt->flags[dt->cavity[ci]] & DT2_INSIDE;
+                if (dt->flags[dt->cavity[ci]] & DT2_CONSTR(k))
+                    in ^= DT2_INSIDE;
+                dt->flags[n] |= DT2_VISITED | in;
+                dt2CavityAdd(dt, n);
+                dt->flags[n] &= ~DT2_CAVITY;
+            }
+        }
+    }
+}
+
+static void dt2Finalize(dt2_t *dt, bor_dt2_t *out, int clip)
+{
+    bor_dt2_tri_t *tri;
+    int *map, t, k, len;
+
+    map = BOR_ALLOC_ARR(int, dt->tris_len);
+    len = 0;
+    for (t = 0; t < dt->tris_len; t++){
+        tri = dt->tris + t;
+        if (tri->v[0] == DT2_FREE || tri->v[2] == DT2_INF
+                || (clip && !(dt->flags[t] & DT2_INSIDE))){
+            map[t] = -1;
+        }else{
+            map[t] = len++;
+        }
+    }
+
+    // compact triangles in place, map[t] <= t
+    for (t = 0; t < dt->tris_len; t++){
+        if (map[t] < 0)
+            continue;
+
+        tri = dt->tris + map[t];
+        *tri = dt->tris[t];
+        for (k = 0; k < 3; k++){
+            tri->v[k] = dt->id[tri->v[k]];
+            tri->nb[k] = map[tri->nb[k]];
+        }
+    }
+    BOR_FREE(map);
+
+    out->tris = BOR_REALLOC_ARR(dt->tris, bor_dt2_tri_t, BOR_MAX(len, 1));
+    out->tris_len = len;
+    dt->tris = NULL;
+}
+
+static void dt2Free(dt2_t *dt)
+{
+    if (dt->pts)
+        BOR_FREE(dt->pts);
+    if (dt->id)
+        BOR_FREE(dt->id);
+    if (dt->rank)
+        BOR_FREE(dt->rank);
+    if (dt->tris)
+        BOR_FREE(dt->tris);
+    if (dt->flags)
+        BOR_FREE(dt->flags);
+    if (dt->cavity)
+        BOR_FREE(dt->cavity);
+    if (dt->bound)
+        BOR_FREE(dt->bound);
+    if (dt->vstart)
+        BOR_FREE(dt->vstart);
+    if (dt->vtri)
+        BOR_FREE(dt->vtri);
+    if (dt->left)
+        BOR_FREE(dt->left);
+    if (dt->right)
+        BOR_FREE(dt->right);
+    if (dt->hash)
+        BOR_FREE(dt->hash);
+}
+
+static int dt2TriNew(dt2_t *dt)
+{
+    int t;
+
+    if (dt->free >= 0){
+        t = dt->free;
+        dt->free = dt->tris[t].nb[0];
+    }else{
+        if (dt->tris_len == dt->tris_size){
+            dt->tris_size = BOR_MAX(2 * dt->tris_size, 64);
+            dt->tris = BOR_REALLOC_ARR(dt->tris, bor_dt2_tri_t,
+                                       dt->tris_size);
+            dt->flags = BOR_REALLOC_ARR(dt->flags, unsigned char,
+                                        dt->tris_size);
+        }
+        t = dt->tris_len++;
+    }
+
+    dt->flags[t] = 0;
+    return t;
+}
+
+static void dt2TriDel(dt2_t *dt, int t)
+{
+    dt->tris[t].v[0] = DT2_FREE;
+    dt->tris[t].nb[0] = dt->free;
+    dt->flags[t] = 0;
+    dt->free = t;
+}
+
+static void dt2CavityAdd(dt2_t *dt, int t)
+{
+    if (dt->cavity_len == dt->cavity_size){
+        dt->cavity_size = BOR_MAX(2 * dt->cavity_size, 64);
+        dt->cavity = BOR_REALLOC_ARR(dt->cavity, int, dt->cavity_size);
+    }
+    dt->cavity[dt->cavity_len++] = t;
+    dt->flags[t] |= DT2_CAVITY;
+}
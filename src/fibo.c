@@ -187,14 +187,17 @@ _bor_inline void __borFiboCutCascade(bor_fibo_t *f, bor_fibo_node_t *n)
     if (p && f->lt(n, p, f->data)){
         __borFiboCut(f, n, p);
 
-        while (p){
+        /* cascade up while parents already lost a child, roots are
+         * never marked */
+        while (p->parent){
             if (!p->mark){
                 p->mark = 1;
                 break;
             }
 
-            __borFiboCut(f, n, p);
+            n = p;
             p = p->parent;
+            __borFiboCut(f, n, p);
         }
     }
 }
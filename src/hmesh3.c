@@ -0,0 +1,659 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <string.h>
+#include <boruvka/alloc.h>
+#include <boruvka/hmesh3.h>
+
+/** Removed vertex is marked by .vhe[v] <= -2 and next removed vertex is
+ *  encoded in it */
+#define VFREE_ENC(next) (-3 - (next))
+#define VFREE_DEC(vhe) (-3 - (vhe))
+
+/**
+ * Undirected edges of triangle soup stored by their smaller vertex.
+ */
+struct _soup_edges_t {
+    int *start; /*!< Edges of vertex v are in [start[v], start[v + 1]) */
+    int *other; /*!< The other (greater) vertex of edge */
+    int *face;  /*!< Triangle the edge belongs to */
+};
+typedef struct _soup_edges_t soup_edges_t;
+
+/** Fills soup_edges_t structure */
+static void soupEdgesInit(soup_edges_t *se, const int *tris, int tris_len,
+                          int verts_len);
+/** Frees soup_edges_t structure */
+static void soupEdgesFree(soup_edges_t *se);
+/** Returns the triangle adjacent to triangle f over its edge (a, b) or -1
+ *  if there is no such triangle or more of them */
+static int soupEdgesAdj(const soup_edges_t *se, int f, int a, int b);
+/** Returns index of vertex v in triangle f */
+static int soupTriIndex(const int *tris, int f, int v);
+/** Makes orientation of triangles consistent */
+static void soupOrient(const soup_edges_t *se, int *tris, int tris_len);
+
+/** Ensures there is space for {n} more vertices / faces */
+static void hmesh3ReserveVerts(bor_hmesh3_t *m, int n);
+static void hmesh3ReserveFaces(bor_hmesh3_t *m, int n);
+/** Returns index of an empty face */
+static int hmesh3NewFace(bor_hmesh3_t *m);
+/** Puts face into the free-list */
+static void hmesh3FreeFace(bor_hmesh3_t *m, int f);
+/** Sets outgoing half-edge of vertex {v} to the clockwise-most half-edge
+ *  in the fan containing {h} */
+static void hmesh3SetVHE(bor_hmesh3_t *m, int v, int h);
+/** Returns true if {v} is a boundary vertex */
+static int hmesh3IsBoundary(const bor_hmesh3_t *m, int v);
+/** Returns true if {u} and {v} are connected by an edge */
+static int hmesh3IsNeighbour(const bor_hmesh3_t *m, int u, int v);
+/** Returns number of neighbours of {v} */
+static int hmesh3Valence(const bor_hmesh3_t *m, int v);
+
+bor_hmesh3_t *borHMesh3New(void)
+{
+    bor_hmesh3_t *m;
+
+    m = BOR_ALLOC(bor_hmesh3_t);
+    memset(m, 0, sizeof(*m));
+    m->verts_free = -1;
+    m->faces_free = -1;
+    return m;
+}
+
+bor_hmesh3_t *borHMesh3NewSoup(const bor_vec3_t *coords, int verts_len,
+                               const int *tris, int tris_len,
+                               unsigned int flags)
+{
+    bor_hmesh3_t *m;
+    soup_edges_t se;
+    int *t;
+    int f, k, h, a, b, g;
+
+    m = borHMesh3New();
+    hmesh3ReserveVerts(m, verts_len);
+    hmesh3ReserveFaces(m, tris_len);
+
+    memcpy(m->coords, coords, sizeof(bor_vec3_t) * verts_len);
+    for (a = 0; a < verts_len; a++)
+        m->vhe[a] = -1;
+    m->verts_len = m->verts_num = verts_len;
+    m->faces_len = m->faces_num = tris_len;
+
+    t = BOR_ALLOC_ARR(int, BOR_MAX(3 * tris_len, 1));
+    memcpy(t, tris, sizeof(int) * 3 * tris_len);
+
+    soupEdgesInit(&se, t, tris_len, verts_len);
+    if (flags & BOR_HMESH3_ORIENT)
+        soupOrient(&se, t, tris_len);
+
+    for (h = 0; h < 3 * tris_len; h++){
+        m->he[h].v = t[h];
+        m->he[h].twin = -1;
+    }
+
+    for (f = 0; f < tris_len; f++){
+        for (k = 0; k < 3; k++){
+            h = 3 * f + k;
+            if (m->he[h].twin >= 0)
+                continue;
+
+            a = t[h];
+            b = t[borHMesh3HENext(h)];
+            g = soupEdgesAdj(&se, f, a, b);
+            if (g < 0)
+                continue;
+
+            // pair only oppositely oriented half-edges
+            g = 3 * g + soupTriIndex(t, g, b);
+            if (t[borHMesh3HENext(g)] == a && m->he[g].twin < 0){
+                m->he[h].twin = g;
+                m->he[g].twin = h;
+            }
+        }
+    }
+    soupEdgesFree(&se);
+    BOR_FREE(t);
+
+    // boundary half-edges take precedence so that the whole fan can be
+    // traversed counter-clockwise from .vhe[]
+    for (h = 0; h < 3 * tris_len; h++){
+        a = m->he[h].v;
+        if (m->vhe[a] < 0 || m->he[h].twin < 0)
+            m->vhe[a] = h;
+    }
+
+    return m;
+}
+
+void borHMesh3Del(bor_hmesh3_t *m)
+{
+    if (m->coords)
+        BOR_FREE(m->coords);
+    if (m->vhe)
+        BOR_FREE(m->vhe);
+    if (m->he)
+        BOR_FREE(m->he);
+    BOR_FREE(m);
+}
+
+int borHMesh3AddVertex(bor_hmesh3_t *m, const bor_vec3_t *coords)
+{
+    int v;
+
+    if (m->verts_free >= 0){
+        v = m->verts_free;
+        m->verts_free = VFREE_DEC(m->vhe[v]);
+    }else{
+        hmesh3ReserveVerts(m, 1);
+        v = m->verts_len++;
+    }
+
+    borVec3Copy(&m->coords[v], coords);
+    m->vhe[v] = -1;
+    ++m->verts_num;
+    return v;
+}
+
+int borHMesh3RemoveVertex(bor_hmesh3_t *m, int v)
+{
+    if (m->vhe[v] != -1)
+        return -1;
+
+    m->vhe[v] = VFREE_ENC(m->verts_free);
+    m->verts_free = v;
+    --m->verts_num;
+    return 0;
+}
+
+int borHMesh3AddFace(bor_hmesh3_t *m, int a, int b, int c)
+{
+    int f, k, h, g, start, u, w;
+
+    f = hmesh3NewFace(m);
+    m->he[3 * f].v = a;
+    m->he[3 * f + 1].v = b;
+    m->he[3 * f + 2].v = c;
+    m->he[3 * f].twin = m->he[3 * f + 1].twin = m->he[3 * f + 2].twin = -1;
+
+    // find twins among outgoing half-edges of the target vertices
+    for (k = 0; k < 3; k++){
+        h = 3 * f + k;
+        u = m->he[h].v;
+        w = borHMesh3HETarget(m, h);
+
+        start = g = m->vhe[w];
+        while (g >= 0){
+            if (borHMesh3HETarget(m, g) == u && m->he[g].twin < 0){
+                m->he[h].twin = g;
+                m->he[g].twin = h;
+                break;
+            }
+            g = borHMesh3HERotCCW(m, g);
+            if (g == start)
+                break;
+        }
+    }
+
+    for (k = 0; k < 3; k++){
+        h = 3 * f + k;
+        u = m->he[h].v;
+        // keep the original fan if the face isn't connected to it
+        if (m->vhe[u] < 0
+                || m->he[h].twin >= 0
+                || m->he[borHMesh3HEPrev(h)].twin >= 0){
+            hmesh3SetVHE(m, u, h);
+        }
+    }
+
+    return f;
+}
+
+void borHMesh3RemoveFace(bor_hmesh3_t *m, int f)
+{
+    int k, h, t;
+    int vs[3], ccw[3], cw[3];
+
+    for (k = 0; k < 3; k++){
+        h = 3 * f + k;
+        vs[k] = m->he[h].v;
+        ccw[k] = borHMesh3HERotCCW(m, h);
+        cw[k] = borHMesh3HERotCW(m, h);
+    }
+
+    for (k = 0; k < 3; k++){
+        h = 3 * f + k;
+        t = m->he[h].twin;
+        if (t >= 0)
+            m->he[t].twin = -1;
+    }
+    hmesh3FreeFace(m, f);
+
+    // counter-clockwise neighbour becomes clockwise-most half-edge of its
+    // fan, otherwise the clockwise neighbour's fan is used
+    for (k = 0; k < 3; k++){
+        if (ccw[k] >= 0){
+            m->vhe[vs[k]] = ccw[k];
+        }else{
+            hmesh3SetVHE(m, vs[k], cw[k]);
+        }
+    }
+}
+
+int borHMesh3EdgeCollapse(bor_hmesh3_t *m, int h)
+{
+    int a, b, c, d, t, n0, p0, n1, p1, tn0, tp0, tn1, tp1;
+    int f0, f1, g, start, last, common, cand;
+
+    a = m->he[h].v;
+    b = borHMesh3HETarget(m, h);
+    t = m->he[h].twin;
+    f0 = borHMesh3HEFace(h);
+    n0 = borHMesh3HENext(h);
+    p0 = borHMesh3HEPrev(h);
+    c = m->he[p0].v;
+
+    f1 = n1 = p1 = d = -1;
+    if (t >= 0){
+        f1 = borHMesh3HEFace(t);
+        n1 = borHMesh3HENext(t);
+        p1 = borHMesh3HEPrev(t);
+        d = m->he[p1].v;
+    }
+
+    // link condition: the only common neighbours are c and d
+    common = 0;
+    start = g = m->vhe[b];
+    last = -1;
+    while (g >= 0){
+        last = g;
+        if (hmesh3IsNeighbour(m, a, borHMesh3HETarget(m, g)))
+            ++common;
+        g = borHMesh3HERotCCW(m, g);
+        if (g == start)
+            break;
+    }
+    if (g < 0 && hmesh3IsNeighbour(m, a, m->he[borHMesh3HEPrev(last)].v))
+        ++common;
+    if (common != (t >= 0 ? 2 : 1))
+        return -1;
+
+    // interior edge between boundary vertices would pinch the surface
+    if (t >= 0 && hmesh3IsBoundary(m, a) && hmesh3IsBoundary(m, b))
+        return -1;
+
+    // opposite interior vertices of valence 3 would end up with two faces
+    // sharing all vertices
+    if (!hmesh3IsBoundary(m, c) && hmesh3Valence(m, c) <= 3)
+        return -1;
+    if (t >= 0 && !hmesh3IsBoundary(m, d) && hmesh3Valence(m, d) <= 3)
+        return -1;
+
+    // any half-edge that stays outgoing from a
+    cand = -1;
+    start = g = m->vhe[b];
+    while (g >= 0){
+        if (borHMesh3HEFace(g) != f0 && borHMesh3HEFace(g) != f1)
+            cand = g;
+        m->he[g].v = a;
+        g = borHMesh3HERotCCW(m, g);
+        if (g == start)
+            break;
+    }
+    start = g = m->vhe[a];
+    while (cand < 0 && g >= 0){
+        if (borHMesh3HEFace(g) != f0 && borHMesh3HEFace(g) != f1)
+            cand = g;
+        g = borHMesh3HERotCCW(m, g);
+        if (g == start)
+            break;
+    }
+
+    // glue the remaining edges of the removed faces
+    tn0 = m->he[n0].twin;
+    tp0 = m->he[p0].twin;
+    if (tn0 >= 0)
+        m->he[tn0].twin = tp0;
+    if (tp0 >= 0)
+        m->he[tp0].twin = tn0;
+
+    tn1 = tp1 = -1;
+    if (t >= 0){
+        tn1 = m->he[n1].twin;
+        tp1 = m->he[p1].twin;
+        if (tn1 >= 0)
+            m->he[tn1].twin = tp1;
+        if (tp1 >= 0)
+            m->he[tp1].twin = tn1;
+    }
+
+    hmesh3FreeFace(m, f0);
+    if (t >= 0)
+        hmesh3FreeFace(m, f1);
+
+    if (tp0 >= 0){
+        hmesh3SetVHE(m, a, tp0);
+    }else if (tp1 >= 0){
+        hmesh3SetVHE(m, a, tp1);
+    }else{
+        hmesh3SetVHE(m, a, cand);
+    }
+
+    if (tn0 >= 0){
+        hmesh3SetVHE(m, c, tn0);
+    }else{
+        hmesh3SetVHE(m, c, (tp0 >= 0 ? borHMesh3HENext(tp0) : -1));
+    }
+
+    if (t >= 0){
+        if (tn1 >= 0){
+            hmesh3SetVHE(m, d, tn1);
+        }else{
+            hmesh3SetVHE(m, d, (tp1 >= 0 ? borHMesh3HENext(tp1) : -1));
+        }
+    }
+
+    m->vhe[b] = VFREE_ENC(m->verts_free);
+    m->verts_free = b;
+    --m->verts_num;
+
+    return 0;
+}
+
+bor_hmesh3_t *borHMesh3FromMesh3(bor_mesh3_t *mesh)
+{
+    bor_hmesh3_t *m;
+    bor_list_t *list;
+    bor_mesh3_vertex_t *v, *vs[3];
+    bor_mesh3_face_t *f;
+    bor_vec3_t *coords;
+    int *tris;
+    int i, n;
+
+    n = borMesh3VerticesLen(mesh);
+    coords = BOR_ALLOC_ARR(bor_vec3_t, BOR_MAX(n, 1));
+    tris = BOR_ALLOC_ARR(int, BOR_MAX(3 * borMesh3FacesLen(mesh), 1));
+
+    i = 0;
+    list = borMesh3Vertices(mesh);
+    BOR_LIST_FOR_EACH_ENTRY(list, bor_mesh3_vertex_t, v, list){
+        borVec3Copy(&coords[i], borMesh3VertexCoords(v));
+        v->_id = i++;
+    }
+
+    i = 0;
+    list = borMesh3Faces(mesh);
+    BOR_LIST_FOR_EACH_ENTRY(list, bor_mesh3_face_t, f, list){
+        borMesh3FaceVertices(f, vs);
+        tris[i++] = vs[0]->_id;
+        tris[i++] = vs[1]->_id;
+        tris[i++] = vs[2]->_id;
+    }
+
+    m = borHMesh3NewSoup(coords, n, tris, i / 3, BOR_HMESH3_ORIENT);
+
+    BOR_FREE(coords);
+    BOR_FREE(tris);
+    return m;
+}
+
+bor_mesh3_t *borHMesh3ToMesh3(const bor_hmesh3_t *m, bor_vec3_t *coords)
+{
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **verts;
+    bor_mesh3_edge_t **edges;
+    bor_mesh3_face_t *face;
+    int v, f, h, t;
+
+    mesh = borMesh3New();
+    verts = BOR_CALLOC_ARR(bor_mesh3_vertex_t *, BOR_MAX(m->verts_len, 1));
+    edges = BOR_ALLOC_ARR(bor_mesh3_edge_t *, BOR_MAX(3 * m->faces_len, 1));
+
+    for (v = 0; v < m->verts_len; v++){
+        if (!borHMesh3VertexAlive(m, v))
+            continue;
+
+        borVec3Copy(&coords[v], &m->coords[v]);
+        verts[v] = borMesh3VertexAlloc(mesh);
+        borMesh3VertexSetCoords(verts[v], &coords[v]);
+        borMesh3AddVertex(mesh, verts[v]);
+    }
+
+    for (f = 0; f < m->faces_len; f++){
+        if (!borHMesh3FaceAlive(m, f))
+            continue;
+
+        for (h = 3 * f; h < 3 * f + 3; h++){
+            t = m->he[h].twin;
+            if (t >= 0 && t < h){
+                edges[h] = edges[t];
+            }else{
+                edges[h] = borMesh3EdgeAlloc(mesh);
+                borMesh3AddEdge(mesh, edges[h],
+                                verts[m->he[h].v],
+                                verts[borHMesh3HETarget(m, h)]);
+            }
+        }
+
+        face = borMesh3FaceAlloc(mesh);
+        borMesh3AddFace(mesh, face, edges[3 * f], edges[3 * f + 1],
+                        edges[3 * f + 2]);
+    }
+
+    BOR_FREE(verts);
+    BOR_FREE(edges);
+    return mesh;
+}
+
+void borHMesh3Mesh3Del(bor_mesh3_t *mesh)
+{
+    borMesh3Del(mesh);
+}
+
+
+
+static void soupEdgesInit(soup_edges_t *se, const int *tris, int tris_len,
+                          int verts_len)
+{
+    int f, k, a, b, i;
+
+    se->start = BOR_CALLOC_ARR(int, verts_len + 2);
+    se->other = BOR_ALLOC_ARR(int, BOR_MAX(3 * tris_len, 1));
+    se->face = BOR_ALLOC_ARR(int, BOR_MAX(3 * tris_len, 1));
+
+    for (i = 0; i < 3 * tris_len; i++){
+        a = tris[i];
+        b = tris[borHMesh3HENext(i)];
+        ++se->start[BOR_MIN(a, b) + 2];
+    }
+    for (i = 2; i < verts_len + 2; i++)
+        se->start[i] += se->start[i - 1];
+
+    for (f = 0; f < tris_len; f++){
+        for (k = 0; k < 3; k++){
+            a = tris[3 * f + k];
+            b = tris[3 * f + (k + 1) % 3];
+            i = se->start[BOR_MIN(a, b) + 1]++;
+            se->other[i] = BOR_MAX(a, b);
+            se->face[i] = f;
+        }
+    }
+}
+
+static void soupEdgesFree(soup_edges_t *se)
+{
+    BOR_FREE(se->start);
+    BOR_FREE(se->other);
+    BOR_FREE(se->face);
+}
+
+static int soupEdgesAdj(const soup_edges_t *se, int f, int a, int b)
+{
+    int i, to, lo, hi, adj = -1;
+
+    lo = BOR_MIN(a, b);
+    hi = BOR_MAX(a, b);
+    to = se->start[lo + 1];
+    for (i = se->start[lo]; i < to; i++){
+        if (se->other[i] != hi || se->face[i] == f)
+            continue;
+        if (adj >= 0)
+            return -1;
+        adj = se->face[i];
+    }
+    return adj;
+}
+
+static int soupTriIndex(const int *tris, int f, int v)
+{
+    if (tris[3 * f] == v)
+        return 0;
+    if (tris[3 * f + 1] == v)
+        return 1;
+    return 2;
+}
+
+static void soupOrient(const soup_edges_t *se, int *tris, int tris_len)
+{
+    char *visited;
+    int *queue, qhead, qtail;
+    int f, g, k, a, b, i, tmp;
+
+    visited = BOR_CALLOC_ARR(char, BOR_MAX(tris_len, 1));
+    queue = BOR_ALLOC_ARR(int, BOR_MAX(tris_len, 1));
+
+    for (f = 0; f < tris_len; f++){
+        if (visited[f])
+            continue;
+
+        visited[f] = 1;
+        queue[0] = f;
+        qhead = 0;
+        qtail = 1;
+        while (qhead < qtail){
+            g = queue[qhead++];
+            for (k = 0; k < 3; k++){
+                a = tris[3 * g + k];
+                b = tris[3 * g + (k + 1) % 3];
+                i = soupEdgesAdj(se, g, a, b);
+                if (i < 0 || visited[i])
+                    continue;
+
+                // the neighbour must traverse the edge as (b, a)
+                if (tris[3 * i + (soupTriIndex(tris, i, a) + 1) % 3] == b)
+                    BOR_SWAP(tris[3 * i + 1], tris[3 * i + 2], tmp);
+                visited[i] = 1;
+                queue[qtail++] = i;
+            }
+        }
+    }
+
+    BOR_FREE(visited);
+    BOR_FREE(queue);
+}
+
+static void hmesh3ReserveVerts(bor_hmesh3_t *m, int n)
+{
+    if (m->verts_len + n > m->verts_size){
+        m->verts_size = BOR_MAX(2 * m->verts_size, m->verts_len + n);
+        m->verts_size = BOR_MAX(m->verts_size, 16);
+        m->coords = BOR_REALLOC_ARR(m->coords, bor_vec3_t, m->verts_size);
+        m->vhe = BOR_REALLOC_ARR(m->vhe, int, m->verts_size);
+    }
+}
+
+static void hmesh3ReserveFaces(bor_hmesh3_t *m, int n)
+{
+    if (m->faces_len + n > m->faces_size){
+        m->faces_size = BOR_MAX(2 * m->faces_size, m->faces_len + n);
+        m->faces_size = BOR_MAX(m->faces_size, 16);
+        m->he = BOR_REALLOC_ARR(m->he, bor_hmesh3_he_t, 3 * m->faces_size);
+    }
+}
+
+static int hmesh3NewFace(bor_hmesh3_t *m)
+{
+    int f;
+
+    if (m->faces_free >= 0){
+        f = m->faces_free;
+        m->faces_free = m->he[3 * f].twin;
+    }else{
+        hmesh3ReserveFaces(m, 1);
+        f = m->faces_len++;
+    }
+    ++m->faces_num;
+    return f;
+}
+
+static void hmesh3FreeFace(bor_hmesh3_t *m, int f)
+{
+    m->he[3 * f].v = m->he[3 * f + 1].v = m->he[3 * f + 2].v = -1;
+    m->he[3 * f + 1].twin = m->he[3 * f + 2].twin = -1;
+    m->he[3 * f].twin = m->faces_free;
+    m->faces_free = f;
+    --m->faces_num;
+}
+
+static void hmesh3SetVHE(bor_hmesh3_t *m, int v, int h)
+{
+    int g, p;
+
+    if (h < 0){
+        m->vhe[v] = -1;
+        return;
+    }
+
+    g = h;
+    while ((p = borHMesh3HERotCW(m, g)) >= 0 && p != h)
+        g = p;
+    m->vhe[v] = (p < 0 ? g : h);
+}
+
+static int hmesh3IsBoundary(const bor_hmesh3_t *m, int v)
+{
+    return m->vhe[v] < 0 || m->he[m->vhe[v]].twin < 0;
+}
+
+static int hmesh3IsNeighbour(const bor_hmesh3_t *m, int u, int v)
+{
+    int start, g, last = -1;
+
+    start = g = m->vhe[u];
+    while (g >= 0){
+        last = g;
+        if (borHMesh3HETarget(m, g) == v)
+            return 1;
+        g = borHMesh3HERotCCW(m, g);
+        if (g == start)
+            return 0;
+    }
+    return last >= 0 && m->he[borHMesh3HEPrev(last)].v == v;
+}
+
+static int hmesh3Valence(const bor_hmesh3_t *m, int v)
+{
+    int start, g, n = 0;
+
+    start = g = m->vhe[v];
+    while (g >= 0){
+        ++n;
+        g = borHMesh3HERotCCW(m, g);
+        if (g == start)
+            return n;
+    }
+    return (n > 0 ? n + 1 : 0);
+}
@@ -0,0 +1,308 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <boruvka/alloc.h>
+#include <boruvka/hset.h>
+
+/** Switches to the array representation */
+static void toArr(bor_hset_t *s);
+/** Switches to the bitset representation */
+static void toBits(bor_hset_t *s);
+/** Switches the representation if it is too sparse or too dense */
+static void adjust(bor_hset_t *s);
+/** Returns number of words of a bitset holding the elements */
+static int hsetWords(const bor_hset_t *s);
+/** Keeps only elements of the array that are (not) in the bitset */
+static void filterArr(bor_iset_t *arr, const bor_bset_t *bits, int keep_in);
+
+void borHSetInit(bor_hset_t *s)
+{
+    bzero(s, sizeof(*s));
+}
+
+void borHSetFree(bor_hset_t *s)
+{
+    borISetFree(&s->arr);
+    borBSetFree(&s->bits);
+}
+
+void borHSetEmpty(bor_hset_t *s)
+{
+    if (s->dense){
+        borBSetFree(&s->bits);
+        borBSetInit(&s->bits);
+        s->dense = 0;
+        s->bits_size = 0;
+    }
+    borISetEmpty(&s->arr);
+}
+
+void borHSetAdd(bor_hset_t *s, int val)
+{
+    /* do not grow the bitset if it would be switched to the array */
+    if (s->dense && (val >> 6) >= s->bits.size
+            && s->bits_size + 1 < (val >> 6) + 1){
+        toArr(s);
+    }
+
+    if (s->dense){
+        if (!borBSetIn(val, &s->bits)){
+            borBSetAdd(&s->bits, val);
+            ++s->bits_size;
+        }
+    }else{
+        borISetAdd(&s->arr, val);
+    }
+    adjust(s);
+}
+
+int borHSetRm(bor_hset_t *s, int val)
+{
+    int found;
+
+    if (s->dense){
+        found = borBSetRm(&s->bits, val);
+        s->bits_size -= found;
+    }else{
+        found = borISetRm(&s->arr, val);
+    }
+    adjust(s);
+    return found;
+}
+
+void borHSetSet(bor_hset_t *d, const bor_hset_t *s)
+{
+    if (d == s)
+        return;
+
+    borHSetEmpty(d);
+    if (s->dense){
+        borBSetSet(&d->bits, &s->bits);
+        d->bits_size = s->bits_size;
+        d->dense = 1;
+    }else{
+        borISetSet(&d->arr, &s->arr);
+    }
+}
+
+void borHSetUnion(bor_hset_t *dst, const bor_hset_t *src)
+{
+    bor_iset_t tmp;
+    int i, words;
+
+    /* number of words of the bitset holding the union */
+    words = BOR_MAX(hsetWords(dst), hsetWords(src));
+    if (dst->dense && borHSetSize(dst) + borHSetSize(src) < words)
+        toArr(dst);
+
+    if (!dst->dense && !src->dense){
+        borISetUnion(&dst->arr, &src->arr);
+
+    }else if (dst->dense && !src->dense){
+        for (i = 0; i < src->arr.size; ++i){
+            if (!borBSetIn(src->arr.s[i], &dst->bits)){
+                borBSetAdd(&dst->bits, src->arr.s[i]);
+                ++dst->bits_size;
+            }
+        }
+
+    }else if (!dst->dense && borHSetSize(dst) + src->bits_size < words){
+        borISetInit(&tmp);
+        borBSetToISet(&src->bits, &tmp);
+        borISetUnion(&dst->arr, &tmp);
+        borISetFree(&tmp);
+
+    }else{
+        if (!dst->dense)
+            toBits(dst);
+        borBSetUnion(&dst->bits, &src->bits);
+        dst->bits_size = borBSetSize(&dst->bits);
+    }
+    adjust(dst);
+}
+
+void borHSetIntersect(bor_hset_t *dst, const bor_hset_t *src)
+{
+    if (!dst->dense && !src->dense){
+        borISetIntersect(&dst->arr, &src->arr);
+
+    }else if (dst->dense && !src->dense){
+        /* the intersection is a subset of src */
+        borISetSet(&dst->arr, &src->arr);
+        filterArr(&dst->arr, &dst->bits, 1);
+        borBSetFree(&dst->bits);
+        borBSetInit(&dst->bits);
+        dst->dense = 0;
+        dst->bits_size = 0;
+
+    }else if (!dst->dense && src->dense){
+        filterArr(&dst->arr, &src->bits, 1);
+
+    }else{
+        borBSetIntersect(&dst->bits, &src->bits);
+        dst->bits_size = borBSetSize(&dst->bits);
+    }
+    adjust(dst);
+}
+
+void borHSetMinus(bor_hset_t *s1, const bor_hset_t *s2)
+{
+    int i;
+
+    if (!s1->dense && !s2->dense){
+        borISetMinus(&s1->arr, &s2->arr);
+
+    }else if (s1->dense && !s2->dense){
+        for (i = 0; i < s2->arr.size; ++i)
+            s1->bits_size -= borBSetRm(&s1->bits, s2->arr.s[i]);
+
+    }else if (!s1->dense && s2->dense){
+        filterArr(&s1->arr, &s2->bits, 0);
+
+    }else{
+        borBSetMinus(&s1->bits, &s2->bits);
+        s1->bits_size = borBSetSize(&s1->bits);
+    }
+    adjust(s1);
+}
+
+int borHSetIsSubset(const bor_hset_t *s1, const bor_hset_t *s2)
+{
+    int i, v;
+
+    if (borHSetSize(s1) > borHSetSize(s2))
+        return 0;
+
+    if (!s1->dense && !s2->dense)
+        return borISetIsSubset(&s1->arr, &s2->arr);
+    if (s1->dense && s2->dense)
+        return borBSetIsSubset(&s1->bits, &s2->bits);
+
+    if (!s1->dense){
+        for (i = 0; i < s1->arr.size; ++i){
+            if (!borBSetIn(s1->arr.s[i], &s2->bits))
+                return 0;
+        }
+        return 1;
+    }
+
+    /* both are sorted, so they are merged */
+    i = 0;
+    BOR_BSET_FOR_EACH(&s1->bits, v){
+        while (i < s2->arr.size && s2->arr.s[i] < v)
+            ++i;
+        if (i == s2->arr.size || s2->arr.s[i] != v)
+            return 0;
+    }
+    return 1;
+}
+
+int borHSetIntersectionSize(const bor_hset_t *s1, const bor_hset_t *s2)
+{
+    const bor_hset_t *arr, *bits;
+    int i, size;
+
+    if (!s1->dense && !s2->dense)
+        return borISetIntersectionSize(&s1->arr, &s2->arr);
+    if (s1->dense && s2->dense)
+        return borBSetIntersectionSize(&s1->bits, &s2->bits);
+
+    arr = (s1->dense ? s2 : s1);
+    bits = (s1->dense ? s1 : s2);
+    size = 0;
+    for (i = 0; i < arr->arr.size; ++i)
+        size += borBSetIn(arr->arr.s[i], &bits->bits);
+    return size;
+}
+
+int borHSetEq(const bor_hset_t *s1, const bor_hset_t *s2)
+{
+    if (borHSetSize(s1) != borHSetSize(s2))
+        return 0;
+    return borHSetIsSubset(s1, s2);
+}
+
+void borHSetFromISet(bor_hset_t *d, const bor_iset_t *s)
+{
+    borHSetEmpty(d);
+    borISetSet(&d->arr, s);
+    adjust(d);
+}
+
+void borHSetToISet(const bor_hset_t *s, bor_iset_t *d)
+{
+    if (s->dense){
+        borBSetToISet(&s->bits, d);
+    }else{
+        borISetSet(d, &s->arr);
+    }
+}
+
+
+static void toArr(bor_hset_t *s)
+{
+    borBSetToISet(&s->bits, &s->arr);
+    borBSetFree(&s->bits);
+    borBSetInit(&s->bits);
+    s->dense = 0;
+    s->bits_size = 0;
+}
+
+static void toBits(bor_hset_t *s)
+{
+    borBSetFromISet(&s->bits, &s->arr);
+    s->bits_size = s->arr.size;
+    s->dense = 1;
+    borISetFree(&s->arr);
+    borISetInit(&s->arr);
+}
+
+static void adjust(bor_hset_t *s)
+{
+    long u;
+
+    if (s->dense){
+        u = 64L * borBSetUsedWords(&s->bits);
+        if (64L * s->bits_size < u)
+            toArr(s);
+
+    }else if (s->arr.size > 0){
+        u = s->arr.s[s->arr.size - 1] + 1L;
+        if (32L * s->arr.size >= u)
+            toBits(s);
+    }
+}
+
+static int hsetWords(const bor_hset_t *s)
+{
+    if (s->dense)
+        return borBSetUsedWords(&s->bits);
+    if (s->arr.size == 0)
+        return 0;
+    return (s->arr.s[s->arr.size - 1] >> 6) + 1;
+}
+
+static void filterArr(bor_iset_t *arr, const bor_bset_t *bits, int keep_in)
+{
+    int i, len;
+
+    len = 0;
+    for (i = 0; i < arr->size; ++i){
+        if (borBSetIn(arr->s[i], bits) == keep_in)
+            arr->s[len++] = arr->s[i];
+    }
+    arr->size = len;
+}
@@ -0,0 +1,188 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <stdio.h>
+#include "boruvka/alloc.h"
+#include "boruvka/iradixq.h"
+
+/** Returns bucket of the key relative to the last popped key */
+_bor_inline int bucketIdx(const bor_iradixq_t *q, long key)
+{
+    unsigned long diff = (unsigned long)key ^ (unsigned long)q->last;
+    if (diff == 0)
+        return 0;
+    return 8 * sizeof(long) - __builtin_clzl(diff);
+}
+
+/** Adds i'th element to the bucket */
+static void bucketAdd(bor_iradixq_t *q, int b, int i)
+{
+    bor_iradixq_bucket_t *bucket = q->bucket + b;
+
+    if (bucket->size == bucket->alloc){
+        if (bucket->alloc == 0){
+            bucket->alloc = BOR_IRADIXQ_BUCKET_INIT_SIZE;
+        }else{
+            bucket->alloc *= 2;
+        }
+        bucket->el = BOR_REALLOC_ARR(bucket->el, int, bucket->alloc);
+    }
+
+    q->el[i].bucket = b;
+    q->el[i].pos = bucket->size;
+    bucket->el[bucket->size++] = i;
+}
+
+/** Removes i'th element from its bucket */
+static void bucketRemove(bor_iradixq_t *q, int i)
+{
+    bor_iradixq_bucket_t *bucket = q->bucket + q->el[i].bucket;
+    int pos = q->el[i].pos;
+
+    bucket->el[pos] = bucket->el[--bucket->size];
+    q->el[bucket->el[pos]].pos = pos;
+}
+
+static void checkKey(const bor_iradixq_t *q, long key)
+{
+    if (key < q->last){
+        fprintf(stderr, "Error: borIRadixQ: key %ld is lower than the"
+                        " last popped key %ld.\n", key, q->last);
+        exit(-1);
+    }
+}
+
+void borIRadixQInit(bor_iradixq_t *q)
+{
+    bzero(q->bucket, sizeof(q->bucket));
+    q->el = NULL;
+    q->el_alloc = 0;
+    q->el_free = -1;
+    q->last = 0;
+    q->size = 0;
+}
+
+void borIRadixQFree(bor_iradixq_t *q)
+{
+    int i;
+
+    for (i = 0; i < BOR_IRADIXQ_BUCKETS; ++i){
+        if (q->bucket[i].el != NULL)
+            BOR_FREE(q->bucket[i].el);
+    }
+    if (q->el != NULL)
+        BOR_FREE(q->el);
+}
+
+void borIRadixQClear(bor_iradixq_t *q)
+{
+    bor_iradixq_bucket_t *bucket;
+    int b, j, i;
+
+    for (b = 0; b < BOR_IRADIXQ_BUCKETS; ++b){
+        bucket = q->bucket + b;
+        for (j = 0; j < bucket->size; ++j){
+            i = bucket->el[j];
+            q->el[i].bucket = -1;
+            q->el[i].pos = q->el_free;
+            q->el_free = i;
+        }
+        bucket->size = 0;
+    }
+    q->last = 0;
+    q->size = 0;
+}
+
+int borIRadixQPush(bor_iradixq_t *q, long key, int value)
+{
+    int i, alloc;
+
+    checkKey(q, key);
+
+    if (q->el_free < 0){
+        alloc = (q->el_alloc == 0 ? BOR_IRADIXQ_BUCKET_INIT_SIZE
+                                  : 2 * q->el_alloc);
+        q->el = BOR_REALLOC_ARR(q->el, bor_iradixq_el_t, alloc);
+        for (i = alloc - 1; i >= q->el_alloc; --i){
+            q->el[i].bucket = -1;
+            q->el[i].pos = q->el_free;
+            q->el_free = i;
+        }
+        q->el_alloc = alloc;
+    }
+
+    i = q->el_free;
+    q->el_free = q->el[i].pos;
+    q->el[i].key = key;
+    q->el[i].value = value;
+    bucketAdd(q, bucketIdx(q, key), i);
+    ++q->size;
+    return i;
+}
+
+int borIRadixQPop(bor_iradixq_t *q, long *key)
+{
+    bor_iradixq_bucket_t *bucket;
+    int b, i, j;
+    long min;
+
+    if (q->size == 0){
+        fprintf(stderr, "Error: borIRadixQ is empty!\n");
+        exit(-1);
+    }
+
+    /* If there is nothing with the last key, the lowest non-empty bucket
+     * is redistributed using its minimal key as the new last key. All its
+     * elements end up in lower buckets because they share all bits above
+     * the bucket's bit with the minimal key. */
+    if (q->bucket[0].size == 0){
+        for (b = 1; q->bucket[b].size == 0; ++b);
+        bucket = q->bucket + b;
+
+        min = q->el[bucket->el[0]].key;
+        for (j = 1; j < bucket->size; ++j)
+            min = BOR_MIN(min, q->el[bucket->el[j]].key);
+        q->last = min;
+
+        for (j = 0; j < bucket->size; ++j){
+            i = bucket->el[j];
+            bucketAdd(q, bucketIdx(q, q->el[i].key), i);
+        }
+        bucket->size = 0;
+    }
+
+    bucket = q->bucket;
+    i = bucket->el[--bucket->size];
+    *key = q->el[i].key;
+    q->el[i].bucket = -1;
+    q->el[i].pos = q->el_free;
+    q->el_free = i;
+    --q->size;
+    return q->el[i].value;
+}
+
+void borIRadixQDecreaseKey(bor_iradixq_t *q, int i, long key)
+{
+    int b;
+
+    checkKey(q, key);
+    q->el[i].key = key;
+    b = bucketIdx(q, key);
+    if (b != q->el[i].bucket){
+        bucketRemove(q, i);
+        bucketAdd(q, b, i);
+    }
+}
@@ -119,3 +119,380 @@ int borMat3Eigen(const bor_mat3_t *_m, bor_mat3_t *eigen,
 
     return 0;
 }
+
+/** Symmetric 3x3 eigensolver.
+ *  The algorithm follows D. Eberly: A Robust Eigensolver for 3x3 Symmetric
+ *  Matrices. Eigenvalues are computed in closed form, the eigenvector of
+ *  the most separated eigenvalue is computed from cross products of rows
+ *  of (A - l * I) and the second one is computed in the orthogonal
+ *  complement of the first one which handles repeated eigenvalues without
+ *  any iteration.
+ *
+ *  Matrices are processed in blocks stored as structure of arrays and all
+ *  loops over a block are branch-free so that they can be vectorized by
+ *  the compiler. */
+#define EIGEN_SYM_BLOCK 8
+
+/** If the smallest eigenvalue is separated at least by this value (with
+ *  the matrix scaled to [-1, 1]) its eigenvector is computed directly from
+ *  cross products even if it is not the most separated one. */
+#define EIGEN_SYM_MIN_GAP 1E-2
+
+struct _eigen_sym_t {
+    double a00[EIGEN_SYM_BLOCK];
+    double a01[EIGEN_SYM_BLOCK];
+    double a02[EIGEN_SYM_BLOCK];
+    double a11[EIGEN_SYM_BLOCK];
+    double a12[EIGEN_SYM_BLOCK];
+    double a22[EIGEN_SYM_BLOCK];
+    double scale[EIGEN_SYM_BLOCK]; /*!< Scale of the matrix */
+    double eval[3][EIGEN_SYM_BLOCK]; /*!< Ascending eigenvalues */
+    double diag[EIGEN_SYM_BLOCK]; /*!< 1. if the matrix is diagonal */
+    double sep[EIGEN_SYM_BLOCK]; /*!< 1. if the largest eigenvalue is the
+                                      most separated one, 0. if the
+                                      smallest one is. */
+    double vec0[3][EIGEN_SYM_BLOCK]; /*!< Eigenvector of eval[0] or eval[2]
+                                          based on .sep */
+    double vec1[3][EIGEN_SYM_BLOCK]; /*!< Eigenvector of eval[1] */
+};
+typedef struct _eigen_sym_t eigen_sym_t;
+
+/** Loads upper triangles of len matrices scaled to [-1, 1] and computes
+ *  their eigenvalues */
+static void eigenSymVals(eigen_sym_t *b, const bor_mat3_t *m, int len)
+{
+    double maxabs, inv, norm, q, b00, b11, b22, p, c00, c01, c02;
+    double half_det, beta0, beta1, beta2, wx, wy, zx, zy, z2x, z2y, z4;
+    int i, it;
+
+    for (i = 0; i < len; ++i){
+        b->a00[i] = borMat3Get(m + i, 0, 0);
+        b->a01[i] = borMat3Get(m + i, 0, 1);
+        b->a02[i] = borMat3Get(m + i, 0, 2);
+        b->a11[i] = borMat3Get(m + i, 1, 1);
+        b->a12[i] = borMat3Get(m + i, 1, 2);
+        b->a22[i] = borMat3Get(m + i, 2, 2);
+    }
+    for (; i < EIGEN_SYM_BLOCK; ++i){
+        b->a00[i] = b->a01[i] = b->a02[i] = 0.;
+        b->a11[i] = b->a12[i] = b->a22[i] = 0.;
+    }
+
+    for (i = 0; i < EIGEN_SYM_BLOCK; ++i){
+        maxabs = fmax(fmax(fabs(b->a00[i]), fabs(b->a01[i])),
+                      fmax(fabs(b->a02[i]), fabs(b->a11[i])));
+        maxabs = fmax(maxabs, fmax(fabs(b->a12[i]), fabs(b->a22[i])));
+        inv = (maxabs > 0. ? 1. / maxabs : 0.);
+        b->scale[i] = maxabs;
+        b->a00[i] *= inv;
+        b->a01[i] *= inv;
+        b->a02[i] *= inv;
+        b->a11[i] *= inv;
+        b->a12[i] *= inv;
+        b->a22[i] *= inv;
+
+        norm  = b->a01[i] * b->a01[i];
+        norm += b->a02[i] * b->a02[i];
+        norm += b->a12[i] * b->a12[i];
+
+        q = (b->a00[i] + b->a11[i] + b->a22[i]) / 3.;
+        b00 = b->a00[i] - q;
+        b11 = b->a11[i] - q;
+        b22 = b->a22[i] - q;
+        p = sqrt((b00 * b00 + b11 * b11 + b22 * b22 + 2. * norm) / 6.);
+        p = (norm > 0. ? p : 1.);
+        c00 = b11 * b22 - b->a12[i] * b->a12[i];
+        c01 = b->a01[i] * b22 - b->a12[i] * b->a02[i];
+        c02 = b->a01[i] * b->a12[i] - b11 * b->a02[i];
+        half_det  = b00 * c00 - b->a01[i] * c01 + b->a02[i] * c02;
+        half_det *= 0.5 / (p * p * p);
+        half_det = fmin(fmax(half_det, -1.), 1.);
+
+        // Roots of beta^3 - 3 * beta - 2 * half_det are
+        // 2 * cos(acos(half_det) / 3 + k * 2 * pi / 3). Instead of calling
+        // acos() and cos() (which would prevent vectorization) the cube
+        // root z of the unit complex number (half_det, sqrt(1 - half_det^2))
+        // is found by a fixed number of Newton iterations
+        // z = (2 * z + w / z^2) / 3 which are enough to reach machine
+        // precision from the initial linear guess.
+        wx = half_det;
+        wy = sqrt(1. - half_det * half_det);
+        zx = 0.75 + 0.25 * half_det;
+        zy = sqrt(1. - zx * zx);
+        for (it = 0; it < 5; ++it){
+            z2x = zx * zx - zy * zy;
+            z2y = 2. * zx * zy;
+            z4 = z2x * z2x + z2y * z2y;
+            zx = (2. * zx + (wx * z2x + wy * z2y) / z4) / 3.;
+            zy = (2. * zy + (wy * z2x - wx * z2y) / z4) / 3.;
+        }
+        beta2 = 2. * zx;
+        beta0 = -zx - 1.73205080756887729352744634150587237 * zy;
+        beta1 = -(beta0 + beta2);
+
+        b->eval[0][i] = q + p * beta0;
+        b->eval[1][i] = q + p * beta1;
+        b->eval[2][i] = q + p * beta2;
+        b->diag[i] = (norm > 0. ? 0. : 1.);
+        b->sep[i] = (half_det >= 0. ? 1. : 0.);
+    }
+}
+
+/** Computes .vec0 as the eigenvector of eval[0] if sel[i] == 0. or of
+ *  eval[2] otherwise. The eigenvalue must be simple. */
+static void eigenSymVec0(eigen_sym_t *b, const double *sel)
+{
+    double e, r0[3], r1[3], r2[3], c01[3], c02[3], c12[3];
+    double d01, d02, d12, dmax, inv, x, y, z;
+    int i;
+
+    for (i = 0; i < EIGEN_SYM_BLOCK; ++i){
+        // Both values are loaded unconditionally so that the select can
+        // be vectorized
+        e = b->eval[0][i];
+        x = b->eval[2][i];
+        e = (sel[i] > 0. ? x : e);
+
+        r0[0] = b->a00[i] - e;
+        r0[1] = b->a01[i];
+        r0[2] = b->a02[i];
+        r1[0] = b->a01[i];
+        r1[1] = b->a11[i] - e;
+        r1[2] = b->a12[i];
+        r2[0] = b->a02[i];
+        r2[1] = b->a12[i];
+        r2[2] = b->a22[i] - e;
+
+        c01[0] = r0[1] * r1[2] - r0[2] * r1[1];
+        c01[1] = r0[2] * r1[0] - r0[0] * r1[2];
+        c01[2] = r0[0] * r1[1] - r0[1] * r1[0];
+        c02[0] = r0[1] * r2[2] - r0[2] * r2[1];
+        c02[1] = r0[2] * r2[0] - r0[0] * r2[2];
+        c02[2] = r0[0] * r2[1] - r0[1] * r2[0];
+        c12[0] = r1[1] * r2[2] - r1[2] * r2[1];
+        c12[1] = r1[2] * r2[0] - r1[0] * r2[2];
+        c12[2] = r1[0] * r2[1] - r1[1] * r2[0];
+        d01 = c01[0] * c01[0] + c01[1] * c01[1] + c01[2] * c01[2];
+        d02 = c02[0] * c02[0] + c02[1] * c02[1] + c02[2] * c02[2];
+        d12 = c12[0] * c12[0] + c12[1] * c12[1] + c12[2] * c12[2];
+
+        dmax = fmax(d01, fmax(d02, d12));
+        inv = (dmax > 0. ? 1. / sqrt(dmax) : 0.);
+        x = (d02 >= d12 ? c02[0] : c12[0]);
+        y = (d02 >= d12 ? c02[1] : c12[1]);
+        z = (d02 >= d12 ? c02[2] : c12[2]);
+        x = (d01 >= dmax ? c01[0] : x);
+        y = (d01 >= dmax ? c01[1] : y);
+        z = (d01 >= dmax ? c01[2] : z);
+        // Degenerate case (multiple of identity)
+        b->vec0[0][i] = (dmax > 0. ? x * inv : 1.);
+        b->vec0[1][i] = y * inv;
+        b->vec0[2][i] = z * inv;
+    }
+}
+
+/** Computes .vec1 as the eigenvector of eval[1] orthogonal to .vec0 */
+static void eigenSymVec1(eigen_sym_t *b)
+{
+    double w[3], u[3], v[3], au[3], av[3];
+    double inv, x, y, m00, m01, m11;
+    int i, k, first;
+
+    for (i = 0; i < EIGEN_SYM_BLOCK; ++i){
+        w[0] = b->vec0[0][i];
+        w[1] = b->vec0[1][i];
+        w[2] = b->vec0[2][i];
+
+        // Orthonormal basis {u, v} of the complement of w
+        first = fabs(w[0]) > fabs(w[1]);
+        x = (first ? w[0] : w[1]);
+        inv = 1. / sqrt(x * x + w[2] * w[2]);
+        u[0] = (first ? -w[2] * inv : 0.);
+        u[1] = (first ? 0. : w[2] * inv);
+        u[2] = (first ? w[0] * inv : -w[1] * inv);
+        v[0] = w[1] * u[2] - w[2] * u[1];
+        v[1] = w[2] * u[0] - w[0] * u[2];
+        v[2] = w[0] * u[1] - w[1] * u[0];
+
+        au[0] = b->a00[i] * u[0] + b->a01[i] * u[1] + b->a02[i] * u[2];
+        au[1] = b->a01[i] * u[0] + b->a11[i] * u[1] + b->a12[i] * u[2];
+        au[2] = b->a02[i] * u[0] + b->a12[i] * u[1] + b->a22[i] * u[2];
+        av[0] = b->a00[i] * v[0] + b->a01[i] * v[1] + b->a02[i] * v[2];
+        av[1] = b->a01[i] * v[0] + b->a11[i] * v[1] + b->a12[i] * v[2];
+        av[2] = b->a02[i] * v[0] + b->a12[i] * v[1] + b->a22[i] * v[2];
+
+        // 2x2 matrix (A - eval[1] * I) restricted to {u, v}
+        m00 = u[0] * au[0] + u[1] * au[1] + u[2] * au[2] - b->eval[1][i];
+        m01 = u[0] * av[0] + u[1] * av[1] + u[2] * av[2];
+        m11 = v[0] * av[0] + v[1] * av[1] + v[2] * av[2] - b->eval[1][i];
+
+        // The eigenvector is orthogonal to the row with larger diagonal
+        // element. If the whole matrix is zero any vector from {u, v}
+        // will do.
+        first = fabs(m00) >= fabs(m11);
+        x = (first ? m01 : m11);
+        y = (first ? m00 : m01);
+        inv = x * x + y * y;
+        inv = (inv > 0. ? 1. / sqrt(inv) : 0.);
+        x = (inv > 0. ? x * inv : 1.);
+        y = y * inv;
+        for (k = 0; k < 3; ++k)
+            b->vec1[k][i] = x * u[k] - y * v[k];
+    }
+}
+
+/** Sorts eigenvalues of a diagonal matrix, evec[i] is set to the
+ *  corresponding unit axis */
+static void eigenSymDiag(double *eval, double evec[3][3])
+{
+    int idx[3] = { 0, 1, 2 };
+    int i, j, tmpi;
+    double tmp;
+
+    for (i = 0; i < 2; ++i){
+        for (j = i + 1; j < 3; ++j){
+            if (eval[j] < eval[i]){
+                BOR_SWAP(eval[i], eval[j], tmp);
+                BOR_SWAP(idx[i], idx[j], tmpi);
+            }
+        }
+    }
+
+    for (i = 0; i < 3; ++i){
+        evec[i][0] = evec[i][1] = evec[i][2] = 0.;
+        evec[i][idx[i]] = 1.;
+    }
+}
+
+_bor_inline void eigenSymCross(double *d, const double *a, const double *b)
+{
+    d[0] = a[1] * b[2] - a[2] * b[1];
+    d[1] = a[2] * b[0] - a[0] * b[2];
+    d[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+/** Collects eigenvalues and eigenvectors of i'th matrix in the block */
+static void eigenSymGet(const eigen_sym_t *b, int i,
+                        double *eval, double evec[3][3])
+{
+    double v0[3], v1[3];
+    int k;
+
+    for (k = 0; k < 3; ++k){
+        v0[k] = b->vec0[k][i];
+        v1[k] = b->vec1[k][i];
+    }
+
+    if (b->diag[i] > 0.){
+        eval[0] = b->a00[i];
+        eval[1] = b->a11[i];
+        eval[2] = b->a22[i];
+        eigenSymDiag(eval, evec);
+
+    }else{
+        for (k = 0; k < 3; ++k){
+            eval[k] = b->eval[k][i];
+            evec[1][k] = v1[k];
+        }
+
+        if (b->sep[i] > 0.){
+            for (k = 0; k < 3; ++k)
+                evec[2][k] = v0[k];
+            eigenSymCross(evec[0], evec[1], evec[2]);
+        }else{
+            for (k = 0; k < 3; ++k)
+                evec[0][k] = v0[k];
+            eigenSymCross(evec[2], evec[0], evec[1]);
+        }
+    }
+
+    for (k = 0; k < 3; ++k)
+        eval[k] *= b->scale[i];
+}
+
+void borMat3EigenSym(const bor_mat3_t *m, bor_mat3_t *eigen,
+                     bor_vec3_t *eigenvals)
+{
+    borMat3EigenSymBatch(m, 1, eigen, eigenvals);
+}
+
+void borMat3EigenSymMin(const bor_mat3_t *m, bor_vec3_t *eigenvec,
+                        bor_real_t *eigenval)
+{
+    borMat3EigenSymMinBatch(m, 1, eigenvec, eigenval);
+}
+
+void borMat3EigenSymBatch(const bor_mat3_t *m, size_t len,
+                          bor_mat3_t *eigen, bor_vec3_t *eigenvals)
+{
+    eigen_sym_t b;
+    double eval[3], evec[3][3];
+    size_t i;
+    int j, blen;
+
+    for (i = 0; i < len; i += EIGEN_SYM_BLOCK){
+        blen = BOR_MIN(EIGEN_SYM_BLOCK, len - i);
+        eigenSymVals(&b, m + i, blen);
+        eigenSymVec0(&b, b.sep);
+        eigenSymVec1(&b);
+
+        for (j = 0; j < blen; ++j){
+            eigenSymGet(&b, j, eval, evec);
+            if (eigen){
+                borMat3Set(eigen + i + j,
+                           evec[0][0], evec[1][0], evec[2][0],
+                           evec[0][1], evec[1][1], evec[2][1],
+                           evec[0][2], evec[1][2], evec[2][2]);
+            }
+            if (eigenvals)
+                borVec3Set(eigenvals + i + j, eval[0], eval[1], eval[2]);
+        }
+    }
+}
+
+void borMat3EigenSymMinBatch(const bor_mat3_t *m, size_t len,
+                             bor_vec3_t *eigenvec, bor_real_t *eigenval)
+{
+    eigen_sym_t b;
+    double sel[EIGEN_SYM_BLOCK], eval[3], evec[3][3], need_vec1;
+    size_t i;
+    int j, blen;
+
+    for (i = 0; i < len; i += EIGEN_SYM_BLOCK){
+        blen = BOR_MIN(EIGEN_SYM_BLOCK, len - i);
+        eigenSymVals(&b, m + i, blen);
+
+        // Compute directly the eigenvector of the smallest eigenvalue
+        // wherever it is separated enough, second eigenvector is needed
+        // only for the rest.
+        need_vec1 = 0.;
+        for (j = 0; j < EIGEN_SYM_BLOCK; ++j){
+            sel[j] = b.sep[j];
+            if (b.eval[1][j] - b.eval[0][j] >= EIGEN_SYM_MIN_GAP)
+                sel[j] = 0.;
+            need_vec1 += sel[j];
+        }
+        eigenSymVec0(&b, sel);
+        if (need_vec1 > 0.)
+            eigenSymVec1(&b);
+
+        for (j = 0; j < blen; ++j){
+            if (b.diag[j] > 0. || sel[j] > 0.){
+                b.sep[j] = sel[j];
+                eigenSymGet(&b, j, eval, evec);
+            }else{
+                eval[0] = b.eval[0][j] * b.scale[j];
+                evec[0][0] = b.vec0[0][j];
+                evec[0][1] = b.vec0[1][j];
+                evec[0][2] = b.vec0[2][j];
+            }
+
+            if (eigenvec){
+                borVec3Set(eigenvec + i + j,
+                           evec[0][0], evec[0][1], evec[0][2]);
+            }
+            if (eigenval)
+                eigenval[i + j] = eval[0];
+        }
+    }
+}
@@ -0,0 +1,1069 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <boruvka/config_endian.h>
+#include <boruvka/mesh3.h>
+#include <boruvka/alloc.h>
+#include <boruvka/dbg.h>
+
+/** Size of buffer used for writing */
+#define OUT_BUF_SIZE (1024 * 1024)
+
+/** Magic string and version of native format */
+#define BIN_MAGIC "BORMESH3"
+#define BIN_VERSION 1
+/** Size of header of native format */
+#define BIN_HEADER_SIZE (8 + 4 + 4 + 3 * 8)
+
+/** Number of faces whose edges are prefetched before they are added */
+#define LOADER_QUEUE_SIZE 16
+
+#if !defined(BOR_LITTLE_ENDIAN) && !defined(BOR_BIG_ENDIAN)
+# error "Cannot determine endianness!"
+#endif
+
+#ifdef BOR_BIG_ENDIAN
+# define FROM_LE(ptr, size) swapBytes((ptr), (size))
+static void swapBytes(void *ptr, int size)
+{
+    unsigned char *p = ptr, c;
+    int i;
+
+    for (i = 0; i < size / 2; ++i){
+        c = p[i];
+        p[i] = p[size - i - 1];
+        p[size - i - 1] = c;
+    }
+}
+#else /* BOR_BIG_ENDIAN */
+# define FROM_LE(ptr, size)
+#endif /* BOR_BIG_ENDIAN */
+
+
+/**
+ * Buffered output
+ * ----------------
+ */
+struct _out_t {
+    FILE *out;
+    unsigned char *buf;
+    size_t len;
+    int err;
+};
+typedef struct _out_t out_t;
+
+static void outInit(out_t *o, FILE *out);
+/** Flushes buffer and frees it, returns 0 if no error occured */
+static int outFree(out_t *o);
+static void outFlush(out_t *o);
+/** Writes {size} bytes of {data} converted to little endian */
+_bor_inline void outLE(out_t *o, const void *data, int size);
+_bor_inline void outU32(out_t *o, uint32_t v);
+_bor_inline void outU64(out_t *o, uint64_t v);
+_bor_inline void outReal(out_t *o, bor_real_t v);
+/** Writes coordinates of all vertices and sets their ._id */
+static void outVertices(out_t *o, bor_mesh3_t *m);
+
+
+/**
+ * Loading
+ * --------
+ */
+struct _edge_bucket_t {
+    uint64_t key;
+    bor_mesh3_edge_t *e;
+};
+typedef struct _edge_bucket_t edge_bucket_t;
+
+struct _loader_t {
+    const char *fn;
+    bor_mesh3_t *mesh;
+    bor_vec3_t *coords;
+    bor_mesh3_vertex_t **verts;
+    size_t verts_len;
+
+    edge_bucket_t *edges; /*!< Open addressing hash table of edges */
+    size_t edges_len;     /*!< Number of used buckets */
+    size_t edges_mask;
+    int edges_shift;
+
+    size_t queue[LOADER_QUEUE_SIZE][3]; /*!< Faces waiting for adding */
+    int queue_len;
+    int queue_head;
+};
+typedef struct _loader_t loader_t;
+
+/** Creates mesh with {verts_len} vertices with uninitialized coordinates
+ *  in .coords and prepares hash table of edges for {faces_len} faces */
+static void loaderInit(loader_t *ld, const char *fn,
+                       size_t verts_len, size_t faces_len);
+/** Frees loader and either returns the mesh or deletes it if {fail} is
+ *  true */
+static bor_mesh3_t *loaderFree(loader_t *ld, bor_vec3_t **coords, int fail);
+/** Allocates hash table of edges with {size} buckets (power of two) */
+static void loaderEdgesAlloc(loader_t *ld, size_t size);
+/** Doubles size of hash table of edges */
+static void loaderEdgesGrow(loader_t *ld);
+/** Returns hash of edge between vertices a and b */
+_bor_inline uint64_t loaderEdgeKey(size_t a, size_t b);
+/** Returns bucket of edge between vertices a and b */
+_bor_inline edge_bucket_t *loaderEdgeBucket(loader_t *ld, size_t a,
+                                            size_t b);
+/** Creates edge (a, b) in empty bucket */
+_bor_inline void loaderEdgeNew(loader_t *ld, edge_bucket_t *bucket,
+                               size_t a, size_t b);
+/** Adds wire edge, returns -1 if any index is out of range */
+static int loaderWire(loader_t *ld, size_t a, size_t b);
+/** Adds face. Returns -1 if any index is out of range, degenerate faces
+ *  and faces that would make an edge incident with more than two faces
+ *  are skipped.
+ *  The face is only queued and buckets of its edges are prefetched, so
+ *  that the cache misses in the hash table overlap. */
+_bor_inline int loaderFace(loader_t *ld, size_t a, size_t b, size_t c);
+/** Adds face to the mesh */
+_bor_inline void loaderFaceAdd(loader_t *ld, const size_t *v);
+/** Adds all queued faces */
+static void loaderFlush(loader_t *ld);
+
+/** Maps whole file into memory, returns NULL on error */
+static const unsigned char *mapFile(const char *fn, size_t *size);
+static void unmapFile(const unsigned char *data, size_t size);
+
+
+/**
+ * PLY
+ * ----
+ */
+#define PLY_MAX_ELEMENTS 16
+#define PLY_MAX_PROPS 32
+
+enum {
+    PLY_INT8 = 0,
+    PLY_UINT8,
+    PLY_INT16,
+    PLY_UINT16,
+    PLY_INT32,
+    PLY_UINT32,
+    PLY_FLOAT32,
+    PLY_FLOAT64
+};
+
+static const char *ply_type_names[][2] = {
+    { "char", "int8" },
+    { "uchar", "uint8" },
+    { "short", "int16" },
+    { "ushort", "uint16" },
+    { "int", "int32" },
+    { "uint", "uint32" },
+    { "float", "float32" },
+    { "double", "float64" },
+};
+static const int ply_type_size[] = { 1, 1, 2, 2, 4, 4, 4, 8 };
+
+struct _ply_prop_t {
+    char name[64];
+    int type;
+    int count_type; /*!< Type of count of list or -1 */
+};
+typedef struct _ply_prop_t ply_prop_t;
+
+struct _ply_element_t {
+    char name[64];
+    size_t len;
+    ply_prop_t prop[PLY_MAX_PROPS];
+    int prop_len;
+};
+typedef struct _ply_element_t ply_element_t;
+
+struct _ply_t {
+    ply_element_t el[PLY_MAX_ELEMENTS];
+    int el_len;
+};
+typedef struct _ply_t ply_t;
+
+/** Parses header, returns offset of data or -1 on error */
+static long plyParseHeader(ply_t *ply, const char *fn,
+                           const unsigned char *data, size_t size);
+_bor_inline double plyReal(const unsigned char *d, int type);
+_bor_inline long plyInt(const unsigned char *d, int type);
+/** Returns size of property stored at {d} or -1 if it would end after
+ *  {end} */
+_bor_inline long plyPropSize(const ply_prop_t *p, const unsigned char *d,
+                             const unsigned char *end);
+static int plyLoadVertices(loader_t *ld, const ply_element_t *el,
+                           const unsigned char **data,
+                           const unsigned char *end);
+static int plyLoadFaces(loader_t *ld, const ply_element_t *el,
+                        const unsigned char **data,
+                        const unsigned char *end);
+static int plySkip(const ply_element_t *el, const unsigned char **data,
+                   const unsigned char *end);
+/** Returns minimal size of one item of element */
+static size_t plyMinSize(const ply_element_t *el);
+
+
+int borMesh3DumpPLY(bor_mesh3_t *m, FILE *out)
+{
+    out_t o;
+    bor_list_t *item;
+    bor_mesh3_face_t *f;
+    bor_mesh3_vertex_t *vs[3];
+    unsigned char cnt = 3;
+    int i;
+
+    fprintf(out, "ply\n");
+    fprintf(out, "format binary_little_endian 1.0\n");
+    fprintf(out, "comment Boruvka mesh3\n");
+    fprintf(out, "element vertex %lu\n", (unsigned long)m->verts_len);
+#ifdef BOR_SINGLE
+    fprintf(out, "property float x\nproperty float y\nproperty float z\n");
+#else /* BOR_SINGLE */
+    fprintf(out, "property double x\nproperty double y\n"
+                 "property double z\n");
+#endif /* BOR_SINGLE */
+    fprintf(out, "element face %lu\n", (unsigned long)m->faces_len);
+    fprintf(out, "property list uchar int vertex_indices\n");
+    fprintf(out, "end_header\n");
+
+    outInit(&o, out);
+    outVertices(&o, m);
+    BOR_LIST_FOR_EACH(&m->faces, item){
+        f = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+        borMesh3FaceVertices(f, vs);
+        outLE(&o, &cnt, 1);
+        for (i = 0; i < 3; ++i)
+            outU32(&o, vs[i]->_id);
+    }
+    return outFree(&o);
+}
+
+int borMesh3DumpBin(bor_mesh3_t *m, FILE *out)
+{
+    out_t o;
+    bor_list_t *item;
+    bor_mesh3_face_t *f;
+    bor_mesh3_edge_t *e;
+    bor_mesh3_vertex_t *vs[3];
+    uint64_t wires;
+    int i;
+
+    wires = 0;
+    BOR_LIST_FOR_EACH(&m->edges, item){
+        e = BOR_LIST_ENTRY(item, bor_mesh3_edge_t, list);
+        if (borMesh3EdgeFacesLen(e) == 0)
+            ++wires;
+    }
+
+    outInit(&o, out);
+    outLE(&o, BIN_MAGIC, 8);
+    outU32(&o, BIN_VERSION);
+    outU32(&o, sizeof(bor_real_t));
+    outU64(&o, m->verts_len);
+    outU64(&o, m->faces_len);
+    outU64(&o, wires);
+
+    outVertices(&o, m);
+    BOR_LIST_FOR_EACH(&m->faces, item){
+        f = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+        borMesh3FaceVertices(f, vs);
+        for (i = 0; i < 3; ++i)
+            outU32(&o, vs[i]->_id);
+    }
+
+    if (wires > 0){
+        BOR_LIST_FOR_EACH(&m->edges, item){
+            e = BOR_LIST_ENTRY(item, bor_mesh3_edge_t, list);
+            if (borMesh3EdgeFacesLen(e) == 0){
+                outU32(&o, e->v[0]->_id);
+                outU32(&o, e->v[1]->_id);
+            }
+        }
+    }
+    return outFree(&o);
+}
+
+bor_mesh3_t *borMesh3LoadPLY(const char *filename, bor_vec3_t **coords)
+{
+    ply_t ply;
+    loader_t ld;
+    const unsigned char *data, *cur, *end;
+    const ply_element_t *vel, *fel;
+    size_t size;
+    long off;
+    int i, ret;
+
+    data = mapFile(filename, &size);
+    if (data == NULL)
+        return NULL;
+
+    off = plyParseHeader(&ply, filename, data, size);
+    if (off < 0){
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    vel = fel = NULL;
+    for (i = 0; i < ply.el_len; ++i){
+        if (vel == NULL && strcmp(ply.el[i].name, "vertex") == 0)
+            vel = ply.el + i;
+        if (fel == NULL && strcmp(ply.el[i].name, "face") == 0)
+            fel = ply.el + i;
+    }
+    if (vel == NULL){
+        fprintf(stderr, "Mesh3 (`%s'): No vertex element.\n", filename);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    if (vel->len > UINT32_MAX
+            || vel->len > (size - off) / BOR_MAX(plyMinSize(vel), 1)
+            || (fel && fel->len > (size - off) / BOR_MAX(plyMinSize(fel), 1))){
+        fprintf(stderr, "Mesh3 (`%s'): Invalid size of file.\n", filename);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    loaderInit(&ld, filename, vel->len, (fel ? fel->len : 0));
+    cur = data + off;
+    end = data + size;
+    ret = 0;
+    for (i = 0; i < ply.el_len && ret == 0; ++i){
+        if (ply.el + i == vel){
+            ret = plyLoadVertices(&ld, vel, &cur, end);
+        }else if (ply.el + i == fel){
+            ret = plyLoadFaces(&ld, fel, &cur, end);
+        }else if (plySkip(ply.el + i, &cur, end) != 0){
+            fprintf(stderr, "Mesh3 (`%s'): Unexpected end of file.\n",
+                    filename);
+            ret = -1;
+        }
+    }
+
+    unmapFile(data, size);
+    return loaderFree(&ld, coords, ret != 0);
+}
+
+bor_mesh3_t *borMesh3LoadBin(const char *filename, bor_vec3_t **coords)
+{
+    loader_t ld;
+    const unsigned char *data, *cur;
+    size_t size, i;
+    uint64_t verts_len, faces_len, wires_len;
+    uint32_t version, real_size, idx[3];
+    bor_real_t x, y, z;
+    int ret;
+
+    data = mapFile(filename, &size);
+    if (data == NULL)
+        return NULL;
+
+    if (size < BIN_HEADER_SIZE || memcmp(data, BIN_MAGIC, 8) != 0){
+        fprintf(stderr, "Mesh3 (`%s'): Not a mesh3 file.\n", filename);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    memcpy(&version, data + 8, 4);
+    FROM_LE(&version, 4);
+    memcpy(&real_size, data + 12, 4);
+    FROM_LE(&real_size, 4);
+    memcpy(&verts_len, data + 16, 8);
+    FROM_LE(&verts_len, 8);
+    memcpy(&faces_len, data + 24, 8);
+    FROM_LE(&faces_len, 8);
+    memcpy(&wires_len, data + 32, 8);
+    FROM_LE(&wires_len, 8);
+
+    if (version != BIN_VERSION || real_size != sizeof(bor_real_t)){
+        fprintf(stderr, "Mesh3 (`%s'): Unsupported version %u or size of"
+                        " real numbers %u.\n",
+                filename, (unsigned)version, (unsigned)real_size);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    if (verts_len > UINT32_MAX
+            || faces_len > (size - BIN_HEADER_SIZE) / 12
+            || wires_len > (size - BIN_HEADER_SIZE) / 8
+            || size != BIN_HEADER_SIZE + verts_len * 3 * real_size
+                                       + faces_len * 12 + wires_len * 8){
+        fprintf(stderr, "Mesh3 (`%s'): Invalid size of file.\n", filename);
+        unmapFile(data, size);
+        return NULL;
+    }
+
+    loaderInit(&ld, filename, verts_len, faces_len);
+    cur = data + BIN_HEADER_SIZE;
+    for (i = 0; i < verts_len; ++i){
+        memcpy(&x, cur, sizeof(bor_real_t));
+        FROM_LE(&x, sizeof(bor_real_t));
+        cur += sizeof(bor_real_t);
+        memcpy(&y, cur, sizeof(bor_real_t));
+        FROM_LE(&y, sizeof(bor_real_t));
+        cur += sizeof(bor_real_t);
+        memcpy(&z, cur, sizeof(bor_real_t));
+        FROM_LE(&z, sizeof(bor_real_t));
+        cur += sizeof(bor_real_t);
+        borVec3Set(ld.coords + i, x, y, z);
+    }
+
+    ret = 0;
+    for (i = 0; i < faces_len && ret == 0; ++i){
+        memcpy(idx, cur, 12);
+        FROM_LE(idx, 4);
+        FROM_LE(idx + 1, 4);
+        FROM_LE(idx + 2, 4);
+        cur += 12;
+        ret = loaderFace(&ld, idx[0], idx[1], idx[2]);
+    }
+
+    for (i = 0; i < wires_len && ret == 0; ++i){
+        memcpy(idx, cur, 8);
+        FROM_LE(idx, 4);
+        FROM_LE(idx + 1, 4);
+        cur += 8;
+        ret = loaderWire(&ld, idx[0], idx[1]);
+    }
+
+    if (ret != 0)
+        fprintf(stderr, "Mesh3 (`%s'): Invalid vertex index.\n", filename);
+
+    unmapFile(data, size);
+    return loaderFree(&ld, coords, ret != 0);
+}
+
+
+
+static void outInit(out_t *o, FILE *out)
+{
+    o->out = out;
+    o->buf = BOR_ALLOC_ARR(unsigned char, OUT_BUF_SIZE);
+    o->len = 0;
+    o->err = 0;
+}
+
+static int outFree(out_t *o)
+{
+    outFlush(o);
+    BOR_FREE(o->buf);
+    if (fflush(o->out) != 0)
+        o->err = 1;
+    return (o->err ? -1 : 0);
+}
+
+static void outFlush(out_t *o)
+{
+    if (o->len > 0 && fwrite(o->buf, 1, o->len, o->out) != o->len)
+        o->err = 1;
+    o->len = 0;
+}
+
+_bor_inline void outLE(out_t *o, const void *data, int size)
+{
+    if (o->len + size > OUT_BUF_SIZE)
+        outFlush(o);
+    memcpy(o->buf + o->len, data, size);
+#ifdef BOR_BIG_ENDIAN
+    if (size > 1 && size <= 8)
+        swapBytes(o->buf + o->len, size);
+#endif /* BOR_BIG_ENDIAN */
+    o->len += size;
+}
+
+_bor_inline void outU32(out_t *o, uint32_t v)
+{
+    outLE(o, &v, 4);
+}
+
+_bor_inline void outU64(out_t *o, uint64_t v)
+{
+    outLE(o, &v, 8);
+}
+
+_bor_inline void outReal(out_t *o, bor_real_t v)
+{
+    outLE(o, &v, sizeof(bor_real_t));
+}
+
+static void outVertices(out_t *o, bor_mesh3_t *m)
+{
+    bor_list_t *item;
+    bor_mesh3_vertex_t *v;
+    int id = 0;
+
+    BOR_LIST_FOR_EACH(&m->verts, item){
+        v = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        v->_id = id++;
+        outReal(o, borVec3X(v->v));
+        outReal(o, borVec3Y(v->v));
+        outReal(o, borVec3Z(v->v));
+    }
+}
+
+
+
+static void loaderInit(loader_t *ld, const char *fn,
+                       size_t verts_len, size_t faces_len)
+{
+    size_t i, size;
+
+    ld->fn = fn;
+    ld->mesh = borMesh3New();
+    ld->verts_len = verts_len;
+    ld->coords = borVec3ArrNew(BOR_MAX(verts_len, 1));
+    ld->verts = BOR_ALLOC_ARR(bor_mesh3_vertex_t *, BOR_MAX(verts_len, 1));
+    for (i = 0; i < verts_len; ++i){
+        ld->verts[i] = borMesh3VertexAlloc(ld->mesh);
+        borMesh3VertexSetCoords(ld->verts[i], ld->coords + i);
+        borMesh3AddVertex(ld->mesh, ld->verts[i]);
+    }
+
+    // a closed mesh has 1.5 edges per face, keep load factor below 0.5
+    for (size = 16; size < 3 * faces_len; size <<= 1);
+    loaderEdgesAlloc(ld, size);
+
+    ld->queue_len = ld->queue_head = 0;
+}
+
+static bor_mesh3_t *loaderFree(loader_t *ld, bor_vec3_t **coords, int fail)
+{
+    bor_mesh3_t *mesh = ld->mesh;
+
+    if (!fail)
+        loaderFlush(ld);
+    BOR_FREE(ld->verts);
+    BOR_FREE(ld->edges);
+
+    if (fail){
+        borMesh3Del(mesh);
+        borVec3ArrDel(ld->coords);
+        return NULL;
+    }
+
+    *coords = ld->coords;
+    return mesh;
+}
+
+static void loaderEdgesAlloc(loader_t *ld, size_t size)
+{
+    ld->edges = BOR_CALLOC_ARR(edge_bucket_t, size);
+    ld->edges_len = 0;
+    ld->edges_mask = size - 1;
+    for (ld->edges_shift = 64; size > 1; size >>= 1)
+        --ld->edges_shift;
+}
+
+static void loaderEdgesGrow(loader_t *ld)
+{
+    edge_bucket_t *old = ld->edges, *b;
+    size_t i, old_size = ld->edges_mask + 1;
+
+    loaderEdgesAlloc(ld, 2 * old_size);
+    for (i = 0; i < old_size; ++i){
+        if (old[i].key == 0)
+            continue;
+        b = loaderEdgeBucket(ld, (old[i].key - 1) >> 32,
+                                 (old[i].key - 1) & 0xffffffffu);
+        *b = old[i];
+        ++ld->edges_len;
+    }
+    BOR_FREE(old);
+}
+
+_bor_inline uint64_t loaderEdgeKey(size_t a, size_t b)
+{
+    // zero key marks an empty bucket
+    if (a < b)
+        return (((uint64_t)a << 32) | b) + 1;
+    return (((uint64_t)b << 32) | a) + 1;
+}
+
+_bor_inline edge_bucket_t *loaderEdgeBucket(loader_t *ld, size_t a,
+                                            size_t b)
+{
+    uint64_t key;
+    size_t i;
+
+    key = loaderEdgeKey(a, b);
+    i = (key * 0x9e3779b97f4a7c15ULL) >> ld->edges_shift;
+    while (ld->edges[i].key != 0 && ld->edges[i].key != key)
+        i = (i + 1) & ld->edges_mask;
+    return ld->edges + i;
+}
+
+_bor_inline void loaderEdgeNew(loader_t *ld, edge_bucket_t *bucket,
+                               size_t a, size_t b)
+{
+    bucket->key = loaderEdgeKey(a, b);
+    bucket->e = borMesh3EdgeAlloc(ld->mesh);
+    borMesh3AddEdge(ld->mesh, bucket->e, ld->verts[a], ld->verts[b]);
+    ++ld->edges_len;
+}
+
+static int loaderWire(loader_t *ld, size_t a, size_t b)
+{
+    edge_bucket_t *bucket;
+
+    if (a >= ld->verts_len || b >= ld->verts_len)
+        return -1;
+    if (a == b)
+        return 0;
+
+    loaderFlush(ld);
+    if (2 * (ld->edges_len + 1) > ld->edges_mask)
+        loaderEdgesGrow(ld);
+    bucket = loaderEdgeBucket(ld, a, b);
+    if (bucket->key == 0)
+        loaderEdgeNew(ld, bucket, a, b);
+    return 0;
+}
+
+_bor_inline int loaderFace(loader_t *ld, size_t a, size_t b, size_t c)
+{
+    size_t *q;
+    uint64_t key;
+    int i;
+
+    if (a >= ld->verts_len || b >= ld->verts_len || c >= ld->verts_len)
+        return -1;
+    if (a == b || b == c || a == c)
+        return 0;
+
+    if (ld->queue_len == LOADER_QUEUE_SIZE){
+        loaderFaceAdd(ld, ld->queue[ld->queue_head]);
+    }else{
+        ++ld->queue_len;
+    }
+
+    q = ld->queue[ld->queue_head];
+    q[0] = a;
+    q[1] = b;
+    q[2] = c;
+    ld->queue_head = (ld->queue_head + 1) % LOADER_QUEUE_SIZE;
+
+    for (i = 0; i < 3; ++i){
+        key = loaderEdgeKey(q[i], q[(i + 1) % 3]);
+        _bor_prefetchw(ld->edges
+                        + ((key * 0x9e3779b97f4a7c15ULL) >> ld->edges_shift));
+    }
+    return 0;
+}
+
+_bor_inline void loaderFaceAdd(loader_t *ld, const size_t *v)
+{
+    edge_bucket_t *eb[3];
+    bor_mesh3_face_t *f;
+    int i;
+
+    if (2 * (ld->edges_len + 3) > ld->edges_mask)
+        loaderEdgesGrow(ld);
+
+    for (i = 0; i < 3; ++i){
+        eb[i] = loaderEdgeBucket(ld, v[i], v[(i + 1) % 3]);
+        if (eb[i]->key != 0 && borMesh3EdgeFacesLen(eb[i]->e) == 2)
+            return;
+    }
+
+    // buckets of distinct edges are distinct so they can be filled now
+    for (i = 0; i < 3; ++i){
+        if (eb[i]->key == 0)
+            loaderEdgeNew(ld, eb[i], v[i], v[(i + 1) % 3]);
+    }
+
+    f = borMesh3FaceAlloc(ld->mesh);
+    borMesh3AddFace(ld->mesh, f, eb[0]->e, eb[1]->e, eb[2]->e);
+}
+
+static void loaderFlush(loader_t *ld)
+{
+    int i;
+
+    i = (ld->queue_head + LOADER_QUEUE_SIZE - ld->queue_len)
+            % LOADER_QUEUE_SIZE;
+    for (; ld->queue_len > 0; --ld->queue_len){
+        loaderFaceAdd(ld, ld->queue[i]);
+        i = (i + 1) % LOADER_QUEUE_SIZE;
+    }
+}
+
+static const unsigned char *mapFile(const char *fn, size_t *size)
+{
+    int fd;
+    struct stat st;
+    void *data;
+
+    fd = open(fn, O_RDONLY);
+    if (fd == -1){
+        fprintf(stderr, "Mesh3: Can't open file `%s'\n", fn);
+        return NULL;
+    }
+
+    if (fstat(fd, &st) != 0){
+        fprintf(stderr, "Mesh3 (`%s'): Can't read file size.\n", fn);
+        close(fd);
+        return NULL;
+    }
+
+    *size = st.st_size;
+    if (*size == 0){
+        fprintf(stderr, "Mesh3 (`%s'): Empty file.\n", fn);
+        close(fd);
+        return NULL;
+    }
+
+    data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED){
+        fprintf(stderr, "Mesh3 (`%s'): Can't map file to memory.\n", fn);
+        return NULL;
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    return data;
+}
+
+static void unmapFile(const unsigned char *data, size_t size)
+{
+    munmap((void *)data, size);
+}
+
+
+
+/** Reads next line of header into {line}, returns 0 on success */
+static int plyLine(const unsigned char **cur, const unsigned char *end,
+                   char *line, size_t size)
+{
+    size_t len = 0;
+
+    while (*cur < end && **cur != '\n'){
+        if (len < size - 1 && **cur != '\r')
+            line[len++] = **cur;
+        ++*cur;
+    }
+    if (*cur >= end)
+        return -1;
+    ++*cur;
+    line[len] = 0;
+    return 0;
+}
+
+static int plyType(const char *name)
+{
+    int i;
+
+    for (i = 0; i < (int)(sizeof(ply_type_size) / sizeof(int)); ++i){
+        if (strcmp(name, ply_type_names[i][0]) == 0
+                || strcmp(name, ply_type_names[i][1]) == 0)
+            return i;
+    }
+    return -1;
+}
+
+static long plyParseHeader(ply_t *ply, const char *fn,
+                           const unsigned char *data, size_t size)
+{
+    const unsigned char *cur = data, *end = data + size;
+    char line[256], w[4][64];
+    ply_element_t *el = NULL;
+    ply_prop_t *p;
+    unsigned long len;
+    int n;
+
+    ply->el_len = 0;
+
+    if (plyLine(&cur, end, line, sizeof(line)) != 0
+            || strcmp(line, "ply") != 0){
+        fprintf(stderr, "Mesh3 (`%s'): Not a PLY file.\n", fn);
+        return -1;
+    }
+
+    while (plyLine(&cur, end, line, sizeof(line)) == 0){
+        n = sscanf(line, "%63s %63s %63s %63s", w[0], w[1], w[2], w[3]);
+        if (n <= 0)
+            continue;
+
+        if (strcmp(w[0], "end_header") == 0){
+            return cur - data;
+
+        }else if (strcmp(w[0], "format") == 0){
+            if (n < 2 || strcmp(w[1], "binary_little_endian") != 0){
+                fprintf(stderr, "Mesh3 (`%s'): Only binary_little_endian"
+                                " PLY format is supported.\n", fn);
+                return -1;
+            }
+
+        }else if (strcmp(w[0], "element") == 0){
+            if (n != 3 || sscanf(w[2], "%lu", &len) != 1
+                    || ply->el_len == PLY_MAX_ELEMENTS){
+                fprintf(stderr, "Mesh3 (`%s'): Invalid element `%s'.\n",
+                        fn, line);
+                return -1;
+            }
+            el = ply->el + ply->el_len++;
+            strcpy(el->name, w[1]);
+            el->len = len;
+            el->prop_len = 0;
+
+        }else if (strcmp(w[0], "property") == 0){
+            if (el == NULL || el->prop_len == PLY_MAX_PROPS){
+                fprintf(stderr, "Mesh3 (`%s'): Invalid property `%s'.\n",
+                        fn, line);
+                return -1;
+            }
+            p = el->prop + el->prop_len++;
+            p->type = p->count_type = -1;
+            if (n == 3 && strcmp(w[1], "list") != 0){
+                p->type = plyType(w[1]);
+                strcpy(p->name, w[2]);
+            }else if (n == 4 && strcmp(w[1], "list") == 0
+                        && sscanf(line, "%*s %*s %*s %*s %63s",
+                                  p->name) == 1){
+                p->count_type = plyType(w[2]);
+                p->type = plyType(w[3]);
+                if (p->count_type < 0 || p->count_type >= PLY_FLOAT32)
+                    p->type = -1;
+            }
+
+            if (p->type < 0){
+                fprintf(stderr, "Mesh3 (`%s'): Invalid property `%s'.\n",
+                        fn, line);
+                return -1;
+            }
+        }
+    }
+
+    fprintf(stderr, "Mesh3 (`%s'): Unterminated PLY header.\n", fn);
+    return -1;
+}
+
+_bor_inline double plyReal(const unsigned char *d, int type)
+{
+    float f;
+    double r;
+
+    if (type == PLY_FLOAT32){
+        memcpy(&f, d, 4);
+        FROM_LE(&f, 4);
+        return f;
+    }else if (type == PLY_FLOAT64){
+        memcpy(&r, d, 8);
+        FROM_LE(&r, 8);
+        return r;
+    }
+    return plyInt(d, type);
+}
+
+_bor_inline long plyInt(const unsigned char *d, int type)
+{
+    union {
+        int8_t i8;
+        uint8_t u8;
+        int16_t i16;
+        uint16_t u16;
+        int32_t i32;
+        uint32_t u32;
+    } v;
+
+    // floating point indices are not supported
+    if (type >= PLY_FLOAT32)
+        return -1;
+
+    memcpy(&v, d, ply_type_size[type]);
+    FROM_LE(&v, ply_type_size[type]);
+    switch (type){
+        case PLY_INT8:
+            return v.i8;
+        case PLY_UINT8:
+            return v.u8;
+        case PLY_INT16:
+            return v.i16;
+        case PLY_UINT16:
+            return v.u16;
+        case PLY_INT32:
+            return v.i32;
+        case PLY_UINT32:
+            return v.u32;
+    }
+    return -1;
+}
+
+_bor_inline long plyPropSize(const ply_prop_t *p, const unsigned char *d,
+                             const unsigned char *end)
+{
+    long size, cnt;
+
+    if (p->count_type < 0){
+        size = ply_type_size[p->type];
+    }else{
+        if (d + ply_type_size[p->count_type] > end)
+            return -1;
+        cnt = plyInt(d, p->count_type);
+        if (cnt < 0)
+            return -1;
+        size = ply_type_size[p->count_type] + cnt * ply_type_size[p->type];
+    }
+
+    if (size > end - d)
+        return -1;
+    return size;
+}
+
+static int plyLoadVertices(loader_t *ld, const ply_element_t *el,
+                           const unsigned char **data,
+                           const unsigned char *end)
+{
+    const unsigned char *cur = *data;
+    double x[3];
+    int coord[PLY_MAX_PROPS];
+    size_t i;
+    int j, k;
+    long size;
+
+    for (j = 0; j < el->prop_len; ++j){
+        coord[j] = -1;
+        if (el->prop[j].count_type >= 0)
+            continue;
+        for (k = 0; k < 3; ++k){
+            if (el->prop[j].name[0] == 'x' + k && el->prop[j].name[1] == 0)
+                coord[j] = k;
+        }
+    }
+
+    for (i = 0; i < el->len; ++i){
+        x[0] = x[1] = x[2] = 0.;
+        for (j = 0; j < el->prop_len; ++j){
+            size = plyPropSize(el->prop + j, cur, end);
+            if (size < 0)
+                goto fail;
+            if (coord[j] >= 0)
+                x[coord[j]] = plyReal(cur, el->prop[j].type);
+            cur += size;
+        }
+        borVec3Set(ld->coords + i, x[0], x[1], x[2]);
+    }
+
+    *data = cur;
+    return 0;
+
+fail:
+    fprintf(stderr, "Mesh3 (`%s'): Unexpected end of file.\n", ld->fn);
+    return -1;
+}
+
+static int plyLoadFaces(loader_t *ld, const ply_element_t *el,
+                        const unsigned char **data,
+                        const unsigned char *end)
+{
+    const unsigned char *cur = *data, *d;
+    const ply_prop_t *p;
+    int idx_prop, isize, csize;
+    size_t i;
+    long size, cnt, k, a, b, c;
+    int j;
+
+    idx_prop = -1;
+    for (j = 0; j < el->prop_len; ++j){
+        if (el->prop[j].count_type >= 0
+                && (strcmp(el->prop[j].name, "vertex_indices") == 0
+                        || strcmp(el->prop[j].name, "vertex_index") == 0)){
+            idx_prop = j;
+            break;
+        }
+    }
+    if (idx_prop < 0){
+        fprintf(stderr, "Mesh3 (`%s'): No vertex_indices property.\n",
+                ld->fn);
+        return -1;
+    }
+    p = el->prop + idx_prop;
+    isize = ply_type_size[p->type];
+    csize = ply_type_size[p->count_type];
+
+    for (i = 0; i < el->len; ++i){
+        for (j = 0; j < el->prop_len; ++j){
+            size = plyPropSize(el->prop + j, cur, end);
+            if (size < 0){
+                fprintf(stderr, "Mesh3 (`%s'): Unexpected end of file.\n",
+                        ld->fn);
+                return -1;
+            }
+
+            if (j == idx_prop){
+                // polygons are triangulated as fans
+                cnt = (size - csize) / isize;
+                d = cur + csize;
+                if (cnt >= 3){
+                    a = plyInt(d, p->type);
+                    c = plyInt(d + isize, p->type);
+                    for (k = 2; k < cnt; ++k){
+                        b = c;
+                        c = plyInt(d + k * isize, p->type);
+                        if (a < 0 || b < 0 || c < 0
+                                || loaderFace(ld, a, b, c) != 0){
+                            fprintf(stderr, "Mesh3 (`%s'): Invalid vertex"
+                                            " index.\n", ld->fn);
+                            return -1;
+                        }
+                    }
+                }
+            }
+            cur += size;
+        }
+    }
+
+    *data = cur;
+    return 0;
+}
+
+static int plySkip(const ply_element_t *el, const unsigned char **data,
+                   const unsigned char *end)
+{
+    size_t i;
+    int j;
+    long size;
+
+    for (i = 0; i < el->len; ++i){
+        for (j = 0; j < el->prop_len; ++j){
+            size = plyPropSize(el->prop + j, *data, end);
+            if (size < 0)
+                return -1;
+            *data += size;
+        }
+    }
+    return 0;
+}
+
+static size_t plyMinSize(const ply_element_t *el)
+{
+    size_t size = 0;
+    int j;
+
+    for (j = 0; j < el->prop_len; ++j){
+        if (el->prop[j].count_type >= 0){
+            size += ply_type_size[el->prop[j].count_type];
+        }else{
+            size += ply_type_size[el->prop[j].type];
+        }
+    }
+    return size;
+}
@@ -18,6 +18,12 @@
 #include <boruvka/alloc.h>
 #include <boruvka/dbg.h>
 
+/** Size of segments of pools of elements */
+#define MESH3_POOL_SEGM_SIZE (64 * 1024)
+
+/** Returns true if all elements of the mesh were allocated from its pools */
+static int mesh3AllPooled(const bor_mesh3_t *m);
+
 bor_mesh3_vertex_t *borMesh3VertexNew(void)
 {
     bor_mesh3_vertex_t *v;
@@ -31,6 +37,24 @@ void borMesh3VertexDel(bor_mesh3_vertex_t *v)
     BOR_FREE(v);
 }
 
+bor_mesh3_vertex_t *borMesh3VertexAlloc(bor_mesh3_t *m)
+{
+    bor_mesh3_vertex_t *v;
+
+    if (!m->verts_pool){
+        m->verts_pool = borPoolNew(sizeof(bor_mesh3_vertex_t),
+                                   MESH3_POOL_SEGM_SIZE);
+    }
+    v = borPoolAlloc(m->verts_pool);
+    v->v = NULL;
+    return v;
+}
+
+void borMesh3VertexFree(bor_mesh3_t *m, bor_mesh3_vertex_t *v)
+{
+    borPoolFree(m->verts_pool, v);
+}
+
 bor_mesh3_edge_t *borMesh3VertexCommonEdge(const bor_mesh3_vertex_t *v1,
                                            const bor_mesh3_vertex_t *v2)
 {
@@ -69,6 +93,20 @@ void borMesh3EdgeDel(bor_mesh3_edge_t *e)
     BOR_FREE(e);
 }
 
+bor_mesh3_edge_t *borMesh3EdgeAlloc(bor_mesh3_t *m)
+{
+    if (!m->edges_pool){
+        m->edges_pool = borPoolNew(sizeof(bor_mesh3_edge_t),
+                                   MESH3_POOL_SEGM_SIZE);
+    }
+    return borPoolAlloc(m->edges_pool);
+}
+
+void borMesh3EdgeFree(bor_mesh3_t *m, bor_mesh3_edge_t *e)
+{
+    borPoolFree(m->edges_pool, e);
+}
+
 /** Returns true if two given edges have exactly one common vertex */
 _bor_inline int borMesh3EdgeTriCheckCommon(const bor_mesh3_edge_t *e1,
                                            const bor_mesh3_edge_t *e2)
@@ -117,6 +155,20 @@ void borMesh3FaceDel(bor_mesh3_face_t *f)
     BOR_FREE(f);
 }
 
+bor_mesh3_face_t *borMesh3FaceAlloc(bor_mesh3_t *m)
+{
+    if (!m->faces_pool){
+        m->faces_pool = borPoolNew(sizeof(bor_mesh3_face_t),
+                                   MESH3_POOL_SEGM_SIZE);
+    }
+    return borPoolAlloc(m->faces_pool);
+}
+
+void borMesh3FaceFree(bor_mesh3_t *m, bor_mesh3_face_t *f)
+{
+    borPoolFree(m->faces_pool, f);
+}
+
 
 
 bor_mesh3_t *borMesh3New(void)
@@ -131,6 +183,10 @@ bor_mesh3_t *borMesh3New(void)
     borListInit(&m->faces);
     m->faces_len = 0;
 
+    m->verts_pool = NULL;
+    m->edges_pool = NULL;
+    m->faces_pool = NULL;
+
     return m;
 }
 
@@ -149,6 +205,9 @@ void borMesh3Del2(bor_mesh3_t *m,
     bor_mesh3_face_t *f;
     bor_list_t *item;
 
+    if (!delvertex && !deledge && !delface && mesh3AllPooled(m))
+        goto free_pools;
+
     // disconnect all faces
     while (!borListEmpty(&m->faces)){
         item = borListNext(&m->faces);
@@ -182,6 +241,14 @@ void borMesh3Del2(bor_mesh3_t *m,
         }
     }
 
+free_pools:
+    if (m->verts_pool)
+        borPoolDel(m->verts_pool);
+    if (m->edges_pool)
+        borPoolDel(m->edges_pool);
+    if (m->faces_pool)
+        borPoolDel(m->faces_pool);
+
     BOR_FREE(m);
 }
 
@@ -400,3 +467,17 @@ void borMesh3DumpPovray(bor_mesh3_t *m, FILE *out)
 
     fflush(out);
 }
+
+static int mesh3AllPooled(const bor_mesh3_t *m)
+{
+    if (m->verts_len > 0
+            && (!m->verts_pool || borPoolLen(m->verts_pool) != m->verts_len))
+        return 0;
+    if (m->edges_len > 0
+            && (!m->edges_pool || borPoolLen(m->edges_pool) != m->edges_len))
+        return 0;
+    if (m->faces_len > 0
+            && (!m->faces_pool || borPoolLen(m->faces_pool) != m->faces_len))
+        return 0;
+    return 1;
+}
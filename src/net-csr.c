@@ -0,0 +1,512 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+
+#include <boruvka/alloc.h>
+#include <boruvka/tasks.h>
+#include "_net.h"
+
+/** Minimal number of nodes in frontier expanded in parallel */
+#define BFS_PAR_MIN 1024
+
+struct _bfs_t {
+    const bor_net_csr_t *csr;
+    int *dist;
+    int *front;        /*!< Current frontier */
+    int front_len;
+    int level;         /*!< Distance of nodes in frontier */
+    int num_threads;
+    int **next;        /*!< Next frontier of each thread */
+    int *next_len;
+    int *next_alloc;
+};
+typedef struct _bfs_t bfs_t;
+
+struct _comp_t {
+    const bor_net_csr_t *csr;
+    int *parent;
+    int num_threads;
+};
+typedef struct _comp_t comp_t;
+
+/** Resizes per-node arrays to hold at least {len} ids */
+static void csrReserveNodes(bor_net_csr_t *csr, int len);
+/** Builds snapshot from scratch */
+static void csrBuild(bor_net_csr_t *csr, bor_net_t *net);
+/** Stores neighbors of the node with id {id} at .adj[.start[id]] */
+static void csrFillNode(bor_net_csr_t *csr, int id);
+/** Rebuilds .adj without gaps and fills dirty nodes, ids are kept */
+static void csrCompact(bor_net_csr_t *csr);
+/** Expands part of frontier */
+static void bfsTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Expands nodes front[from, to) into next frontier of thread {tid} */
+static int bfsExpand(bfs_t *bfs, int tid, int from, int to);
+/** Connects components of part of nodes */
+static void compTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Returns root of the node in the union-find forest */
+_bor_inline int ufFind(int *parent, int x);
+/** Joins trees of nodes a and b, the smaller root becomes the root */
+_bor_inline void ufUnion(int *parent, int a, int b);
+
+bor_net_csr_t *borNetToCSR(bor_net_t *net)
+{
+    bor_net_csr_t *csr;
+
+    csr = BOR_ALLOC(bor_net_csr_t);
+    bzero(csr, sizeof(*csr));
+
+    /* ids of nodes from the previous snapshot are overwritten by
+     * csrBuild() */
+    if (net->csr)
+        net->csr->net = NULL;
+    net->csr = csr;
+    csr->net = net;
+
+    csrBuild(csr, net);
+    return csr;
+}
+
+void borNetCSRDel(bor_net_csr_t *csr)
+{
+    int id;
+
+    if (csr->net){
+        /* Removed nodes have the id already reset and may be freed */
+        for (id = 0; id < csr->nodes_len; ++id){
+            if (csr->node[id] != NULL && csr->is_dirty[id] != 2)
+                csr->node[id]->_id = -1;
+        }
+        csr->net->csr = NULL;
+    }
+
+    if (csr->node)
+        BOR_FREE(csr->node);
+    if (csr->start)
+        BOR_FREE(csr->start);
+    if (csr->deg)
+        BOR_FREE(csr->deg);
+    if (csr->cap)
+        BOR_FREE(csr->cap);
+    if (csr->adj)
+        BOR_FREE(csr->adj);
+    if (csr->dirty)
+        BOR_FREE(csr->dirty);
+    if (csr->is_dirty)
+        BOR_FREE(csr->is_dirty);
+    if (csr->free_ids)
+        BOR_FREE(csr->free_ids);
+    BOR_FREE(csr);
+}
+
+void borNetCSRUpdate(bor_net_csr_t *csr)
+{
+    int i, id, deg, need;
+
+    if (!csr->net)
+        return;
+
+    /* Nodes that still fit into their space are updated in place, the
+     * others are moved to the end of .adj. If there is not enough space
+     * at the end or too much of .adj is wasted, the whole .adj is
+     * compacted. */
+    need = 0;
+    for (i = 0; i < csr->dirty_len; ++i){
+        id = csr->dirty[i];
+        if (csr->is_dirty[id] == 2){
+            csr->adj_unused += csr->deg[id];
+            csr->node[id] = NULL;
+            csr->deg[id] = csr->cap[id] = 0;
+            csr->free_ids[csr->free_len++] = id;
+            continue;
+        }
+
+        deg = csr->node[id]->edges_len;
+        if (deg > csr->cap[id])
+            need += deg + 2;
+    }
+
+    if (csr->adj_len + need > csr->adj_alloc
+            || csr->adj_unused > csr->adj_len / 2){
+        csrCompact(csr);
+
+    }else{
+        for (i = 0; i < csr->dirty_len; ++i){
+            id = csr->dirty[i];
+            if (csr->node[id] == NULL)
+                continue;
+
+            deg = csr->node[id]->edges_len;
+            if (deg > csr->cap[id]){
+                csr->start[id] = csr->adj_len;
+                csr->cap[id] = deg + 2;
+                csr->adj_len += deg + 2;
+                csr->adj_unused += deg + 2;
+            }
+            csr->adj_unused += csr->deg[id] - deg;
+            csrFillNode(csr, id);
+        }
+    }
+
+    for (i = 0; i < csr->dirty_len; ++i)
+        csr->is_dirty[csr->dirty[i]] = 0;
+    csr->dirty_len = 0;
+}
+
+int borNetCSRBFS(const bor_net_csr_t *csr, int src, int *dist,
+                 int num_threads)
+{
+    bor_tasks_t *tasks = NULL;
+    bfs_t bfs;
+    int i, len, reached;
+
+    for (i = 0; i < csr->nodes_len; ++i)
+        dist[i] = -1;
+    if (src < 0 || src >= csr->nodes_len || csr->node[src] == NULL)
+        return 0;
+
+    num_threads = BOR_MAX(num_threads, 1);
+    bfs.csr = csr;
+    bfs.dist = dist;
+    bfs.front = BOR_ALLOC_ARR(int, csr->nodes_len);
+    bfs.front[0] = src;
+    bfs.front_len = 1;
+    bfs.level = 0;
+    bfs.num_threads = num_threads;
+    bfs.next = BOR_CALLOC_ARR(int *, num_threads);
+    bfs.next_len = BOR_CALLOC_ARR(int, num_threads);
+    bfs.next_alloc = BOR_CALLOC_ARR(int, num_threads);
+    dist[src] = 0;
+    reached = 1;
+
+    if (num_threads > 1){
+        tasks = borTasksNew(num_threads);
+        borTasksRun(tasks);
+    }
+
+    while (bfs.front_len > 0){
+        if (tasks && bfs.front_len >= BFS_PAR_MIN){
+            for (i = 0; i < num_threads; ++i)
+                borTasksAdd(tasks, bfsTask, i, &bfs);
+            borTasksBarrier(tasks);
+        }else{
+            bfsExpand(&bfs, 0, 0, bfs.front_len);
+        }
+
+        /* Frontier never contains a node twice, so it always fits */
+        bfs.front_len = 0;
+        for (i = 0; i < num_threads; ++i){
+            len = bfs.next_len[i];
+            memcpy(bfs.front + bfs.front_len, bfs.next[i], sizeof(int) * len);
+            bfs.front_len += len;
+            bfs.next_len[i] = 0;
+        }
+        reached += bfs.front_len;
+        ++bfs.level;
+    }
+
+    if (tasks)
+        borTasksDel(tasks);
+    for (i = 0; i < num_threads; ++i){
+        if (bfs.next[i])
+            BOR_FREE(bfs.next[i]);
+    }
+    BOR_FREE(bfs.next);
+    BOR_FREE(bfs.next_len);
+    BOR_FREE(bfs.next_alloc);
+    BOR_FREE(bfs.front);
+
+    return reached;
+}
+
+int borNetCSRComponents(const bor_net_csr_t *csr, int *comp,
+                        int num_threads)
+{
+    bor_tasks_t *tasks;
+    comp_t c;
+    int i, len, root;
+
+    c.csr = csr;
+    c.parent = BOR_ALLOC_ARR(int, csr->nodes_len);
+    c.num_threads = BOR_MAX(num_threads, 1);
+    for (i = 0; i < csr->nodes_len; ++i)
+        c.parent[i] = i;
+
+    if (c.num_threads > 1){
+        tasks = borTasksNew(c.num_threads);
+        for (i = 0; i < c.num_threads; ++i)
+            borTasksAdd(tasks, compTask, i, &c);
+        borTasksRun(tasks);
+        borTasksBarrier(tasks);
+        borTasksDel(tasks);
+    }else{
+        compTask(0, &c, NULL);
+    }
+
+    /* Roots are the smallest ids of components, so they are labeled
+     * before any other node of their component. */
+    len = 0;
+    for (i = 0; i < csr->nodes_len; ++i){
+        if (csr->node[i] == NULL){
+            comp[i] = -1;
+            continue;
+        }
+
+        root = ufFind(c.parent, i);
+        if (root == i){
+            comp[i] = len++;
+        }else{
+            comp[i] = comp[root];
+        }
+    }
+
+    BOR_FREE(c.parent);
+    return len;
+}
+
+
+static void csrReserveNodes(bor_net_csr_t *csr, int len)
+{
+    if (len <= csr->nodes_alloc)
+        return;
+
+    csr->nodes_alloc = BOR_MAX(2 * csr->nodes_alloc, len);
+    csr->nodes_alloc = BOR_MAX(csr->nodes_alloc, 16);
+    csr->node = BOR_REALLOC_ARR(csr->node, bor_net_node_t *,
+                                csr->nodes_alloc);
+    csr->start = BOR_REALLOC_ARR(csr->start, int, csr->nodes_alloc);
+    csr->deg = BOR_REALLOC_ARR(csr->deg, int, csr->nodes_alloc);
+    csr->cap = BOR_REALLOC_ARR(csr->cap, int, csr->nodes_alloc);
+    csr->dirty = BOR_REALLOC_ARR(csr->dirty, int, csr->nodes_alloc);
+    csr->is_dirty = BOR_REALLOC_ARR(csr->is_dirty, char, csr->nodes_alloc);
+    csr->free_ids = BOR_REALLOC_ARR(csr->free_ids, int, csr->nodes_alloc);
+}
+
+static void csrBuild(bor_net_csr_t *csr, bor_net_t *net)
+{
+    bor_list_t *item;
+    bor_net_node_t *n;
+    int id;
+
+    csrReserveNodes(csr, net->nodes_len);
+    csr->nodes_len = 0;
+    BOR_LIST_FOR_EACH(&net->nodes, item){
+        n = BOR_LIST_ENTRY(item, bor_net_node_t, list);
+        n->_id = csr->nodes_len++;
+        csr->node[n->_id] = n;
+    }
+
+    /* Leave space for nodes moved to the end of .adj by updates */
+    csr->adj_alloc = BOR_MAX(4 * net->edges_len, 16);
+    csr->adj = BOR_ALLOC_ARR(int, csr->adj_alloc);
+    csr->adj_len = 0;
+    for (id = 0; id < csr->nodes_len; ++id){
+        csr->start[id] = csr->adj_len;
+        csr->cap[id] = csr->node[id]->edges_len;
+        csr->adj_len += csr->cap[id];
+        csrFillNode(csr, id);
+        csr->is_dirty[id] = 0;
+    }
+    csr->adj_unused = 0;
+    csr->dirty_len = 0;
+    csr->free_len = 0;
+}
+
+static void csrFillNode(bor_net_csr_t *csr, int id)
+{
+    bor_net_node_t *n = csr->node[id];
+    bor_list_t *item;
+    bor_net_edge_t *e;
+    int *adj;
+
+    adj = csr->adj + csr->start[id];
+    BOR_LIST_FOR_EACH(&n->edges, item){
+        e = borNetEdgeFromNodeList(item);
+        *adj++ = borNetEdgeOtherNode(e, n)->_id;
+    }
+    csr->deg[id] = n->edges_len;
+}
+
+static void csrCompact(bor_net_csr_t *csr)
+{
+    int *adj, id, len, deg;
+
+    len = 0;
+    for (id = 0; id < csr->nodes_len; ++id){
+        if (csr->node[id] == NULL)
+            continue;
+        if (csr->is_dirty[id]){
+            len += csr->node[id]->edges_len;
+        }else{
+            len += csr->deg[id];
+        }
+    }
+    csr->adj_alloc = BOR_MAX(2 * len, 16);
+    adj = BOR_ALLOC_ARR(int, csr->adj_alloc);
+
+    len = 0;
+    for (id = 0; id < csr->nodes_len; ++id){
+        if (csr->node[id] == NULL){
+            csr->start[id] = len;
+            continue;
+        }
+
+        if (csr->is_dirty[id]){
+            csr->start[id] = len;
+            csr->cap[id] = csr->node[id]->edges_len;
+            len += csr->cap[id];
+            continue;
+        }
+
+        deg = csr->deg[id];
+        memcpy(adj + len, csr->adj + csr->start[id], sizeof(int) * deg);
+        csr->start[id] = len;
+        csr->cap[id] = deg;
+        len += deg;
+    }
+
+    BOR_FREE(csr->adj);
+    csr->adj = adj;
+    csr->adj_len = len;
+    csr->adj_unused = 0;
+
+    for (id = 0; id < csr->nodes_len; ++id){
+        if (csr->is_dirty[id] && csr->node[id] != NULL)
+            csrFillNode(csr, id);
+    }
+}
+
+void borNetCSRNodeAdded(bor_net_csr_t *csr, bor_net_node_t *n)
+{
+    int id;
+
+    if (csr->free_len > 0){
+        id = csr->free_ids[--csr->free_len];
+    }else{
+        csrReserveNodes(csr, csr->nodes_len + 1);
+        id = csr->nodes_len++;
+        csr->is_dirty[id] = 0;
+    }
+
+    n->_id = id;
+    csr->node[id] = n;
+    csr->start[id] = csr->adj_len;
+    csr->deg[id] = csr->cap[id] = 0;
+    borNetCSRNodeChanged(csr, n);
+}
+
+void borNetCSRNodeRemoved(bor_net_csr_t *csr, bor_net_node_t *n)
+{
+    int id = n->_id;
+
+    /* The id is released in the next update so that the snapshot stays
+     * consistent until then */
+    if (!csr->is_dirty[id])
+        csr->dirty[csr->dirty_len++] = id;
+    csr->is_dirty[id] = 2;
+    n->_id = -1;
+}
+
+
+static void bfsTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    bfs_t *bfs = (bfs_t *)data;
+    int from, to;
+
+    from = (long)bfs->front_len * id / bfs->num_threads;
+    to = (long)bfs->front_len * (id + 1) / bfs->num_threads;
+    bfsExpand(bfs, id, from, to);
+}
+
+static int bfsExpand(bfs_t *bfs, int tid, int from, int to)
+{
+    const bor_net_csr_t *csr = bfs->csr;
+    int i, j, u, v, end, *next, len, alloc;
+    int level = bfs->level + 1;
+
+    next = bfs->next[tid];
+    len = bfs->next_len[tid];
+    alloc = bfs->next_alloc[tid];
+
+    for (i = from; i < to; ++i){
+        u = bfs->front[i];
+        end = csr->start[u] + csr->deg[u];
+        for (j = csr->start[u]; j < end; ++j){
+            v = csr->adj[j];
+            if (bfs->dist[v] >= 0)
+                continue;
+            if (!__sync_bool_compare_and_swap(bfs->dist + v, -1, level))
+                continue;
+
+            if (len == alloc){
+                alloc = BOR_MAX(2 * alloc, 1024);
+                next = BOR_REALLOC_ARR(next, int, alloc);
+            }
+            next[len++] = v;
+        }
+    }
+
+    bfs->next[tid] = next;
+    bfs->next_len[tid] = len;
+    bfs->next_alloc[tid] = alloc;
+    return len;
+}
+
+static void compTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    comp_t *c = (comp_t *)data;
+    const bor_net_csr_t *csr = c->csr;
+    int from, to, u, j, end;
+
+    from = (long)csr->nodes_len * id / c->num_threads;
+    to = (long)csr->nodes_len * (id + 1) / c->num_threads;
+    for (u = from; u < to; ++u){
+        end = csr->start[u] + csr->deg[u];
+        for (j = csr->start[u]; j < end; ++j){
+            if (csr->adj[j] < u)
+                ufUnion(c->parent, u, csr->adj[j]);
+        }
+    }
+}
+
+_bor_inline int ufFind(int *parent, int x)
+{
+    volatile int *p = parent;
+    int y;
+
+    /* Path halving only ever replaces parent with its ancestor, so it is
+     * safe even if other threads update the forest concurrently. */
+    while ((y = p[x]) != x){
+        p[x] = p[y];
+        x = y;
+    }
+    return x;
+}
+
+_bor_inline void ufUnion(int *parent, int a, int b)
+{
+    int tmp;
+
+    for (;;){
+        a = ufFind(parent, a);
+        b = ufFind(parent, b);
+        if (a == b)
+            return;
+        if (a < b)
+            BOR_SWAP(a, b, tmp);
+        if (__sync_bool_compare_and_swap(parent + a, a, b))
+            return;
+    }
+}
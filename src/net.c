@@ -17,6 +17,13 @@
 #include <boruvka/net.h>
 #include <boruvka/alloc.h>
 #include <boruvka/dbg.h>
+#include "_net.h"
+
+/** Size of segments of pools of nodes and edges */
+#define NET_POOL_SEGM_SIZE (64 * 1024)
+
+/** Returns true if all nodes and edges were allocated from pools */
+static int netAllPooled(const bor_net_t *m);
 
 bor_net_node_t *borNetNodeNew(void)
 {
@@ -30,6 +37,18 @@ void borNetNodeDel(bor_net_node_t *v)
     BOR_FREE(v);
 }
 
+bor_net_node_t *borNetNodeAlloc(bor_net_t *m)
+{
+    if (!m->nodes_pool)
+        m->nodes_pool = borPoolNew(sizeof(bor_net_node_t), NET_POOL_SEGM_SIZE);
+    return borPoolAlloc(m->nodes_pool);
+}
+
+void borNetNodeFree(bor_net_t *m, bor_net_node_t *n)
+{
+    borPoolFree(m->nodes_pool, n);
+}
+
 bor_net_edge_t *borNetNodeCommonEdge(const bor_net_node_t *v1,
                                        const bor_net_node_t *v2)
 {
@@ -68,6 +87,18 @@ void borNetEdgeDel(bor_net_edge_t *e)
     BOR_FREE(e);
 }
 
+bor_net_edge_t *borNetEdgeAlloc(bor_net_t *m)
+{
+    if (!m->edges_pool)
+        m->edges_pool = borPoolNew(sizeof(bor_net_edge_t), NET_POOL_SEGM_SIZE);
+    return borPoolAlloc(m->edges_pool);
+}
+
+void borNetEdgeFree(bor_net_t *m, bor_net_edge_t *e)
+{
+    borPoolFree(m->edges_pool, e);
+}
+
 /** Returns true if two given edges have exactly one common node */
 _bor_inline int borNetEdgeTriCheckCommon(const bor_net_edge_t *e1,
                                            const bor_net_edge_t *e2)
@@ -116,6 +147,10 @@ bor_net_t *borNetNew(void)
     borListInit(&m->edges);
     m->edges_len = 0;
 
+    m->nodes_pool = NULL;
+    m->edges_pool = NULL;
+    m->csr = NULL;
+
     return m;
 }
 
@@ -132,6 +167,14 @@ void borNetDel2(bor_net_t *m,
     bor_net_edge_t *e;
     bor_list_t *item;
 
+    if (m->csr){
+        m->csr->net = NULL;
+        m->csr = NULL;
+    }
+
+    if (!delnode && !deledge && netAllPooled(m))
+        goto free_pools;
+
     // disedgeect all edges
     while (!borListEmpty(&m->edges)){
         item = borListNext(&m->edges);
@@ -154,6 +197,12 @@ void borNetDel2(bor_net_t *m,
         }
     }
 
+free_pools:
+    if (m->nodes_pool)
+        borPoolDel(m->nodes_pool);
+    if (m->edges_pool)
+        borPoolDel(m->edges_pool);
+
     BOR_FREE(m);
 }
 
@@ -164,6 +213,10 @@ void borNetAddNode(bor_net_t *m, bor_net_node_t *v)
 
     borListInit(&v->edges);
     v->edges_len = 0;
+
+    v->_id = -1;
+    if (m->csr)
+        borNetCSRNodeAdded(m->csr, v);
 }
 
 int borNetRemoveNode(bor_net_t *m, bor_net_node_t *v)
@@ -173,6 +226,9 @@ int borNetRemoveNode(bor_net_t *m, bor_net_node_t *v)
 
     borListDel(&v->list);
     m->nodes_len--;
+
+    if (m->csr)
+        borNetCSRNodeRemoved(m->csr, v);
     return 0;
 }
 
@@ -194,6 +250,11 @@ void borNetAddEdge(bor_net_t *m, bor_net_edge_t *e,
     // add edge to list of all edges
     borListAppend(&m->edges, &e->list);
     m->edges_len++;
+
+    if (m->csr){
+        borNetCSRNodeChanged(m->csr, start);
+        borNetCSRNodeChanged(m->csr, end);
+    }
 }
 
 void borNetRemoveEdge(bor_net_t *m, bor_net_edge_t *e)
@@ -207,6 +268,11 @@ void borNetRemoveEdge(bor_net_t *m, bor_net_edge_t *e)
     // remove edge from list of all edges
     borListDel(&e->list);
     m->edges_len--;
+
+    if (m->csr){
+        borNetCSRNodeChanged(m->csr, e->n[0]);
+        borNetCSRNodeChanged(m->csr, e->n[1]);
+    }
 }
 
 
@@ -236,3 +302,13 @@ void borNetTraverseEdge(bor_net_t *net,
     }
 }
 
+static int netAllPooled(const bor_net_t *m)
+{
+    if (m->nodes_len > 0
+            && (!m->nodes_pool || borPoolLen(m->nodes_pool) != m->nodes_len))
+        return 0;
+    if (m->edges_len > 0
+            && (!m->edges_pool || borPoolLen(m->edges_pool) != m->edges_len))
+        return 0;
+    return 1;
+}
@@ -0,0 +1,129 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <stdio.h>
+#include <limits.h>
+#include "boruvka/alloc.h"
+#include "boruvka/pbucketq.h"
+#include "_bucketbmap.h"
+
+/** Enlarges array of buckets so that it contains bucket {key} */
+static void grow(bor_pbucketq_t *q, int key);
+
+void borPBucketQInit(bor_pbucketq_t *q)
+{
+    q->bucket_size = BOR_PBUCKETQ_SIZE;
+    q->bucket = BOR_CALLOC_ARR(bor_pbucketq_bucket_t, q->bucket_size);
+    q->bmap = NULL;
+    q->bmap_top = NULL;
+    borBucketBmapResize(&q->bmap, &q->bmap_top, 0, q->bucket_size);
+    q->lowest_key = q->bucket_size;
+    q->size = 0;
+}
+
+void borPBucketQFree(bor_pbucketq_t *q)
+{
+    int i;
+
+    for (i = 0; i < q->bucket_size; ++i){
+        if (q->bucket[i].value != NULL)
+            BOR_FREE(q->bucket[i].value);
+    }
+    if (q->bucket != NULL)
+        BOR_FREE(q->bucket);
+    if (q->bmap != NULL)
+        BOR_FREE(q->bmap);
+    if (q->bmap_top != NULL)
+        BOR_FREE(q->bmap_top);
+}
+
+void borPBucketQPush(bor_pbucketq_t *q, int key, void * value)
+{
+    bor_pbucketq_bucket_t *bucket;
+
+    if (key < 0){
+        fprintf(stderr, "Error: borPBucketQ: negative key %d.\n", key);
+        exit(-1);
+    }
+
+    if (key >= q->bucket_size)
+        grow(q, key);
+
+    bucket = q->bucket + key;
+    if (bucket->value == NULL){
+        bucket->alloc = BOR_PBUCKETQ_BUCKET_INIT_SIZE;
+        bucket->value = BOR_ALLOC_ARR(void *, bucket->alloc);
+
+    }else if (bucket->size >= bucket->alloc){
+        bucket->alloc *= BOR_PBUCKETQ_BUCKET_EXPANSION_FACTOR;
+        bucket->value = BOR_REALLOC_ARR(bucket->value,
+                                        void *, bucket->alloc);
+    }
+    if (bucket->size == 0)
+        borBucketBmapSet(q->bmap, q->bmap_top, key);
+    bucket->value[bucket->size++] = value;
+    ++q->size;
+
+    if (key < q->lowest_key)
+        q->lowest_key = key;
+}
+
+void * borPBucketQPop(bor_pbucketq_t *q, int *key)
+{
+    bor_pbucketq_bucket_t *bucket;
+    void * val;
+
+    if (q->size == 0){
+        fprintf(stderr, "Error: borPBucketQ is empty!\n");
+        exit(-1);
+    }
+
+    bucket = q->bucket + q->lowest_key;
+    if (bucket->size == 0){
+        q->lowest_key = borBucketBmapNext(q->bmap, q->bmap_top,
+                                          q->bucket_size, q->lowest_key);
+        bucket = q->bucket + q->lowest_key;
+    }
+
+    val = bucket->value[--bucket->size];
+    if (bucket->size == 0)
+        borBucketBmapUnset(q->bmap, q->bmap_top, q->lowest_key);
+    *key = q->lowest_key;
+    --q->size;
+    return val;
+}
+
+static void grow(bor_pbucketq_t *q, int key)
+{
+    int size;
+
+    if (key > INT_MAX - 64){
+        fprintf(stderr, "Error: borPBucketQ: key %d is too large.\n", key);
+        exit(-1);
+    }
+
+    size = q->bucket_size;
+    while (size <= key && size < (1 << 30))
+        size *= 2;
+    if (size <= key)
+        size = ((key >> 6) + 1) << 6;
+
+    q->bucket = BOR_REALLOC_ARR(q->bucket, bor_pbucketq_bucket_t, size);
+    bzero(q->bucket + q->bucket_size,
+          sizeof(bor_pbucketq_bucket_t) * (size - q->bucket_size));
+    borBucketBmapResize(&q->bmap, &q->bmap_top, q->bucket_size, size);
+    q->bucket_size = size;
+}
@@ -16,6 +16,7 @@
 
 #include <boruvka/alloc.h>
 #include <boruvka/poly2.h>
+#include <boruvka/tasks.h>
 
 static void poly2Init(bor_poly2_t *p, int size)
 {
@@ -124,3 +125,372 @@ int borPoly2PointIn(const bor_poly2_t *p, const bor_vec2_t *v)
     }
     return odd;
 }
+
+
+/** Relative tolerance used for assigning edges to cells */
+#define GRID_EPS BOR_REAL(1E-5)
+
+/** Maximal number of cells per row or column */
+#define GRID_MAX_DIM 16384
+
+struct _grid_build_t {
+    bor_poly2_grid_t *g;
+    bor_real_t cw, ch;   /*!< Size of a cell */
+    bor_real_t eps_x, eps_y;
+    int *ecnt, *vcnt;    /*!< Number of edges and vertices per cell */
+    int fill;            /*!< True if .e* and .vy are filled */
+};
+typedef struct _grid_build_t grid_build_t;
+
+struct _grid_task_t {
+    const bor_poly2_grid_t *g;
+    const bor_vec2_t *pts;
+    int *in;
+    int from, to;
+};
+typedef struct _grid_task_t grid_task_t;
+
+/** Sets up size of the grid */
+static void gridSetUp(grid_build_t *b, int cells);
+/** Maps real coordinate to index of a cell, clamped to [-1, max] */
+static int gridIdx(bor_real_t v, bor_real_t lo, bor_real_t inv, int max);
+/** Computes range of cells [c0, c1] of {row} the i'th edge passes
+ *  through, all cells after c1 have the edge completely on the left.
+ *  Returns false if the edge does not intersect the row. */
+static int gridEdgeCells(const grid_build_t *b, int i, int row,
+                         int *c0, int *c1);
+/** Adds edges of all rows to the cells */
+static void gridEdges(grid_build_t *b);
+/** Adds vertices where the edges on the left side of the cell end */
+static void gridVertices(grid_build_t *b);
+/** Returns true if edge i is crossed by horizontal line at y */
+_bor_inline int gridCross(const bor_poly2_t *p, int i, bor_real_t y);
+/** Classifies range of points */
+static void gridTask(int id, void *data, const bor_tasks_thinfo_t *th);
+
+bor_poly2_grid_t *borPoly2GridNew(const bor_poly2_t *poly, int cells)
+{
+    grid_build_t b;
+    bor_poly2_grid_t *g;
+    int i, len;
+
+    g = BOR_ALLOC(bor_poly2_grid_t);
+    g->poly = poly;
+
+    b.g = g;
+    gridSetUp(&b, cells);
+    len = g->cols * g->rows;
+
+    g->parity = BOR_CALLOC_ARR(char, len);
+    g->cell = BOR_ALLOC_ARR(int, len + 1);
+    g->vcell = BOR_ALLOC_ARR(int, len + 1);
+    b.ecnt = BOR_CALLOC_ARR(int, len);
+    b.vcnt = BOR_CALLOC_ARR(int, len);
+
+    /* count edges and vertices of cells first */
+    b.fill = 0;
+    gridEdges(&b);
+    gridVertices(&b);
+
+    g->cell[0] = g->vcell[0] = 0;
+    for (i = 0; i < len; ++i){
+        g->cell[i + 1] = g->cell[i] + b.ecnt[i];
+        g->vcell[i + 1] = g->vcell[i] + b.vcnt[i];
+        b.ecnt[i] = g->cell[i];
+        b.vcnt[i] = g->vcell[i];
+    }
+
+    g->ey0 = BOR_ALLOC_ARR(bor_real_t, g->cell[len] + 1);
+    g->ey1 = BOR_ALLOC_ARR(bor_real_t, g->cell[len] + 1);
+    g->emul = BOR_ALLOC_ARR(bor_real_t, g->cell[len] + 1);
+    g->econ = BOR_ALLOC_ARR(bor_real_t, g->cell[len] + 1);
+    g->vy = BOR_ALLOC_ARR(bor_real_t, g->vcell[len] + 1);
+
+    /* and then fill them, parity is computed in this pass */
+    b.fill = 1;
+    gridEdges(&b);
+    gridVertices(&b);
+
+    BOR_FREE(b.ecnt);
+    BOR_FREE(b.vcnt);
+
+    return g;
+}
+
+void borPoly2GridDel(bor_poly2_grid_t *g)
+{
+    BOR_FREE(g->parity);
+    BOR_FREE(g->cell);
+    BOR_FREE(g->vcell);
+    BOR_FREE(g->ey0);
+    BOR_FREE(g->ey1);
+    BOR_FREE(g->emul);
+    BOR_FREE(g->econ);
+    BOR_FREE(g->vy);
+    BOR_FREE(g);
+}
+
+int borPoly2GridPointIn(const bor_poly2_grid_t *g, const bor_vec2_t *v)
+{
+    int c, r, i, end, odd;
+    bor_real_t x, y;
+
+    x = borVec2X(v);
+    y = borVec2Y(v);
+
+    if (x < g->x0 || x >= g->x1 || y < g->y0 || y >= g->y1)
+        return 0;
+
+    c = BOR_MIN((int)((x - g->x0) * g->inv_w), g->cols - 1);
+    r = BOR_MIN((int)((y - g->y0) * g->inv_h), g->rows - 1);
+    c = r * g->cols + c;
+
+    odd = g->parity[c];
+
+    /* The loops are kept branch-free so that they can be vectorized. */
+    end = g->cell[c + 1];
+    for (i = g->cell[c]; i < end; ++i){
+        odd ^= ((g->ey0[i] < y) ^ (g->ey1[i] < y))
+                    & (y * g->emul[i] + g->econ[i] < x);
+    }
+
+    end = g->vcell[c + 1];
+    for (i = g->vcell[c]; i < end; ++i)
+        odd ^= (g->vy[i] < y);
+
+    return odd;
+}
+
+void borPoly2GridPointsIn(const bor_poly2_grid_t *g,
+                          const bor_vec2_t *pts, int len, int *in,
+                          int num_threads)
+{
+    bor_tasks_t *tasks;
+    grid_task_t *task;
+    int i;
+
+    if (num_threads <= 1 || len < 2 * num_threads){
+        for (i = 0; i < len; ++i)
+            in[i] = borPoly2GridPointIn(g, pts + i);
+        return;
+    }
+
+    task = BOR_ALLOC_ARR(grid_task_t, num_threads);
+    tasks = borTasksNew(num_threads);
+    borTasksRun(tasks);
+    for (i = 0; i < num_threads; ++i){
+        task[i].g = g;
+        task[i].pts = pts;
+        task[i].in = in;
+        task[i].from = (long)len * i / num_threads;
+        task[i].to = (long)len * (i + 1) / num_threads;
+        borTasksAdd(tasks, gridTask, i, task + i);
+    }
+    borTasksBarrier(tasks);
+    borTasksDel(tasks);
+    BOR_FREE(task);
+}
+
+
+static void gridSetUp(grid_build_t *b, int cells)
+{
+    bor_poly2_grid_t *g = b->g;
+    const bor_poly2_t *p = g->poly;
+    bor_real_t xmin, xmax, ymin, ymax, w, h, absmax;
+    int i;
+
+    xmin = ymin = BOR_REAL_MAX;
+    xmax = ymax = -BOR_REAL_MAX;
+    for (i = 0; i < p->size; ++i){
+        xmin = BOR_MIN(xmin, p->px[i]);
+        xmax = BOR_MAX(xmax, p->px[i]);
+        ymin = BOR_MIN(ymin, p->py[i]);
+        ymax = BOR_MAX(ymax, p->py[i]);
+    }
+    if (p->size == 0){
+        xmin = xmax = ymin = ymax = BOR_ZERO;
+    }
+
+    absmax = BOR_MAX(BOR_MAX(BOR_FABS(xmin), BOR_FABS(xmax)),
+                     BOR_MAX(BOR_FABS(ymin), BOR_FABS(ymax)));
+    w = xmax - xmin;
+    h = ymax - ymin;
+    b->eps_x = b->eps_y = GRID_EPS * (BOR_MAX(w, h) + absmax);
+    if (b->eps_x == BOR_ZERO)
+        b->eps_x = b->eps_y = GRID_EPS;
+
+    g->x0 = xmin - b->eps_x;
+    g->x1 = xmax + b->eps_x;
+    g->y0 = ymin - b->eps_y;
+    g->y1 = ymax + b->eps_y;
+    w = g->x1 - g->x0;
+    h = g->y1 - g->y0;
+
+    if (cells <= 0)
+        cells = 2 * p->size;
+    cells = BOR_MAX(cells, 1);
+    g->cols = BOR_SQRT((bor_real_t)cells * w / h) + BOR_REAL(0.5);
+    g->cols = BOR_MAX(BOR_MIN(g->cols, GRID_MAX_DIM), 1);
+    g->rows = BOR_MAX(BOR_MIN(cells / g->cols, GRID_MAX_DIM), 1);
+
+    b->cw = w / g->cols;
+    b->ch = h / g->rows;
+    g->inv_w = BOR_ONE / b->cw;
+    g->inv_h = BOR_ONE / b->ch;
+}
+
+static int gridIdx(bor_real_t v, bor_real_t lo, bor_real_t inv, int max)
+{
+    v = (v - lo) * inv;
+    if (v < BOR_ZERO)
+        return -1;
+    if (v >= max)
+        return max;
+    return v;
+}
+
+static int gridEdgeCells(const grid_build_t *b, int i, int row,
+                         int *c0, int *c1)
+{
+    const bor_poly2_grid_t *g = b->g;
+    const bor_poly2_t *p = g->poly;
+    bor_real_t ylo, yhi, ya, yb, xa, xb;
+    int j;
+
+    j = (i == 0 ? p->size - 1 : i - 1);
+    ylo = BOR_MIN(p->py[i], p->py[j]);
+    yhi = BOR_MAX(p->py[i], p->py[j]);
+
+    ya = g->y0 + row * b->ch;
+    yb = ya + b->ch;
+    ya = BOR_MAX(ylo, ya - b->eps_y);
+    yb = BOR_MIN(yhi, yb + b->eps_y);
+    if (ya > yb)
+        return 0;
+
+    if (p->py[i] == p->py[j]){
+        xa = BOR_MIN(p->px[i], p->px[j]);
+        xb = BOR_MAX(p->px[i], p->px[j]);
+    }else{
+        /* Use the same formula as the crossing test so that the range
+         * contains exactly the values the test can compute. */
+        xa = ya * p->multiple[i] + p->constant[i];
+        xb = yb * p->multiple[i] + p->constant[i];
+        if (xa > xb)
+            BOR_SWAP(xa, xb, ylo);
+    }
+
+    *c0 = gridIdx(xa - b->eps_x, g->x0, g->inv_w, g->cols);
+    *c1 = gridIdx(xb + b->eps_x, g->x0, g->inv_w, g->cols);
+    *c0 = BOR_MAX(*c0, 0);
+    *c1 = BOR_MIN(*c1, g->cols - 1);
+    return 1;
+}
+
+_bor_inline int gridCross(const bor_poly2_t *p, int i, bor_real_t y)
+{
+    int j = (i == 0 ? p->size - 1 : i - 1);
+    return (p->py[j] < y) ^ (p->py[i] < y);
+}
+
+static void gridEdges(grid_build_t *b)
+{
+    bor_poly2_grid_t *g = b->g;
+    const bor_poly2_t *p = g->poly;
+    bor_real_t ylo, yhi, yc;
+    int i, j, r, r0, r1, c, c0, c1, k, id;
+
+    for (i = 0; i < p->size; ++i){
+        j = (i == 0 ? p->size - 1 : i - 1);
+        ylo = BOR_MIN(p->py[i], p->py[j]);
+        yhi = BOR_MAX(p->py[i], p->py[j]);
+        r0 = gridIdx(ylo - b->eps_y, g->y0, g->inv_h, g->rows - 1);
+        r1 = gridIdx(yhi + b->eps_y, g->y0, g->inv_h, g->rows - 1);
+        r0 = BOR_MAX(r0, 0);
+
+        for (r = r0; r <= r1; ++r){
+            if (!gridEdgeCells(b, i, r, &c0, &c1))
+                continue;
+
+            /* Edges completely on the left side of a cell contribute to
+             * its parity taken in the middle of the row. Here it is only
+             * toggled in the first such cell and summed up below. */
+            yc = g->y0 + (r + BOR_REAL(0.5)) * b->ch;
+            if (b->fill && c1 + 1 < g->cols && gridCross(p, i, yc))
+                g->parity[r * g->cols + c1 + 1] ^= 1;
+
+            for (c = c0; c <= c1; ++c){
+                id = r * g->cols + c;
+                if (b->fill){
+                    k = b->ecnt[id];
+                    g->ey0[k] = p->py[j];
+                    g->ey1[k] = p->py[i];
+                    g->emul[k] = p->multiple[i];
+                    g->econ[k] = p->constant[i];
+                }
+                ++b->ecnt[id];
+            }
+        }
+    }
+
+    if (!b->fill)
+        return;
+
+    /* Turn the toggles into parity of each cell */
+    for (r = 0; r < g->rows; ++r){
+        for (c = 0, k = 0; c < g->cols; ++c){
+            id = r * g->cols + c;
+            k ^= g->parity[id];
+            g->parity[id] = k;
+        }
+    }
+}
+
+static void gridVertices(grid_build_t *b)
+{
+    bor_poly2_grid_t *g = b->g;
+    const bor_poly2_t *p = g->poly;
+    bor_real_t y, yc;
+    int i, next, r, r0, r1, c, c0, c1, ca, cb, id;
+
+    /* The crossings of the edges on the left side of a cell telescope to
+     * the sum of [py < y] over their end points. The end points shared by
+     * two such edges cancel out and those outside the row are constant.
+     * So only the vertices inside the row connecting an edge on the left
+     * with an edge of the cell need to be stored. */
+    for (i = 0; i < p->size; ++i){
+        next = (i + 1 == p->size ? 0 : i + 1);
+        y = p->py[i];
+        r0 = gridIdx(y - b->eps_y / 2, g->y0, g->inv_h, g->rows - 1);
+        r1 = gridIdx(y + b->eps_y / 2, g->y0, g->inv_h, g->rows - 1);
+        r0 = BOR_MAX(r0, 0);
+
+        for (r = r0; r <= r1; ++r){
+            if (!gridEdgeCells(b, i, r, &c0, &ca)
+                    || !gridEdgeCells(b, next, r, &c0, &cb)){
+                continue;
+            }
+
+            c0 = BOR_MIN(ca, cb) + 1;
+            c1 = BOR_MAX(ca, cb);
+            yc = g->y0 + (r + BOR_REAL(0.5)) * b->ch;
+            for (c = c0; c <= c1; ++c){
+                id = r * g->cols + c;
+                if (b->fill){
+                    g->vy[b->vcnt[id]] = y;
+                    g->parity[id] ^= (y < yc);
+                }
+                ++b->vcnt[id];
+            }
+        }
+    }
+}
+
+static void gridTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    grid_task_t *t = (grid_task_t *)data;
+    int i;
+
+    for (i = t->from; i < t->to; ++i)
+        t->in[i] = borPoly2GridPointIn(t->g, t->pts + i);
+}
@@ -0,0 +1,45 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2016 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <boruvka/alloc.h>
+#include <boruvka/pool.h>
+
+/** Alignment of elements, segments are allocated by malloc() which
+ *  returns memory aligned at least to this boundary */
+#define POOL_ALIGN 16
+
+bor_pool_t *borPoolNew(size_t el_size, size_t segment_size)
+{
+    bor_pool_t *pool;
+
+    el_size = BOR_MAX(el_size, sizeof(void *));
+    el_size = (el_size + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+    segment_size = BOR_MAX(segment_size, el_size);
+
+    pool = BOR_ALLOC(bor_pool_t);
+    pool->arr  = borSegmArrNew(el_size, segment_size);
+    pool->used = 0;
+    pool->free = NULL;
+    pool->len  = 0;
+
+    return pool;
+}
+
+void borPoolDel(bor_pool_t *pool)
+{
+    borSegmArrDel(pool->arr);
+    BOR_FREE(pool);
+}
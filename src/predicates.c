@@ -2620,3 +2620,262 @@ REAL borPredInSphere(const bor_pred_t *pred,
 
   return insphereadapt(pred, pa, pb, pc, pd, pe, permanent);
 }
+
+
+/*****************************************************************************/
+/*                                                                           */
+/*  Batch predicates.                                                        */
+/*                                                                           */
+/*  Points are processed in blocks. For each block, determinants are        */
+/*  computed in a loop without any branches (using the same expressions as   */
+/*  the robust predicates above) together with maximal absolute values of    */
+/*  the coordinate differences. These maximums bound the "permanent" of the  */
+/*  determinant for the whole block, which gives a semi-static error bound   */
+/*  (based on the first stage bounds A of the robust predicates enlarged by  */
+/*  a safety factor covering roundoff in the bound itself). Only points      */
+/*  whose determinant does not exceed the bound are recomputed by the        */
+/*  robust predicate.                                                        */
+/*                                                                           */
+/*****************************************************************************/
+
+#define BATCH_BLOCK 64
+
+/** Returns safety factor covering roundoff errors of the static bound */
+_bor_inline REAL batchSafe(const bor_pred_t *pred)
+{
+    return BOR_ONE + BOR_REAL(64.) * pred->epsilon;
+}
+
+void borPredOrient2dBatch(const bor_pred_t *pred,
+                          const bor_vec2_t *pa,
+                          const bor_vec2_t *pb,
+                          const bor_vec2_t *pc, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat)
+{
+    REAL acx, bcx, acy, bcy, mx, my, bound, safe;
+    unsigned long fallback = 0;
+    size_t i, start, end;
+
+    safe = batchSafe(pred);
+    for (start = 0; start < len; start = end){
+        end = BOR_MIN(start + BATCH_BLOCK, len);
+
+        mx = my = BOR_ZERO;
+        for (i = start; i < end; ++i){
+            acx = borVec2X(pa) - borVec2X(pc + i);
+            bcx = borVec2X(pb) - borVec2X(pc + i);
+            acy = borVec2Y(pa) - borVec2Y(pc + i);
+            bcy = borVec2Y(pb) - borVec2Y(pc + i);
+            res[i] = acx * bcy - acy * bcx;
+
+            mx = BOR_FMAX(mx, BOR_FMAX(BOR_FABS(acx), BOR_FABS(bcx)));
+            my = BOR_FMAX(my, BOR_FMAX(BOR_FABS(acy), BOR_FABS(bcy)));
+        }
+
+        // detsum <= 2 * mx * my
+        bound = pred->ccwerrboundA * BOR_REAL(2.) * mx * my * safe;
+        for (i = start; i < end; ++i){
+            if (res[i] > bound || -res[i] > bound)
+                continue;
+            res[i] = borPredOrient2d(pred, pa, pb, pc + i);
+            ++fallback;
+        }
+    }
+
+    if (stat){
+        stat->tests += len;
+        stat->fallback += fallback;
+    }
+}
+
+void borPredOrient3dBatch(const bor_pred_t *pred,
+                          const bor_vec3_t *pa,
+                          const bor_vec3_t *pb,
+                          const bor_vec3_t *pc,
+                          const bor_vec3_t *pd, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat)
+{
+    REAL adx, bdx, cdx, ady, bdy, cdy, adz, bdz, cdz;
+    REAL mx, my, mz, bound, safe;
+    unsigned long fallback = 0;
+    size_t i, start, end;
+
+    safe = batchSafe(pred);
+    for (start = 0; start < len; start = end){
+        end = BOR_MIN(start + BATCH_BLOCK, len);
+
+        mx = my = mz = BOR_ZERO;
+        for (i = start; i < end; ++i){
+            adx = borVec3X(pa) - borVec3X(pd + i);
+            bdx = borVec3X(pb) - borVec3X(pd + i);
+            cdx = borVec3X(pc) - borVec3X(pd + i);
+            ady = borVec3Y(pa) - borVec3Y(pd + i);
+            bdy = borVec3Y(pb) - borVec3Y(pd + i);
+            cdy = borVec3Y(pc) - borVec3Y(pd + i);
+            adz = borVec3Z(pa) - borVec3Z(pd + i);
+            bdz = borVec3Z(pb) - borVec3Z(pd + i);
+            cdz = borVec3Z(pc) - borVec3Z(pd + i);
+
+            res[i] = adz * (bdx * cdy - cdx * bdy)
+                   + bdz * (cdx * ady - adx * cdy)
+                   + cdz * (adx * bdy - bdx * ady);
+
+            mx = BOR_FMAX(mx, BOR_FMAX(BOR_FABS(adx),
+                                       BOR_FMAX(BOR_FABS(bdx), BOR_FABS(cdx))));
+            my = BOR_FMAX(my, BOR_FMAX(BOR_FABS(ady),
+                                       BOR_FMAX(BOR_FABS(bdy), BOR_FABS(cdy))));
+            mz = BOR_FMAX(mz, BOR_FMAX(BOR_FABS(adz),
+                                       BOR_FMAX(BOR_FABS(bdz), BOR_FABS(cdz))));
+        }
+
+        // permanent <= 6 * mx * my * mz
+        bound = pred->o3derrboundA * BOR_REAL(6.) * mx * my * mz * safe;
+        for (i = start; i < end; ++i){
+            if (res[i] > bound || -res[i] > bound)
+                continue;
+            res[i] = borPredOrient3d(pred, pa, pb, pc, pd + i);
+            ++fallback;
+        }
+    }
+
+    if (stat){
+        stat->tests += len;
+        stat->fallback += fallback;
+    }
+}
+
+void borPredInCircleBatch(const bor_pred_t *pred,
+                          const bor_vec2_t *pa,
+                          const bor_vec2_t *pb,
+                          const bor_vec2_t *pc,
+                          const bor_vec2_t *pd, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat)
+{
+    REAL adx, bdx, cdx, ady, bdy, cdy;
+    REAL alift, blift, clift;
+    REAL mx, my, bound, safe;
+    unsigned long fallback = 0;
+    size_t i, start, end;
+
+    safe = batchSafe(pred);
+    for (start = 0; start < len; start = end){
+        end = BOR_MIN(start + BATCH_BLOCK, len);
+
+        mx = my = BOR_ZERO;
+        for (i = start; i < end; ++i){
+            adx = borVec2X(pa) - borVec2X(pd + i);
+            bdx = borVec2X(pb) - borVec2X(pd + i);
+            cdx = borVec2X(pc) - borVec2X(pd + i);
+            ady = borVec2Y(pa) - borVec2Y(pd + i);
+            bdy = borVec2Y(pb) - borVec2Y(pd + i);
+            cdy = borVec2Y(pc) - borVec2Y(pd + i);
+
+            alift = adx * adx + ady * ady;
+            blift = bdx * bdx + bdy * bdy;
+            clift = cdx * cdx + cdy * cdy;
+
+            res[i] = alift * (bdx * cdy - cdx * bdy)
+                   + blift * (cdx * ady - adx * cdy)
+                   + clift * (adx * bdy - bdx * ady);
+
+            mx = BOR_FMAX(mx, BOR_FMAX(BOR_FABS(adx),
+                                       BOR_FMAX(BOR_FABS(bdx), BOR_FABS(cdx))));
+            my = BOR_FMAX(my, BOR_FMAX(BOR_FABS(ady),
+                                       BOR_FMAX(BOR_FABS(bdy), BOR_FABS(cdy))));
+        }
+
+        // permanent <= 6 * mx * my * (mx^2 + my^2)
+        bound  = pred->iccerrboundA * BOR_REAL(6.) * mx * my;
+        bound *= (mx * mx + my * my) * safe;
+        for (i = start; i < end; ++i){
+            if (res[i] > bound || -res[i] > bound)
+                continue;
+            res[i] = borPredInCircle(pred, pa, pb, pc, pd + i);
+            ++fallback;
+        }
+    }
+
+    if (stat){
+        stat->tests += len;
+        stat->fallback += fallback;
+    }
+}
+
+void borPredInSphereBatch(const bor_pred_t *pred,
+                          const bor_vec3_t *pa,
+                          const bor_vec3_t *pb,
+                          const bor_vec3_t *pc,
+                          const bor_vec3_t *pd,
+                          const bor_vec3_t *pe, size_t len,
+                          bor_real_t *res, bor_pred_stat_t *stat)
+{
+    REAL aex, bex, cex, dex, aey, bey, cey, dey, aez, bez, cez, dez;
+    REAL ab, bc, cd, da, ac, bd;
+    REAL abc, bcd, cda, dab;
+    REAL alift, blift, clift, dlift;
+    REAL mx, my, mz, bound, safe;
+    unsigned long fallback = 0;
+    size_t i, start, end;
+
+    safe = batchSafe(pred);
+    for (start = 0; start < len; start = end){
+        end = BOR_MIN(start + BATCH_BLOCK, len);
+
+        mx = my = mz = BOR_ZERO;
+        for (i = start; i < end; ++i){
+            aex = borVec3X(pa) - borVec3X(pe + i);
+            bex = borVec3X(pb) - borVec3X(pe + i);
+            cex = borVec3X(pc) - borVec3X(pe + i);
+            dex = borVec3X(pd) - borVec3X(pe + i);
+            aey = borVec3Y(pa) - borVec3Y(pe + i);
+            bey = borVec3Y(pb) - borVec3Y(pe + i);
+            cey = borVec3Y(pc) - borVec3Y(pe + i);
+            dey = borVec3Y(pd) - borVec3Y(pe + i);
+            aez = borVec3Z(pa) - borVec3Z(pe + i);
+            bez = borVec3Z(pb) - borVec3Z(pe + i);
+            cez = borVec3Z(pc) - borVec3Z(pe + i);
+            dez = borVec3Z(pd) - borVec3Z(pe + i);
+
+            ab = aex * bey - bex * aey;
+            bc = bex * cey - cex * bey;
+            cd = cex * dey - dex * cey;
+            da = dex * aey - aex * dey;
+            ac = aex * cey - cex * aey;
+            bd = bex * dey - dex * bey;
+
+            abc = aez * bc - bez * ac + cez * ab;
+            bcd = bez * cd - cez * bd + dez * bc;
+            cda = cez * da + dez * ac + aez * cd;
+            dab = dez * ab + aez * bd + bez * da;
+
+            alift = aex * aex + aey * aey + aez * aez;
+            blift = bex * bex + bey * bey + bez * bez;
+            clift = cex * cex + cey * cey + cez * cez;
+            dlift = dex * dex + dey * dey + dez * dez;
+
+            res[i] = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+            mx = BOR_FMAX(mx, BOR_FMAX(BOR_FMAX(BOR_FABS(aex), BOR_FABS(bex)),
+                                       BOR_FMAX(BOR_FABS(cex), BOR_FABS(dex))));
+            my = BOR_FMAX(my, BOR_FMAX(BOR_FMAX(BOR_FABS(aey), BOR_FABS(bey)),
+                                       BOR_FMAX(BOR_FABS(cey), BOR_FABS(dey))));
+            mz = BOR_FMAX(mz, BOR_FMAX(BOR_FMAX(BOR_FABS(aez), BOR_FABS(bez)),
+                                       BOR_FMAX(BOR_FABS(cez), BOR_FABS(dez))));
+        }
+
+        // permanent <= 24 * mx * my * mz * (mx^2 + my^2 + mz^2)
+        bound  = pred->isperrboundA * BOR_REAL(24.) * mx * my * mz;
+        bound *= (mx * mx + my * my + mz * mz) * safe;
+        for (i = start; i < end; ++i){
+            if (res[i] > bound || -res[i] > bound)
+                continue;
+            res[i] = borPredInSphere(pred, pa, pb, pc, pd, pe + i);
+            ++fallback;
+        }
+    }
+
+    if (stat){
+        stat->tests += len;
+        stat->fallback += fallback;
+    }
+}
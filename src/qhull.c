@@ -4,6 +4,9 @@
 #include <boruvka/qhull.h>
 #include <boruvka/alloc.h>
 #include <boruvka/dbg.h>
+#include <boruvka/predicates.h>
+#include <boruvka/rand.h>
+#include <boruvka/sort.h>
 
 
 /** Maximal length of line  */
@@ -12,11 +15,6 @@
 /** Creates new qhull mesh3 */
 static bor_qhull_mesh3_t *borQHullMesh3New(size_t vertices);
 
-/** Deletes dymanically allocated vertices, edges and faces */
-static void mesh3DelVert(bor_mesh3_vertex_t *v, void *data);
-static void mesh3DelEdge(bor_mesh3_edge_t *e, void *data);
-static void mesh3DelFace(bor_mesh3_face_t *f, void *data);
-
 /** Writes point cloud into fd in format qhull accepts.
  *  Returns 0 on success */
 static int writePC33(bor_pc_t *pc, int fd);
@@ -24,12 +22,94 @@ static int writePC33(bor_pc_t *pc, int fd);
 static bor_qhull_mesh3_t *qdelaunayToMesh3(int fd);
 
 
+/**
+ * Native Delaunay Triangulation
+ * ------------------------------
+ * Bowyer-Watson algorithm. Tetrahedra are stored in an array and refer to
+ * each other by indices. The triangulation is closed by "ghost"
+ * tetrahedra connecting each convex hull face with a vertex in infinity,
+ * so the point outside the current hull is handled same way as the
+ * point inside. All decisions are made by exact predicates.
+ */
+
+/** Vertex in infinity */
+#define DT_INF -1
+/** Mark of unused tetrahedron */
+#define DT_FREE -2
+/** Seed of the insertion order, fixed so that the triangulation of
+ *  degenerate (e.g., co-spherical) input is reproducible */
+#define DT_RAND_SEED 3145739
+
+struct _dt_tet_t {
+    int v[4];  /*!< Vertices, only v[3] can be DT_INF. Finite tetrahedra
+                    are positively oriented (see borPredOrient3d()) */
+    int nb[4]; /*!< nb[i] is neighbour opposite to v[i] */
+    int mark;  /*!< Mark used during search for cavity */
+};
+typedef struct _dt_tet_t dt_tet_t;
+
+struct _dt_hash_t {
+    int a, b;  /*!< Edge */
+    int tet;   /*!< Tetrahedron and its face containing the edge */
+    int face;
+};
+typedef struct _dt_hash_t dt_hash_t;
+
+struct _dt_sort_t {
+    long key;
+    int id;
+};
+typedef struct _dt_sort_t dt_sort_t;
+
+struct _dt_t {
+    const bor_vec3_t *pts;
+    bor_pred_t pred;
+
+    dt_tet_t *tets;
+    int tets_len, tets_size;
+    int free;          /*!< List of unused tetrahedra linked by .nb[0] */
+    int mark;          /*!< Last used mark */
+    int last;          /*!< Starting tetrahedron for walk */
+    unsigned int walk; /*!< Counter for choosing first face in walk */
+
+    int *cavity;       /*!< Tetrahedra in conflict with inserted point */
+    int cavity_len, cavity_size;
+    int *bound;        /*!< Pairs (tet, face) of boundary of cavity */
+    int bound_len, bound_size;
+    dt_hash_t *hash;   /*!< Edges of new tetrahedra waiting for neighbour */
+    int hash_size;
+    int hash_mask;     /*!< Mask of part of .hash used by current
+                            insertion */
+};
+typedef struct _dt_t dt_t;
+
+/** Vertices of face opposite to i'th vertex ordered so that the i'th
+ *  vertex lies on positive side */
+static const int dt_face[4][3] = { {1, 3, 2}, {0, 2, 3}, {0, 3, 1}, {0, 1, 2} };
+
+/** Orders points for insertion (BRIO with Morton order in each round) */
+static void dtInsertOrder(const bor_vec3_t *pts, size_t n, int *order);
+/** Creates initial tetrahedron from four non-coplanar points found in
+ *  {order}; these are set to -1. Returns -1 if there are no such. */
+static int dtInit(dt_t *dt, int *order, size_t n);
+/** Inserts point into triangulation */
+static void dtInsert(dt_t *dt, int p);
+/** Returns tetrahedron in conflict with p or -1 if p is duplicate */
+static int dtLocate(dt_t *dt, int p);
+/** Returns true if tetrahedron is in conflict with point */
+static int dtConflict(dt_t *dt, const dt_tet_t *t, int p);
+static int dtTetNew(dt_t *dt);
+static void dtTetDel(dt_t *dt, int t);
+/** Sets neighbour of new tetrahedron {t} across its {face} using hash
+ *  table of edges */
+static void dtLinkFace(dt_t *dt, int t, int face, int pi);
+
+
 void borQHullMesh3Del(bor_qhull_mesh3_t *m)
 {
     if (m->mesh){
-        borMesh3Del2(m->mesh, mesh3DelVert, NULL,
-                              mesh3DelEdge, NULL,
-                              mesh3DelFace, NULL);
+        // vertices and edges are allocated from pools of the mesh
+        borMesh3Del(m->mesh);
     }
 
     if (m->vecs){
@@ -58,6 +138,87 @@ void borQDelaunayDel(bor_qdelaunay_t *q)
     BOR_FREE(q);
 }
 
+bor_qhull_mesh3_t *borDelaunayMesh3(const bor_pc_t *pc)
+{
+    bor_qhull_mesh3_t *qmesh;
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **verts;
+    bor_mesh3_edge_t *edge;
+    bor_pc_it_t pcit;
+    const bor_vec_t *v;
+    dt_t dt;
+    dt_tet_t *t;
+    int *order, i, j, k;
+    size_t n, pi;
+
+    n = borPCLen(pc);
+    qmesh = borQHullMesh3New(n);
+    mesh = borQHullMesh3(qmesh);
+
+    verts = BOR_ALLOC_ARR(bor_mesh3_vertex_t *, n);
+    borPCItInit(&pcit, (bor_pc_t *)pc);
+    for (pi = 0; pi < n; pi++){
+        v = borPCItGet(&pcit);
+        borVec3Set(&qmesh->vecs[pi], borVecGet(v, 0), borVecGet(v, 1),
+                                     borVecGet(v, 2));
+
+        verts[pi] = borMesh3VertexAlloc(mesh);
+        borMesh3VertexSetCoords(verts[pi], &qmesh->vecs[pi]);
+        borMesh3AddVertex(mesh, verts[pi]);
+
+        borPCItNext(&pcit);
+    }
+
+    memset(&dt, 0, sizeof(dt));
+    dt.pts = qmesh->vecs;
+    borPredInit(&dt.pred);
+    dt.free = -1;
+
+    order = BOR_ALLOC_ARR(int, n);
+    dtInsertOrder(qmesh->vecs, n, order);
+    if (dtInit(&dt, order, n) != 0){
+        // all points are coplanar
+        BOR_FREE(order);
+        BOR_FREE(verts);
+        borQHullMesh3Del(qmesh);
+        return NULL;
+    }
+
+    for (pi = 0; pi < n; pi++){
+        if (order[pi] >= 0)
+            dtInsert(&dt, order[pi]);
+    }
+
+    // create edges of finite tetrahedra
+    for (i = 0; i < dt.tets_len; i++){
+        t = dt.tets + i;
+        if (t->v[0] == DT_FREE || t->v[3] == DT_INF)
+            continue;
+
+        for (j = 0; j < 3; j++){
+            for (k = j + 1; k < 4; k++){
+                edge = borMesh3VertexCommonEdge(verts[t->v[j]], verts[t->v[k]]);
+                if (!edge){
+                    edge = borMesh3EdgeAlloc(mesh);
+                    borMesh3AddEdge(mesh, edge, verts[t->v[j]], verts[t->v[k]]);
+                }
+            }
+        }
+    }
+
+    BOR_FREE(order);
+    BOR_FREE(verts);
+    BOR_FREE(dt.tets);
+    if (dt.cavity)
+        BOR_FREE(dt.cavity);
+    if (dt.bound)
+        BOR_FREE(dt.bound);
+    if (dt.hash)
+        BOR_FREE(dt.hash);
+
+    return qmesh;
+}
+
 void borQDelaunaySetPath(bor_qdelaunay_t *q, const char *path)
 {
     if (q->bin_path)
@@ -157,21 +318,6 @@ static bor_qhull_mesh3_t *borQHullMesh3New(size_t vertices)
     return m;
 }
 
-static void mesh3DelVert(bor_mesh3_vertex_t *v, void *data)
-{
-    BOR_FREE(v);
-}
-
-static void mesh3DelEdge(bor_mesh3_edge_t *e, void *data)
-{
-    BOR_FREE(e);
-}
-
-static void mesh3DelFace(bor_mesh3_face_t *f, void *data)
-{
-    BOR_FREE(f);
-}
-
 static int writePC33(bor_pc_t *pc, int fd)
 {
     FILE *fout;
@@ -248,7 +394,7 @@ static bor_qhull_mesh3_t *qdelaunayToMesh3(int fd)
 
         borVec3Set(&qmesh->vecs[i], x, y, z);
 
-        vert = BOR_ALLOC(bor_mesh3_vertex_t);
+        vert = borMesh3VertexAlloc(mesh);
         borMesh3VertexSetCoords(vert, &qmesh->vecs[i]);
         borMesh3AddVertex(mesh, vert);
         verts[i] = vert;
@@ -268,7 +414,7 @@ static bor_qhull_mesh3_t *qdelaunayToMesh3(int fd)
                 // create new edge only if it is not already there
                 edge = borMesh3VertexCommonEdge(verts[id[j]], verts[id[k]]);
                 if (!edge){
-                    edge = BOR_ALLOC(bor_mesh3_edge_t);
+                    edge = borMesh3EdgeAlloc(mesh);
                     borMesh3AddEdge(mesh, edge, verts[id[j]], verts[id[k]]);
                 }
             }
@@ -283,3 +429,412 @@ static bor_qhull_mesh3_t *qdelaunayToMesh3(int fd)
     fclose(fin);
     return qmesh;
 }
+
+
+
+static long dtMorton(unsigned long x)
+{
+    // spread lower 21 bits of x to every third bit
+    x &= 0x1fffffUL;
+    x = (x | (x << 32)) & 0x1f00000000ffffUL;
+    x = (x | (x << 16)) & 0x1f0000ff0000ffUL;
+    x = (x | (x << 8))  & 0x100f00f00f00f00fUL;
+    x = (x | (x << 4))  & 0x10c30c30c30c30c3UL;
+    x = (x | (x << 2))  & 0x1249249249249249UL;
+    return x;
+}
+
+static void dtInsertOrder(const bor_vec3_t *pts, size_t n, int *order)
+{
+    dt_sort_t *sort;
+    bor_rand_t rnd;
+    bor_real_t aabb[6], scale, range;
+    unsigned long c[3];
+    size_t i, j, from, to, tmp;
+    int a;
+
+    if (n == 0)
+        return;
+
+    for (a = 0; a < 3; a++){
+        aabb[2 * a] = aabb[2 * a + 1] = borVec3Get(&pts[0], a);
+    }
+    for (i = 1; i < n; i++){
+        for (a = 0; a < 3; a++){
+            aabb[2 * a] = BOR_MIN(aabb[2 * a], borVec3Get(&pts[i], a));
+            aabb[2 * a + 1] = BOR_MAX(aabb[2 * a + 1], borVec3Get(&pts[i], a));
+        }
+    }
+    range = BOR_MAX(aabb[1] - aabb[0], aabb[3] - aabb[2]);
+    range = BOR_MAX(range, aabb[5] - aabb[4]);
+    scale = BOR_ZERO;
+    if (range > BOR_ZERO)
+        scale = BOR_REAL(2097151.) / range;
+
+    // biased randomized insertion order: points are shuffled and split
+    // into rounds of doubling size, each round is sorted along space
+    // filling curve
+    for (i = 0; i < n; i++)
+        order[i] = i;
+    borRandInitSeed(&rnd, DT_RAND_SEED);
+    for (i = n - 1; i > 0; i--){
+        j = borRand(&rnd, 0, i + 1);
+        if (j > i)
+            j = i;
+        BOR_SWAP(order[i], order[j], tmp);
+    }
+
+    sort = BOR_ALLOC_ARR(dt_sort_t, n);
+    to = n;
+    while (to > 0){
+        from = (to > 128 ? to / 2 : 0);
+
+        for (i = from; i < to; i++){
+            for (a = 0; a < 3; a++){
+                c[a] = (borVec3Get(&pts[order[i]], a) - aabb[2 * a]) * scale;
+            }
+            sort[i - from].key = dtMorton(c[0]) | (dtMorton(c[1]) << 1)
+                                    | (dtMorton(c[2]) << 2);
+            sort[i - from].id = order[i];
+        }
+        BOR_SORT_BY_LONG_KEY(sort, to - from, dt_sort_t, key);
+        for (i = from; i < to; i++)
+            order[i] = sort[i - from].id;
+
+        to = from;
+    }
+
+    BOR_FREE(sort);
+}
+
+static int dtInit(dt_t *dt, int *order, size_t n)
+{
+    const bor_vec3_t *pts = dt->pts;
+    bor_vec2_t a2, b2, c2;
+    int init[4], ghost[4], t, i, j, k, g, a, found, tmp;
+    size_t pi, idx[4];
+    dt_tet_t *tet;
+
+    // find four non-coplanar points
+    found = 0;
+    for (pi = 0; pi < n && found < 4; pi++){
+        i = order[pi];
+        if (found == 0){
+            init[found] = i;
+            idx[found++] = pi;
+
+        }else if (found == 1){
+            if (!borVec3Eq(&pts[i], &pts[init[0]])){
+                init[found] = i;
+                idx[found++] = pi;
+            }
+
+        }else if (found == 2){
+            // non-collinear iff some projection is not collinear
+            for (a = 0; a < 3; a++){
+                borVec2Set(&a2, borVec3Get(&pts[init[0]], a),
+                                borVec3Get(&pts[init[0]], (a + 1) % 3));
+                borVec2Set(&b2, borVec3Get(&pts[init[1]], a),
+                                borVec3Get(&pts[init[1]], (a + 1) % 3));
+                borVec2Set(&c2, borVec3Get(&pts[i], a),
+                                borVec3Get(&pts[i], (a + 1) % 3));
+                if (borPredOrient2d(&dt->pred, &a2, &b2, &c2) != BOR_ZERO){
+                    init[found] = i;
+                    idx[found++] = pi;
+                    break;
+                }
+            }
+
+        }else{
+            if (borPredOrient3d(&dt->pred, &pts[init[0]], &pts[init[1]],
+                                &pts[init[2]], &pts[i]) != BOR_ZERO){
+                init[found] = i;
+                idx[found++] = pi;
+            }
+        }
+    }
+
+    if (found < 4)
+        return -1;
+
+    for (i = 0; i < 4; i++)
+        order[idx[i]] = -1;
+
+    if (borPredOrient3d(&dt->pred, &pts[init[0]], &pts[init[1]],
+                        &pts[init[2]], &pts[init[3]]) < BOR_ZERO){
+        BOR_SWAP(init[0], init[1], tmp);
+    }
+
+    t = dtTetNew(dt);
+    for (i = 0; i < 4; i++)
+        dt->tets[t].v[i] = init[i];
+
+    // ghost tetrahedra over all faces, oriented towards infinity
+    for (i = 0; i < 4; i++){
+        g = ghost[i] = dtTetNew(dt);
+        tet = dt->tets + g;
+        tet->v[0] = init[dt_face[i][0]];
+        tet->v[1] = init[dt_face[i][2]];
+        tet->v[2] = init[dt_face[i][1]];
+        tet->v[3] = DT_INF;
+        tet->nb[3] = t;
+        dt->tets[t].nb[i] = g;
+    }
+
+    // connect ghosts with each other: face j of a ghost contains
+    // infinity and the edge formed by other two finite vertices
+    for (i = 0; i < 4; i++){
+        for (j = 0; j < 3; j++){
+            a = dt->tets[ghost[i]].v[(j + 1) % 3];
+            tmp = dt->tets[ghost[i]].v[(j + 2) % 3];
+            for (k = 0; k < 4; k++){
+                if (k == i)
+                    continue;
+                tet = dt->tets + ghost[k];
+                if ((tet->v[0] == a || tet->v[1] == a || tet->v[2] == a)
+                        && (tet->v[0] == tmp || tet->v[1] == tmp
+                                || tet->v[2] == tmp)){
+                    dt->tets[ghost[i]].nb[j] = ghost[k];
+                }
+            }
+        }
+    }
+
+    dt->last = t;
+    return 0;
+}
+
+static void dtInsert(dt_t *dt, int p)
+{
+    dt_tet_t *c, *nt, *nb;
+    int start, i, j, ci, ni, t, mark, size;
+
+    start = dtLocate(dt, p);
+    if (start < 0)
+        return;
+
+    // find cavity: all tetrahedra in conflict connected with start;
+    // .mark == mark means in cavity, mark + 1 means not in conflict
+    dt->mark += 2;
+    mark = dt->mark;
+    dt->cavity_len = dt->bound_len = 0;
+
+    dt->tets[start].mark = mark;
+    if (dt->cavity_size == 0){
+        dt->cavity_size = 64;
+        dt->cavity = BOR_ALLOC_ARR(int, dt->cavity_size);
+    }
+    dt->cavity[dt->cavity_len++] = start;
+
+    for (ci = 0; ci < dt->cavity_len; ci++){
+        for (i = 0; i < 4; i++){
+            ni = dt->tets[dt->cavity[ci]].nb[i];
+            nb = dt->tets + ni;
+            if (nb->mark == mark)
+                continue;
+
+            if (nb->mark != mark + 1 && dtConflict(dt, nb, p)){
+                nb->mark = mark;
+                if (dt->cavity_len == dt->cavity_size){
+                    dt->cavity_size *= 2;
+                    dt->cavity = BOR_REALLOC_ARR(dt->cavity, int,
+                                                 dt->cavity_size);
+                }
+                dt->cavity[dt->cavity_len++] = ni;
+
+            }else{
+                nb->mark = mark + 1;
+                if (dt->bound_len + 2 > dt->bound_size){
+                    dt->bound_size = BOR_MAX(2 * dt->bound_size, 128);
+                    dt->bound = BOR_REALLOC_ARR(dt->bound, int,
+                                                dt->bound_size);
+                }
+                dt->bound[dt->bound_len++] = dt->cavity[ci];
+                dt->bound[dt->bound_len++] = i;
+            }
+        }
+    }
+
+    // prepare hash table for edges of new tetrahedra
+    size = 16;
+    while (size < 3 * dt->bound_len)
+        size *= 2;
+    if (size > dt->hash_size){
+        dt->hash_size = size;
+        dt->hash = BOR_REALLOC_ARR(dt->hash, dt_hash_t, size);
+        for (i = 0; i < size; i++)
+            dt->hash[i].tet = -1;
+    }
+    dt->hash_mask = size - 1;
+
+    // fill cavity with new tetrahedra connecting p with boundary faces
+    t = dt->last;
+    for (j = 0; j < dt->bound_len; j += 2){
+        i = dt->bound[j + 1];
+        t = dtTetNew(dt);
+        c = dt->tets + dt->bound[j];
+        nt = dt->tets + t;
+        *nt = *c;
+        nt->v[i] = p;
+        nt->mark = 0;
+
+        nb = dt->tets + nt->nb[i];
+        for (ci = 0; ci < 4; ci++){
+            if (nb->nb[ci] == dt->bound[j])
+                nb->nb[ci] = t;
+        }
+
+        for (ci = 0; ci < 4; ci++){
+            if (ci != i)
+                dtLinkFace(dt, t, ci, i);
+        }
+
+        if (nt->v[3] != DT_INF)
+            dt->last = t;
+    }
+
+    for (ci = 0; ci < dt->cavity_len; ci++)
+        dtTetDel(dt, dt->cavity[ci]);
+
+    if (dt->tets[dt->last].v[0] == DT_FREE)
+        dt->last = t;
+
+    // clear used part of hash table
+    for (i = 0; i <= dt->hash_mask; i++)
+        dt->hash[i].tet = -1;
+}
+
+static int dtLocate(dt_t *dt, int p)
+{
+    const bor_vec3_t *pts = dt->pts;
+    const dt_tet_t *t;
+    int ti, i, k, f, next;
+
+    ti = dt->last;
+    while (1){
+        t = dt->tets + ti;
+
+        if (t->v[3] == DT_INF){
+            if (borPredOrient3d(&dt->pred, &pts[t->v[0]], &pts[t->v[1]],
+                                &pts[t->v[2]], &pts[p]) > BOR_ZERO)
+                return ti;
+            ti = t->nb[3];
+            continue;
+        }
+
+        // visibility walk, first tested face is rotated to prevent
+        // cycling
+        next = -1;
+        f = dt->walk++;
+        for (k = 0; k < 4; k++){
+            i = (f + k) & 3;
+            if (borPredOrient3d(&dt->pred, &pts[t->v[dt_face[i][0]]],
+                                &pts[t->v[dt_face[i][1]]],
+                                &pts[t->v[dt_face[i][2]]],
+                                &pts[p]) < BOR_ZERO){
+                next = t->nb[i];
+                break;
+            }
+        }
+
+        if (next < 0){
+            for (i = 0; i < 4; i++){
+                if (borVec3Eq(&pts[t->v[i]], &pts[p]))
+                    return -1;
+            }
+            return ti;
+        }
+        ti = next;
+    }
+
+    return -1;
+}
+
+static int dtConflict(dt_t *dt, const dt_tet_t *t, int p)
+{
+    const bor_vec3_t *pts = dt->pts;
+    bor_real_t o;
+
+    if (t->v[3] != DT_INF){
+        return borPredInSphere(&dt->pred, &pts[t->v[0]], &pts[t->v[1]],
+                               &pts[t->v[2]], &pts[t->v[3]],
+                               &pts[p]) > BOR_ZERO;
+    }
+
+    o = borPredOrient3d(&dt->pred, &pts[t->v[0]], &pts[t->v[1]],
+                        &pts[t->v[2]], &pts[p]);
+    if (o != BOR_ZERO)
+        return o > BOR_ZERO;
+
+    // point is coplanar with the hull face, it is in conflict if it lies
+    // inside circumcircle of the face, i.e., inside circumsphere of the
+    // finite tetrahedron on the other side of the face
+    return dtConflict(dt, dt->tets + t->nb[3], p);
+}
+
+static int dtTetNew(dt_t *dt)
+{
+    int t;
+
+    if (dt->free >= 0){
+        t = dt->free;
+        dt->free = dt->tets[t].nb[0];
+    }else{
+        if (dt->tets_len == dt->tets_size){
+            dt->tets_size = BOR_MAX(2 * dt->tets_size, 64);
+            dt->tets = BOR_REALLOC_ARR(dt->tets, dt_tet_t, dt->tets_size);
+        }
+        t = dt->tets_len++;
+    }
+
+    dt->tets[t].mark = 0;
+    return t;
+}
+
+static void dtTetDel(dt_t *dt, int t)
+{
+    dt->tets[t].v[0] = DT_FREE;
+    dt->tets[t].nb[0] = dt->free;
+    dt->tets[t].mark = 0;
+    dt->free = t;
+}
+
+static void dtLinkFace(dt_t *dt, int t, int face, int pi)
+{
+    dt_tet_t *tet = dt->tets + t;
+    dt_hash_t *h;
+    int e[2], i, j, tmp;
+    unsigned int key;
+
+    // the face contains the new point (at position pi) and the edge
+    // formed by the other two vertices
+    for (i = 0, j = 0; i < 4; i++){
+        if (i != face && i != pi)
+            e[j++] = tet->v[i];
+    }
+    if (e[0] > e[1])
+        BOR_SWAP(e[0], e[1], tmp);
+
+    key = ((unsigned int)e[0] * 2654435761u) ^ ((unsigned int)e[1] * 40503u);
+    key &= dt->hash_mask;
+    while (1){
+        h = dt->hash + key;
+        if (h->tet < 0){
+            h->a = e[0];
+            h->b = e[1];
+            h->tet = t;
+            h->face = face;
+            return;
+        }
+
+        if (h->a == e[0] && h->b == e[1] && h->tet >= 0){
+            tet->nb[face] = h->tet;
+            dt->tets[h->tet].nb[h->face] = t;
+            // mark as matched, table is cleared after insertion
+            h->a = h->b = DT_FREE;
+            return;
+        }
+
+        key = (key + 1) & dt->hash_mask;
+    }
+}
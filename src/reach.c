@@ -0,0 +1,409 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <boruvka/alloc.h>
+#include <boruvka/tasks.h>
+#include <boruvka/scc.h>
+#include <boruvka/reach.h>
+
+/** Minimal number of components of one level closed in parallel */
+#define PAR_MIN 32
+
+/**
+ * Condensation of the graph: successors of component c are
+ * adj[start[c]], ..., adj[start[c + 1] - 1] sorted in decreasing order.
+ */
+struct _cond_t {
+    int *start;
+    int *adj;
+};
+typedef struct _cond_t cond_t;
+
+struct _close_t {
+    bor_reach_t *r;
+    const cond_t *cond;
+    const int *comp;    /*!< Components of the current level */
+    int comp_len;
+    int num_threads;
+};
+typedef struct _close_t close_t;
+
+/** Callbacks for bor_scc_t over the frozen graph */
+static long sccIt(int node_id, void *ud);
+static int sccNext(int node_id, long *it, void *ud);
+/** Fills r->comp and r->comp_size */
+static void condense(bor_reach_t *r, const bor_digraph_frozen_t *g,
+                     int num_threads, cond_t *cond);
+/** Closes component c, i.e., sets its row in the bitset */
+static void closeComp(bor_reach_t *r, const cond_t *cond, int c);
+static void closeTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Computes the closure as bitsets */
+static void buildBits(bor_reach_t *r, const cond_t *cond, int num_threads);
+/** Computes the closure as lists of intervals */
+static void buildIntervals(bor_reach_t *r, const cond_t *cond);
+
+void borReachInit(bor_reach_t *r, const bor_digraph_t *g,
+                  unsigned flags, int num_threads)
+{
+    bor_digraph_frozen_t fg;
+
+    borDigraphFreeze(&fg, g);
+    borReachInitFrozen(r, &fg, flags, num_threads);
+    borDigraphFrozenFree(&fg);
+}
+
+void borReachInitFrozen(bor_reach_t *r, const bor_digraph_frozen_t *g,
+                        unsigned flags, int num_threads)
+{
+    cond_t cond;
+
+    bzero(r, sizeof(*r));
+    if (num_threads < 1)
+        num_threads = 1;
+
+    condense(r, g, num_threads, &cond);
+    if (flags & BOR_REACH_INTERVAL){
+        buildIntervals(r, &cond);
+    }else{
+        buildBits(r, &cond, num_threads);
+    }
+
+    BOR_FREE(cond.start);
+    BOR_FREE(cond.adj);
+}
+
+void borReachFree(bor_reach_t *r)
+{
+    if (r->comp)
+        BOR_FREE(r->comp);
+    if (r->bits)
+        BOR_FREE(r->bits);
+    if (r->row)
+        BOR_FREE(r->row);
+    if (r->post)
+        BOR_FREE(r->post);
+    if (r->ival_start)
+        BOR_FREE(r->ival_start);
+    if (r->ival)
+        BOR_FREE(r->ival);
+}
+
+int borReachCompInterval(const bor_reach_t *r, int from_comp, int to_comp)
+{
+    int p = r->post[from_comp];
+    int x = r->post[to_comp];
+    int lo = r->ival_start[p];
+    int hi = r->ival_start[p + 1];
+    int mid;
+
+    /* find the last interval with the lower bound <= x */
+    while (hi - lo > 1){
+        mid = (lo + hi) / 2;
+        if (r->ival[2 * mid] <= x){
+            lo = mid;
+        }else{
+            hi = mid;
+        }
+    }
+    return r->ival[2 * lo] <= x && x <= r->ival[2 * lo + 1];
+}
+
+
+static long sccIt(int node_id, void *ud)
+{
+    const bor_digraph_frozen_t *g = ud;
+    return g->out_start[node_id];
+}
+
+static int sccNext(int node_id, long *it, void *ud)
+{
+    const bor_digraph_frozen_t *g = ud;
+    if (*it < g->out_start[node_id + 1])
+        return g->out_node[(*it)++];
+    return -1;
+}
+
+static int cmpDesc(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x < y) - (x > y);
+}
+
+static void condense(bor_reach_t *r, const bor_digraph_frozen_t *g,
+                     int num_threads, cond_t *cond)
+{
+    bor_scc_t scc;
+    const bor_scc_comp_t *comp;
+    int *mark, c, i, j, u, d, len;
+
+    r->node_size = g->node_size;
+    borSCCInitFlags(&scc, g->node_size, sccIt, sccNext, (void *)g,
+                    (num_threads > 1 ? BOR_SCC_PARALLEL : 0u), num_threads);
+    borSCC(&scc);
+
+    r->comp_size = scc.comp_size;
+    r->comp = BOR_ALLOC_ARR(int, BOR_MAX(g->node_size, 1));
+    for (c = 0; c < scc.comp_size; ++c){
+        for (i = 0; i < scc.comp[c].node_size; ++i)
+            r->comp[scc.comp[c].node[i]] = c;
+    }
+
+    cond->start = BOR_ALLOC_ARR(int, r->comp_size + 1);
+    cond->adj = BOR_ALLOC_ARR(int, BOR_MAX(g->edge_size, 1));
+    mark = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    for (c = 0; c < r->comp_size; ++c)
+        mark[c] = -1;
+
+    len = 0;
+    for (c = 0; c < r->comp_size; ++c){
+        cond->start[c] = len;
+        comp = scc.comp + c;
+        for (i = 0; i < comp->node_size; ++i){
+            u = comp->node[i];
+            for (j = g->out_start[u]; j < g->out_start[u + 1]; ++j){
+                d = r->comp[g->out_node[j]];
+                if (d != c && mark[d] != c){
+                    /* components are in reverse topological order */
+                    mark[d] = c;
+                    cond->adj[len++] = d;
+                }
+            }
+        }
+        qsort(cond->adj + cond->start[c], len - cond->start[c],
+              sizeof(int), cmpDesc);
+    }
+    cond->start[r->comp_size] = len;
+
+    BOR_FREE(mark);
+    borSCCFree(&scc);
+}
+
+static void closeComp(bor_reach_t *r, const cond_t *cond, int c)
+{
+    uint64_t *dst = r->bits + r->row[c];
+    const uint64_t *src;
+    int i, d, w, len;
+
+    dst[c >> 6] |= (uint64_t)1 << (c & 63);
+    /* Successors are visited from the highest ID, which are the most
+     * likely to reach the others. A successor whose bit is already set
+     * is skipped because its row is a subset of the current row. */
+    for (i = cond->start[c]; i < cond->start[c + 1]; ++i){
+        d = cond->adj[i];
+        if ((dst[d >> 6] >> (d & 63)) & 1u)
+            continue;
+
+        src = r->bits + r->row[d];
+        len = (d >> 6) + 1;
+        for (w = 0; w < len; ++w)
+            dst[w] |= src[w];
+    }
+}
+
+static void closeTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    close_t *cl = data;
+    int from = (long)cl->comp_len * id / cl->num_threads;
+    int to = (long)cl->comp_len * (id + 1) / cl->num_threads;
+    int i;
+
+    for (i = from; i < to; ++i)
+        closeComp(cl->r, cl->cond, cl->comp[i]);
+}
+
+static void buildBits(bor_reach_t *r, const cond_t *cond, int num_threads)
+{
+    bor_tasks_t *tasks = NULL;
+    close_t cl;
+    int *level, *level_start, *order, level_size;
+    int c, i, l;
+
+    /* c-th row has bits of components 0, ..., c */
+    r->row = BOR_ALLOC_ARR(long, r->comp_size + 1);
+    r->row[0] = 0;
+    for (c = 0; c < r->comp_size; ++c)
+        r->row[c + 1] = r->row[c] + (c >> 6) + 1;
+    r->bits = BOR_CALLOC_ARR(uint64_t, BOR_MAX(r->row[r->comp_size], 1));
+
+    /* Level of a component is the length of the longest path to a sink.
+     * All successors of a component lie in lower levels, so components
+     * of one level can be closed independently. */
+    level = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    level_size = 0;
+    for (c = 0; c < r->comp_size; ++c){
+        level[c] = 0;
+        for (i = cond->start[c]; i < cond->start[c + 1]; ++i)
+            level[c] = BOR_MAX(level[c], level[cond->adj[i]] + 1);
+        level_size = BOR_MAX(level_size, level[c] + 1);
+    }
+
+    level_start = BOR_CALLOC_ARR(int, level_size + 2);
+    for (c = 0; c < r->comp_size; ++c)
+        ++level_start[level[c] + 2];
+    for (l = 2; l < level_size + 2; ++l)
+        level_start[l] += level_start[l - 1];
+    order = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    for (c = 0; c < r->comp_size; ++c)
+        order[level_start[level[c] + 1]++] = c;
+
+    if (num_threads > 1){
+        tasks = borTasksNew(num_threads);
+        borTasksRun(tasks);
+    }
+
+    cl.r = r;
+    cl.cond = cond;
+    cl.num_threads = num_threads;
+    for (l = 0; l < level_size; ++l){
+        cl.comp = order + level_start[l];
+        cl.comp_len = level_start[l + 1] - level_start[l];
+        if (tasks && cl.comp_len >= PAR_MIN){
+            for (i = 0; i < num_threads; ++i)
+                borTasksAdd(tasks, closeTask, i, &cl);
+            borTasksBarrier(tasks);
+        }else{
+            for (i = 0; i < cl.comp_len; ++i)
+                closeComp(r, cond, cl.comp[i]);
+        }
+    }
+
+    if (tasks)
+        borTasksDel(tasks);
+
+    BOR_FREE(level);
+    BOR_FREE(level_start);
+    BOR_FREE(order);
+}
+
+static int cmpInterval(const void *a, const void *b)
+{
+    const int *x = a;
+    const int *y = b;
+    return (x[0] > y[0]) - (x[0] < y[0]);
+}
+
+static void buildIntervals(bor_reach_t *r, const cond_t *cond)
+{
+    int *stack, *stack_it, stack_len;
+    int *low, *by_post, *buf, buf_len, buf_alloc;
+    int ival_len, ival_alloc;
+    int c, d, i, j, p, root, counter;
+
+    r->post = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    low = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    by_post = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    for (c = 0; c < r->comp_size; ++c)
+        r->post[c] = -1;
+
+    /* Post-order numbering of the DFS forest. The descendants of c in
+     * the forest are numbered low[c], ..., post[c]. Sources have the
+     * highest IDs, so roots are taken from the top. */
+    stack = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    stack_it = BOR_ALLOC_ARR(int, BOR_MAX(r->comp_size, 1));
+    counter = 0;
+    for (root = r->comp_size - 1; root >= 0; --root){
+        if (r->post[root] >= 0)
+            continue;
+
+        r->post[root] = -2;
+        low[root] = counter;
+        stack[0] = root;
+        stack_it[0] = cond->start[root];
+        stack_len = 1;
+        while (stack_len > 0){
+            c = stack[stack_len - 1];
+            if (stack_it[stack_len - 1] < cond->start[c + 1]){
+                d = cond->adj[stack_it[stack_len - 1]++];
+                if (r->post[d] == -1){
+                    r->post[d] = -2;
+                    low[d] = counter;
+                    stack[stack_len] = d;
+                    stack_it[stack_len] = cond->start[d];
+                    ++stack_len;
+                }
+            }else{
+                by_post[counter] = c;
+                r->post[c] = counter++;
+                --stack_len;
+            }
+        }
+    }
+    BOR_FREE(stack);
+    BOR_FREE(stack_it);
+
+    /* All successors have lower post-order numbers, so their lists are
+     * complete when the component is reached. */
+    r->ival_start = BOR_ALLOC_ARR(int, r->comp_size + 1);
+    ival_alloc = 2 * BOR_MAX(r->comp_size, 1);
+    r->ival = BOR_ALLOC_ARR(int, 2 * ival_alloc);
+    ival_len = 0;
+    buf_alloc = 16;
+    buf = BOR_ALLOC_ARR(int, 2 * buf_alloc);
+    for (p = 0; p < r->comp_size; ++p){
+        c = by_post[p];
+        r->ival_start[p] = ival_len;
+
+        buf[0] = low[c];
+        buf[1] = p;
+        buf_len = 1;
+        for (i = cond->start[c]; i < cond->start[c + 1]; ++i){
+            d = r->post[cond->adj[i]];
+            /* tree descendants with no other edges are already covered */
+            if (d >= low[c]
+                    && r->ival_start[d + 1] - r->ival_start[d] == 1
+                    && r->ival[2 * r->ival_start[d]] >= low[c]){
+                continue;
+            }
+
+            for (j = r->ival_start[d]; j < r->ival_start[d + 1]; ++j){
+                if (buf_len == buf_alloc){
+                    buf_alloc *= 2;
+                    buf = BOR_REALLOC_ARR(buf, int, 2 * buf_alloc);
+                }
+                buf[2 * buf_len] = r->ival[2 * j];
+                buf[2 * buf_len + 1] = r->ival[2 * j + 1];
+                ++buf_len;
+            }
+        }
+        if (buf_len > 1)
+            qsort(buf, buf_len, 2 * sizeof(int), cmpInterval);
+
+        /* merge overlapping and adjacent intervals */
+        for (i = 0; i < buf_len; ++i){
+            if (ival_len > r->ival_start[p]
+                    && buf[2 * i] <= r->ival[2 * ival_len - 1] + 1){
+                r->ival[2 * ival_len - 1] = BOR_MAX(r->ival[2 * ival_len - 1],
+                                                    buf[2 * i + 1]);
+                continue;
+            }
+
+            if (ival_len == ival_alloc){
+                ival_alloc *= 2;
+                r->ival = BOR_REALLOC_ARR(r->ival, int, 2 * ival_alloc);
+            }
+            r->ival[2 * ival_len] = buf[2 * i];
+            r->ival[2 * ival_len + 1] = buf[2 * i + 1];
+            ++ival_len;
+        }
+    }
+    r->ival_start[r->comp_size] = ival_len;
+    r->ival = BOR_REALLOC_ARR(r->ival, int, 2 * BOR_MAX(ival_len, 1));
+
+    BOR_FREE(buf);
+    BOR_FREE(low);
+    BOR_FREE(by_post);
+}
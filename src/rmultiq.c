@@ -0,0 +1,250 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include "boruvka/alloc.h"
+#include "boruvka/rmultiq.h"
+
+#define HEAP_INIT_SIZE 64
+
+/** Returns random index of a heap */
+_bor_inline int randHeap(bor_rmultiq_t *q, bor_rmultiq_thread_t *th);
+/** Inserts element into the locked heap */
+static void heapPush(bor_rmultiq_heap_t *h, const bor_rmultiq_el_t *el);
+/** Removes minimum from the locked non-empty heap */
+static void heapPop(bor_rmultiq_heap_t *h, bor_rmultiq_el_t *el);
+/** Returns the better of two heaps or NULL if both are empty */
+_bor_inline bor_rmultiq_heap_t *better(bor_rmultiq_heap_t *h1,
+                                      bor_rmultiq_heap_t *h2);
+/** Returns the non-empty heap with the lowest minimum or NULL */
+static bor_rmultiq_heap_t *bestHeap(bor_rmultiq_t *q);
+
+bor_rmultiq_t *borRMultiQNew(int num_threads, int c)
+{
+    bor_rmultiq_t *q;
+    int i;
+
+    q = BOR_ALLOC(bor_rmultiq_t);
+    q->num_threads = BOR_MAX(num_threads, 1);
+    q->heap_len = q->num_threads * BOR_MAX(c, 1);
+    q->heap = BOR_ALLOC_ALIGN_ARR(bor_rmultiq_heap_t, q->heap_len, 64);
+    for (i = 0; i < q->heap_len; ++i){
+        pthread_mutex_init(&q->heap[i].lock, NULL);
+        q->heap[i].alloc = HEAP_INIT_SIZE;
+        q->heap[i].el = BOR_ALLOC_ARR(bor_rmultiq_el_t, HEAP_INIT_SIZE);
+        q->heap[i].size = 0;
+        q->heap[i].min = 0;
+    }
+
+    q->thread = BOR_ALLOC_ALIGN_ARR(bor_rmultiq_thread_t, q->num_threads, 64);
+    for (i = 0; i < q->num_threads; ++i){
+        q->thread[i].buf_len = 0;
+        q->thread[i].rnd = 2463534242u ^ (0x9e3779b9u * (uint32_t)(i + 1));
+        if (q->thread[i].rnd == 0)
+            q->thread[i].rnd = 1;
+    }
+
+    return q;
+}
+
+void borRMultiQDel(bor_rmultiq_t *q)
+{
+    int i;
+
+    for (i = 0; i < q->heap_len; ++i){
+        pthread_mutex_destroy(&q->heap[i].lock);
+        BOR_FREE(q->heap[i].el);
+    }
+    BOR_FREE(q->heap);
+    BOR_FREE(q->thread);
+    BOR_FREE(q);
+}
+
+void borRMultiQPush(bor_rmultiq_t *q, int tid, bor_real_t key, void *data)
+{
+    bor_rmultiq_thread_t *th = q->thread + tid;
+
+    th->buf[th->buf_len].key = key;
+    th->buf[th->buf_len].data = data;
+    if (++th->buf_len == BOR_RMULTIQ_BUF_SIZE)
+        borRMultiQFlush(q, tid);
+}
+
+int borRMultiQPop(bor_rmultiq_t *q, int tid, bor_real_t *key, void **data)
+{
+    bor_rmultiq_thread_t *th = q->thread + tid;
+    bor_rmultiq_heap_t *h;
+    bor_rmultiq_el_t el;
+    int i, bi, try;
+
+    bi = -1;
+    for (i = 0; i < th->buf_len; ++i){
+        if (bi < 0 || th->buf[i].key < th->buf[bi].key)
+            bi = i;
+    }
+
+    for (try = 0;; ++try){
+        if (try < BOR_RMULTIQ_POP_TRIES){
+            h = better(q->heap + randHeap(q, th), q->heap + randHeap(q, th));
+            if (h == NULL)
+                continue;
+        }else{
+            h = bestHeap(q);
+            if (h == NULL)
+                break;
+        }
+
+        if (bi >= 0 && th->buf[bi].key <= h->min)
+            break;
+
+        if (pthread_mutex_trylock(&h->lock) != 0)
+            continue;
+        if (h->size == 0){
+            pthread_mutex_unlock(&h->lock);
+            continue;
+        }
+        heapPop(h, &el);
+        pthread_mutex_unlock(&h->lock);
+
+        if (key)
+            *key = el.key;
+        if (data)
+            *data = el.data;
+        return 0;
+    }
+
+    if (bi < 0)
+        return -1;
+
+    if (key)
+        *key = th->buf[bi].key;
+    if (data)
+        *data = th->buf[bi].data;
+    th->buf[bi] = th->buf[--th->buf_len];
+    return 0;
+}
+
+void borRMultiQFlush(bor_rmultiq_t *q, int tid)
+{
+    bor_rmultiq_thread_t *th = q->thread + tid;
+    bor_rmultiq_heap_t *h;
+    int i;
+
+    if (th->buf_len == 0)
+        return;
+
+    do {
+        h = q->heap + randHeap(q, th);
+    } while (pthread_mutex_trylock(&h->lock) != 0);
+
+    for (i = 0; i < th->buf_len; ++i)
+        heapPush(h, th->buf + i);
+    pthread_mutex_unlock(&h->lock);
+    th->buf_len = 0;
+}
+
+int borRMultiQSize(const bor_rmultiq_t *q)
+{
+    int i, size = 0;
+
+    for (i = 0; i < q->heap_len; ++i)
+        size += q->heap[i].size;
+    return size;
+}
+
+_bor_inline int randHeap(bor_rmultiq_t *q, bor_rmultiq_thread_t *th)
+{
+    uint32_t x = th->rnd;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    th->rnd = x;
+    return ((uint64_t)x * (uint64_t)q->heap_len) >> 32;
+}
+
+static void heapPush(bor_rmultiq_heap_t *h, const bor_rmultiq_el_t *el)
+{
+    bor_rmultiq_el_t *arr;
+    int i, parent;
+
+    if (h->size == h->alloc){
+        h->alloc *= 2;
+        h->el = BOR_REALLOC_ARR(h->el, bor_rmultiq_el_t, h->alloc);
+    }
+
+    arr = h->el;
+    i = h->size;
+    while (i > 0){
+        parent = (i - 1) >> 1;
+        if (arr[parent].key <= el->key)
+            break;
+        arr[i] = arr[parent];
+        i = parent;
+    }
+    arr[i] = *el;
+    h->min = arr[0].key;
+    ++h->size;
+}
+
+static void heapPop(bor_rmultiq_heap_t *h, bor_rmultiq_el_t *el)
+{
+    bor_rmultiq_el_t *arr = h->el;
+    bor_rmultiq_el_t last;
+    int i, child, size;
+
+    *el = arr[0];
+    size = h->size - 1;
+    last = arr[size];
+
+    i = 0;
+    while ((child = 2 * i + 1) < size){
+        if (child + 1 < size && arr[child + 1].key < arr[child].key)
+            ++child;
+        if (last.key <= arr[child].key)
+            break;
+        arr[i] = arr[child];
+        i = child;
+    }
+    arr[i] = last;
+
+    if (size > 0)
+        h->min = arr[0].key;
+    h->size = size;
+}
+
+_bor_inline bor_rmultiq_heap_t *better(bor_rmultiq_heap_t *h1,
+                                      bor_rmultiq_heap_t *h2)
+{
+    if (h1->size == 0)
+        return (h2->size == 0 ? NULL : h2);
+    if (h2->size == 0)
+        return h1;
+    return (h2->min < h1->min ? h2 : h1);
+}
+
+static bor_rmultiq_heap_t *bestHeap(bor_rmultiq_t *q)
+{
+    bor_rmultiq_heap_t *best = NULL;
+    int i;
+
+    for (i = 0; i < q->heap_len; ++i){
+        if (q->heap[i].size > 0
+                && (best == NULL || q->heap[i].min < best->min)){
+            best = q->heap + i;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,513 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <limits.h>
+#include <boruvka/alloc.h>
+#include <boruvka/scc.h>
+#include <boruvka/scc-inc.h>
+
+/**
+ * Weight of the last insertion in the running average of costs of
+ * insertions.
+ */
+#define COST_WEIGHT 0.25
+
+/** Resizes per-node arrays to hold at least {size} nodes */
+static void nodeRealloc(bor_scc_inc_t *inc, int size);
+/** Appends a position for the component {root} */
+static void posAdd(bor_scc_inc_t *inc, int root);
+/** Removes holes from .pos */
+static void posCompact(bor_scc_inc_t *inc);
+/** Returns the root of the component of {node} */
+static int find(bor_scc_inc_t *inc, int node);
+/** Merges components given by their roots, returns the new root */
+static int merge(bor_scc_inc_t *inc, const int *root, int len);
+/** Inserts the edge between roots, the edge is already in the lists */
+static int insert(bor_scc_inc_t *inc, int x, int y);
+/** Searches from {root} over {list} and collects components with
+ *  positions in [lb, ub] into {found} */
+static void search(bor_scc_inc_t *inc, int root, bor_iarr_t *list,
+                   int *mark, int lb, int ub, bor_iarr_t *found,
+                   long *scanned);
+/** Rewrites the list of {root} to roots of other components */
+static void compactList(bor_scc_inc_t *inc, int root, bor_iarr_t *l);
+/** Recomputes all components and the order from scratch */
+static void recompute(bor_scc_inc_t *inc);
+static void nextStamp(bor_scc_inc_t *inc);
+
+void borSCCIncInit(bor_scc_inc_t *inc, int node_size)
+{
+    int i;
+
+    bzero(inc, sizeof(*inc));
+    nodeRealloc(inc, BOR_MAX(node_size, 4));
+    for (i = 0; i < node_size; ++i)
+        borSCCIncAddNode(inc);
+}
+
+void borSCCIncInitDigraph(bor_scc_inc_t *inc, const bor_digraph_t *g)
+{
+    int i, from, to;
+
+    borSCCIncInit(inc, g->node_size);
+    for (i = 0; i < g->edge_size; ++i){
+        from = g->edge[i].from;
+        to = g->edge[i].to;
+        borIArrAdd(inc->out + from, to);
+        borIArrAdd(inc->in + to, from);
+    }
+    inc->edge_size = g->edge_size;
+    if (g->edge_size > 0)
+        recompute(inc);
+}
+
+void borSCCIncFree(bor_scc_inc_t *inc)
+{
+    int i;
+
+    for (i = 0; i < inc->node_size; ++i){
+        borIArrFree(inc->out + i);
+        borIArrFree(inc->in + i);
+    }
+    BOR_FREE(inc->out);
+    BOR_FREE(inc->in);
+    BOR_FREE(inc->parent);
+    BOR_FREE(inc->size);
+    BOR_FREE(inc->member);
+    BOR_FREE(inc->ord);
+    BOR_FREE(inc->pos);
+    BOR_FREE(inc->mark_fw);
+    BOR_FREE(inc->mark_bw);
+    borIArrFree(&inc->fw);
+    borIArrFree(&inc->bw);
+    borIArrFree(&inc->stack);
+    borIArrFree(&inc->slot);
+    borIArrFree(&inc->back);
+}
+
+int borSCCIncAddNode(bor_scc_inc_t *inc)
+{
+    int node = inc->node_size;
+
+    if (node == inc->node_alloc)
+        nodeRealloc(inc, 2 * inc->node_alloc);
+    ++inc->node_size;
+    ++inc->comp_size;
+
+    inc->parent[node] = node;
+    inc->size[node] = 1;
+    inc->member[node] = node;
+    borIArrInit(inc->out + node);
+    borIArrInit(inc->in + node);
+    inc->mark_fw[node] = inc->mark_bw[node] = 0;
+    posAdd(inc, node);
+    return node;
+}
+
+int borSCCIncAddEdge(bor_scc_inc_t *inc, int from, int to)
+{
+    int x, y;
+
+    borIArrAdd(inc->out + (x = find(inc, from)), to);
+    borIArrAdd(inc->in + (y = find(inc, to)), from);
+    ++inc->edge_size;
+    if (x == y || inc->ord[x] < inc->ord[y])
+        return 0;
+    return insert(inc, x, y);
+}
+
+int borSCCIncAddEdges(bor_scc_inc_t *inc, const int *from, const int *to,
+                      int len)
+{
+    bor_iarr_t *back = &inc->back;
+    int comp_size = inc->comp_size;
+    int merged, i, x, y;
+
+    /* edges agreeing with the order are inserted right away, the rest is
+     * postponed so that the lists respect the order during searches */
+    borIArrEmpty(back);
+    for (i = 0; i < len; ++i){
+        x = find(inc, from[i]);
+        y = find(inc, to[i]);
+        if (x == y || inc->ord[x] < inc->ord[y]){
+            borIArrAdd(inc->out + x, to[i]);
+            borIArrAdd(inc->in + y, from[i]);
+            ++inc->edge_size;
+        }else{
+            borIArrAdd(back, i);
+        }
+    }
+
+    /* recomputation is linear in the size of the graph */
+    if (back->size * inc->insert_cost > inc->node_size + inc->edge_size){
+        for (i = 0; i < back->size; ++i){
+            x = back->arr[i];
+            borIArrAdd(inc->out + find(inc, from[x]), to[x]);
+            borIArrAdd(inc->in + find(inc, to[x]), from[x]);
+            ++inc->edge_size;
+        }
+        recompute(inc);
+        return comp_size - inc->comp_size;
+    }
+
+    merged = 0;
+    for (i = 0; i < back->size; ++i)
+        merged += borSCCIncAddEdge(inc, from[back->arr[i]], to[back->arr[i]]);
+    return merged;
+}
+
+int borSCCIncComp(bor_scc_inc_t *inc, int node)
+{
+    return find(inc, node);
+}
+
+int borSCCIncCompSize(bor_scc_inc_t *inc, int node)
+{
+    return inc->size[find(inc, node)];
+}
+
+static int intCmp(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+int borSCCIncCompNodes(bor_scc_inc_t *inc, int node, int *nodes)
+{
+    int root = find(inc, node);
+    int n, len;
+
+    len = 0;
+    n = root;
+    do {
+        nodes[len++] = n;
+        n = inc->member[n];
+    } while (n != root);
+    qsort(nodes, len, sizeof(int), intCmp);
+    return len;
+}
+
+void borSCCIncTopo(const bor_scc_inc_t *inc, int *comp)
+{
+    int i, len;
+
+    len = 0;
+    for (i = 0; i < inc->pos_size; ++i){
+        if (inc->pos[i] >= 0)
+            comp[len++] = inc->pos[i];
+    }
+}
+
+
+static void nodeRealloc(bor_scc_inc_t *inc, int size)
+{
+    inc->node_alloc = size;
+    inc->parent = BOR_REALLOC_ARR(inc->parent, int, size);
+    inc->size = BOR_REALLOC_ARR(inc->size, int, size);
+    inc->member = BOR_REALLOC_ARR(inc->member, int, size);
+    inc->ord = BOR_REALLOC_ARR(inc->ord, int, size);
+    inc->out = BOR_REALLOC_ARR(inc->out, bor_iarr_t, size);
+    inc->in = BOR_REALLOC_ARR(inc->in, bor_iarr_t, size);
+    inc->mark_fw = BOR_REALLOC_ARR(inc->mark_fw, int, size);
+    inc->mark_bw = BOR_REALLOC_ARR(inc->mark_bw, int, size);
+}
+
+static void posAdd(bor_scc_inc_t *inc, int root)
+{
+    if (inc->pos_size == inc->pos_alloc){
+        if (2 * inc->comp_size <= inc->pos_size){
+            posCompact(inc);
+        }else{
+            inc->pos_alloc = BOR_MAX(2 * inc->pos_alloc, 4);
+            inc->pos = BOR_REALLOC_ARR(inc->pos, int, inc->pos_alloc);
+        }
+    }
+    inc->ord[root] = inc->pos_size;
+    inc->pos[inc->pos_size++] = root;
+}
+
+static void posCompact(bor_scc_inc_t *inc)
+{
+    int i, len;
+
+    len = 0;
+    for (i = 0; i < inc->pos_size; ++i){
+        if (inc->pos[i] >= 0){
+            inc->ord[inc->pos[i]] = len;
+            inc->pos[len++] = inc->pos[i];
+        }
+    }
+    inc->pos_size = len;
+}
+
+static int find(bor_scc_inc_t *inc, int node)
+{
+    int *parent = inc->parent;
+
+    /* path halving */
+    while (parent[node] != node){
+        parent[node] = parent[parent[node]];
+        node = parent[node];
+    }
+    return node;
+}
+
+static void appendList(bor_iarr_t *dst, bor_iarr_t *src)
+{
+    bor_iarr_t tmp;
+
+    if (src->size > dst->size){
+        tmp = *dst;
+        *dst = *src;
+        *src = tmp;
+    }
+    borIArrAppendArr(dst, src);
+    borIArrFree(src);
+    borIArrInit(src);
+}
+
+static int merge(bor_scc_inc_t *inc, const int *root, int len)
+{
+    int r, o, i, tmp;
+
+    r = root[0];
+    for (i = 1; i < len; ++i){
+        if (inc->size[root[i]] > inc->size[r])
+            r = root[i];
+    }
+
+    for (i = 0; i < len; ++i){
+        o = root[i];
+        if (o == r)
+            continue;
+
+        inc->parent[o] = r;
+        inc->size[r] += inc->size[o];
+        /* splice circular lists of members */
+        BOR_SWAP(inc->member[r], inc->member[o], tmp);
+        appendList(inc->out + r, inc->out + o);
+        appendList(inc->in + r, inc->in + o);
+    }
+    inc->comp_size -= len - 1;
+    return r;
+}
+
+static void nextStamp(bor_scc_inc_t *inc)
+{
+    int i;
+
+    if (inc->stamp == INT_MAX){
+        for (i = 0; i < inc->node_size; ++i)
+            inc->mark_fw[i] = inc->mark_bw[i] = 0;
+        inc->stamp = 0;
+    }
+    ++inc->stamp;
+}
+
+static void compactList(bor_scc_inc_t *inc, int root, bor_iarr_t *l)
+{
+    int i, d, len;
+
+    len = 0;
+    for (i = 0; i < l->size; ++i){
+        d = find(inc, l->arr[i]);
+        if (d != root)
+            l->arr[len++] = d;
+    }
+    l->size = len;
+}
+
+static void search(bor_scc_inc_t *inc, int root, bor_iarr_t *list,
+                   int *mark, int lb, int ub, bor_iarr_t *found,
+                   long *scanned)
+{
+    bor_iarr_t *stack = &inc->stack;
+    bor_iarr_t *l;
+    int base = stack->size;
+    int c, d, i;
+
+    borIArrEmpty(found);
+    mark[root] = inc->stamp;
+    borIArrAdd(found, root);
+    borIArrAdd(stack, root);
+    while (stack->size > base){
+        c = borIArrPopLast(stack);
+        l = list + c;
+
+        /* the list is rewritten to roots and edges inside the
+         * component are dropped on the way */
+        compactList(inc, c, l);
+        *scanned += l->size + 1;
+        for (i = 0; i < l->size; ++i){
+            d = l->arr[i];
+            if (mark[d] != inc->stamp && inc->ord[d] >= lb
+                    && inc->ord[d] <= ub){
+                mark[d] = inc->stamp;
+                borIArrAdd(found, d);
+                borIArrAdd(stack, d);
+            }
+        }
+    }
+}
+
+static int insert(bor_scc_inc_t *inc, int x, int y)
+{
+    bor_iarr_t *fw = &inc->fw;
+    bor_iarr_t *bw = &inc->bw;
+    bor_iarr_t *slot = &inc->slot;
+    int lb = inc->ord[y];
+    int ub = inc->ord[x];
+    long scanned = 0;
+    int cycle, merged, r, i, j, k, c;
+
+    nextStamp(inc);
+    search(inc, y, inc->out, inc->mark_fw, lb, ub, fw, &scanned);
+    search(inc, x, inc->in, inc->mark_bw, lb, ub, bw, &scanned);
+    cycle = (inc->mark_fw[x] == inc->stamp);
+
+    /* positions of all affected components in increasing order */
+    borIArrEmpty(slot);
+    for (i = 0; i < bw->size; ++i)
+        borIArrAdd(slot, inc->ord[bw->arr[i]]);
+    for (i = 0; i < fw->size; ++i){
+        if (inc->mark_bw[fw->arr[i]] != inc->stamp)
+            borIArrAdd(slot, inc->ord[fw->arr[i]]);
+    }
+    qsort(slot->arr, slot->size, sizeof(int), intCmp);
+
+    /* Components found by both searches lie on a cycle with the new edge
+     * and are merged. The new order is: components reaching x, the
+     * merged component, components reachable from y. Each group keeps
+     * its original relative order. */
+    for (i = 0; i < bw->size; ++i)
+        bw->arr[i] = inc->ord[bw->arr[i]];
+    qsort(bw->arr, bw->size, sizeof(int), intCmp);
+    for (i = 0; i < fw->size; ++i)
+        fw->arr[i] = inc->ord[fw->arr[i]];
+    qsort(fw->arr, fw->size, sizeof(int), intCmp);
+    for (i = 0; i < bw->size; ++i)
+        bw->arr[i] = inc->pos[bw->arr[i]];
+    for (i = 0; i < fw->size; ++i)
+        fw->arr[i] = inc->pos[fw->arr[i]];
+
+    merged = 0;
+    k = 0;
+    for (i = 0; i < bw->size; ++i){
+        c = bw->arr[i];
+        if (cycle && inc->mark_fw[c] == inc->stamp)
+            continue;
+        inc->ord[c] = slot->arr[k];
+        inc->pos[slot->arr[k++]] = c;
+    }
+
+    if (cycle){
+        /* .bw is reused for the members of the cycle */
+        borIArrEmpty(bw);
+        for (i = 0, j = 0; i < fw->size; ++i){
+            c = fw->arr[i];
+            if (inc->mark_bw[c] == inc->stamp){
+                borIArrAdd(bw, c);
+            }else{
+                fw->arr[j++] = fw->arr[i];
+            }
+        }
+        fw->size = j;
+
+        r = merge(inc, bw->arr, bw->size);
+        merged = bw->size - 1;
+        inc->ord[r] = slot->arr[k];
+        inc->pos[slot->arr[k++]] = r;
+    }
+
+    /* components reachable from y take the last positions so that they
+     * move only forward, the positions between are left empty */
+    for (i = 0; i < fw->size; ++i){
+        c = fw->arr[i];
+        j = slot->size - fw->size + i;
+        inc->ord[c] = slot->arr[j];
+        inc->pos[slot->arr[j]] = c;
+    }
+    for (; k < slot->size - fw->size; ++k)
+        inc->pos[slot->arr[k]] = -1;
+
+    scanned += slot->size;
+    inc->insert_cost += COST_WEIGHT * (scanned - inc->insert_cost);
+    return merged;
+}
+
+static long sccIt(int node_id, void *ud)
+{
+    return 0;
+}
+
+static int sccNext(int node_id, long *it, void *ud)
+{
+    bor_scc_inc_t *inc = ud;
+    bor_iarr_t *l = inc->out + node_id;
+    int d;
+
+    while (*it < l->size){
+        d = find(inc, l->arr[(*it)++]);
+        if (d != node_id)
+            return d;
+    }
+    return -1;
+}
+
+static void recompute(bor_scc_inc_t *inc)
+{
+    bor_scc_t scc;
+    const bor_scc_comp_t *comp;
+    int i, r, len;
+
+    /* Non-root nodes have no edges and are not targets of any edge, so
+     * each of them forms its own component that is skipped. */
+    borSCCInit(&scc, inc->node_size, sccIt, sccNext, inc);
+    borSCC(&scc);
+
+    len = 0;
+    for (i = 0; i < scc.comp_size; ++i){
+        if (inc->parent[scc.comp[i].node[0]] == scc.comp[i].node[0])
+            ++len;
+    }
+
+    /* components are in reverse topological order */
+    inc->pos_size = 0;
+    if (inc->pos_alloc < len){
+        inc->pos_alloc = len;
+        inc->pos = BOR_REALLOC_ARR(inc->pos, int, inc->pos_alloc);
+    }
+    inc->pos_size = len;
+    for (i = 0; i < scc.comp_size; ++i){
+        comp = scc.comp + i;
+        if (inc->parent[comp->node[0]] != comp->node[0])
+            continue;
+
+        r = merge(inc, comp->node, comp->node_size);
+        --len;
+        inc->ord[r] = len;
+        inc->pos[len] = r;
+    }
+    borSCCFree(&scc);
+
+    for (i = 0; i < inc->node_size; ++i){
+        if (inc->parent[i] == i){
+            compactList(inc, i, inc->out + i);
+            compactList(inc, i, inc->in + i);
+        }
+    }
+}
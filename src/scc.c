@@ -17,72 +17,248 @@
 #include "boruvka/scc.h"
 #include "boruvka/alloc.h"
 #include "boruvka/sort.h"
+#include "boruvka/tasks.h"
+
+/** Minimal number of nodes processed in parallel */
+#define PAR_MIN 1024
+
+struct _scc_frame_t {
+    int node;
+    long it;
+};
+typedef struct _scc_frame_t scc_frame_t;
 
 struct _scc_dfs_t {
+    bor_scc_neighbor_it_fn it;     /*!< Source of edges */
+    bor_scc_neighbor_next_fn next;
+    void *userdata;
+    const char *skip;              /*!< Nodes that are ignored or NULL */
+
     int cur_index;
     int *index;
     int *lowlink;
     int *in_stack;
     int *stack;
     int stack_size;
+    scc_frame_t *call;             /*!< Stack replacing recursion */
+    int call_size;
 };
 typedef struct _scc_dfs_t scc_dfs_t;
 
-static void sccTarjanStrongconnect(bor_scc_t *scc, scc_dfs_t *dfs, int node)
+/**
+ * Graph read through callbacks and state of parallel algorithm.
+ */
+struct _scc_par_t {
+    bor_scc_t *scc;
+    int num_threads;
+    int *start;      /*!< Successors of i are adj[start[i], start[i+1]) */
+    int *adj;
+    int *rstart;     /*!< Predecessors of i are radj[rstart[i], ...) */
+    int *radj;
+    char *done;      /*!< True if node's component is known */
+    int *indeg;      /*!< In-degree considering only nodes not done */
+    int *outdeg;     /*!< Out-degree considering only nodes not done */
+    int *fw;         /*!< Reached by forward search */
+    int *bw;         /*!< Reached by backward search */
+    int *visited;    /*!< Either fw or bw */
+
+    int *front;      /*!< Nodes processed in one round */
+    int front_len;
+    int **next;      /*!< Nodes produced by each thread */
+    int *next_len;
+    int *next_alloc;
+};
+typedef struct _scc_par_t scc_par_t;
+
+/** Appends a new component with nodes copied from {node} */
+static void sccAddComp(bor_scc_t *scc, const int *node, int node_size);
+/** Tarjan's algorithm from a single node */
+static void sccTarjanStrongconnect(bor_scc_t *scc, scc_dfs_t *dfs,
+                                   int node);
+/** Runs Tarjan's algorithm from start_node or from all nodes if -1 */
+static void sccTarjan(bor_scc_t *scc, int start_node,
+                      bor_scc_neighbor_it_fn it,
+                      bor_scc_neighbor_next_fn next,
+                      void *userdata, const char *skip);
+/** Parallel trimming + forward-backward + Tarjan */
+static void sccParallel(bor_scc_t *scc);
+/** Sorts components into reverse topological order */
+static void sccSortComps(bor_scc_t *scc, const scc_par_t *par);
+
+/** Runs {fn} either in parallel or only in the calling thread */
+static void parRun(scc_par_t *par, bor_tasks_t *tasks, int len,
+                   bor_tasks_fn fn);
+/** Returns range [from, to) of {len} items assigned to thread {id} */
+static void parRange(const scc_par_t *par, int id, int len,
+                     int *from, int *to);
+/** Appends node to the output of thread {tid} */
+_bor_inline void parPush(scc_par_t *par, int tid, int node);
+/** Moves nodes produced by threads to .front */
+static void parCollect(scc_par_t *par);
+/** Tasks reading graph through callbacks */
+static void parCountTask(int id, void *data, const bor_tasks_thinfo_t *th);
+static void parFillTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Tasks of trimming */
+static void parTrimInitTask(int id, void *data,
+                            const bor_tasks_thinfo_t *th);
+static void parTrimTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Tasks of forward and backward search */
+static void parFwTask(int id, void *data, const bor_tasks_thinfo_t *th);
+static void parBwTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Iterator over the adjacency array read from callbacks */
+static long parIt(int node, void *userdata);
+static int parNext(int node, long *it, void *userdata);
+
+
+void borSCCInit(bor_scc_t *scc, int node_size,
+                bor_scc_neighbor_it_fn it_fn,
+                bor_scc_neighbor_next_fn next_fn,
+                void *userdata)
+{
+    borSCCInitFlags(scc, node_size, it_fn, next_fn, userdata, 0u, 1);
+}
+
+void borSCCInitFlags(bor_scc_t *scc, int node_size,
+                     bor_scc_neighbor_it_fn it_fn,
+                     bor_scc_neighbor_next_fn next_fn,
+                     void *userdata,
+                     unsigned flags, int num_threads)
+{
+    bzero(scc, sizeof(*scc));
+    scc->node_size = node_size;
+    scc->it = it_fn;
+    scc->next = next_fn;
+    scc->userdata = userdata;
+    scc->flags = flags;
+    scc->num_threads = BOR_MAX(num_threads, 1);
+}
+
+void borSCCFree(bor_scc_t *scc)
+{
+    int i;
+
+    for (i = 0; i < scc->comp_size; ++i){
+        if (scc->comp[i].node != NULL)
+            BOR_FREE(scc->comp[i].node);
+    }
+    if (scc->comp)
+        BOR_FREE(scc->comp);
+}
+
+void borSCC(bor_scc_t *scc)
+{
+    if (scc->flags & BOR_SCC_PARALLEL){
+        sccParallel(scc);
+    }else{
+        sccTarjan(scc, -1, scc->it, scc->next, scc->userdata, NULL);
+    }
+}
+
+void borSCC1(bor_scc_t *scc, int node)
+{
+    sccTarjan(scc, node, scc->it, scc->next, scc->userdata, NULL);
+}
+
+
+static void sccAddComp(bor_scc_t *scc, const int *node, int node_size)
 {
-    int i, w;
-    long it;
     bor_scc_comp_t *comp;
 
+    if (scc->comp_size == scc->comp_alloc){
+        scc->comp_alloc = BOR_MAX(2 * scc->comp_alloc, 8);
+        scc->comp = BOR_REALLOC_ARR(scc->comp, bor_scc_comp_t,
+                                    scc->comp_alloc);
+    }
+    comp = scc->comp + scc->comp_size++;
+    comp->node_size = node_size;
+    comp->node = BOR_ALLOC_ARR(int, comp->node_size);
+
+    memcpy(comp->node, node, sizeof(int) * comp->node_size);
+    if (comp->node_size > 1)
+        borSortByIntKey(comp->node, comp->node_size, sizeof(int), 0);
+}
+
+_bor_inline void sccTarjanVisit(scc_dfs_t *dfs, int node)
+{
+    scc_frame_t *f;
+
     dfs->index[node] = dfs->lowlink[node] = dfs->cur_index++;
     dfs->stack[dfs->stack_size++] = node;
     dfs->in_stack[node] = 1;
 
-    it = scc->it(node, scc->userdata);
-    while ((w = scc->next(node, &it, scc->userdata)) >= 0){
-        if (dfs->index[w] == -1){
-            sccTarjanStrongconnect(scc, dfs, w);
-            dfs->lowlink[node] = BOR_MIN(dfs->lowlink[node], dfs->lowlink[w]);
-        }else if (dfs->in_stack[w]){
-            dfs->lowlink[node] = BOR_MIN(dfs->lowlink[node], dfs->lowlink[w]);
+    f = dfs->call + dfs->call_size++;
+    f->node = node;
+    f->it = dfs->it(node, dfs->userdata);
+}
+
+static void sccTarjanStrongconnect(bor_scc_t *scc, scc_dfs_t *dfs, int node)
+{
+    scc_frame_t *f;
+    int i, w, parent;
+
+    sccTarjanVisit(dfs, node);
+    while (dfs->call_size > 0){
+        f = dfs->call + dfs->call_size - 1;
+        node = f->node;
+
+        w = dfs->next(node, &f->it, dfs->userdata);
+        if (w >= 0){
+            if (dfs->skip != NULL && dfs->skip[w])
+                continue;
+
+            if (dfs->index[w] == -1){
+                // Descend, lowlink of node is updated when w is finished
+                sccTarjanVisit(dfs, w);
+            }else if (dfs->in_stack[w]){
+                dfs->lowlink[node] = BOR_MIN(dfs->lowlink[node],
+                                             dfs->lowlink[w]);
+            }
+            continue;
         }
-    }
 
-    if (dfs->index[node] == dfs->lowlink[node]){
-        // Find how deep unroll stack
-        for (i = dfs->stack_size - 1; dfs->stack[i] != node; --i)
+        // All successors of node are processed
+        --dfs->call_size;
+        if (dfs->index[node] == dfs->lowlink[node]){
+            // Find how deep unroll stack
+            for (i = dfs->stack_size - 1; dfs->stack[i] != node; --i)
+                dfs->in_stack[dfs->stack[i]] = 0;
             dfs->in_stack[dfs->stack[i]] = 0;
-        dfs->in_stack[dfs->stack[i]] = 0;
 
-        // Create new component
-        ++scc->comp_size;
-        scc->comp = BOR_REALLOC_ARR(scc->comp, bor_scc_comp_t, scc->comp_size);
-        comp = scc->comp + scc->comp_size - 1;
-        comp->node_size = dfs->stack_size - i;
-        comp->node = BOR_ALLOC_ARR(int, comp->node_size);
+            sccAddComp(scc, dfs->stack + i, dfs->stack_size - i);
 
-        // Copy node IDs from stack to the component
-        memcpy(comp->node, dfs->stack + i, sizeof(int) * comp->node_size);
-        if (comp->node_size > 1)
-            borSortByIntKey(comp->node, comp->node_size, sizeof(int), 0);
+            // Shrink stack
+            dfs->stack_size = i;
+        }
 
-        // Shrink stack
-        dfs->stack_size = i;
+        if (dfs->call_size > 0){
+            parent = dfs->call[dfs->call_size - 1].node;
+            dfs->lowlink[parent] = BOR_MIN(dfs->lowlink[parent],
+                                           dfs->lowlink[node]);
+        }
     }
 }
 
-static void sccTarjan(bor_scc_t *scc, int start_node)
+static void sccTarjan(bor_scc_t *scc, int start_node,
+                      bor_scc_neighbor_it_fn it,
+                      bor_scc_neighbor_next_fn next,
+                      void *userdata, const char *skip)
 {
     scc_dfs_t dfs;
     int i, node;
 
     // Initialize structure for Tarjan's algorithm
+    dfs.it = it;
+    dfs.next = next;
+    dfs.userdata = userdata;
+    dfs.skip = skip;
     dfs.cur_index = 0;
     dfs.index    = BOR_ALLOC_ARR(int, 4 * scc->node_size);
     dfs.lowlink  = dfs.index + scc->node_size;
     dfs.in_stack = dfs.lowlink + scc->node_size;
     dfs.stack    = dfs.in_stack + scc->node_size;
     dfs.stack_size = 0;
+    dfs.call = BOR_ALLOC_ARR(scc_frame_t, scc->node_size);
+    dfs.call_size = 0;
     for (i = 0; i < scc->node_size; ++i){
         dfs.index[i] = dfs.lowlink[i] = -1;
         dfs.in_stack[i] = 0;
@@ -92,45 +268,375 @@ static void sccTarjan(bor_scc_t *scc, int start_node)
         sccTarjanStrongconnect(scc, &dfs, start_node);
     }else{
         for (node = 0; node < scc->node_size; ++node){
-            if (dfs.index[node] == -1)
+            if (dfs.index[node] == -1 && (skip == NULL || !skip[node]))
                 sccTarjanStrongconnect(scc, &dfs, node);
         }
     }
 
+    BOR_FREE(dfs.call);
     BOR_FREE(dfs.index);
 }
 
+static void sccParallel(bor_scc_t *scc)
+{
+    bor_tasks_t *tasks = NULL;
+    scc_par_t par;
+    int i, n, node, pivot, remain, *pos;
+    long score, best;
 
-void borSCCInit(bor_scc_t *scc, int node_size,
-                bor_scc_neighbor_it_fn it_fn,
-                bor_scc_neighbor_next_fn next_fn,
-                void *userdata)
+    n = scc->node_size;
+    bzero(&par, sizeof(par));
+    par.scc = scc;
+    par.num_threads = scc->num_threads;
+    par.next = BOR_CALLOC_ARR(int *, par.num_threads);
+    par.next_len = BOR_CALLOC_ARR(int, par.num_threads);
+    par.next_alloc = BOR_CALLOC_ARR(int, par.num_threads);
+    par.front = BOR_ALLOC_ARR(int, BOR_MAX(n, 1));
+    par.start = BOR_CALLOC_ARR(int, n + 1);
+    par.rstart = BOR_CALLOC_ARR(int, n + 1);
+    par.done = BOR_CALLOC_ARR(char, BOR_MAX(n, 1));
+    par.indeg = BOR_CALLOC_ARR(int, BOR_MAX(n, 1));
+    par.outdeg = BOR_CALLOC_ARR(int, BOR_MAX(n, 1));
+
+    if (par.num_threads > 1 && n >= PAR_MIN){
+        tasks = borTasksNew(par.num_threads);
+        borTasksRun(tasks);
+    }
+
+    // Read graph: out-degrees, then successors
+    parRun(&par, tasks, n, parCountTask);
+    for (i = 0; i < n; ++i)
+        par.start[i + 1] = par.start[i] + par.outdeg[i];
+    par.adj = BOR_ALLOC_ARR(int, BOR_MAX(par.start[n], 1));
+    parRun(&par, tasks, n, parFillTask);
+
+    // Predecessors are sorted by ID because nodes are traversed in order
+    for (i = 0; i < par.start[n]; ++i)
+        ++par.indeg[par.adj[i]];
+    for (i = 0; i < n; ++i)
+        par.rstart[i + 1] = par.rstart[i] + par.indeg[i];
+    par.radj = BOR_ALLOC_ARR(int, BOR_MAX(par.start[n], 1));
+    pos = BOR_ALLOC_ARR(int, n + 1);
+    memcpy(pos, par.rstart, sizeof(int) * (n + 1));
+    for (node = 0; node < n; ++node){
+        for (i = par.start[node]; i < par.start[node + 1]; ++i)
+            par.radj[pos[par.adj[i]]++] = node;
+    }
+    BOR_FREE(pos);
+
+    // Trimming: nodes without predecessors or successors among nodes
+    // that are not done are components on their own
+    remain = n;
+    parRun(&par, tasks, n, parTrimInitTask);
+    parCollect(&par);
+    while (par.front_len > 0){
+        remain -= par.front_len;
+        parRun(&par, tasks, par.front_len, parTrimTask);
+        for (i = 0; i < par.front_len; ++i)
+            sccAddComp(scc, par.front + i, 1);
+        parCollect(&par);
+    }
+
+    // Forward-backward search from the node likely lying in the largest
+    // component
+    pivot = -1;
+    best = -1;
+    for (node = 0; node < n; ++node){
+        if (par.done[node])
+            continue;
+        score = (long)par.indeg[node] * par.outdeg[node];
+        if (score > best){
+            best = score;
+            pivot = node;
+        }
+    }
+
+    if (pivot >= 0){
+        par.fw = BOR_CALLOC_ARR(int, n);
+        par.bw = BOR_CALLOC_ARR(int, n);
+
+        par.visited = par.fw;
+        par.fw[pivot] = 1;
+        par.front[0] = pivot;
+        par.front_len = 1;
+        while (par.front_len > 0){
+            parRun(&par, tasks, par.front_len, parFwTask);
+            parCollect(&par);
+        }
+
+        par.visited = par.bw;
+        par.bw[pivot] = 1;
+        par.front[0] = pivot;
+        par.front_len = 1;
+        while (par.front_len > 0){
+            parRun(&par, tasks, par.front_len, parBwTask);
+            parCollect(&par);
+        }
+
+        par.front_len = 0;
+        for (node = 0; node < n; ++node){
+            if (par.fw[node] && par.bw[node]){
+                par.front[par.front_len++] = node;
+                par.done[node] = 1;
+            }
+        }
+        sccAddComp(scc, par.front, par.front_len);
+        remain -= par.front_len;
+
+        BOR_FREE(par.fw);
+        BOR_FREE(par.bw);
+    }
+
+    if (tasks)
+        borTasksDel(tasks);
+
+    // The rest is left for Tarjan's algorithm
+    if (remain > 0)
+        sccTarjan(scc, -1, parIt, parNext, &par, par.done);
+
+    sccSortComps(scc, &par);
+
+    for (i = 0; i < par.num_threads; ++i){
+        if (par.next[i])
+            BOR_FREE(par.next[i]);
+    }
+    BOR_FREE(par.next);
+    BOR_FREE(par.next_len);
+    BOR_FREE(par.next_alloc);
+    BOR_FREE(par.front);
+    BOR_FREE(par.start);
+    BOR_FREE(par.adj);
+    BOR_FREE(par.rstart);
+    BOR_FREE(par.radj);
+    BOR_FREE(par.done);
+    BOR_FREE(par.indeg);
+    BOR_FREE(par.outdeg);
+}
+
+static int compCmp(const void *a, const void *b)
 {
-    bzero(scc, sizeof(*scc));
-    scc->node_size = node_size;
-    scc->it = it_fn;
-    scc->next = next_fn;
-    scc->userdata = userdata;
+    const bor_scc_comp_t *c1 = a, *c2 = b;
+    return c1->node[0] - c2->node[0];
 }
 
-void borSCCFree(bor_scc_t *scc)
+static void sccSortComps(bor_scc_t *scc, const scc_par_t *par)
+{
+    bor_scc_comp_t *comp;
+    int *comp_id, *outdeg, *queue, head, tail;
+    int i, j, k, c, cu, node;
+
+    // Components are found in an order depending on scheduling, so they
+    // are first sorted by their smallest node
+    qsort(scc->comp, scc->comp_size, sizeof(bor_scc_comp_t), compCmp);
+
+    comp_id = BOR_ALLOC_ARR(int, BOR_MAX(scc->node_size, 1));
+    outdeg = BOR_CALLOC_ARR(int, BOR_MAX(scc->comp_size, 1));
+    queue = BOR_ALLOC_ARR(int, BOR_MAX(scc->comp_size, 1));
+    for (c = 0; c < scc->comp_size; ++c){
+        for (i = 0; i < scc->comp[c].node_size; ++i)
+            comp_id[scc->comp[c].node[i]] = c;
+    }
+    for (node = 0; node < scc->node_size; ++node){
+        for (i = par->start[node]; i < par->start[node + 1]; ++i){
+            if (comp_id[par->adj[i]] != comp_id[node])
+                ++outdeg[comp_id[node]];
+        }
+    }
+
+    // Kahn's algorithm on the reversed condensation
+    head = tail = 0;
+    for (c = 0; c < scc->comp_size; ++c){
+        if (outdeg[c] == 0)
+            queue[tail++] = c;
+    }
+    while (head < tail){
+        c = queue[head++];
+        for (j = 0; j < scc->comp[c].node_size; ++j){
+            node = scc->comp[c].node[j];
+            for (k = par->rstart[node]; k < par->rstart[node + 1]; ++k){
+                cu = comp_id[par->radj[k]];
+                if (cu != c && --outdeg[cu] == 0)
+                    queue[tail++] = cu;
+            }
+        }
+    }
+
+    comp = BOR_ALLOC_ARR(bor_scc_comp_t, BOR_MAX(scc->comp_alloc, 1));
+    for (i = 0; i < scc->comp_size; ++i)
+        comp[i] = scc->comp[queue[i]];
+    BOR_FREE(scc->comp);
+    scc->comp = comp;
+
+    BOR_FREE(comp_id);
+    BOR_FREE(outdeg);
+    BOR_FREE(queue);
+}
+
+static void parRun(scc_par_t *par, bor_tasks_t *tasks, int len,
+                   bor_tasks_fn fn)
 {
     int i;
 
-    for (i = 0; i < scc->comp_size; ++i){
-        if (scc->comp[i].node != NULL)
-            BOR_FREE(scc->comp[i].node);
+    if (tasks && len >= PAR_MIN){
+        for (i = 0; i < par->num_threads; ++i)
+            borTasksAdd(tasks, fn, i, par);
+        borTasksBarrier(tasks);
+    }else{
+        // Range of thread 0 is then the whole input
+        i = par->num_threads;
+        par->num_threads = 1;
+        fn(0, par, NULL);
+        par->num_threads = i;
     }
-    if (scc->comp)
-        BOR_FREE(scc->comp);
 }
 
-void borSCC(bor_scc_t *scc)
+static void parRange(const scc_par_t *par, int id, int len,
+                     int *from, int *to)
 {
-    sccTarjan(scc, -1);
+    *from = (long)len * id / par->num_threads;
+    *to = (long)len * (id + 1) / par->num_threads;
 }
 
-void borSCC1(bor_scc_t *scc, int node)
+_bor_inline void parPush(scc_par_t *par, int tid, int node)
+{
+    if (par->next_len[tid] == par->next_alloc[tid]){
+        par->next_alloc[tid] = BOR_MAX(2 * par->next_alloc[tid], 1024);
+        par->next[tid] = BOR_REALLOC_ARR(par->next[tid], int,
+                                         par->next_alloc[tid]);
+    }
+    par->next[tid][par->next_len[tid]++] = node;
+}
+
+static void parCollect(scc_par_t *par)
 {
-    sccTarjan(scc, node);
+    int i;
+
+    // Each node is produced at most once, so it always fits
+    par->front_len = 0;
+    for (i = 0; i < par->num_threads; ++i){
+        memcpy(par->front + par->front_len, par->next[i],
+               sizeof(int) * par->next_len[i]);
+        par->front_len += par->next_len[i];
+        par->next_len[i] = 0;
+    }
+}
+
+static void parCountTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    bor_scc_t *scc = par->scc;
+    int node, from, to, deg;
+    long it;
+
+    parRange(par, id, scc->node_size, &from, &to);
+    for (node = from; node < to; ++node){
+        deg = 0;
+        it = scc->it(node, scc->userdata);
+        while (scc->next(node, &it, scc->userdata) >= 0)
+            ++deg;
+        par->outdeg[node] = deg;
+    }
+}
+
+static void parFillTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    bor_scc_t *scc = par->scc;
+    int node, from, to, w, *adj;
+    long it;
+
+    parRange(par, id, scc->node_size, &from, &to);
+    for (node = from; node < to; ++node){
+        adj = par->adj + par->start[node];
+        it = scc->it(node, scc->userdata);
+        while ((w = scc->next(node, &it, scc->userdata)) >= 0)
+            *adj++ = w;
+    }
+}
+
+_bor_inline void parTrimClaim(scc_par_t *par, int tid, int node)
+{
+    if (!par->done[node]
+            && __sync_bool_compare_and_swap(par->done + node, 0, 1)){
+        parPush(par, tid, node);
+    }
+}
+
+static void parTrimInitTask(int id, void *data,
+                            const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    int node, from, to;
+
+    parRange(par, id, par->scc->node_size, &from, &to);
+    for (node = from; node < to; ++node){
+        if (par->indeg[node] == 0 || par->outdeg[node] == 0)
+            parTrimClaim(par, id, node);
+    }
+}
+
+static void parTrimTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    int i, j, from, to, node, w;
+
+    parRange(par, id, par->front_len, &from, &to);
+    for (i = from; i < to; ++i){
+        node = par->front[i];
+        for (j = par->start[node]; j < par->start[node + 1]; ++j){
+            w = par->adj[j];
+            if (__sync_sub_and_fetch(par->indeg + w, 1) == 0)
+                parTrimClaim(par, id, w);
+        }
+        for (j = par->rstart[node]; j < par->rstart[node + 1]; ++j){
+            w = par->radj[j];
+            if (__sync_sub_and_fetch(par->outdeg + w, 1) == 0)
+                parTrimClaim(par, id, w);
+        }
+    }
+}
+
+_bor_inline void parSearch(scc_par_t *par, int id,
+                           const int *start, const int *adj)
+{
+    int i, j, from, to, node, w;
+
+    parRange(par, id, par->front_len, &from, &to);
+    for (i = from; i < to; ++i){
+        node = par->front[i];
+        for (j = start[node]; j < start[node + 1]; ++j){
+            w = adj[j];
+            if (par->done[w] || par->visited[w])
+                continue;
+            if (__sync_bool_compare_and_swap(par->visited + w, 0, 1))
+                parPush(par, id, w);
+        }
+    }
+}
+
+static void parFwTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    parSearch(par, id, par->start, par->adj);
+}
+
+static void parBwTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    scc_par_t *par = data;
+    parSearch(par, id, par->rstart, par->radj);
+}
+
+static long parIt(int node, void *userdata)
+{
+    const scc_par_t *par = userdata;
+    return par->start[node];
+}
+
+static int parNext(int node, long *it, void *userdata)
+{
+    const scc_par_t *par = userdata;
+
+    if (*it >= par->start[node + 1])
+        return -1;
+    return par->adj[(*it)++];
 }
@@ -0,0 +1,431 @@
+/***
+ * Boruvka
+ * --------
+ * Copyright (c)2017 Daniel Fiser <danfis@danfis.cz>
+ *
+ *  This file is part of Boruvka.
+ *
+ *  Distributed under the OSI-approved BSD License (the "License");
+ *  see accompanying file BDS-LICENSE for details or see
+ *  <http://www.opensource.org/licenses/bsd-license.php>.
+ *
+ *  This software is distributed WITHOUT ANY WARRANTY; without even the
+ *  implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *  See the License for more information.
+ */
+
+#include <limits.h>
+#include <boruvka/alloc.h>
+#include <boruvka/tasks.h>
+#include <boruvka/iradixq.h>
+#include <boruvka/sssp.h>
+#include "_bucketbmap.h"
+
+/** Minimal number of nodes relaxed in parallel */
+#define PAR_MIN 1024
+
+struct _bucket_t {
+    int *node;
+    int len;
+    int alloc;
+};
+typedef struct _bucket_t bucket_t;
+
+struct _ds_t {
+    const bor_sssp_graph_t *g;
+    long *dist;
+    int delta;
+    int num_threads;
+
+    bucket_t *bucket;   /*!< Cyclic array of buckets */
+    int bucket_size;
+    uint64_t *bmap;     /*!< Non-empty buckets */
+    uint64_t *bmap_top;
+    long *mark;         /*!< Bucket in which the node is queued or -1 */
+    char *removed;      /*!< True if the node is in .removed_node */
+    int *removed_node;  /*!< Nodes removed from the current bucket */
+    int removed_len;
+
+    int *front;         /*!< Nodes whose edges are relaxed */
+    int front_len;
+    int heavy;          /*!< True if heavy edges are relaxed */
+    int **req;          /*!< Nodes with lowered distance of each thread */
+    int *req_len;
+    int *req_alloc;
+};
+typedef struct _ds_t ds_t;
+
+/** Compares edges by weight */
+static int edgeCmp(const void *a, const void *b);
+/** Lowers dist[u] to d, returns true if it was lowered */
+_bor_inline int relax(long *dist, int u, long d);
+/** Relaxes edges of part of frontier */
+static void relaxTask(int id, void *data, const bor_tasks_thinfo_t *th);
+/** Relaxes edges of nodes front[from, to) by thread {tid} */
+static void relaxNodes(ds_t *ds, int tid, int from, int to);
+/** Relaxes edges of the whole frontier */
+static void relaxFront(ds_t *ds, bor_tasks_t *tasks);
+/** Moves nodes with lowered distances to buckets */
+static void mergeReq(ds_t *ds);
+/** Inserts node into bucket corresponding to its distance */
+static void bucketPush(ds_t *ds, int node);
+
+void borSSSPGraphInit(bor_sssp_graph_t *g, const bor_digraph_t *dg,
+                      const int *weight)
+{
+    const bor_digraph_edge_t *e;
+    int i, *pos, w;
+
+    g->node_size = dg->node_size;
+    g->edge_size = dg->edge_size;
+    g->start = BOR_CALLOC_ARR(int, g->node_size + 1);
+    g->edge = BOR_ALLOC_ARR(bor_sssp_edge_t, BOR_MAX(g->edge_size, 1));
+    g->max_weight = 0;
+
+    for (i = 0; i < dg->edge_size; ++i)
+        ++g->start[dg->edge[i].from + 1];
+    for (i = 0; i < g->node_size; ++i)
+        g->start[i + 1] += g->start[i];
+
+    pos = BOR_ALLOC_ARR(int, BOR_MAX(g->node_size, 1));
+    memcpy(pos, g->start, sizeof(int) * g->node_size);
+    for (i = 0; i < dg->edge_size; ++i){
+        e = dg->edge + i;
+        w = (weight != NULL ? weight[i] : 1);
+        if (w < 0){
+            fprintf(stderr, "Error: borSSSP: negative weight %d of edge %d.\n",
+                    w, i);
+            exit(-1);
+        }
+
+        g->edge[pos[e->from]].to = e->to;
+        g->edge[pos[e->from]].weight = w;
+        ++pos[e->from];
+        g->max_weight = BOR_MAX(g->max_weight, w);
+    }
+    BOR_FREE(pos);
+
+    /* Light edges are then a prefix of each node's edges */
+    for (i = 0; i < g->node_size; ++i){
+        if (g->start[i + 1] - g->start[i] > 1){
+            qsort(g->edge + g->start[i], g->start[i + 1] - g->start[i],
+                  sizeof(bor_sssp_edge_t), edgeCmp);
+        }
+    }
+}
+
+void borSSSPGraphFree(bor_sssp_graph_t *g)
+{
+    BOR_FREE(g->start);
+    BOR_FREE(g->edge);
+}
+
+int borSSSPDijkstra(const bor_sssp_graph_t *g, int src, long *dist)
+{
+    bor_iradixq_t pq;
+    const bor_sssp_edge_t *e, *end;
+    int *handle, v, u, reached;
+    long d;
+
+    for (v = 0; v < g->node_size; ++v)
+        dist[v] = -1;
+    if (src < 0 || src >= g->node_size)
+        return 0;
+
+    /* handle is -1 for unreached nodes and -2 for closed nodes */
+    handle = BOR_ALLOC_ARR(int, g->node_size);
+    for (v = 0; v < g->node_size; ++v)
+        handle[v] = -1;
+
+    borIRadixQInit(&pq);
+    dist[src] = 0;
+    handle[src] = borIRadixQPush(&pq, 0, src);
+    reached = 0;
+    while (!borIRadixQIsEmpty(&pq)){
+        v = borIRadixQPop(&pq, &d);
+        handle[v] = -2;
+        ++reached;
+
+        end = g->edge + g->start[v + 1];
+        for (e = g->edge + g->start[v]; e != end; ++e){
+            u = e->to;
+            if (handle[u] == -2)
+                continue;
+
+            if (handle[u] == -1){
+                dist[u] = d + e->weight;
+                handle[u] = borIRadixQPush(&pq, dist[u], u);
+            }else if (d + e->weight < dist[u]){
+                dist[u] = d + e->weight;
+                borIRadixQDecreaseKey(&pq, handle[u], dist[u]);
+            }
+        }
+    }
+    borIRadixQFree(&pq);
+    BOR_FREE(handle);
+
+    return reached;
+}
+
+int borSSSPDeltaStep(const bor_sssp_graph_t *g, int src, int delta,
+                     int num_threads, long *dist)
+{
+    bor_tasks_t *tasks = NULL;
+    ds_t ds;
+    bucket_t *bucket;
+    long cur;
+    int i, v, slot, next, reached;
+
+    if (src < 0 || src >= g->node_size){
+        for (v = 0; v < g->node_size; ++v)
+            dist[v] = -1;
+        return 0;
+    }
+
+    if (delta <= 0){
+        delta = g->max_weight;
+        if (g->edge_size > g->node_size)
+            delta = (long)delta * g->node_size / g->edge_size;
+        delta = BOR_MAX(delta, 1);
+    }
+
+    bzero(&ds, sizeof(ds));
+    ds.g = g;
+    ds.dist = dist;
+    ds.delta = delta;
+    ds.num_threads = BOR_MAX(num_threads, 1);
+
+    /* All queued nodes have distance lower than
+     * (cur + 1) * delta + max_weight, so this many buckets never overlap */
+    ds.bucket_size = g->max_weight / delta + 2;
+    ds.bucket_size = (ds.bucket_size + 63) & ~63;
+    ds.bucket = BOR_CALLOC_ARR(bucket_t, ds.bucket_size);
+    borBucketBmapResize(&ds.bmap, &ds.bmap_top, 0, ds.bucket_size);
+
+    ds.mark = BOR_ALLOC_ARR(long, g->node_size);
+    ds.removed = BOR_CALLOC_ARR(char, g->node_size);
+    ds.removed_node = BOR_ALLOC_ARR(int, g->node_size);
+    ds.front = BOR_ALLOC_ARR(int, g->node_size);
+    ds.req = BOR_CALLOC_ARR(int *, ds.num_threads);
+    ds.req_len = BOR_CALLOC_ARR(int, ds.num_threads);
+    ds.req_alloc = BOR_CALLOC_ARR(int, ds.num_threads);
+
+    for (v = 0; v < g->node_size; ++v){
+        dist[v] = LONG_MAX;
+        ds.mark[v] = -1;
+    }
+    dist[src] = 0;
+    bucketPush(&ds, src);
+
+    if (ds.num_threads > 1){
+        tasks = borTasksNew(ds.num_threads);
+        borTasksRun(tasks);
+    }
+
+    cur = 0;
+    slot = 0;
+    while (1){
+        bucket = ds.bucket + slot;
+        ds.removed_len = 0;
+        while (bucket->len > 0){
+            /* Skip nodes that moved to a lower bucket meanwhile and
+             * duplicates of already taken nodes */
+            ds.front_len = 0;
+            for (i = 0; i < bucket->len; ++i){
+                v = bucket->node[i];
+                if (ds.mark[v] != cur)
+                    continue;
+                ds.mark[v] = -1;
+                ds.front[ds.front_len++] = v;
+                if (!ds.removed[v]){
+                    ds.removed[v] = 1;
+                    ds.removed_node[ds.removed_len++] = v;
+                }
+            }
+            bucket->len = 0;
+            borBucketBmapUnset(ds.bmap, ds.bmap_top, slot);
+
+            ds.heavy = 0;
+            relaxFront(&ds, tasks);
+            mergeReq(&ds);
+        }
+
+        /* Distances of removed nodes are final now, heavy edges can
+         * never lead back to the current bucket */
+        ds.front_len = ds.removed_len;
+        for (i = 0; i < ds.removed_len; ++i){
+            v = ds.removed_node[i];
+            ds.removed[v] = 0;
+            ds.front[i] = v;
+        }
+        ds.heavy = 1;
+        relaxFront(&ds, tasks);
+        mergeReq(&ds);
+
+        next = -1;
+        if (slot + 1 < ds.bucket_size)
+            next = borBucketBmapNext(ds.bmap, ds.bmap_top,
+                                     ds.bucket_size, slot + 1);
+        if (next < 0)
+            next = borBucketBmapNext(ds.bmap, ds.bmap_top,
+                                     ds.bucket_size, 0);
+        if (next < 0)
+            break;
+
+        cur += (next - slot + ds.bucket_size) % ds.bucket_size;
+        slot = next;
+    }
+
+    if (tasks)
+        borTasksDel(tasks);
+
+    reached = 0;
+    for (v = 0; v < g->node_size; ++v){
+        if (dist[v] == LONG_MAX){
+            dist[v] = -1;
+        }else{
+            ++reached;
+        }
+    }
+
+    for (i = 0; i < ds.num_threads; ++i){
+        if (ds.req[i])
+            BOR_FREE(ds.req[i]);
+    }
+    BOR_FREE(ds.req);
+    BOR_FREE(ds.req_len);
+    BOR_FREE(ds.req_alloc);
+    BOR_FREE(ds.front);
+    BOR_FREE(ds.removed_node);
+    BOR_FREE(ds.removed);
+    BOR_FREE(ds.mark);
+    for (i = 0; i < ds.bucket_size; ++i){
+        if (ds.bucket[i].node)
+            BOR_FREE(ds.bucket[i].node);
+    }
+    BOR_FREE(ds.bucket);
+    BOR_FREE(ds.bmap);
+    BOR_FREE(ds.bmap_top);
+
+    return reached;
+}
+
+
+static int edgeCmp(const void *a, const void *b)
+{
+    const bor_sssp_edge_t *e1 = a, *e2 = b;
+    return e1->weight - e2->weight;
+}
+
+_bor_inline int relax(long *dist, int u, long d)
+{
+    volatile long *vdist = dist;
+    long old;
+
+    while (d < (old = vdist[u])){
+        if (__sync_bool_compare_and_swap(dist + u, old, d))
+            return 1;
+    }
+    return 0;
+}
+
+static void relaxTask(int id, void *data, const bor_tasks_thinfo_t *th)
+{
+    ds_t *ds = (ds_t *)data;
+    int from, to;
+
+    from = (long)ds->front_len * id / ds->num_threads;
+    to = (long)ds->front_len * (id + 1) / ds->num_threads;
+    relaxNodes(ds, id, from, to);
+}
+
+static void relaxNodes(ds_t *ds, int tid, int from, int to)
+{
+    const bor_sssp_graph_t *g = ds->g;
+    const bor_sssp_edge_t *e, *beg, *end;
+    volatile long *vdist = ds->dist;
+    int i, v, *req, len, alloc;
+    long d;
+
+    req = ds->req[tid];
+    len = ds->req_len[tid];
+    alloc = ds->req_alloc[tid];
+
+    for (i = from; i < to; ++i){
+        v = ds->front[i];
+        /* dist[v] may be lowered by other thread, then v is queued again
+         * and relaxed with the lower distance later */
+        d = vdist[v];
+        beg = g->edge + g->start[v];
+        end = g->edge + g->start[v + 1];
+        if (ds->heavy){
+            while (beg != end && beg->weight <= ds->delta)
+                ++beg;
+        }else{
+            e = beg;
+            while (e != end && e->weight <= ds->delta)
+                ++e;
+            end = e;
+        }
+
+        for (e = beg; e != end; ++e){
+            if (!relax(ds->dist, e->to, d + e->weight))
+                continue;
+
+            if (len == alloc){
+                alloc = BOR_MAX(2 * alloc, 1024);
+                req = BOR_REALLOC_ARR(req, int, alloc);
+            }
+            req[len++] = e->to;
+        }
+    }
+
+    ds->req[tid] = req;
+    ds->req_len[tid] = len;
+    ds->req_alloc[tid] = alloc;
+}
+
+static void relaxFront(ds_t *ds, bor_tasks_t *tasks)
+{
+    int i;
+
+    if (tasks && ds->front_len >= PAR_MIN){
+        for (i = 0; i < ds->num_threads; ++i)
+            borTasksAdd(tasks, relaxTask, i, ds);
+        borTasksBarrier(tasks);
+    }else{
+        relaxNodes(ds, 0, 0, ds->front_len);
+    }
+}
+
+static void mergeReq(ds_t *ds)
+{
+    int i, j;
+
+    for (i = 0; i < ds->num_threads; ++i){
+        for (j = 0; j < ds->req_len[i]; ++j)
+            bucketPush(ds, ds->req[i][j]);
+        ds->req_len[i] = 0;
+    }
+}
+
+static void bucketPush(ds_t *ds, int node)
+{
+    bucket_t *bucket;
+    long b;
+    int slot;
+
+    b = ds->dist[node] / ds->delta;
+    if (ds->mark[node] == b)
+        return;
+    ds->mark[node] = b;
+
+    slot = b % ds->bucket_size;
+    bucket = ds->bucket + slot;
+    if (bucket->len == bucket->alloc){
+        bucket->alloc = BOR_MAX(2 * bucket->alloc, 16);
+        bucket->node = BOR_REALLOC_ARR(bucket->node, int, bucket->alloc);
+    }
+    bucket->node[bucket->len++] = node;
+    borBucketBmapSet(ds->bmap, ds->bmap_top, slot);
+}
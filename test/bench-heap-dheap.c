@@ -0,0 +1,18 @@
+#include <boruvka/dheap.h>
+
+#ifndef DHEAP_D
+# define DHEAP_D 4
+#endif
+
+#define HHEAP bor_dheap_t
+#define HNODE bor_dheap_node_t
+#define HFUNC(name) borDHeap ## name
+
+#define HNEW() borDHeapNew(DHEAP_D)
+#define HADD(heap, el) borDHeapAdd((heap), &(el)->node, (el)->val)
+#define HEXTRACTMIN(heap) borDHeapExtractMin((heap), NULL)
+#define HDECREASEKEY(heap, el) \
+    borDHeapDecreaseKey((heap), &(el)->node, (el)->val)
+#define HUPDATE(heap, el) borDHeapUpdate((heap), &(el)->node, (el)->val)
+
+#include "bench-heap.c"
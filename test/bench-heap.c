@@ -30,6 +30,9 @@ static el_t *randomEls(size_t num)
     return els;
 }
 
+/* Heaps that compare nodes by a callback are used directly, heaps that
+ * store keys define these macros before including this file. */
+#ifndef HNEW
 static int ltEl(const HNODE *n1, const HNODE *n2, void *_)
 {
     el_t *el1, *el2;
@@ -40,17 +43,24 @@ static int ltEl(const HNODE *n1, const HNODE *n2, void *_)
     return el1->val < el2->val;
 }
 
+# define HNEW() HFUNC(New)(ltEl, NULL)
+# define HADD(heap, el) HFUNC(Add)((heap), &(el)->node)
+# define HEXTRACTMIN(heap) HFUNC(ExtractMin)(heap)
+# define HDECREASEKEY(heap, el) HFUNC(DecreaseKey)((heap), &(el)->node)
+# define HUPDATE(heap, el) HFUNC(Update)((heap), &(el)->node)
+#endif /* HNEW */
+
 static void IP(HHEAP *heap, el_t *els, size_t num)
 {
     HNODE *node;
     size_t i;
 
     for (i = 0; i < num; i++){
-        HFUNC(Add)(heap, &els[i].node);
+        HADD(heap, &els[i]);
     }
 
     while (!HFUNC(Empty)(heap)){
-        node = HFUNC(ExtractMin)(heap);
+        node = HEXTRACTMIN(heap);
         fprintf(fout, "%lx\n", (long)node);
     }
 }
@@ -70,7 +80,7 @@ static void IPR(HHEAP *heap, el_t *els, size_t num)
     while (num_inserts != num){
         if (insert == 0){
             while (!HFUNC(Empty)(heap)){
-                node = HFUNC(ExtractMin)(heap);
+                node = HEXTRACTMIN(heap);
                 el = bor_container_of(node, el_t, node);
                 el->onheap = 0;
                 fprintf(fout, "%lx\n", (long)node);
@@ -79,7 +89,7 @@ static void IPR(HHEAP *heap, el_t *els, size_t num)
             insert = borRand(&r, 1, 500);
         }
 
-        HFUNC(Add)(heap, &els[i].node);
+        HADD(heap, &els[i]);
         els[i].onheap = 1;
         i++;
         num_inserts++;
@@ -88,7 +98,7 @@ static void IPR(HHEAP *heap, el_t *els, size_t num)
 
 
     while (!HFUNC(Empty)(heap)){
-        node = HFUNC(ExtractMin)(heap);
+        node = HEXTRACTMIN(heap);
         el = bor_container_of(node, el_t, node);
         el->onheap = 0;
         fprintf(fout, "%lx\n", (long)node);
@@ -111,7 +121,7 @@ static void IPD(HHEAP *heap, el_t *els, size_t num)
         // insert some
         loop = borRand(&r, 1, 1000);
         while (loop > 0 && num_inserts != num){
-            HFUNC(Add)(heap, &els[i].node);
+            HADD(heap, &els[i]);
             els[i].onheap = 1;
             i++;
             loop--;
@@ -121,7 +131,7 @@ static void IPD(HHEAP *heap, el_t *els, size_t num)
         // pop some
         loop = borRand(&r, 1, 1000);
         while (!HFUNC(Empty)(heap) && loop > 0 && num_inserts != num){
-            node = HFUNC(ExtractMin)(heap);
+            node = HEXTRACTMIN(heap);
             el = bor_container_of(node, el_t, node);
             el->onheap = 0;
             fprintf(fout, "%lx\n", (long)node);
@@ -134,7 +144,7 @@ static void IPD(HHEAP *heap, el_t *els, size_t num)
             dec = borRand(&r, 0, num);
             if (els[dec].onheap){
                 els[dec].val -= borRand(&r, 1, 10);
-                HFUNC(DecreaseKey)(heap, &els[dec].node);
+                HDECREASEKEY(heap, &els[dec]);
             }
 
             loop--;
@@ -143,7 +153,7 @@ static void IPD(HHEAP *heap, el_t *els, size_t num)
         // pop some
         loop = borRand(&r, 1, 1000);
         while (!HFUNC(Empty)(heap) && loop > 0 && num_inserts != num){
-            node = HFUNC(ExtractMin)(heap);
+            node = HEXTRACTMIN(heap);
             el = bor_container_of(node, el_t, node);
             el->onheap = 0;
             fprintf(fout, "%lx\n", (long)node);
@@ -153,7 +163,7 @@ static void IPD(HHEAP *heap, el_t *els, size_t num)
 
 
     while (!HFUNC(Empty)(heap)){
-        node = HFUNC(ExtractMin)(heap);
+        node = HEXTRACTMIN(heap);
         el = bor_container_of(node, el_t, node);
         el->onheap = 0;
         fprintf(fout, "%lx\n", (long)node);
@@ -176,7 +186,7 @@ static void IPC(HHEAP *heap, el_t *els, size_t num)
         // insert some
         loop = borRand(&r, 1, 1000);
         while (loop > 0 && num_inserts != num){
-            HFUNC(Add)(heap, &els[i].node);
+            HADD(heap, &els[i]);
             els[i].onheap = 1;
             i++;
             loop--;
@@ -186,7 +196,7 @@ static void IPC(HHEAP *heap, el_t *els, size_t num)
         // pop some
         loop = borRand(&r, 1, 1000);
         while (!HFUNC(Empty)(heap) && loop > 0 && num_inserts != num){
-            node = HFUNC(ExtractMin)(heap);
+            node = HEXTRACTMIN(heap);
             el = bor_container_of(node, el_t, node);
             el->onheap = 0;
             fprintf(fout, "%lx\n", (long)node);
@@ -199,7 +209,7 @@ static void IPC(HHEAP *heap, el_t *els, size_t num)
             dec = borRand(&r, 0, num);
             if (els[dec].onheap){
                 els[dec].val += borRand(&r, -10, 10);
-                HFUNC(Update)(heap, &els[dec].node);
+                HUPDATE(heap, &els[dec]);
             }
 
             loop--;
@@ -208,7 +218,7 @@ static void IPC(HHEAP *heap, el_t *els, size_t num)
         // pop some
         loop = borRand(&r, 1, 1000);
         while (!HFUNC(Empty)(heap) && loop > 0 && num_inserts != num){
-            node = HFUNC(ExtractMin)(heap);
+            node = HEXTRACTMIN(heap);
             el = bor_container_of(node, el_t, node);
             el->onheap = 0;
             fprintf(fout, "%lx\n", (long)node);
@@ -218,7 +228,7 @@ static void IPC(HHEAP *heap, el_t *els, size_t num)
 
 
     while (!HFUNC(Empty)(heap)){
-        node = HFUNC(ExtractMin)(heap);
+        node = HEXTRACTMIN(heap);
         el = bor_container_of(node, el_t, node);
         el->onheap = 0;
         fprintf(fout, "%lx\n", (long)node);
@@ -242,7 +252,7 @@ int main(int argc, char *argv[])
     num = atoi(argv[2]);
 
     els = randomEls(num);
-    heap = HFUNC(New)(ltEl, NULL);
+    heap = HNEW();
 
     borTimerStart(&timer);
 
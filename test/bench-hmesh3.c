@@ -0,0 +1,284 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <boruvka/hmesh3.h>
+#include <boruvka/mesh3.h>
+#include <boruvka/timer.h>
+#include <boruvka/alloc.h>
+
+/**
+ * Compares bor_mesh3_t and bor_hmesh3_t on n x n grid:
+ *   traverse - sums coordinates of neighbours of all vertices
+ *   collapse - performs random sequence of edge collapses
+ */
+
+static int n;
+static bor_vec3_t *coords;
+static int *tris;
+
+static void grid(void)
+{
+    int x, y, i = 0;
+
+    coords = BOR_ALLOC_ARR(bor_vec3_t, n * n);
+    tris = BOR_ALLOC_ARR(int, 6 * (n - 1) * (n - 1));
+
+    for (y = 0; y < n; y++){
+        for (x = 0; x < n; x++)
+            borVec3Set(&coords[y * n + x], x, y, (x * y) % 7);
+    }
+
+    for (y = 0; y < n - 1; y++){
+        for (x = 0; x < n - 1; x++){
+            tris[i++] = y * n + x;
+            tris[i++] = y * n + x + 1;
+            tris[i++] = (y + 1) * n + x + 1;
+            tris[i++] = y * n + x;
+            tris[i++] = (y + 1) * n + x + 1;
+            tris[i++] = (y + 1) * n + x;
+        }
+    }
+}
+
+static bor_real_t traverseMesh3(bor_mesh3_t *mesh)
+{
+    bor_list_t *list, *item;
+    bor_mesh3_vertex_t *v, *o;
+    bor_mesh3_edge_t *e;
+    bor_vec3_t sum;
+    bor_real_t s = BOR_ZERO;
+
+    list = borMesh3Vertices(mesh);
+    BOR_LIST_FOR_EACH_ENTRY(list, bor_mesh3_vertex_t, v, list){
+        borVec3Set(&sum, BOR_ZERO, BOR_ZERO, BOR_ZERO);
+        BOR_LIST_FOR_EACH(borMesh3VertexEdges(v), item){
+            e = borMesh3EdgeFromVertexList(item);
+            o = borMesh3EdgeOtherVertex(e, v);
+            borVec3Add(&sum, borMesh3VertexCoords(o));
+        }
+        s += borVec3X(&sum) + borVec3Y(&sum) + borVec3Z(&sum);
+    }
+    return s;
+}
+
+static bor_real_t traverseHMesh3(const bor_hmesh3_t *m)
+{
+    bor_vec3_t sum;
+    bor_real_t s = BOR_ZERO;
+    int v, h, start, last;
+
+    for (v = 0; v < m->verts_len; v++){
+        borVec3Set(&sum, BOR_ZERO, BOR_ZERO, BOR_ZERO);
+        start = h = borHMesh3VertexHE(m, v);
+        last = -1;
+        while (h >= 0){
+            last = h;
+            borVec3Add(&sum, &m->coords[borHMesh3HETarget(m, h)]);
+            h = borHMesh3HERotCCW(m, h);
+            if (h == start)
+                break;
+        }
+        if (h < 0 && last >= 0){
+            h = borHMesh3HEPrev(last);
+            borVec3Add(&sum, &m->coords[borHMesh3HEOrigin(m, h)]);
+        }
+        s += borVec3X(&sum) + borVec3Y(&sum) + borVec3Z(&sum);
+    }
+    return s;
+}
+
+/** Collapses edge (a, b) into vertex a */
+static void collapseMesh3(bor_mesh3_t *mesh,
+                          bor_mesh3_vertex_t *a, bor_mesh3_vertex_t *b)
+{
+    static bor_mesh3_face_t **faces = NULL;
+    static bor_mesh3_edge_t **fe = NULL;
+    static int faces_size = 0;
+    bor_mesh3_edge_t *e, *eb, *merge[2][2];
+    bor_mesh3_face_t *f;
+    bor_mesh3_vertex_t *x;
+    bor_list_t *item, *tmp;
+    int i, j, k, nf, nm;
+
+    if (faces_size < 2 * (int)borMesh3VertexEdgesLen(b)){
+        faces_size = 4 * borMesh3VertexEdgesLen(b);
+        faces = BOR_REALLOC_ARR(faces, bor_mesh3_face_t *, faces_size);
+        fe = BOR_REALLOC_ARR(fe, bor_mesh3_edge_t *, 3 * faces_size);
+    }
+
+    // faces of the edge disappear and their sides incident with b are
+    // merged into sides incident with a
+    e = borMesh3VertexCommonEdge(a, b);
+    nm = 0;
+    while ((f = borMesh3EdgeFace(e, 0)) != NULL){
+        x = borMesh3FaceOtherVertex(f, a, b);
+        merge[nm][0] = borMesh3VertexCommonEdge(b, x);
+        merge[nm][1] = borMesh3VertexCommonEdge(a, x);
+        ++nm;
+        borMesh3RemoveFace(mesh, f);
+        borMesh3FaceFree(mesh, f);
+    }
+
+    nf = 0;
+    BOR_LIST_FOR_EACH(borMesh3VertexEdges(b), item){
+        eb = borMesh3EdgeFromVertexList(item);
+        while ((f = borMesh3EdgeFace(eb, 0)) != NULL){
+            faces[nf] = f;
+            for (k = 0; k < 3; k++)
+                fe[3 * nf + k] = borMesh3FaceEdge(f, k);
+            borMesh3RemoveFace(mesh, f);
+            ++nf;
+        }
+    }
+
+    BOR_LIST_FOR_EACH_SAFE(borMesh3VertexEdges(b), item, tmp){
+        eb = borMesh3EdgeFromVertexList(item);
+        x = borMesh3EdgeOtherVertex(eb, b);
+        borMesh3RemoveEdge(mesh, eb);
+        for (j = 0; j < nm && merge[j][0] != eb; j++);
+        if (x == a || j < nm){
+            borMesh3EdgeFree(mesh, eb);
+        }else{
+            borMesh3AddEdge(mesh, eb, a, x);
+        }
+    }
+
+    for (i = 0; i < nf; i++){
+        for (k = 0; k < 3; k++){
+            for (j = 0; j < nm; j++){
+                if (fe[3 * i + k] == merge[j][0])
+                    fe[3 * i + k] = merge[j][1];
+            }
+        }
+        borMesh3AddFace(mesh, faces[i], fe[3 * i], fe[3 * i + 1],
+                        fe[3 * i + 2]);
+    }
+
+    borMesh3RemoveVertex(mesh, b);
+    borMesh3VertexFree(mesh, b);
+}
+
+/** Returns half-edge a -> b */
+static int findHE(const bor_hmesh3_t *m, int a, int b)
+{
+    int h, start;
+
+    start = h = borHMesh3VertexHE(m, a);
+    while (h >= 0){
+        if (borHMesh3HETarget(m, h) == b)
+            return h;
+        h = borHMesh3HERotCCW(m, h);
+        if (h == start)
+            break;
+    }
+    return -1;
+}
+
+/** Generates sequence of collapsible edges, returns its length */
+static int collapseSeq(int *seq)
+{
+    bor_hmesh3_t *m;
+    int i, h, len = 0;
+
+    srand(0);
+    m = borHMesh3NewSoup(coords, n * n, tris, 2 * (n - 1) * (n - 1), 0);
+    for (i = 0; i < 4 * n * n && m->faces_num > 2 * n; i++){
+        h = rand() % (3 * m->faces_len);
+        if (!borHMesh3FaceAlive(m, borHMesh3HEFace(h)))
+            continue;
+
+        seq[2 * len] = borHMesh3HEOrigin(m, h);
+        seq[2 * len + 1] = borHMesh3HETarget(m, h);
+        if (borHMesh3EdgeCollapse(m, h) == 0)
+            ++len;
+    }
+    borHMesh3Del(m);
+    return len;
+}
+
+int main(int argc, char *argv[])
+{
+    bor_hmesh3_t *m;
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **verts, *v;
+    bor_vec3_t *coords2;
+    bor_list_t *list;
+    bor_timer_t timer;
+    bor_real_t s;
+    int *seq, len, i, rep;
+
+    if (argc != 3){
+        fprintf(stderr, "Usage: %s traverse|collapse n\n", argv[0]);
+        return -1;
+    }
+
+    n = atoi(argv[2]);
+    grid();
+
+    borTimerStart(&timer);
+    m = borHMesh3NewSoup(coords, n * n, tris, 2 * (n - 1) * (n - 1), 0);
+    borTimerStop(&timer);
+    fprintf(stdout, "hmesh3 build:     %lu us\n",
+            borTimerElapsedInUs(&timer));
+
+    coords2 = BOR_ALLOC_ARR(bor_vec3_t, n * n);
+    borTimerStart(&timer);
+    mesh = borHMesh3ToMesh3(m, coords2);
+    borTimerStop(&timer);
+    fprintf(stdout, "mesh3 build:      %lu us\n",
+            borTimerElapsedInUs(&timer));
+
+    if (strcmp(argv[1], "traverse") == 0){
+        rep = 10;
+        borTimerStart(&timer);
+        for (s = BOR_ZERO, i = 0; i < rep; i++)
+            s += traverseHMesh3(m);
+        borTimerStop(&timer);
+        fprintf(stdout, "hmesh3 traverse:  %lu us (%f)\n",
+                borTimerElapsedInUs(&timer) / rep, s);
+
+        borTimerStart(&timer);
+        for (s = BOR_ZERO, i = 0; i < rep; i++)
+            s += traverseMesh3(mesh);
+        borTimerStop(&timer);
+        fprintf(stdout, "mesh3 traverse:   %lu us (%f)\n",
+                borTimerElapsedInUs(&timer) / rep, s);
+
+    }else if (strcmp(argv[1], "collapse") == 0){
+        seq = BOR_ALLOC_ARR(int, 2 * 4 * n * n);
+        len = collapseSeq(seq);
+
+        borTimerStart(&timer);
+        for (i = 0; i < len; i++)
+            borHMesh3EdgeCollapse(m, findHE(m, seq[2 * i], seq[2 * i + 1]));
+        borTimerStop(&timer);
+        fprintf(stdout, "hmesh3 collapse:  %lu us (%d edges, %d faces)\n",
+                borTimerElapsedInUs(&timer), len, m->faces_num);
+
+        verts = BOR_ALLOC_ARR(bor_mesh3_vertex_t *, n * n);
+        list = borMesh3Vertices(mesh);
+        BOR_LIST_FOR_EACH_ENTRY(list, bor_mesh3_vertex_t, v, list)
+            verts[borMesh3VertexCoords(v) - coords2] = v;
+
+        borTimerStart(&timer);
+        for (i = 0; i < len; i++)
+            collapseMesh3(mesh, verts[seq[2 * i]], verts[seq[2 * i + 1]]);
+        borTimerStop(&timer);
+        fprintf(stdout, "mesh3 collapse:   %lu us (%d edges, %d faces)\n",
+                borTimerElapsedInUs(&timer), len,
+                (int)borMesh3FacesLen(mesh));
+
+        BOR_FREE(verts);
+        BOR_FREE(seq);
+    }else{
+        fprintf(stderr, "Unkown method!\n");
+    }
+
+    borHMesh3Mesh3Del(mesh);
+    borHMesh3Del(m);
+    BOR_FREE(coords2);
+    BOR_FREE(coords);
+    BOR_FREE(tris);
+
+    return 0;
+}
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <boruvka/imultiq.h>
+#include <boruvka/pairheap_nonintrusive_int.h>
+#include <boruvka/tasks.h>
+#include <boruvka/timer.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
+
+/**
+ * Measures throughput of bor_imultiq_t and pairing heap protected by one
+ * global mutex on "hold" workload: the queue is prefilled and then each
+ * thread repeatedly pops an element and pushes a new one with the key
+ * increased by a random value.
+ * Rank error of bor_imultiq_t is measured by logging all operations with
+ * a global timestamp and replaying them sequentially.
+ *
+ * Usage: bench-multiq [max_threads [ops_per_thread [c]]]
+ */
+
+#define PREFILL 100000
+
+struct log_op {
+    unsigned long ts;
+    int key;
+    int pop;
+};
+typedef struct log_op log_op_t;
+
+struct thread {
+    bor_rand_t rnd;
+    log_op_t *log;
+    int log_len;
+} bor_aligned(64);
+typedef struct thread thread_t;
+
+static int ops;
+static int num_threads;
+static int use_log;
+static thread_t *threads;
+static unsigned long ts;
+static bor_imultiq_t *mq;
+static bor_pairheap_nonintr_int_t *ph;
+static pthread_mutex_t ph_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void logOp(thread_t *th, int key, int pop)
+{
+    log_op_t *op = th->log + th->log_len++;
+    op->ts = __sync_fetch_and_add(&ts, 1);
+    op->key = key;
+    op->pop = pop;
+}
+
+static int randKey(thread_t *th)
+{
+    return BOR_MIN((int)borRand(&th->rnd, 1, 101), 100);
+}
+
+static void holdMultiQ(int id, void *_, const bor_tasks_thinfo_t *thinfo)
+{
+    thread_t *th = threads + id;
+    int i, key;
+
+    for (i = 0; i < ops; ++i){
+        if (borIMultiQPop(mq, id, &key, NULL) != 0)
+            key = 0;
+        if (use_log)
+            logOp(th, key, 1);
+        key += randKey(th);
+        /* Push is logged before the element can be popped by others */
+        if (use_log)
+            logOp(th, key, 0);
+        borIMultiQPush(mq, id, key, NULL);
+    }
+}
+
+static void holdPairHeap(int id, void *_, const bor_tasks_thinfo_t *thinfo)
+{
+    thread_t *th = threads + id;
+    int i, key;
+
+    for (i = 0; i < ops; ++i){
+        pthread_mutex_lock(&ph_lock);
+        borPairHeapNonIntrIntExtractMin(ph, &key);
+        pthread_mutex_unlock(&ph_lock);
+
+        key += randKey(th);
+
+        pthread_mutex_lock(&ph_lock);
+        borPairHeapNonIntrIntAdd(ph, key, NULL);
+        pthread_mutex_unlock(&ph_lock);
+    }
+}
+
+static double run(bor_tasks_fn fn)
+{
+    bor_tasks_t *tasks;
+    bor_timer_t timer;
+    int i;
+
+    tasks = borTasksNew(num_threads);
+    for (i = 0; i < num_threads; ++i)
+        borTasksAdd(tasks, fn, i, NULL);
+    borTimerStart(&timer);
+    borTasksRun(tasks);
+    borTasksDel(tasks);
+    borTimerStop(&timer);
+
+    return (double)ops * num_threads / borTimerElapsedInSF(&timer) / 1E6;
+}
+
+static int cmpTs(const void *a, const void *b)
+{
+    const log_op_t *o1 = a, *o2 = b;
+    if (o1->ts < o2->ts)
+        return -1;
+    return o1->ts > o2->ts;
+}
+
+static int cmpInt(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+/** Replays log and returns mean rank error, max is stored in {max} */
+static double rankError(log_op_t *log, int len, int *prefill, int *max)
+{
+    int *keys, keys_len, *fen, i, j, k, rank;
+    double sum = 0.;
+    long num = 0;
+
+    keys = BOR_ALLOC_ARR(int, len + PREFILL);
+    for (i = 0; i < len; ++i)
+        keys[i] = log[i].key;
+    for (i = 0; i < PREFILL; ++i)
+        keys[len + i] = prefill[i];
+    qsort(keys, len + PREFILL, sizeof(int), cmpInt);
+    for (i = 1, keys_len = 1; i < len + PREFILL; ++i){
+        if (keys[i] != keys[keys_len - 1])
+            keys[keys_len++] = keys[i];
+    }
+
+    /* Fenwick tree counting present keys */
+    fen = BOR_CALLOC_ARR(int, keys_len + 1);
+#define KEY_IDX(key) \
+    ((int *)bsearch(&(key), keys, keys_len, sizeof(int), cmpInt) - keys + 1)
+    for (i = 0; i < PREFILL; ++i){
+        for (k = KEY_IDX(prefill[i]); k <= keys_len; k += k & -k)
+            ++fen[k];
+    }
+
+    *max = 0;
+    for (i = 0; i < len; ++i){
+        j = KEY_IDX(log[i].key);
+        if (log[i].pop){
+            rank = 0;
+            for (k = j - 1; k > 0; k -= k & -k)
+                rank += fen[k];
+            sum += rank;
+            ++num;
+            *max = BOR_MAX(*max, rank);
+            for (k = j; k <= keys_len; k += k & -k)
+                --fen[k];
+        }else{
+            for (k = j; k <= keys_len; k += k & -k)
+                ++fen[k];
+        }
+    }
+#undef KEY_IDX
+
+    BOR_FREE(fen);
+    BOR_FREE(keys);
+    return sum / BOR_MAX(num, 1);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_threads = 4, c = 2, *prefill, i, t, len, max;
+    double mops_mq, mops_ph, err;
+    log_op_t *log;
+    bor_rand_t rnd;
+
+    if (argc > 1)
+        max_threads = atoi(argv[1]);
+    ops = 1000000;
+    if (argc > 2)
+        ops = atoi(argv[2]);
+    if (argc > 3)
+        c = atoi(argv[3]);
+
+    borRandInitSeed(&rnd, 1);
+    prefill = BOR_ALLOC_ARR(int, PREFILL);
+    for (i = 0; i < PREFILL; ++i)
+        prefill[i] = BOR_MIN((int)borRand(&rnd, 0, PREFILL), PREFILL - 1);
+
+    threads = BOR_ALLOC_ALIGN_ARR(thread_t, max_threads, 64);
+    printf("threads  pairheap+mutex[Mops/s]  multiq[Mops/s]"
+           "  rank-error-mean  rank-error-max\n");
+    for (num_threads = 1; num_threads <= max_threads; num_threads *= 2){
+        for (i = 0; i < num_threads; ++i)
+            borRandInitSeed(&threads[i].rnd, i + 1);
+
+        ph = borPairHeapNonIntrIntNew();
+        for (i = 0; i < PREFILL; ++i)
+            borPairHeapNonIntrIntAdd(ph, prefill[i], NULL);
+        mops_ph = run(holdPairHeap);
+        borPairHeapNonIntrIntDel(ph);
+
+        mq = borIMultiQNew(num_threads, c);
+        for (i = 0; i < PREFILL; ++i)
+            borIMultiQPush(mq, i % num_threads, prefill[i], NULL);
+        for (i = 0; i < num_threads; ++i)
+            borIMultiQFlush(mq, i);
+        use_log = 0;
+        mops_mq = run(holdMultiQ);
+        borIMultiQDel(mq);
+
+        mq = borIMultiQNew(num_threads, c);
+        for (i = 0; i < PREFILL; ++i)
+            borIMultiQPush(mq, i % num_threads, prefill[i], NULL);
+        for (i = 0; i < num_threads; ++i){
+            borIMultiQFlush(mq, i);
+            threads[i].log = BOR_ALLOC_ARR(log_op_t, 2 * ops);
+            threads[i].log_len = 0;
+            borRandInitSeed(&threads[i].rnd, i + 1);
+        }
+        use_log = 1;
+        ts = 0;
+        run(holdMultiQ);
+        borIMultiQDel(mq);
+
+        log = BOR_ALLOC_ARR(log_op_t, 2 * ops * num_threads);
+        for (len = 0, t = 0; t < num_threads; ++t){
+            for (i = 0; i < threads[t].log_len; ++i)
+                log[len++] = threads[t].log[i];
+            BOR_FREE(threads[t].log);
+        }
+        qsort(log, len, sizeof(log_op_t), cmpTs);
+        err = rankError(log, len, prefill, &max);
+        BOR_FREE(log);
+
+        printf("%7d  %22.2f  %14.2f  %15.2f  %14d\n",
+               num_threads, mops_ph, mops_mq, err, max);
+    }
+
+    BOR_FREE(threads);
+    BOR_FREE(prefill);
+    return 0;
+}
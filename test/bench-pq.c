@@ -0,0 +1,623 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <boruvka/fibo.h>
+#include <boruvka/pairheap.h>
+#include <boruvka/dheap.h>
+#include <boruvka/bucketheap.h>
+#include <boruvka/apq.h>
+#include <boruvka/ibucketq.h>
+#include <boruvka/lbucketq.h>
+#include <boruvka/pbucketq.h>
+#include <boruvka/iadaq.h>
+#include <boruvka/ladaq.h>
+#include <boruvka/padaq.h>
+#include <boruvka/iradixq.h>
+#include <boruvka/multimap_int.h>
+#include <boruvka/rand.h>
+#include <boruvka/timer.h>
+#include <boruvka/alloc.h>
+
+/**
+ * Runs the same workloads against all priority queues of the library.
+ *
+ * Workloads (n is the size parameter):
+ *   dijkstra  - Dijkstra on sqrt(n) x sqrt(n) grid with random weights
+ *               1..100
+ *   monotone  - queue with n elements, 10n times pop the minimum and push
+ *               an element with key greater by 0..1000
+ *   decrease  - n pushes, then rounds of many decrease-key operations
+ *               and few pops
+ *   sweep-R   - n random keys from [0, R) pushed and popped, for R from
+ *               16 to 2^20
+ *
+ * Queues without decrease-key get a duplicate pushed instead and stale
+ * entries are skipped on pop (lazy deletion).
+ *
+ * Each run is executed in its own process so that peak RSS can be
+ * measured. Output is one tab separated line per run:
+ *   queue workload n ops seconds ops/s peak-rss-kb check
+ * where check is a checksum of popped keys that must be the same for all
+ * queues. The only exception is "decrease" where the choice of decreased
+ * elements depends on the order in which queues pop elements with equal
+ * keys.
+ *
+ * Usage: bench-pq [queue[,queue...]|all [workload[,workload...]|all [n]]]
+ */
+
+struct _el_t {
+    int key;
+    int onq;
+    union {
+        bor_fibo_node_t fibo;
+        bor_pairheap_node_t pairheap;
+        bor_dheap_node_t dheap;
+        bor_bucketheap_node_t bucketheap;
+        bor_apq_el_t apq;
+        bor_multimap_int_node_t mm;
+        int radixq;
+    } conn;
+};
+typedef struct _el_t el_t;
+
+struct _pq_t {
+    const char *name;
+    void *(*new)(void);
+    void (*del)(void *q);
+    /** Pushes el with el->key */
+    void (*push)(void *q, el_t *el);
+    /** Pops an entry, returns NULL if the queue is empty */
+    el_t *(*pop)(void *q, int *key);
+    /** Moves el to decreased el->key, NULL if not supported */
+    void (*decrease)(void *q, el_t *el);
+};
+typedef struct _pq_t pq_t;
+
+/** Elements of the running workload, used by queues storing indexes */
+static el_t *els;
+static unsigned long ops;
+
+/*** Fibonacci heap ***/
+static int fiboLT(const bor_fibo_node_t *n1, const bor_fibo_node_t *n2,
+                  void *_)
+{
+    return bor_container_of(n1, el_t, conn.fibo)->key
+                < bor_container_of(n2, el_t, conn.fibo)->key;
+}
+
+static void *fiboNew(void)
+{
+    return borFiboNew(fiboLT, NULL);
+}
+
+static void fiboDel(void *q)
+{
+    borFiboDel(q);
+}
+
+static void fiboPush(void *q, el_t *el)
+{
+    borFiboAdd(q, &el->conn.fibo);
+}
+
+static el_t *fiboPop(void *q, int *key)
+{
+    el_t *el;
+
+    if (borFiboEmpty(q))
+        return NULL;
+    el = bor_container_of(borFiboExtractMin(q), el_t, conn.fibo);
+    *key = el->key;
+    return el;
+}
+
+static void fiboDecrease(void *q, el_t *el)
+{
+    borFiboDecreaseKey(q, &el->conn.fibo);
+}
+
+/*** Pairing heap ***/
+static int pairheapLT(const bor_pairheap_node_t *n1,
+                      const bor_pairheap_node_t *n2, void *_)
+{
+    return bor_container_of(n1, el_t, conn.pairheap)->key
+                < bor_container_of(n2, el_t, conn.pairheap)->key;
+}
+
+static void *pairheapNew(void)
+{
+    return borPairHeapNew(pairheapLT, NULL);
+}
+
+static void pairheapDel(void *q)
+{
+    borPairHeapDel(q);
+}
+
+static void pairheapPush(void *q, el_t *el)
+{
+    borPairHeapAdd(q, &el->conn.pairheap);
+}
+
+static el_t *pairheapPop(void *q, int *key)
+{
+    el_t *el;
+
+    if (borPairHeapEmpty(q))
+        return NULL;
+    el = bor_container_of(borPairHeapExtractMin(q), el_t, conn.pairheap);
+    *key = el->key;
+    return el;
+}
+
+static void pairheapDecrease(void *q, el_t *el)
+{
+    borPairHeapDecreaseKey(q, &el->conn.pairheap);
+}
+
+/*** d-ary heap ***/
+static void *dheapNew(void)
+{
+    return borDHeapNew(4);
+}
+
+static void dheapDel(void *q)
+{
+    borDHeapDel(q);
+}
+
+static void dheapPush(void *q, el_t *el)
+{
+    borDHeapAdd(q, &el->conn.dheap, el->key);
+}
+
+static el_t *dheapPop(void *q, int *key)
+{
+    bor_dheap_node_t *n;
+    bor_real_t k;
+
+    if (borDHeapEmpty(q))
+        return NULL;
+    n = borDHeapExtractMin(q, &k);
+    *key = k;
+    return bor_container_of(n, el_t, conn.dheap);
+}
+
+static void dheapDecrease(void *q, el_t *el)
+{
+    borDHeapDecreaseKey(q, &el->conn.dheap, el->key);
+}
+
+/*** Bucket heap ***/
+static void *bucketheapNew(void)
+{
+    return borBucketHeapNew();
+}
+
+static void bucketheapDel(void *q)
+{
+    borBucketHeapDel(q);
+}
+
+static void bucketheapPush(void *q, el_t *el)
+{
+    borBucketHeapAdd(q, el->key, &el->conn.bucketheap);
+}
+
+static el_t *bucketheapPop(void *q, int *key)
+{
+    if (borBucketHeapEmpty(q))
+        return NULL;
+    return bor_container_of(borBucketHeapExtractMin(q, key),
+                            el_t, conn.bucketheap);
+}
+
+static void bucketheapDecrease(void *q, el_t *el)
+{
+    borBucketHeapDecreaseKey(q, &el->conn.bucketheap, el->key);
+}
+
+/*** Adaptive priority queue ***/
+static void *apqNew(void)
+{
+    bor_apq_t *q = BOR_ALLOC(bor_apq_t);
+    borAPQInit(q);
+    return q;
+}
+
+static void apqDel(void *q)
+{
+    borAPQFree(q);
+    BOR_FREE(q);
+}
+
+static void apqPush(void *q, el_t *el)
+{
+    borAPQPush(q, el->key, &el->conn.apq);
+}
+
+static el_t *apqPop(void *q, int *key)
+{
+    if (borAPQIsEmpty(q))
+        return NULL;
+    return bor_container_of(borAPQPop(q, key), el_t, conn.apq);
+}
+
+static void apqDecrease(void *q, el_t *el)
+{
+    borAPQUpdate(q, el->key, &el->conn.apq);
+}
+
+/*** Multimap with FIFO and LIFO extraction ***/
+static void *mmNew(void)
+{
+    return borMultiMapIntNew();
+}
+
+static void mmDel(void *q)
+{
+    borMultiMapIntDel(q);
+}
+
+static void mmPush(void *q, el_t *el)
+{
+    borMultiMapIntInsert(q, el->key, &el->conn.mm);
+}
+
+static el_t *mmPopFifo(void *q, int *key)
+{
+    if (borMultiMapIntEmpty(q))
+        return NULL;
+    return bor_container_of(borMultiMapIntExtractMinNodeFifo(q, key),
+                            el_t, conn.mm);
+}
+
+static el_t *mmPopLifo(void *q, int *key)
+{
+    if (borMultiMapIntEmpty(q))
+        return NULL;
+    return bor_container_of(borMultiMapIntExtractMinNodeLifo(q, key),
+                            el_t, conn.mm);
+}
+
+static void mmDecrease(void *q, el_t *el)
+{
+    borMultiMapIntRemove(q, &el->conn.mm);
+    borMultiMapIntInsert(q, el->key, &el->conn.mm);
+}
+
+/*** Radix heap ***/
+static void *iradixqNew(void)
+{
+    bor_iradixq_t *q = BOR_ALLOC(bor_iradixq_t);
+    borIRadixQInit(q);
+    return q;
+}
+
+static void iradixqDel(void *q)
+{
+    borIRadixQFree(q);
+    BOR_FREE(q);
+}
+
+static void iradixqPush(void *q, el_t *el)
+{
+    el->conn.radixq = borIRadixQPush(q, el->key, el - els);
+}
+
+static el_t *iradixqPop(void *q, int *key)
+{
+    el_t *el;
+    long k;
+
+    if (borIRadixQIsEmpty(q))
+        return NULL;
+    el = els + borIRadixQPop(q, &k);
+    *key = k;
+    return el;
+}
+
+static void iradixqDecrease(void *q, el_t *el)
+{
+    borIRadixQDecreaseKey(q, el->conn.radixq, el->key);
+}
+
+/*** Bucket queues and adaptive queues without decrease-key ***/
+#define VAL_QUEUE(prefix, Prefix, TYPE, TOVAL, TOEL) \
+static void *prefix##New(void) \
+{ \
+    bor_##prefix##_t *q = BOR_ALLOC(bor_##prefix##_t); \
+    bor##Prefix##Init(q); \
+    return q; \
+} \
+static void prefix##Del(void *q) \
+{ \
+    bor##Prefix##Free(q); \
+    BOR_FREE(q); \
+} \
+static void prefix##Push(void *q, el_t *el) \
+{ \
+    bor##Prefix##Push(q, el->key, (TYPE)(TOVAL)); \
+} \
+static el_t *prefix##Pop(void *q, int *key) \
+{ \
+    TYPE v; \
+    if (bor##Prefix##IsEmpty(q)) \
+        return NULL; \
+    v = bor##Prefix##Pop(q, key); \
+    return (TOEL); \
+}
+
+VAL_QUEUE(ibucketq, IBucketQ, int, el - els, els + v)
+VAL_QUEUE(lbucketq, LBucketQ, long, el - els, els + v)
+VAL_QUEUE(pbucketq, PBucketQ, void *, el, (el_t *)v)
+VAL_QUEUE(iadaq, IAdaQ, int, el - els, els + v)
+VAL_QUEUE(ladaq, LAdaQ, long, el - els, els + v)
+VAL_QUEUE(padaq, PAdaQ, void *, el, (el_t *)v)
+
+#define PQ(name, prefix, dec) \
+    { name, prefix##New, prefix##Del, prefix##Push, prefix##Pop, dec }
+static pq_t pqs[] = {
+    PQ("fibo", fibo, fiboDecrease),
+    PQ("pairheap", pairheap, pairheapDecrease),
+    PQ("dheap4", dheap, dheapDecrease),
+    PQ("bucketheap", bucketheap, bucketheapDecrease),
+    PQ("apq", apq, apqDecrease),
+    { "multimap-fifo", mmNew, mmDel, mmPush, mmPopFifo, mmDecrease },
+    { "multimap-lifo", mmNew, mmDel, mmPush, mmPopLifo, mmDecrease },
+    PQ("iradixq", iradixq, iradixqDecrease),
+    PQ("ibucketq", ibucketq, NULL),
+    PQ("lbucketq", lbucketq, NULL),
+    PQ("pbucketq", pbucketq, NULL),
+    PQ("iadaq", iadaq, NULL),
+    PQ("ladaq", ladaq, NULL),
+    PQ("padaq", padaq, NULL),
+    { NULL, NULL, NULL, NULL, NULL, NULL },
+};
+
+
+/*** Operations with lazy deletion for queues without decrease-key ***/
+static void push(const pq_t *pq, void *q, el_t *el, int key)
+{
+    el->key = key;
+    el->onq = 1;
+    pq->push(q, el);
+    ++ops;
+}
+
+static el_t *pop(const pq_t *pq, void *q, int *key)
+{
+    el_t *el;
+
+    while ((el = pq->pop(q, key)) != NULL){
+        ++ops;
+        if (pq->decrease != NULL || (el->onq && el->key == *key)){
+            *key = el->key;
+            el->onq = 0;
+            return el;
+        }
+    }
+    return NULL;
+}
+
+static void decrease(const pq_t *pq, void *q, el_t *el, int key)
+{
+    el->key = key;
+    if (pq->decrease != NULL){
+        pq->decrease(q, el);
+    }else{
+        pq->push(q, el);
+    }
+    ++ops;
+}
+
+
+/*** Workloads ***/
+static unsigned long dijkstra(const pq_t *pq, void *q, int n)
+{
+    int w, *weight, i, u, v, d, key, dir;
+    unsigned long check = 0;
+    bor_rand_t rnd;
+    el_t *el;
+    static const int dx[4] = { 1, -1, 0, 0 };
+    static const int dy[4] = { 0, 0, 1, -1 };
+
+    for (w = 1; (w + 1) * (w + 1) <= n; ++w);
+    n = w * w;
+    els = BOR_CALLOC_ARR(el_t, n);
+    weight = BOR_ALLOC_ARR(int, 4 * n);
+    borRandInitSeed(&rnd, 1);
+    for (i = 0; i < 4 * n; ++i)
+        weight[i] = BOR_MIN((int)borRand(&rnd, 1, 101), 100);
+    for (i = 0; i < n; ++i)
+        els[i].key = -1;
+
+    push(pq, q, els, 0);
+    while ((el = pop(pq, q, &key)) != NULL){
+        u = el - els;
+        check += key;
+        for (dir = 0; dir < 4; ++dir){
+            if (u % w + dx[dir] < 0 || u % w + dx[dir] >= w
+                    || u / w + dy[dir] < 0 || u / w + dy[dir] >= w)
+                continue;
+            v = u + dx[dir] + dy[dir] * w;
+            d = key + weight[4 * u + dir];
+            if (els[v].key < 0){
+                push(pq, q, els + v, d);
+            }else if (els[v].onq && d < els[v].key){
+                decrease(pq, q, els + v, d);
+            }
+        }
+    }
+
+    BOR_FREE(weight);
+    return check;
+}
+
+static unsigned long monotone(const pq_t *pq, void *q, int n)
+{
+    unsigned long check = 0;
+    bor_rand_t rnd;
+    el_t *el;
+    int i, key;
+
+    els = BOR_CALLOC_ARR(el_t, n);
+    borRandInitSeed(&rnd, 2);
+    for (i = 0; i < n; ++i)
+        push(pq, q, els + i, BOR_MIN((int)borRand(&rnd, 0, n), n - 1));
+
+    for (i = 0; i < 10 * n; ++i){
+        el = pop(pq, q, &key);
+        check += key;
+        push(pq, q, el, key + BOR_MIN((int)borRand(&rnd, 0, 1001), 1000));
+    }
+    while ((el = pop(pq, q, &key)) != NULL)
+        check += key;
+
+    return check;
+}
+
+static unsigned long decreaseKey(const pq_t *pq, void *q, int n)
+{
+    unsigned long check = 0;
+    bor_rand_t rnd;
+    el_t *el;
+    int i, j, key, last = 0;
+
+    els = BOR_CALLOC_ARR(el_t, n);
+    borRandInitSeed(&rnd, 3);
+    for (i = 0; i < n; ++i)
+        push(pq, q, els + i, BOR_MIN((int)borRand(&rnd, 0, 10 * n),
+                                     10 * n - 1));
+
+    do {
+        for (j = 0; j < 100; ++j){
+            i = BOR_MIN((int)borRand(&rnd, 0, n), n - 1);
+            if (!els[i].onq)
+                continue;
+            /* Keys never drop below the last popped key, so monotone
+             * queues can be used too */
+            key = els[i].key - BOR_MIN((int)borRand(&rnd, 1, 1001), 1000);
+            key = BOR_MAX(key, last);
+            if (key < els[i].key)
+                decrease(pq, q, els + i, key);
+        }
+
+        for (j = 0; j < 10 && (el = pop(pq, q, &key)) != NULL; ++j){
+            check += key;
+            last = key;
+        }
+    } while (j == 10);
+
+    return check;
+}
+
+static unsigned long sweep(const pq_t *pq, void *q, int n, int range)
+{
+    unsigned long check = 0;
+    bor_rand_t rnd;
+    int i, key;
+
+    els = BOR_CALLOC_ARR(el_t, n);
+    borRandInitSeed(&rnd, 4);
+    for (i = 0; i < n; ++i)
+        push(pq, q, els + i, BOR_MIN((int)borRand(&rnd, 0, range), range - 1));
+    while (pop(pq, q, &key) != NULL)
+        check += key;
+
+    return check;
+}
+
+static void run(const pq_t *pq, const char *workload, int n)
+{
+    bor_timer_t timer;
+    struct rusage usg;
+    unsigned long check = 0;
+    void *q;
+    int range;
+
+    ops = 0;
+    q = pq->new();
+    borTimerStart(&timer);
+    if (strcmp(workload, "dijkstra") == 0){
+        check = dijkstra(pq, q, n);
+    }else if (strcmp(workload, "monotone") == 0){
+        check = monotone(pq, q, n);
+    }else if (strcmp(workload, "decrease") == 0){
+        check = decreaseKey(pq, q, n);
+    }else if (strncmp(workload, "sweep-", 6) == 0){
+        range = atoi(workload + 6);
+        check = sweep(pq, q, n, range);
+    }
+    borTimerStop(&timer);
+    getrusage(RUSAGE_SELF, &usg);
+
+    printf("%s\t%s\t%d\t%lu\t%.6f\t%.0f\t%ld\t%lu\n",
+           pq->name, workload, n, ops,
+           (double)borTimerElapsedInSF(&timer),
+           ops / (double)borTimerElapsedInSF(&timer),
+           (long)usg.ru_maxrss, check);
+    fflush(stdout);
+
+    pq->del(q);
+    BOR_FREE(els);
+}
+
+static int inList(const char *list, const char *name)
+{
+    size_t len = strlen(name);
+    const char *s;
+
+    if (strcmp(list, "all") == 0)
+        return 1;
+    for (s = strstr(list, name); s != NULL; s = strstr(s + 1, name)){
+        if ((s == list || s[-1] == ',') && (s[len] == ',' || s[len] == 0))
+            return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *queues = "all", *workloads = "all";
+    static const char *ws[] = { "dijkstra", "monotone", "decrease",
+                                "sweep-16", "sweep-256", "sweep-4096",
+                                "sweep-65536", "sweep-1048576", NULL };
+    int n = 1000000, i, j, status;
+    pid_t pid;
+
+    if (argc > 1)
+        queues = argv[1];
+    if (argc > 2)
+        workloads = argv[2];
+    if (argc > 3)
+        n = atoi(argv[3]);
+
+    printf("queue\tworkload\tn\tops\tseconds\tops/s\tpeak-rss-kb\tcheck\n");
+    fflush(stdout);
+    for (j = 0; ws[j] != NULL; ++j){
+        if (!inList(workloads, ws[j]))
+            continue;
+        for (i = 0; pqs[i].name != NULL; ++i){
+            if (!inList(queues, pqs[i].name))
+                continue;
+
+            pid = fork();
+            if (pid == 0){
+                run(pqs + i, ws[j], n);
+                exit(0);
+            }else if (pid < 0){
+                perror("fork");
+                return -1;
+            }
+            waitpid(pid, &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                fprintf(stderr, "%s %s: failed\n", pqs[i].name, ws[j]);
+        }
+    }
+
+    return 0;
+}
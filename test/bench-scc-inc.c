@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <boruvka/scc-inc.h>
+#include <boruvka/timer.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
+#include "data.h"
+
+/**
+ * Compares bor_scc_inc_t with recomputation of all components by
+ * borDigraphSCC() after each batch of inserted edges. Edges are inserted
+ * into an empty graph in batches of 1, 10, 100, ... edges on two
+ * workloads:
+ *   - random: uniformly random edges,
+ *   - dag: edges go from lower to higher node IDs except for a small
+ *     fraction of random edges, so components stay small.
+ * Recomputation is timed only on SAMPLES evenly spaced batches and its
+ * total time is extrapolated. The number of components is compared on
+ * the same batches.
+ *
+ * Usage: bench-scc-inc [nodes [edges [back_edge_ratio]]]
+ */
+
+#define SAMPLES 50
+
+static void genEdges(int nodes, int edges, double back, int *from, int *to,
+                     bor_rand_t *rnd)
+{
+    int i, tmp;
+
+    for (i = 0; i < edges; ++i){
+        from[i] = testRandIdx(rnd, nodes);
+        to[i] = testRandIdx(rnd, nodes);
+        if (from[i] > to[i] && borRand(rnd, 0, 1) >= back)
+            BOR_SWAP(from[i], to[i], tmp);
+    }
+}
+
+static void bench(const char *name, int nodes, int edges,
+                  const int *from, const int *to, int batch)
+{
+    bor_scc_inc_t inc;
+    bor_digraph_t g, scc;
+    bor_timer_t timer;
+    double inc_time, full_time;
+    int num_batches, step, samples, b, i, start, len;
+
+    num_batches = (edges + batch - 1) / batch;
+    step = BOR_MAX(num_batches / SAMPLES, 1);
+
+    borDigraphInit(&g);
+    for (i = 0; i < nodes; ++i)
+        borDigraphAddNode(&g);
+    borSCCIncInit(&inc, nodes);
+
+    inc_time = full_time = 0.;
+    samples = 0;
+    for (b = 0; b < num_batches; ++b){
+        start = b * batch;
+        len = BOR_MIN(batch, edges - start);
+
+        borTimerStart(&timer);
+        if (len == 1){
+            borSCCIncAddEdge(&inc, from[start], to[start]);
+        }else{
+            borSCCIncAddEdges(&inc, from + start, to + start, len);
+        }
+        borTimerStop(&timer);
+        inc_time += borTimerElapsedInSF(&timer);
+
+        for (i = start; i < start + len; ++i)
+            borDigraphAddEdge(&g, from[i], to[i]);
+        if (b % step == step - 1 || b == num_batches - 1){
+            borTimerStart(&timer);
+            borDigraphSCC(&scc, &g);
+            borTimerStop(&timer);
+            full_time += borTimerElapsedInSF(&timer);
+            ++samples;
+
+            if (scc.node_size != inc.comp_size){
+                fprintf(stderr, "Error: %s: %d components instead of %d"
+                        " after batch %d.\n", name, inc.comp_size,
+                        scc.node_size, b);
+                exit(-1);
+            }
+            borDigraphFree(&scc);
+        }
+    }
+    full_time = full_time / samples * num_batches;
+
+    printf("%s\t%d\t%d\t%d\t%d\t%.4f\t%.4f\t%.2f\n",
+           name, nodes, edges, batch, inc.comp_size,
+           inc_time, full_time, full_time / inc_time);
+
+    borSCCIncFree(&inc);
+    borDigraphFree(&g);
+}
+
+int main(int argc, char *argv[])
+{
+    int nodes = 10000, edges = 50000;
+    double back = 0.01;
+    int *from, *to, batch;
+    bor_rand_t rnd;
+
+    if (argc > 1)
+        nodes = atoi(argv[1]);
+    if (argc > 2)
+        edges = atoi(argv[2]);
+    if (argc > 3)
+        back = atof(argv[3]);
+
+    from = BOR_ALLOC_ARR(int, edges);
+    to = BOR_ALLOC_ARR(int, edges);
+    borRandInitSeed(&rnd, 1);
+    printf("graph\tnodes\tedges\tbatch\tcomps\tincremental[s]"
+           "\trecompute[s]\tspeedup\n");
+
+    genEdges(nodes, edges, 1., from, to, &rnd);
+    for (batch = 1; batch <= edges; batch *= 10)
+        bench("random", nodes, edges, from, to, batch);
+
+    genEdges(nodes, edges, back, from, to, &rnd);
+    for (batch = 1; batch <= edges; batch *= 10)
+        bench("dag", nodes, edges, from, to, batch);
+
+    BOR_FREE(from);
+    BOR_FREE(to);
+    return 0;
+}
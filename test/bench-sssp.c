@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <boruvka/sssp.h>
+#include <boruvka/timer.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
+#include "data.h"
+
+/**
+ * Compares borSSSPDijkstra() with borSSSPDeltaStep() for several values
+ * of delta and numbers of threads on two synthetic graphs:
+ *   - grid: 2D grid with edges in both directions and weights in
+ *     [1, 100],
+ *   - power-law: preferential attachment graph (each new node connects
+ *     to {deg} nodes chosen with probability proportional to their
+ *     degree) with edges in both directions and weights in [1, 100].
+ * Each run is checked against distances from Dijkstra's algorithm.
+ *
+ * Usage: bench-sssp [max_threads [grid_size [power_law_nodes [deg]]]]
+ */
+
+#define MAX_WEIGHT 100
+#define RUNS 3
+
+static int *weights(const bor_digraph_t *g, bor_rand_t *rnd)
+{
+    int i, *weight;
+
+    weight = BOR_ALLOC_ARR(int, g->edge_size);
+    for (i = 0; i < g->edge_size; ++i)
+        weight[i] = 1 + testRandIdx(rnd, MAX_WEIGHT);
+    return weight;
+}
+
+static void addEdge2(bor_digraph_t *g, int a, int b)
+{
+    borDigraphAddEdge(g, a, b);
+    borDigraphAddEdge(g, b, a);
+}
+
+static void powerLawGraph(bor_digraph_t *g, int nodes, int deg,
+                          bor_rand_t *rnd)
+{
+    int *end, end_len, i, j, u;
+
+    borDigraphInit(g);
+    /* end holds endpoints of all edges, so a uniformly chosen element
+     * is a node chosen proportionally to its degree */
+    end = BOR_ALLOC_ARR(int, 2 * (long)nodes * deg + 2);
+    end_len = 0;
+
+    borDigraphAddNode(g);
+    borDigraphAddNode(g);
+    addEdge2(g, 0, 1);
+    end[end_len++] = 0;
+    end[end_len++] = 1;
+    for (i = 2; i < nodes; ++i){
+        borDigraphAddNode(g);
+        for (j = 0; j < deg; ++j){
+            u = end[testRandIdx(rnd, end_len)];
+            addEdge2(g, i, u);
+            end[end_len++] = u;
+        }
+        for (j = 0; j < deg; ++j)
+            end[end_len++] = i;
+    }
+    BOR_FREE(end);
+}
+
+static void bench(const char *name, const bor_digraph_t *dg,
+                  int max_threads, bor_rand_t *rnd)
+{
+    static const int delta_mul[] = { 0, 1, 4, 16 };
+    bor_sssp_graph_t g;
+    bor_timer_t timer;
+    long *dist, *dist2;
+    int *weight, *src, i, d, t, delta;
+    double ref;
+
+    weight = weights(dg, rnd);
+    borSSSPGraphInit(&g, dg, weight);
+    BOR_FREE(weight);
+
+    src = BOR_ALLOC_ARR(int, RUNS);
+    for (i = 0; i < RUNS; ++i)
+        src[i] = testRandIdx(rnd, g.node_size);
+    dist = BOR_ALLOC_ARR(long, (long)g.node_size * RUNS);
+    dist2 = BOR_ALLOC_ARR(long, g.node_size);
+
+    borTimerStart(&timer);
+    for (i = 0; i < RUNS; ++i)
+        borSSSPDijkstra(&g, src[i], dist + (long)i * g.node_size);
+    borTimerStop(&timer);
+    ref = borTimerElapsedInSF(&timer) / RUNS;
+    printf("%s\t%d\t%d\tdijkstra\t-\t1\t%.4f\t1.00\n",
+           name, g.node_size, g.edge_size, ref);
+
+    for (d = 0; d < (int)(sizeof(delta_mul) / sizeof(int)); ++d){
+        for (t = 1; t <= max_threads; t *= 2){
+            /* 0 means default delta, otherwise multiples of 10 */
+            delta = delta_mul[d] * 10;
+
+            borTimerStart(&timer);
+            for (i = 0; i < RUNS; ++i){
+                borSSSPDeltaStep(&g, src[i], delta, t, dist2);
+                if (memcmp(dist + (long)i * g.node_size, dist2,
+                           sizeof(long) * g.node_size) != 0){
+                    fprintf(stderr, "Error: %s: delta-stepping with"
+                            " delta %d and %d threads differs from"
+                            " Dijkstra.\n", name, delta, t);
+                    exit(-1);
+                }
+            }
+            borTimerStop(&timer);
+
+            printf("%s\t%d\t%d\tdelta-step\t%d\t%d\t%.4f\t%.2f\n",
+                   name, g.node_size, g.edge_size, delta, t,
+                   borTimerElapsedInSF(&timer) / RUNS,
+                   ref / (borTimerElapsedInSF(&timer) / RUNS));
+        }
+    }
+
+    BOR_FREE(src);
+    BOR_FREE(dist);
+    BOR_FREE(dist2);
+    borSSSPGraphFree(&g);
+}
+
+int main(int argc, char *argv[])
+{
+    int max_threads = 4, grid = 1000, pl = 1000000, deg = 4;
+    bor_digraph_t g;
+    bor_rand_t rnd;
+
+    if (argc > 1)
+        max_threads = atoi(argv[1]);
+    if (argc > 2)
+        grid = atoi(argv[2]);
+    if (argc > 3)
+        pl = atoi(argv[3]);
+    if (argc > 4)
+        deg = atoi(argv[4]);
+
+    borRandInitSeed(&rnd, 1);
+    printf("graph\tnodes\tedges\talgorithm\tdelta\tthreads"
+           "\ttime[s]\tspeedup\n");
+
+    testGridDigraph(&g, grid);
+    bench("grid", &g, max_threads, &rnd);
+    borDigraphFree(&g);
+
+    powerLawGraph(&g, pl, deg, &rnd);
+    bench("power-law", &g, max_threads, &rnd);
+    borDigraphFree(&g);
+
+    return 0;
+}
@@ -0,0 +1,394 @@
+#include <cu/cu.h>
+#include <boruvka/bvh3.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
+#include <boruvka/dbg.h>
+
+/** Creates wavy grid of n x n cells shifted by {z} */
+static bor_mesh3_t *grid(int n, bor_real_t z, bor_vec3_t **coords)
+{
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **v, *w[3];
+    bor_mesh3_edge_t *e[3];
+    bor_mesh3_face_t *f;
+    int i, j, k, l, tri[6];
+    bor_real_t x, y;
+
+    tri[0] = 0;
+    tri[1] = 1;
+    tri[2] = n + 2;
+    tri[3] = 0;
+    tri[4] = n + 2;
+    tri[5] = n + 1;
+
+    mesh = borMesh3New();
+    *coords = borVec3ArrNew((n + 1) * (n + 1));
+    v = BOR_ALLOC_ARR(bor_mesh3_vertex_t *, (n + 1) * (n + 1));
+    for (i = 0; i < (n + 1) * (n + 1); i++){
+        x = (bor_real_t)(i % (n + 1)) / n;
+        y = (bor_real_t)(i / (n + 1)) / n;
+        borVec3Set(*coords + i, x, y, z + 0.1 * sin(7. * x) * cos(5. * y));
+        v[i] = borMesh3VertexAlloc(mesh);
+        borMesh3VertexSetCoords(v[i], *coords + i);
+        borMesh3AddVertex(mesh, v[i]);
+    }
+
+    for (i = 0; i < n; i++){
+        for (j = 0; j < n; j++){
+            for (k = 0; k < 2; k++){
+                for (l = 0; l < 3; l++)
+                    w[l] = v[i * (n + 1) + j + tri[3 * k + l]];
+                for (l = 0; l < 3; l++){
+                    e[l] = borMesh3VertexCommonEdge(w[l], w[(l + 1) % 3]);
+                    if (!e[l]){
+                        e[l] = borMesh3EdgeAlloc(mesh);
+                        borMesh3AddEdge(mesh, e[l], w[l], w[(l + 1) % 3]);
+                    }
+                }
+                f = borMesh3FaceAlloc(mesh);
+                borMesh3AddFace(mesh, f, e[0], e[1], e[2]);
+            }
+        }
+    }
+
+    BOR_FREE(v);
+    return mesh;
+}
+
+static void faceTri(bor_mesh3_face_t *f, const bor_vec3_t **t)
+{
+    bor_mesh3_vertex_t *vs[3];
+    int i;
+
+    borMesh3FaceVertices(f, vs);
+    for (i = 0; i < 3; i++)
+        t[i] = borMesh3VertexCoords(vs[i]);
+}
+
+static void checkTree(const bor_bvh3_t *bvh, int faces_len)
+{
+    const bor_bvh3_node_t *n, *c;
+    int *used, i, j, k, l;
+
+    assertEquals(bvh->faces_len, faces_len);
+    used = BOR_CALLOC_ARR(int, faces_len);
+    for (i = 0; i < bvh->nodes_len; i++){
+        n = bvh->nodes + i;
+        if (n->len > 0){
+            assertTrue(n->first >= 0 && n->first + n->len <= faces_len);
+            for (j = n->first; j < n->first + n->len; j++){
+                ++used[j];
+                for (k = 0; k < 3; k++){
+                    for (l = 0; l < 3; l++){
+                        assertTrue(borVec3Get(bvh->tris[3 * j + l], k)
+                                        >= n->lo[k]);
+                        assertTrue(borVec3Get(bvh->tris[3 * j + l], k)
+                                        <= n->hi[k]);
+                    }
+                }
+            }
+        }else{
+            // children are stored after parent
+            assertTrue(n->first > i && n->first + 1 < bvh->nodes_len);
+            for (j = 0; j < 2; j++){
+                c = bvh->nodes + n->first + j;
+                for (k = 0; k < 3; k++){
+                    assertTrue(c->lo[k] >= n->lo[k]);
+                    assertTrue(c->hi[k] <= n->hi[k]);
+                }
+            }
+        }
+    }
+
+    for (i = 0; i < faces_len; i++)
+        assertEquals(used[i], 1);
+    BOR_FREE(used);
+}
+
+static bor_real_t closestBrute(bor_mesh3_t *mesh, const bor_vec3_t *p)
+{
+    bor_list_t *item;
+    const bor_vec3_t *t[3];
+    bor_real_t best = BOR_REAL_MAX, d;
+
+    BOR_LIST_FOR_EACH(&mesh->faces, item){
+        faceTri(BOR_LIST_ENTRY(item, bor_mesh3_face_t, list), t);
+        d = borVec3PointTriDist2(p, t[0], t[1], t[2], NULL);
+        best = BOR_MIN(best, d);
+    }
+    return best;
+}
+
+static bor_real_t rayBrute(bor_mesh3_t *mesh, const bor_vec3_t *o,
+                           const bor_vec3_t *dir)
+{
+    bor_list_t *item;
+    const bor_vec3_t *t[3];
+    bor_vec3_t u, v, n, q;
+    bor_real_t best = BOR_REAL_MAX, d, nd;
+
+    BOR_LIST_FOR_EACH(&mesh->faces, item){
+        faceTri(BOR_LIST_ENTRY(item, bor_mesh3_face_t, list), t);
+        borVec3Sub2(&u, t[1], t[0]);
+        borVec3Sub2(&v, t[2], t[0]);
+        borVec3Cross(&n, &u, &v);
+        nd = borVec3Dot(&n, dir);
+        if (BOR_FABS(nd) < 1E-12)
+            continue;
+        borVec3Sub2(&u, t[0], o);
+        d = borVec3Dot(&n, &u) / nd;
+        if (d < 0. || d >= best)
+            continue;
+        borVec3Scale2(&q, dir, d);
+        borVec3Add(&q, o);
+        if (borVec3PointTriDist2(&q, t[0], t[1], t[2], NULL) < 1E-8)
+            best = d;
+    }
+    return best;
+}
+
+TEST(bvh3Build)
+{
+    bor_mesh3_t *mesh;
+    bor_vec3_t *coords;
+    bor_bvh3_t *bvh;
+
+    mesh = grid(30, 0., &coords);
+    bvh = borBVH3New(mesh, 1);
+    checkTree(bvh, 1800);
+    assertTrue(bvh->depth < 30);
+    borBVH3Del(bvh);
+    borMesh3Del(mesh);
+    borVec3ArrDel(coords);
+
+    // subtrees are built in parallel
+    mesh = grid(100, 0., &coords);
+    bvh = borBVH3New(mesh, 4);
+    checkTree(bvh, 20000);
+    assertTrue(bvh->depth < 40);
+    borBVH3Del(bvh);
+    borMesh3Del(mesh);
+    borVec3ArrDel(coords);
+
+    // empty mesh
+    mesh = borMesh3New();
+    bvh = borBVH3New(mesh, 1);
+    assertEquals(bvh->nodes_len, 0);
+    assertEquals(borBVH3ClosestPoint(bvh, bor_vec3_origin, NULL, NULL),
+                 BOR_REAL_MAX);
+    borBVH3Del(bvh);
+    borMesh3Del(mesh);
+}
+
+static void checkQueries(bor_mesh3_t *mesh, bor_bvh3_t *bvh, int seed)
+{
+    bor_rand_t rnd;
+    bor_vec3_t p, w, dir, a, b, c;
+    const bor_vec3_t *t[3];
+    bor_mesh3_face_t *face;
+    bor_list_t *item;
+    bor_real_t d, d2, len;
+    int i, hit, hit2, miss;
+
+    borRandInitSeed(&rnd, seed);
+    miss = 0;
+    for (i = 0; i < 300; i++){
+        borVec3Set(&p, borRand(&rnd, -0.5, 1.5), borRand(&rnd, -0.5, 1.5),
+                       borRand(&rnd, -1., 1.));
+        face = NULL;
+        d = borBVH3ClosestPoint(bvh, &p, &w, &face);
+        d2 = closestBrute(mesh, &p);
+        assertTrue(BOR_FABS(d - d2) < 1E-5);
+        assertNotEquals(face, NULL);
+        faceTri(face, t);
+        assertTrue(BOR_FABS(borVec3PointTriDist2(&p, t[0], t[1], t[2], NULL)
+                                - d) < 1E-5);
+        assertTrue(BOR_FABS(borVec3Dist2(&p, &w) - d) < 1E-5);
+    }
+
+    for (i = 0; i < 300; i++){
+        borVec3Set(&p, borRand(&rnd, 0., 1.), borRand(&rnd, 0., 1.),
+                       borRand(&rnd, 0.5, 1.));
+        borVec3Set(&dir, borRand(&rnd, -1., 1.), borRand(&rnd, -1., 1.),
+                         borRand(&rnd, -1., 0.1));
+        len = 10.;
+        hit = borBVH3Ray(bvh, &p, &dir, &len, &face);
+        d = rayBrute(mesh, &p, &dir);
+        if (hit){
+            // the hit point lies on the face
+            borVec3Scale2(&w, &dir, len);
+            borVec3Add(&w, &p);
+            faceTri(face, t);
+            assertTrue(borVec3PointTriDist2(&w, t[0], t[1], t[2], NULL)
+                            < 1E-6);
+            assertTrue(BOR_FABS(d - len) < 1E-4);
+        }else{
+            ++miss;
+            assertTrue(d > 10.);
+        }
+    }
+    assertTrue(miss < 300);
+
+    for (i = 0; i < 300; i++){
+        borVec3Set(&a, borRand(&rnd, 0., 1.), borRand(&rnd, 0., 1.),
+                       borRand(&rnd, -0.2, 0.2));
+        borVec3Set(&b, borRand(&rnd, -0.05, 0.05), borRand(&rnd, -0.05, 0.05),
+                       borRand(&rnd, -0.05, 0.05));
+        borVec3Add(&b, &a);
+        borVec3Set(&c, borRand(&rnd, -0.05, 0.05), borRand(&rnd, -0.05, 0.05),
+                       borRand(&rnd, -0.05, 0.05));
+        borVec3Add(&c, &a);
+
+        face = NULL;
+        hit = borBVH3TriOverlap(bvh, &a, &b, &c, &face);
+        hit2 = 0;
+        BOR_LIST_FOR_EACH(&mesh->faces, item){
+            faceTri(BOR_LIST_ENTRY(item, bor_mesh3_face_t, list), t);
+            if (borVec3TriTriOverlap(&a, &b, &c, t[0], t[1], t[2]))
+                hit2 = 1;
+        }
+        assertEquals(hit, hit2);
+        if (hit){
+            faceTri(face, t);
+            assertTrue(borVec3TriTriOverlap(&a, &b, &c, t[0], t[1], t[2]));
+        }
+    }
+}
+
+TEST(bvh3Query)
+{
+    bor_mesh3_t *mesh;
+    bor_vec3_t *coords;
+    bor_bvh3_t *bvh;
+
+    mesh = grid(25, 0., &coords);
+    bvh = borBVH3New(mesh, 1);
+    checkQueries(mesh, bvh, 1);
+    borBVH3Del(bvh);
+    borMesh3Del(mesh);
+    borVec3ArrDel(coords);
+}
+
+TEST(bvh3Refit)
+{
+    bor_mesh3_t *mesh;
+    bor_vec3_t *coords;
+    bor_bvh3_t *bvh;
+    int i;
+
+    mesh = grid(25, 0., &coords);
+    bvh = borBVH3New(mesh, 1);
+
+    for (i = 0; i < 26 * 26; i++){
+        borVec3Set(coords + i, borVec3X(coords + i) * 1.2,
+                   borVec3Y(coords + i) + 0.1 * borVec3X(coords + i),
+                   borVec3Z(coords + i) * 2.);
+    }
+    borBVH3Refit(bvh);
+    checkTree(bvh, 25 * 25 * 2);
+    checkQueries(mesh, bvh, 2);
+
+    borBVH3Del(bvh);
+    borMesh3Del(mesh);
+    borVec3ArrDel(coords);
+}
+
+static int overlapCount(bor_mesh3_face_t *f1, bor_mesh3_face_t *f2,
+                        void *data)
+{
+    const bor_vec3_t *t1[3], *t2[3];
+
+    faceTri(f1, t1);
+    faceTri(f2, t2);
+    assertTrue(borVec3TriTriOverlap(t1[0], t1[1], t1[2],
+                                    t2[0], t2[1], t2[2]));
+    ++*(int *)data;
+    return 0;
+}
+
+static int overlapStop(bor_mesh3_face_t *f1, bor_mesh3_face_t *f2,
+                       void *data)
+{
+    return 1;
+}
+
+TEST(bvh3MeshMesh)
+{
+    bor_mesh3_t *mesh1, *mesh2;
+    bor_vec3_t *coords1, *coords2, w1, w2;
+    bor_bvh3_t *bvh1, *bvh2;
+    bor_mesh3_face_t *f1, *f2;
+    bor_list_t *item1, *item2;
+    const bor_vec3_t *t1[3], *t2[3];
+    bor_real_t d, best;
+    int i, num, brute;
+
+    mesh1 = grid(20, 0., &coords1);
+    mesh2 = grid(15, 0.05, &coords2);
+    // second grid is rotated so that the meshes cross each other
+    for (i = 0; i < 16 * 16; i++){
+        borVec3Set(coords2 + i, borVec3Y(coords2 + i),
+                   borVec3X(coords2 + i) * 0.8 + 0.1,
+                   borVec3Z(coords2 + i));
+    }
+    bvh1 = borBVH3New(mesh1, 1);
+    bvh2 = borBVH3New(mesh2, 1);
+
+    brute = 0;
+    BOR_LIST_FOR_EACH(&mesh1->faces, item1){
+        faceTri(BOR_LIST_ENTRY(item1, bor_mesh3_face_t, list), t1);
+        BOR_LIST_FOR_EACH(&mesh2->faces, item2){
+            faceTri(BOR_LIST_ENTRY(item2, bor_mesh3_face_t, list), t2);
+            if (borVec3TriTriOverlap(t1[0], t1[1], t1[2],
+                                     t2[0], t2[1], t2[2]))
+                ++brute;
+        }
+    }
+    assertTrue(brute > 0);
+
+    num = 0;
+    assertEquals(borBVH3Overlap(bvh1, bvh2, overlapCount, &num), brute);
+    assertEquals(num, brute);
+    assertEquals(borBVH3Overlap(bvh1, bvh2, overlapStop, NULL), 1);
+    assertEquals(borBVH3Overlap(bvh1, bvh2, NULL, NULL), brute);
+    d = borBVH3Dist2(bvh1, bvh2, &w1, &w2, &f1, &f2);
+    assertEquals(d, BOR_ZERO);
+    assertTrue(borVec3Dist2(&w1, &w2) < 1E-10);
+
+    // move the second mesh away
+    for (i = 0; i < 16 * 16; i++)
+        borVec3Set(coords2 + i, borVec3X(coords2 + i),
+                   borVec3Y(coords2 + i), borVec3Z(coords2 + i) + 0.3);
+    borBVH3Refit(bvh2);
+    assertEquals(borBVH3Overlap(bvh1, bvh2, NULL, NULL), 0);
+
+    best = BOR_REAL_MAX;
+    BOR_LIST_FOR_EACH(&mesh1->faces, item1){
+        faceTri(BOR_LIST_ENTRY(item1, bor_mesh3_face_t, list), t1);
+        BOR_LIST_FOR_EACH(&mesh2->faces, item2){
+            faceTri(BOR_LIST_ENTRY(item2, bor_mesh3_face_t, list), t2);
+            for (i = 0; i < 3; i++){
+                d = borVec3PointTriDist2(t1[i], t2[0], t2[1], t2[2], NULL);
+                best = BOR_MIN(best, d);
+                d = borVec3PointTriDist2(t2[i], t1[0], t1[1], t1[2], NULL);
+                best = BOR_MIN(best, d);
+            }
+        }
+    }
+
+    d = borBVH3Dist2(bvh1, bvh2, &w1, &w2, &f1, &f2);
+    assertTrue(d > 0.);
+    assertTrue(d <= best + 1E-6);
+    assertTrue(BOR_FABS(borVec3Dist2(&w1, &w2) - d) < 1E-5);
+    faceTri(f1, t1);
+    faceTri(f2, t2);
+    assertTrue(borVec3PointTriDist2(&w1, t1[0], t1[1], t1[2], NULL) < 1E-8);
+    assertTrue(borVec3PointTriDist2(&w2, t2[0], t2[1], t2[2], NULL) < 1E-8);
+
+    borBVH3Del(bvh1);
+    borBVH3Del(bvh2);
+    borMesh3Del(mesh1);
+    borMesh3Del(mesh2);
+    borVec3ArrDel(coords1);
+    borVec3ArrDel(coords2);
+}
@@ -0,0 +1,17 @@
+#ifndef TEST_BVH3_H
+#define TEST_BVH3_H
+
+TEST(bvh3Build);
+TEST(bvh3Query);
+TEST(bvh3Refit);
+TEST(bvh3MeshMesh);
+
+TEST_SUITE(TSBVH3) {
+    TEST_ADD(bvh3Build),
+    TEST_ADD(bvh3Query),
+    TEST_ADD(bvh3Refit),
+    TEST_ADD(bvh3MeshMesh),
+    TEST_SUITE_CLOSURE
+};
+
+#endif
@@ -2,6 +2,8 @@
 #include <stdarg.h>
 #include <boruvka/chull3.h>
 #include <boruvka/dbg.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
 #include "data.h"
 
 static void check(bor_chull3_t *h, int num, ...)
@@ -924,3 +926,210 @@ TEST(testCHullBunny)
 
     borCHull3Del(h);
 }
+
+static int hasVertex(bor_chull3_t *h, const bor_vec3_t *v)
+{
+    bor_list_t *list, *item;
+    bor_mesh3_vertex_t *mv;
+
+    list = borMesh3Vertices(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        if (borVec3Eq(mv->v, v))
+            return 1;
+    }
+    return 0;
+}
+
+/** Checks that hull is closed and all points lie inside */
+static void checkBuild(bor_chull3_t *h, const bor_vec3_t *pts, size_t n)
+{
+    bor_list_t *list, *item;
+    bor_mesh3_face_t *f;
+    bor_mesh3_vertex_t *v[3], *mv;
+    bor_vec3_t center;
+    bor_real_t vol;
+    size_t i, outside = 0;
+
+    assertEquals(borMesh3VerticesLen(h->mesh)
+                    - borMesh3EdgesLen(h->mesh)
+                    + borMesh3FacesLen(h->mesh), 2);
+
+    list = borMesh3Edges(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        assertEquals(borMesh3EdgeFacesLen(
+                        BOR_LIST_ENTRY(item, bor_mesh3_edge_t, list)), 2);
+    }
+
+    // center of hull lies inside
+    borVec3Set(&center, 0., 0., 0.);
+    list = borMesh3Vertices(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        borVec3Add(&center, mv->v);
+    }
+    borVec3Scale(&center, BOR_ONE / borMesh3VerticesLen(h->mesh));
+
+    list = borMesh3Faces(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        f = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+        borMesh3FaceVertices(f, v);
+
+        // all points must be on the same side of each face as center
+        vol = borVec3Volume6(v[0]->v, v[1]->v, v[2]->v, &center);
+        for (i = 0; i < n; i++){
+            if (vol >= BOR_ZERO){
+                if (borVec3Volume6(v[0]->v, v[1]->v, v[2]->v, &pts[i])
+                        < -BOR_REAL(1E-4))
+                    ++outside;
+            }else{
+                if (borVec3Volume6(v[0]->v, v[1]->v, v[2]->v, &pts[i])
+                        > BOR_REAL(1E-4))
+                    ++outside;
+            }
+        }
+    }
+    assertEquals(outside, 0);
+}
+
+TEST(testCHullBuild)
+{
+    bor_chull3_t *h, *h2;
+    bor_vec3_t *pts;
+    bor_list_t *list, *item;
+    bor_mesh3_vertex_t *mv;
+    bor_rand_t r;
+    size_t i, n;
+
+    // bunny -- same result as incremental algorithm
+    h = borCHull3New();
+    for (i = 0; i < bunny_coords_len; i++)
+        borCHull3Add(h, &bunny_coords[i]);
+    h2 = borCHull3Build(bunny_coords, bunny_coords_len);
+
+    assertEquals(borCHull3NumPoints(h), borCHull3NumPoints(h2));
+    list = borMesh3Vertices(h2->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        assertTrue(hasVertex(h, mv->v));
+    }
+    checkBuild(h2, bunny_coords, bunny_coords_len);
+    borCHull3Del(h);
+    borCHull3Del(h2);
+
+    // points in ball, points on sphere and duplicates
+    n = 5000;
+    pts = BOR_ALLOC_ARR(bor_vec3_t, n);
+    borRandInitSeed(&r, 1);
+    for (i = 0; i < n; i++){
+        if (i % 10 == 9){
+            borVec3Copy(&pts[i], &pts[i / 2]);
+            continue;
+        }
+
+        borVec3Set(&pts[i], borRand(&r, -1., 1.), borRand(&r, -1., 1.),
+                            borRand(&r, -1., 1.));
+        if (i % 5 == 0){
+            borVec3Normalize(&pts[i]);
+        }else{
+            borVec3Scale(&pts[i], 0.5);
+        }
+    }
+    h = borCHull3Build(pts, n);
+    checkBuild(h, pts, n);
+    list = borMesh3Vertices(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        assertTrue(borEq(borVec3Len2(mv->v), BOR_ONE)
+                    || borVec3Len2(mv->v) > BOR_REAL(0.99));
+    }
+    // all elements of the mesh come from its pools, so they are released
+    // at once
+    assertEquals(borPoolLen(h->mesh->verts_pool), borMesh3VerticesLen(h->mesh));
+    assertEquals(borPoolLen(h->mesh->edges_pool), borMesh3EdgesLen(h->mesh));
+    assertEquals(borPoolLen(h->mesh->faces_pool), borMesh3FacesLen(h->mesh));
+    borCHull3Del(h);
+
+    // coplanar points
+    for (i = 0; i < 100; i++)
+        borVec3Set(&pts[i], borRand(&r, -1., 1.), borRand(&r, -1., 1.), 0.);
+    borVec3Set(&pts[0], -2., -2., 0.);
+    borVec3Set(&pts[1], 2., -2., 0.);
+    borVec3Set(&pts[2], 2., 2., 0.);
+    borVec3Set(&pts[3], -2., 2., 0.);
+    h = borCHull3Build(pts, 100);
+    for (i = 0; i < 4; i++)
+        assertTrue(hasVertex(h, &pts[i]));
+    borCHull3Del(h);
+
+    BOR_FREE(pts);
+}
+
+TEST(testCHullBuildParallel)
+{
+    bor_chull3_t *h, *h2;
+    bor_vec3_t *pts;
+    bor_list_t *list, *item;
+    bor_mesh3_vertex_t *mv;
+    bor_rand_t r;
+    size_t i, n;
+    int threads;
+
+    for (threads = 1; threads <= 4; threads += 3){
+        // bunny -- same result as incremental algorithm
+        h = borCHull3Build(bunny_coords, bunny_coords_len);
+        h2 = borCHull3BuildParallel(bunny_coords, bunny_coords_len, threads);
+        assertEquals(borCHull3NumPoints(h), borCHull3NumPoints(h2));
+        list = borMesh3Vertices(h2->mesh);
+        BOR_LIST_FOR_EACH(list, item){
+            mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+            assertTrue(hasVertex(h, mv->v));
+        }
+        checkBuild(h2, bunny_coords, bunny_coords_len);
+        borCHull3Del(h);
+        borCHull3Del(h2);
+    }
+
+    // points in ball, points on sphere and duplicates
+    n = 5000;
+    pts = BOR_ALLOC_ARR(bor_vec3_t, n);
+    borRandInitSeed(&r, 2);
+    for (i = 0; i < n; i++){
+        if (i % 10 == 9){
+            borVec3Copy(&pts[i], &pts[i / 2]);
+            continue;
+        }
+
+        borVec3Set(&pts[i], borRand(&r, -1., 1.), borRand(&r, -1., 1.),
+                            borRand(&r, -1., 1.));
+        if (i % 5 == 0){
+            borVec3Normalize(&pts[i]);
+        }else{
+            borVec3Scale(&pts[i], 0.5);
+        }
+    }
+
+    h = borCHull3BuildParallel(pts, n, 3);
+    checkBuild(h, pts, n);
+    list = borMesh3Vertices(h->mesh);
+    BOR_LIST_FOR_EACH(list, item){
+        mv = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        assertTrue(borVec3Len2(mv->v) > BOR_REAL(0.99));
+    }
+
+    // hull can be further extended incrementally
+    borVec3Set(&pts[0], 2., 2., 2.);
+    borCHull3Add(h, &pts[0]);
+    assertTrue(hasVertex(h, &pts[0]));
+    checkBuild(h, pts, n);
+    borCHull3Del(h);
+
+    // points on grid -- lot of coplanar faces
+    for (i = 0; i < 1000; i++)
+        borVec3Set(&pts[i], i % 10, (i / 10) % 10, i / 100);
+    h = borCHull3BuildParallel(pts, 1000, 2);
+    checkBuild(h, pts, 1000);
+    borCHull3Del(h);
+
+    BOR_FREE(pts);
+}
@@ -10,6 +10,8 @@ TEST(testCHull6);
 TEST(testCHull7);
 TEST(testCHull8);
 TEST(testCHullBunny);
+TEST(testCHullBuild);
+TEST(testCHullBuildParallel);
 
 TEST_SUITE(TSCHull3){
     TEST_ADD(testCHull),
@@ -21,6 +23,8 @@ TEST_SUITE(TSCHull3){
     TEST_ADD(testCHull7),
     TEST_ADD(testCHull8),
     TEST_ADD(testCHullBunny),
+    TEST_ADD(testCHullBuild),
+    TEST_ADD(testCHullBuildParallel),
 
     TEST_SUITE_CLOSURE
 };
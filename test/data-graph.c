@@ -0,0 +1,51 @@
+#include <stdio.h>
+#include <boruvka/alloc.h>
+#include "data.h"
+
+int testRandIdx(bor_rand_t *rnd, int len)
+{
+    return BOR_MIN((int)borRand(rnd, 0, len), len - 1);
+}
+
+void testRandDigraph(bor_digraph_t *g, int nodes, int edges, int dag,
+                     bor_rand_t *rnd)
+{
+    int i, u, v, tmp;
+
+    borDigraphInit(g);
+    for (i = 0; i < nodes; ++i)
+        borDigraphAddNode(g);
+
+    for (i = 0; i < edges; ++i){
+        u = testRandIdx(rnd, nodes);
+        v = testRandIdx(rnd, nodes);
+        if (dag && u < v)
+            BOR_SWAP(u, v, tmp);
+        if (dag && u == v)
+            continue;
+        borDigraphAddEdge(g, u, v);
+    }
+}
+
+void testGridDigraph(bor_digraph_t *g, int size)
+{
+    int x, y, i;
+
+    borDigraphInit(g);
+    for (i = 0; i < size * size; ++i)
+        borDigraphAddNode(g);
+
+    for (y = 0; y < size; ++y){
+        for (x = 0; x < size; ++x){
+            i = y * size + x;
+            if (x < size - 1){
+                borDigraphAddEdge(g, i, i + 1);
+                borDigraphAddEdge(g, i + 1, i);
+            }
+            if (y < size - 1){
+                borDigraphAddEdge(g, i, i + size);
+                borDigraphAddEdge(g, i + size, i);
+            }
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#include <boruvka/quat.h>
+
+bor_quat_t quats[] = {
+    BOR_QUAT_STATIC(1.594992, 1.700655, 1.385374, -0.466335),
+    BOR_QUAT_STATIC(-0.142541, 1.183630, -0.509468, 0.997455),
+    BOR_QUAT_STATIC(-0.074318, -0.653835, -0.175407, -1.533962),
+    BOR_QUAT_STATIC(-0.582013, -0.339222, -1.927346, -1.311704),
+    BOR_QUAT_STATIC(-0.959068, 1.431536, 0.358309, -0.851420),
+    BOR_QUAT_STATIC(1.990907, -0.968318, 0.055153, 0.958079),
+    BOR_QUAT_STATIC(0.765282, -0.265989, 1.107991, -0.056824),
+    BOR_QUAT_STATIC(0.861860, -0.034494, 1.885979, 0.864720),
+    BOR_QUAT_STATIC(-1.634491, -1.482119, 1.866059, -1.083086),
+    BOR_QUAT_STATIC(-1.895456, -0.987105, -0.080852, 1.808674),
+    BOR_QUAT_STATIC(-0.403480, 0.894022, 1.337450, -1.643352),
+    BOR_QUAT_STATIC(0.447568, 1.983137, 0.198384, 0.137945),
+    BOR_QUAT_STATIC(-0.613190, 1.784422, 1.878397, -1.587321),
+    BOR_QUAT_STATIC(0.211335, -0.321483, 0.686585, -1.525413),
+    BOR_QUAT_STATIC(-0.938663, -0.884986, -0.081148, 1.173131),
+    BOR_QUAT_STATIC(1.431390, 1.145695, 0.707227, -1.651229),
+    BOR_QUAT_STATIC(-0.441132, 0.674806, -0.823009, 0.031274),
+    BOR_QUAT_STATIC(1.620313, -1.535372, 1.415507, -1.576681),
+    BOR_QUAT_STATIC(-0.454542, 1.621558, -1.195200, 0.082971),
+    BOR_QUAT_STATIC(-0.333584, 1.551789, 1.968259, -0.845630),
+    BOR_QUAT_STATIC(-0.030094, 1.580021, 0.179183, -1.141500),
+    BOR_QUAT_STATIC(1.038649, -0.651643, -0.056103, -1.965752),
+    BOR_QUAT_STATIC(1.955868, 0.629129, 1.703251, 1.874741),
+    BOR_QUAT_STATIC(-0.929865, 0.162144, -0.238995, 1.039421),
+    BOR_QUAT_STATIC(1.369543, -1.085759, -0.901741, 0.825046),
+    BOR_QUAT_STATIC(-0.353428, -1.479194, -1.218758, 0.243397),
+    BOR_QUAT_STATIC(0.393978, 1.840286, 0.131120, 0.435923),
+    BOR_QUAT_STATIC(-1.404581, -0.344792, -0.880835, 0.781691),
+    BOR_QUAT_STATIC(-0.931771, -1.142399, -0.529262, -0.117804),
+    BOR_QUAT_STATIC(-0.646420, 0.422929, -1.275185, 1.519641),
+    BOR_QUAT_STATIC(0.776685, 0.139053, -1.767351, -0.695973),
+    BOR_QUAT_STATIC(0.760429, 0.580257, 1.247817, 1.566034),
+    BOR_QUAT_STATIC(-0.738535, -0.025077, -0.679834, -1.488311),
+    BOR_QUAT_STATIC(-1.439532, -0.974122, -1.647885, 0.155302),
+    BOR_QUAT_STATIC(0.811690, 0.252290, 0.739067, -1.095008),
+    BOR_QUAT_STATIC(-1.202383, 0.270299, 1.537142, -0.310942),
+    BOR_QUAT_STATIC(-1.983053, -1.919794, -0.778782, 0.461497),
+    BOR_QUAT_STATIC(-1.661738, -1.101959, 0.722762, 1.939968),
+    BOR_QUAT_STATIC(-0.635709, 0.404556, 0.073719, -1.907501),
+    BOR_QUAT_STATIC(-0.680662, -1.442235, -0.996713, 1.079924),
+    BOR_QUAT_STATIC(0.724810, -1.835908, -1.690500, 0.899717),
+    BOR_QUAT_STATIC(-1.587161, -0.731920, -0.922649, -1.800934),
+    BOR_QUAT_STATIC(-1.875320, -1.443861, -0.402691, 1.734823),
+    BOR_QUAT_STATIC(0.553513, -1.031756, 0.718577, -0.905467),
+    BOR_QUAT_STATIC(0.060952, -0.712689, 1.794684, -0.590550),
+    BOR_QUAT_STATIC(1.214251, 0.564772, 1.373302, 0.424641),
+    BOR_QUAT_STATIC(1.481540, -0.379348, 0.716011, 0.482549),
+    BOR_QUAT_STATIC(0.110935, 0.257760, 0.143048, -0.424917),
+    BOR_QUAT_STATIC(1.593278, 0.530918, 0.196492, -1.784244),
+    BOR_QUAT_STATIC(0.034112, -1.299413, -1.139907, -0.261551),
+    BOR_QUAT_STATIC(0.183827, -0.998351, -0.916262, 0.120585),
+    BOR_QUAT_STATIC(-0.107064, -0.386850, -1.584986, -0.506089),
+    BOR_QUAT_STATIC(0.617685, 0.176796, 0.179011, 1.375272),
+    BOR_QUAT_STATIC(0.892652, 0.738357, -1.878345, -0.767488),
+    BOR_QUAT_STATIC(0.729649, -1.376909, 1.653892, -1.432294),
+    BOR_QUAT_STATIC(1.516486, -1.134927, 1.366359, 1.392919),
+    BOR_QUAT_STATIC(-0.658141, 1.554369, -1.360929, 1.396438),
+    BOR_QUAT_STATIC(-0.473062, -0.241130, -1.528561, 0.404021),
+    BOR_QUAT_STATIC(-0.920977, 0.667517, 1.197552, 0.414736),
+    BOR_QUAT_STATIC(-1.967261, 1.809341, 1.678725, 0.571741),
+    BOR_QUAT_STATIC(-0.481975, 0.247655, 1.531248, -0.161885),
+    BOR_QUAT_STATIC(1.116873, 0.394236, -0.310883, 1.734106),
+    BOR_QUAT_STATIC(-0.366276, 0.423116, -1.786903, -0.116945),
+    BOR_QUAT_STATIC(-1.850343, 0.816531, -1.997639, -1.831738),
+    BOR_QUAT_STATIC(-1.555498, -1.441700, 0.032313, -0.574846),
+    BOR_QUAT_STATIC(-0.916387, 1.934494, 1.636000, 0.619449),
+    BOR_QUAT_STATIC(1.208348, 1.278833, -1.019306, 1.233144),
+    BOR_QUAT_STATIC(-1.040754, 0.249426, -0.569132, -1.365363),
+    BOR_QUAT_STATIC(1.107418, 1.665367, -0.745206, 1.519050),
+    BOR_QUAT_STATIC(-0.614976, 0.630221, 1.983158, 1.088283),
+    BOR_QUAT_STATIC(-1.777331, -0.260509, -0.494787, -0.824273),
+    BOR_QUAT_STATIC(1.264542, -0.235919, 0.796961, 0.539725),
+    BOR_QUAT_STATIC(0.075983, -1.775875, 0.692141, 1.565532),
+    BOR_QUAT_STATIC(-1.311202, 0.570978, -0.050243, -0.636062),
+    BOR_QUAT_STATIC(0.841707, 1.900796, -1.913341, 1.589223),
+    BOR_QUAT_STATIC(-0.467045, 1.335393, -1.301154, 0.866366),
+    BOR_QUAT_STATIC(-1.601214, -0.657559, 1.879635, 0.626462),
+    BOR_QUAT_STATIC(1.138095, -0.154778, -0.115332, -0.029499),
+    BOR_QUAT_STATIC(1.092621, 0.892999, -1.224928, -0.237582),
+    BOR_QUAT_STATIC(0.168096, 0.285715, 1.707084, 1.358989),
+    BOR_QUAT_STATIC(-1.400475, -0.495517, -1.564110, -1.895105),
+    BOR_QUAT_STATIC(-1.701656, -1.268138, 1.064309, 0.668886),
+    BOR_QUAT_STATIC(1.191484, -0.845986, -1.377956, 1.888401),
+    BOR_QUAT_STATIC(1.304100, 1.787128, -1.924852, -0.413810),
+    BOR_QUAT_STATIC(0.535193, 0.944298, 1.650602, 0.150927),
+    BOR_QUAT_STATIC(-0.436830, -1.978704, 1.215453, 1.928632),
+    BOR_QUAT_STATIC(1.628986, 0.649074, -0.630098, -1.043399),
+    BOR_QUAT_STATIC(1.100079, 1.741717, 1.841304, -1.297570),
+    BOR_QUAT_STATIC(0.341411, 0.052473, -0.290299, 1.177603),
+    BOR_QUAT_STATIC(1.743130, 0.898499, 0.801223, 0.762458),
+    BOR_QUAT_STATIC(0.614227, 0.147016, -1.008337, 1.117908),
+    BOR_QUAT_STATIC(-1.523626, 0.575553, -0.452051, 0.239850),
+    BOR_QUAT_STATIC(0.565745, -0.084306, 1.912376, -1.043228),
+    BOR_QUAT_STATIC(-1.951327, 1.821032, -0.751969, -0.887710),
+    BOR_QUAT_STATIC(-0.337764, 0.379867, 1.944458, 0.830099),
+    BOR_QUAT_STATIC(-0.726719, 0.138753, -0.205258, 0.006348),
+    BOR_QUAT_STATIC(-0.329567, -1.329529, -0.418064, -0.443644),
+    BOR_QUAT_STATIC(-1.197122, 1.267675, -0.560036, -1.394054),
+    BOR_QUAT_STATIC(0.267497, 1.379374, 1.122244, 0.488161),
+    BOR_QUAT_STATIC(0.924152, -0.655542, -1.429154, -0.979961),
+};
+size_t quats_len = sizeof(quats) / sizeof(bor_quat_t);
@@ -0,0 +1,105 @@
+#include <boruvka/vec2.h>
+
+bor_vec2_t vecs2[] = {
+    BOR_VEC2_STATIC(-1.462543, 1.389735),
+    BOR_VEC2_STATIC(1.055098, -0.979724),
+    BOR_VEC2_STATIC(-0.018260, -0.202036),
+    BOR_VEC2_STATIC(0.606372, 1.154893),
+    BOR_VEC2_STATIC(-1.624562, -1.886610),
+    BOR_VEC2_STATIC(1.343060, -0.268932),
+    BOR_VEC2_STATIC(1.049120, -1.991576),
+    BOR_VEC2_STATIC(-0.218451, 0.886160),
+    BOR_VEC2_STATIC(-1.084951, 1.781083),
+    BOR_VEC2_STATIC(1.605710, -1.877640),
+    BOR_VEC2_STATIC(-1.898217, 0.165650),
+    BOR_VEC2_STATIC(1.756597, -0.475183),
+    BOR_VEC2_STATIC(-1.133602, -0.311534),
+    BOR_VEC2_STATIC(-1.883837, -1.113233),
+    BOR_VEC2_STATIC(-0.248450, -0.016751),
+    BOR_VEC2_STATIC(-1.067662, -1.076534),
+    BOR_VEC2_STATIC(-1.124876, -0.161586),
+    BOR_VEC2_STATIC(-0.840874, -1.914041),
+    BOR_VEC2_STATIC(1.350312, 0.225817),
+    BOR_VEC2_STATIC(0.569177, -1.256375),
+    BOR_VEC2_STATIC(1.970174, 1.439786),
+    BOR_VEC2_STATIC(-1.516440, -0.669219),
+    BOR_VEC2_STATIC(0.885938, 0.844767),
+    BOR_VEC2_STATIC(1.745762, -0.311572),
+    BOR_VEC2_STATIC(1.320143, 0.681222),
+    BOR_VEC2_STATIC(-0.786526, 0.350322),
+    BOR_VEC2_STATIC(1.529916, 1.384790),
+    BOR_VEC2_STATIC(0.021135, 0.356009),
+    BOR_VEC2_STATIC(-1.861897, -1.029040),
+    BOR_VEC2_STATIC(1.189617, -0.342744),
+    BOR_VEC2_STATIC(-1.307970, 0.195195),
+    BOR_VEC2_STATIC(0.812163, 0.697943),
+    BOR_VEC2_STATIC(-0.501188, -0.244153),
+    BOR_VEC2_STATIC(0.033706, 1.113770),
+    BOR_VEC2_STATIC(0.083754, -0.426980),
+    BOR_VEC2_STATIC(-0.041226, -1.881700),
+    BOR_VEC2_STATIC(-1.826051, 0.813528),
+    BOR_VEC2_STATIC(1.932751, 0.372735),
+    BOR_VEC2_STATIC(-0.425601, -1.318603),
+    BOR_VEC2_STATIC(0.008954, 1.928307),
+    BOR_VEC2_STATIC(1.082093, 0.158470),
+    BOR_VEC2_STATIC(1.441159, -1.071295),
+    BOR_VEC2_STATIC(0.055087, 1.809870),
+    BOR_VEC2_STATIC(0.311179, -0.163473),
+    BOR_VEC2_STATIC(-0.922882, 0.191985),
+    BOR_VEC2_STATIC(1.828465, -1.977163),
+    BOR_VEC2_STATIC(1.134621, 1.281944),
+    BOR_VEC2_STATIC(1.544718, 0.962014),
+    BOR_VEC2_STATIC(1.236560, 0.074713),
+    BOR_VEC2_STATIC(0.245431, -0.295637),
+    BOR_VEC2_STATIC(-1.775507, 1.480041),
+    BOR_VEC2_STATIC(0.279997, -1.200642),
+    BOR_VEC2_STATIC(0.018882, -0.060300),
+    BOR_VEC2_STATIC(-0.572840, -0.615688),
+    BOR_VEC2_STATIC(0.153915, 0.493958),
+    BOR_VEC2_STATIC(0.449810, -0.167413),
+    BOR_VEC2_STATIC(-1.888100, -1.081580),
+    BOR_VEC2_STATIC(-1.291155, 0.337843),
+    BOR_VEC2_STATIC(1.444035, 1.193756),
+    BOR_VEC2_STATIC(1.188390, 1.265749),
+    BOR_VEC2_STATIC(-0.978824, 1.366979),
+    BOR_VEC2_STATIC(0.692454, -1.667063),
+    BOR_VEC2_STATIC(-1.933237, -1.941760),
+    BOR_VEC2_STATIC(1.022347, -1.001763),
+    BOR_VEC2_STATIC(-1.562045, 0.499208),
+    BOR_VEC2_STATIC(-0.622309, -1.721938),
+    BOR_VEC2_STATIC(-1.361498, 0.109522),
+    BOR_VEC2_STATIC(-1.327420, -0.908342),
+    BOR_VEC2_STATIC(0.846360, -0.181193),
+    BOR_VEC2_STATIC(-0.711993, -0.104916),
+    BOR_VEC2_STATIC(-1.905462, -0.453772),
+    BOR_VEC2_STATIC(-0.316325, -1.247843),
+    BOR_VEC2_STATIC(-1.564953, 1.599274),
+    BOR_VEC2_STATIC(0.040464, -1.163636),
+    BOR_VEC2_STATIC(0.422595, 1.268159),
+    BOR_VEC2_STATIC(-1.916728, -1.928542),
+    BOR_VEC2_STATIC(-1.414153, 0.875342),
+    BOR_VEC2_STATIC(-1.359090, 0.818423),
+    BOR_VEC2_STATIC(0.712703, 0.178809),
+    BOR_VEC2_STATIC(-1.117601, 1.902378),
+    BOR_VEC2_STATIC(1.191243, 0.066398),
+    BOR_VEC2_STATIC(-1.107217, 0.594026),
+    BOR_VEC2_STATIC(-0.420408, 0.303384),
+    BOR_VEC2_STATIC(-0.715017, 0.523791),
+    BOR_VEC2_STATIC(-1.764860, -0.805576),
+    BOR_VEC2_STATIC(1.871613, 1.502137),
+    BOR_VEC2_STATIC(-0.774454, 1.434058),
+    BOR_VEC2_STATIC(-0.758545, 1.757154),
+    BOR_VEC2_STATIC(0.975368, -0.335311),
+    BOR_VEC2_STATIC(-0.990568, -1.966079),
+    BOR_VEC2_STATIC(1.514872, -1.848334),
+    BOR_VEC2_STATIC(1.277656, 1.848805),
+    BOR_VEC2_STATIC(0.281122, -1.313932),
+    BOR_VEC2_STATIC(1.471124, 1.895101),
+    BOR_VEC2_STATIC(0.816093, 0.035495),
+    BOR_VEC2_STATIC(-0.488125, -0.612276),
+    BOR_VEC2_STATIC(-1.176953, 0.696612),
+    BOR_VEC2_STATIC(-0.268200, -1.223525),
+    BOR_VEC2_STATIC(-1.582303, 0.663830),
+    BOR_VEC2_STATIC(-0.815709, -0.000800),
+};
+size_t vecs2_len = sizeof(vecs2) / sizeof(bor_vec2_t);
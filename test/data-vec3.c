@@ -0,0 +1,105 @@
+#include <boruvka/vec3.h>
+
+bor_vec3_t vecs[] = {
+    BOR_VEC3_STATIC(-0.698617, 1.486486, 1.598713),
+    BOR_VEC3_STATIC(-1.927628, -1.196588, -0.689037),
+    BOR_VEC3_STATIC(1.948199, 1.130802, -0.643617),
+    BOR_VEC3_STATIC(-1.147881, 0.697820, 1.350804),
+    BOR_VEC3_STATIC(1.728750, -0.624601, 1.529573),
+    BOR_VEC3_STATIC(0.748441, -0.062005, 1.942033),
+    BOR_VEC3_STATIC(-1.061438, 0.901861, -1.661279),
+    BOR_VEC3_STATIC(-1.321223, 1.643951, -1.148127),
+    BOR_VEC3_STATIC(1.036465, 0.400835, 1.364529),
+    BOR_VEC3_STATIC(-0.527568, -0.638859, -0.835139),
+    BOR_VEC3_STATIC(1.469679, 0.415930, 1.817230),
+    BOR_VEC3_STATIC(1.549060, -1.458616, 0.204682),
+    BOR_VEC3_STATIC(-1.582900, -1.843449, -1.707226),
+    BOR_VEC3_STATIC(1.464673, 1.152466, 1.314024),
+    BOR_VEC3_STATIC(-0.636410, 0.460744, 1.127614),
+    BOR_VEC3_STATIC(-0.487841, 0.283126, -1.105144),
+    BOR_VEC3_STATIC(-1.673027, -0.933105, 1.563073),
+    BOR_VEC3_STATIC(0.257787, 1.700269, -0.168923),
+    BOR_VEC3_STATIC(-0.891269, 1.148059, 1.311073),
+    BOR_VEC3_STATIC(-1.950473, 0.681647, -1.633268),
+    BOR_VEC3_STATIC(-1.539590, 1.540240, -1.839906),
+    BOR_VEC3_STATIC(-1.041467, 1.952634, -0.315946),
+    BOR_VEC3_STATIC(-1.537767, -1.330466, -1.034319),
+    BOR_VEC3_STATIC(0.976026, -1.588663, 1.643058),
+    BOR_VEC3_STATIC(-0.486891, 1.881056, 1.636891),
+    BOR_VEC3_STATIC(-0.823906, -0.986359, -0.091960),
+    BOR_VEC3_STATIC(-1.599483, 0.608201, -1.841519),
+    BOR_VEC3_STATIC(-1.957975, 1.930335, -0.817801),
+    BOR_VEC3_STATIC(0.386283, -0.200622, -0.746877),
+    BOR_VEC3_STATIC(-1.748141, 1.653568, 1.879253),
+    BOR_VEC3_STATIC(1.879186, -1.554551, -1.139227),
+    BOR_VEC3_STATIC(0.471228, 1.919812, 0.171653),
+    BOR_VEC3_STATIC(0.752759, 0.647338, -0.963656),
+    BOR_VEC3_STATIC(0.166409, -0.770716, -1.014475),
+    BOR_VEC3_STATIC(-1.674525, -0.876853, 1.933507),
+    BOR_VEC3_STATIC(-0.208391, 0.608042, 0.573864),
+    BOR_VEC3_STATIC(1.762938, -0.438086, -0.772863),
+    BOR_VEC3_STATIC(-0.691034, -0.733059, 1.388539),
+    BOR_VEC3_STATIC(1.574001, -0.788763, -0.662666),
+    BOR_VEC3_STATIC(0.176902, 0.315942, 0.383850),
+    BOR_VEC3_STATIC(-1.019608, -1.918504, -1.024963),
+    BOR_VEC3_STATIC(-1.710690, 0.204819, -1.716335),
+    BOR_VEC3_STATIC(-1.699481, 0.541528, -0.836714),
+    BOR_VEC3_STATIC(1.168739, -0.026956, 1.450596),
+    BOR_VEC3_STATIC(-1.383282, 0.005718, 1.179934),
+    BOR_VEC3_STATIC(-1.691572, 1.796912, -1.307032),
+    BOR_VEC3_STATIC(1.104836, 1.939583, 1.286201),
+    BOR_VEC3_STATIC(-0.720864, -1.572489, 0.057433),
+    BOR_VEC3_STATIC(1.677428, -0.826042, 1.575035),
+    BOR_VEC3_STATIC(-1.433277, 1.641927, -1.872960),
+    BOR_VEC3_STATIC(-0.735725, 1.612353, 1.215425),
+    BOR_VEC3_STATIC(1.628615, 1.362874, 0.984740),
+    BOR_VEC3_STATIC(0.758381, -1.287381, -0.269448),
+    BOR_VEC3_STATIC(-1.368412, 0.859298, 0.671115),
+    BOR_VEC3_STATIC(-0.989654, -1.742343, 1.853544),
+    BOR_VEC3_STATIC(1.233011, 0.197080, 0.165511),
+    BOR_VEC3_STATIC(1.405171, -0.186761, -0.417158),
+    BOR_VEC3_STATIC(-0.645323, -0.968124, -1.902366),
+    BOR_VEC3_STATIC(0.585755, -0.333264, 0.282415),
+    BOR_VEC3_STATIC(-1.750713, -0.580226, -1.446864),
+    BOR_VEC3_STATIC(-1.499484, -0.963548, 1.315738),
+    BOR_VEC3_STATIC(-0.408811, -0.395671, 0.449780),
+    BOR_VEC3_STATIC(-1.065881, -1.970091, 0.114807),
+    BOR_VEC3_STATIC(0.003598, 0.595358, -0.246732),
+    BOR_VEC3_STATIC(0.746053, 0.925688, -1.046501),
+    BOR_VEC3_STATIC(-0.019711, -0.084692, -1.099752),
+    BOR_VEC3_STATIC(-0.351015, 0.241630, 1.627758),
+    BOR_VEC3_STATIC(1.670826, -0.899099, 0.585661),
+    BOR_VEC3_STATIC(-1.807211, -1.713794, 0.046767),
+    BOR_VEC3_STATIC(1.509696, -1.362129, 1.064111),
+    BOR_VEC3_STATIC(1.532038, -0.752792, 0.770228),
+    BOR_VEC3_STATIC(1.395964, -0.513543, 0.805131),
+    BOR_VEC3_STATIC(0.945672, 0.378311, 1.425109),
+    BOR_VEC3_STATIC(1.586417, 1.840315, 0.284931),
+    BOR_VEC3_STATIC(-1.294896, -0.997618, -1.129525),
+    BOR_VEC3_STATIC(0.278069, 1.031000, -1.791467),
+    BOR_VEC3_STATIC(0.726546, 0.868613, -0.608074),
+    BOR_VEC3_STATIC(0.060223, -1.340807, 0.919585),
+    BOR_VEC3_STATIC(-1.837165, 1.924884, 1.231775),
+    BOR_VEC3_STATIC(0.513794, -0.929895, 1.651452),
+    BOR_VEC3_STATIC(1.837755, -1.443495, 1.103029),
+    BOR_VEC3_STATIC(1.367723, 0.638869, 0.801631),
+    BOR_VEC3_STATIC(-0.219765, 1.697231, 1.884830),
+    BOR_VEC3_STATIC(-0.470587, 1.210846, -0.268314),
+    BOR_VEC3_STATIC(-1.340983, -0.698131, -1.494680),
+    BOR_VEC3_STATIC(1.635539, 1.837696, -1.523253),
+    BOR_VEC3_STATIC(0.402716, -0.367104, -1.527640),
+    BOR_VEC3_STATIC(-0.818098, -1.007135, 0.998307),
+    BOR_VEC3_STATIC(-1.983964, -1.240645, -0.244908),
+    BOR_VEC3_STATIC(-1.915861, 0.510106, 0.422510),
+    BOR_VEC3_STATIC(1.341329, -1.173577, -0.860874),
+    BOR_VEC3_STATIC(0.169358, -0.907097, 0.342952),
+    BOR_VEC3_STATIC(-0.996471, 0.734109, 1.164363),
+    BOR_VEC3_STATIC(1.234618, 1.894464, 0.181508),
+    BOR_VEC3_STATIC(-0.036763, 1.422791, 1.076270),
+    BOR_VEC3_STATIC(0.282179, -0.466974, -0.863810),
+    BOR_VEC3_STATIC(-1.567443, 1.230196, -1.527714),
+    BOR_VEC3_STATIC(0.989061, 0.181148, 1.859781),
+    BOR_VEC3_STATIC(1.044263, 1.894079, -1.453624),
+    BOR_VEC3_STATIC(0.001486, 0.290313, -0.754994),
+};
+size_t vecs_len = sizeof(vecs) / sizeof(bor_vec3_t);
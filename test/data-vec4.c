@@ -0,0 +1,105 @@
+#include <boruvka/vec4.h>
+
+bor_vec4_t vecs4[] = {
+    BOR_VEC4_STATIC(0.012130, -0.572725, 0.113576, -1.996621),
+    BOR_VEC4_STATIC(-0.230743, -0.201791, -0.780803, -0.402389),
+    BOR_VEC4_STATIC(1.132349, 0.733652, -0.030803, 0.590673),
+    BOR_VEC4_STATIC(-0.489767, -1.184344, -1.984497, -0.889515),
+    BOR_VEC4_STATIC(0.392657, 1.526652, 1.317685, 0.043841),
+    BOR_VEC4_STATIC(1.948073, -0.153676, 1.338374, -0.364139),
+    BOR_VEC4_STATIC(0.978522, 1.950367, -0.778654, -1.318749),
+    BOR_VEC4_STATIC(0.480135, 0.123825, -0.562312, -1.985923),
+    BOR_VEC4_STATIC(-0.443349, -0.296522, -0.378992, 1.444981),
+    BOR_VEC4_STATIC(0.337712, 0.935323, 1.591637, 0.995094),
+    BOR_VEC4_STATIC(-0.029192, 0.983073, 0.561422, 0.594982),
+    BOR_VEC4_STATIC(0.518701, -0.372004, 0.517048, 0.534930),
+    BOR_VEC4_STATIC(1.748472, 1.129895, 1.385072, 1.069999),
+    BOR_VEC4_STATIC(1.261303, 0.421850, -0.602200, -0.941667),
+    BOR_VEC4_STATIC(0.832080, 1.495768, 0.176987, -1.391720),
+    BOR_VEC4_STATIC(1.331901, -0.061828, -0.131589, -1.818448),
+    BOR_VEC4_STATIC(0.041124, 0.978991, -0.309609, -0.579291),
+    BOR_VEC4_STATIC(0.627374, -1.921034, 0.028654, 1.784508),
+    BOR_VEC4_STATIC(0.761790, -0.392305, 0.755633, 0.419976),
+    BOR_VEC4_STATIC(-1.164442, -1.169167, 1.544101, -0.923723),
+    BOR_VEC4_STATIC(-1.700461, 1.322710, 0.092791, -0.527167),
+    BOR_VEC4_STATIC(0.046076, 0.946903, -1.325786, 0.612268),
+    BOR_VEC4_STATIC(0.853748, 1.260014, -0.920957, 0.438665),
+    BOR_VEC4_STATIC(-1.071544, 0.244179, -1.310548, 1.159070),
+    BOR_VEC4_STATIC(1.466871, -0.681426, -1.110726, 1.855154),
+    BOR_VEC4_STATIC(0.826761, 1.375170, -1.877862, 1.597573),
+    BOR_VEC4_STATIC(0.489808, -0.733883, -0.272938, 1.046372),
+    BOR_VEC4_STATIC(1.141648, -1.240397, 0.503546, -1.337482),
+    BOR_VEC4_STATIC(1.892199, -0.225694, 1.652580, 0.912991),
+    BOR_VEC4_STATIC(0.425040, -0.952064, 0.106369, -1.445521),
+    BOR_VEC4_STATIC(-1.447608, 0.862999, -0.555641, 1.005505),
+    BOR_VEC4_STATIC(-1.038026, 0.872633, 0.873908, -0.778016),
+    BOR_VEC4_STATIC(-1.574458, -0.411969, -0.030554, -1.600103),
+    BOR_VEC4_STATIC(-1.252955, -1.778628, 0.390054, 1.555504),
+    BOR_VEC4_STATIC(-1.133769, -1.861146, 0.815694, 1.259642),
+    BOR_VEC4_STATIC(1.856486, 0.452716, -0.630227, 1.351474),
+    BOR_VEC4_STATIC(-1.527732, 0.770548, -1.619077, -0.401177),
+    BOR_VEC4_STATIC(-0.019908, -0.488423, -1.325610, -1.073131),
+    BOR_VEC4_STATIC(1.280600, -0.149697, 0.319731, -1.152372),
+    BOR_VEC4_STATIC(0.859740, -0.679531, 0.374474, 1.637948),
+    BOR_VEC4_STATIC(1.977574, -1.815128, 1.189771, 1.430351),
+    BOR_VEC4_STATIC(-0.721702, -0.467409, 0.321015, 1.675361),
+    BOR_VEC4_STATIC(-0.400286, 1.520121, 1.034242, -1.390908),
+    BOR_VEC4_STATIC(1.654720, -1.939276, -1.419287, 0.659245),
+    BOR_VEC4_STATIC(-1.771521, -0.482040, -1.480085, -0.148443),
+    BOR_VEC4_STATIC(1.359921, 1.624337, -1.858121, -1.756593),
+    BOR_VEC4_STATIC(1.362496, -1.828741, -0.905639, -1.530253),
+    BOR_VEC4_STATIC(-1.635849, -1.889508, 0.550052, 0.978457),
+    BOR_VEC4_STATIC(0.747086, 1.382491, 0.652065, -0.441192),
+    BOR_VEC4_STATIC(0.524252, 1.878379, 0.566413, -1.027633),
+    BOR_VEC4_STATIC(-1.759264, 1.740664, 0.361982, -0.601541),
+    BOR_VEC4_STATIC(0.421411, 0.241030, 0.088687, -1.756781),
+    BOR_VEC4_STATIC(-0.587090, -0.349400, -1.202527, 1.520421),
+    BOR_VEC4_STATIC(-0.303521, 0.649543, 0.854186, 0.973132),
+    BOR_VEC4_STATIC(0.884461, 1.008834, -0.993677, 1.905615),
+    BOR_VEC4_STATIC(-1.395961, 1.674590, 1.418275, 1.408657),
+    BOR_VEC4_STATIC(-1.788755, -1.635128, 1.252223, -0.123333),
+    BOR_VEC4_STATIC(-0.518987, 1.938750, -1.839528, 0.125860),
+    BOR_VEC4_STATIC(-0.226601, -1.487188, -0.419247, 0.830590),
+    BOR_VEC4_STATIC(1.529262, -1.901521, 0.098038, -1.638494),
+    BOR_VEC4_STATIC(1.201574, -1.656859, -1.863227, -0.463055),
+    BOR_VEC4_STATIC(0.930425, -0.747173, -1.479980, 1.178289),
+    BOR_VEC4_STATIC(1.227678, 1.423439, -0.785022, -0.300679),
+    BOR_VEC4_STATIC(-1.018440, 0.228710, -0.679571, -0.645347),
+    BOR_VEC4_STATIC(1.134486, 1.825185, 0.336561, -1.581248),
+    BOR_VEC4_STATIC(0.610300, -0.205553, 1.952122, 0.877526),
+    BOR_VEC4_STATIC(1.339144, 0.805145, 0.142476, 1.587274),
+    BOR_VEC4_STATIC(1.326468, -0.834696, -1.371872, -0.518593),
+    BOR_VEC4_STATIC(0.084311, -1.610480, -0.618483, 0.299623),
+    BOR_VEC4_STATIC(-1.825702, 1.259795, 0.604468, -0.745399),
+    BOR_VEC4_STATIC(-0.806716, -0.589535, -0.698845, 0.994055),
+    BOR_VEC4_STATIC(0.004227, 0.104514, -1.404974, 1.657672),
+    BOR_VEC4_STATIC(-0.697708, -0.689742, -1.724615, 1.917646),
+    BOR_VEC4_STATIC(-0.081209, 1.651539, 1.710469, 1.879009),
+    BOR_VEC4_STATIC(1.262517, 1.701773, 1.689157, 1.205471),
+    BOR_VEC4_STATIC(-1.461675, 0.094847, 0.302416, 1.969990),
+    BOR_VEC4_STATIC(1.135794, 0.811665, 0.986596, -0.553689),
+    BOR_VEC4_STATIC(1.769254, 0.574004, -0.389702, -0.141714),
+    BOR_VEC4_STATIC(1.919020, 0.128514, -1.328810, -1.406580),
+    BOR_VEC4_STATIC(0.748969, 0.251102, 1.627225, -1.261599),
+    BOR_VEC4_STATIC(-0.355565, 0.911841, -1.799580, -1.603110),
+    BOR_VEC4_STATIC(0.182832, -0.937083, -1.572250, -0.953210),
+    BOR_VEC4_STATIC(0.528564, 0.105510, -1.686013, -1.708754),
+    BOR_VEC4_STATIC(1.402508, 0.572956, -1.306531, 1.447336),
+    BOR_VEC4_STATIC(-1.912602, -0.527581, 1.390519, 0.841114),
+    BOR_VEC4_STATIC(-0.864990, 1.565126, 0.392312, 1.461973),
+    BOR_VEC4_STATIC(1.571173, -0.298224, 0.702401, 0.177905),
+    BOR_VEC4_STATIC(1.778941, 1.192643, 0.903274, 1.256129),
+    BOR_VEC4_STATIC(1.992640, -0.973755, -1.194545, 0.987131),
+    BOR_VEC4_STATIC(1.081330, 0.057135, -0.051697, -0.385028),
+    BOR_VEC4_STATIC(1.530788, 1.184928, 0.338390, -1.839524),
+    BOR_VEC4_STATIC(1.404566, -0.166185, -1.240958, -0.802583),
+    BOR_VEC4_STATIC(0.765338, -1.977972, -1.519821, -0.789385),
+    BOR_VEC4_STATIC(1.548765, 0.987442, 1.883167, 0.172115),
+    BOR_VEC4_STATIC(0.287873, 0.205507, 0.102509, 0.168162),
+    BOR_VEC4_STATIC(1.274270, 1.813475, -0.366797, 0.519861),
+    BOR_VEC4_STATIC(-0.768962, -0.792358, 0.025269, 0.345071),
+    BOR_VEC4_STATIC(0.199978, 1.906319, -1.348115, 0.546658),
+    BOR_VEC4_STATIC(1.978124, 0.944541, 0.263634, -0.526547),
+    BOR_VEC4_STATIC(-0.391444, 1.746092, 1.581322, 0.678705),
+};
+size_t vecs4_len = sizeof(vecs4) / sizeof(bor_vec4_t);
@@ -7,6 +7,8 @@
 #include <boruvka/quat.h>
 #include <boruvka/mat3.h>
 #include <boruvka/mat4.h>
+#include <boruvka/rand.h>
+#include <boruvka/digraph.h>
 
 extern bor_vec2_t vecs2[];
 extern size_t vecs2_len;
@@ -34,4 +36,15 @@ extern size_t bunny_tri_len;
 
 void testBunnyDumpSVT(FILE *out, const char *name);
 
+/** Returns random integer from [0, len) */
+int testRandIdx(bor_rand_t *rnd, int len);
+
+/** Random digraph with {edges} edges between random nodes, with {dag} set
+ *  edges go only to nodes with lower IDs and loops are skipped */
+void testRandDigraph(bor_digraph_t *g, int nodes, int edges, int dag,
+                     bor_rand_t *rnd);
+
+/** {size} x {size} grid with edges in both directions between neighbours */
+void testGridDigraph(bor_digraph_t *g, int size);
+
 #endif
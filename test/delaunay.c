@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/qhull.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+
+static void addPoint(bor_pc_t *pc, bor_real_t x, bor_real_t y, bor_real_t z)
+{
+    BOR_VEC(v, 3);
+
+    borVecSet(v, 0, x);
+    borVecSet(v, 1, y);
+    borVecSet(v, 2, z);
+    borPCAdd(pc, v);
+}
+
+/** Returns array of vertices ordered same way as points in point cloud */
+static bor_mesh3_vertex_t **vertices(bor_qhull_mesh3_t *qmesh)
+{
+    bor_mesh3_t *mesh = borQHullMesh3(qmesh);
+    bor_mesh3_vertex_t **verts, *v;
+    bor_list_t *item;
+
+    verts = BOR_ALLOC_ARR(bor_mesh3_vertex_t *, borMesh3VerticesLen(mesh));
+    BOR_LIST_FOR_EACH(borMesh3Vertices(mesh), item){
+        v = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        verts[borMesh3VertexCoords(v) - qmesh->vecs] = v;
+    }
+
+    return verts;
+}
+
+/** Returns number of points whose nearest neighbour is not connected by
+ *  an edge (nearest neighbour of each point is Delaunay neighbour) */
+static int nearestMissing(bor_qhull_mesh3_t *qmesh)
+{
+    bor_mesh3_vertex_t **verts;
+    bor_real_t d, best;
+    size_t i, j, n, nearest;
+    int missing = 0;
+
+    n = qmesh->vecs_len;
+    verts = vertices(qmesh);
+    for (i = 0; i < n; i++){
+        best = BOR_REAL_MAX;
+        nearest = i;
+        for (j = 0; j < n; j++){
+            if (j == i)
+                continue;
+            d = borVec3Dist2(&qmesh->vecs[i], &qmesh->vecs[j]);
+            if (d < best){
+                best = d;
+                nearest = j;
+            }
+        }
+
+        if (!borMesh3VertexCommonEdge(verts[i], verts[nearest]))
+            ++missing;
+    }
+    BOR_FREE(verts);
+
+    return missing;
+}
+
+TEST(delaunayCube)
+{
+    bor_pc_t *pc;
+    bor_qhull_mesh3_t *qmesh;
+    bor_mesh3_t *mesh;
+    bor_mesh3_vertex_t **verts;
+    int i;
+
+    pc = borPCNew(3);
+    for (i = 0; i < 8; i++)
+        addPoint(pc, i & 1, (i >> 1) & 1, (i >> 2) & 1);
+    addPoint(pc, 0.5, 0.5, 0.5);
+
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh != NULL);
+    mesh = borQHullMesh3(qmesh);
+
+    // 8 edges from center, 12 edges of cube and one diagonal on each
+    // side of cube
+    assertEquals(borMesh3VerticesLen(mesh), 9);
+    assertEquals(borMesh3EdgesLen(mesh), 26);
+
+    verts = vertices(qmesh);
+    for (i = 0; i < 8; i++)
+        assertTrue(borMesh3VertexCommonEdge(verts[8], verts[i]) != NULL);
+    // edges of cube
+    assertTrue(borMesh3VertexCommonEdge(verts[0], verts[1]) != NULL);
+    assertTrue(borMesh3VertexCommonEdge(verts[0], verts[2]) != NULL);
+    assertTrue(borMesh3VertexCommonEdge(verts[0], verts[4]) != NULL);
+    // main diagonal of cube
+    assertTrue(borMesh3VertexCommonEdge(verts[0], verts[7]) == NULL);
+    BOR_FREE(verts);
+
+    borQHullMesh3Del(qmesh);
+    borPCDel(pc);
+}
+
+TEST(delaunayRandom)
+{
+    bor_pc_t *pc;
+    bor_qhull_mesh3_t *qmesh;
+    bor_mesh3_t *mesh;
+    bor_rand_t rnd;
+    bor_real_t x, y, z, len;
+    int i;
+
+    borRandInitSeed(&rnd, 11);
+
+    // random points in cube
+    pc = borPCNew(3);
+    for (i = 0; i < 2000; i++){
+        addPoint(pc, borRand(&rnd, -1., 1.), borRand(&rnd, -1., 1.),
+                     borRand(&rnd, -1., 1.));
+    }
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh != NULL);
+    mesh = borQHullMesh3(qmesh);
+    assertEquals(borMesh3VerticesLen(mesh), 2000);
+    assertEquals(nearestMissing(qmesh), 0);
+    borQHullMesh3Del(qmesh);
+    borPCDel(pc);
+
+    // points on sphere (all points are on convex hull)
+    pc = borPCNew(3);
+    for (i = 0; i < 1000; i++){
+        x = borRand(&rnd, -1., 1.);
+        y = borRand(&rnd, -1., 1.);
+        z = borRand(&rnd, -1., 1.);
+        len = BOR_SQRT(x * x + y * y + z * z);
+        if (len < 1E-3){
+            --i;
+            continue;
+        }
+        addPoint(pc, x / len, y / len, z / len);
+    }
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh != NULL);
+    mesh = borQHullMesh3(qmesh);
+    assertEquals(borMesh3VerticesLen(mesh), 1000);
+    assertEquals(nearestMissing(qmesh), 0);
+    borQHullMesh3Del(qmesh);
+    borPCDel(pc);
+}
+
+TEST(delaunayGrid)
+{
+    bor_pc_t *pc;
+    bor_qhull_mesh3_t *qmesh, *qmesh2;
+    bor_mesh3_vertex_t **verts, **verts2;
+    bor_mesh3_edge_t *e;
+    bor_list_t *item;
+    int i, x, y, z, missing;
+
+    // regular grid is highly degenerate: many cospherical and coplanar
+    // points
+    pc = borPCNew(3);
+    for (i = 0; i < 1000; i++)
+        addPoint(pc, i % 10, (i / 10) % 10, i / 100);
+
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh != NULL);
+    verts = vertices(qmesh);
+
+    // edges between neighbouring grid points are in each Delaunay
+    // triangulation of grid
+    missing = 0;
+    for (i = 0; i < 1000; i++){
+        x = i % 10;
+        y = (i / 10) % 10;
+        z = i / 100;
+        if (x < 9 && !borMesh3VertexCommonEdge(verts[i], verts[i + 1]))
+            ++missing;
+        if (y < 9 && !borMesh3VertexCommonEdge(verts[i], verts[i + 10]))
+            ++missing;
+        if (z < 9 && !borMesh3VertexCommonEdge(verts[i], verts[i + 100]))
+            ++missing;
+    }
+    assertEquals(missing, 0);
+
+    // the triangulation of degenerate input is reproducible
+    qmesh2 = borDelaunayMesh3(pc);
+    assertTrue(qmesh2 != NULL);
+    verts2 = vertices(qmesh2);
+    assertEquals(borMesh3EdgesLen(borQHullMesh3(qmesh)),
+                 borMesh3EdgesLen(borQHullMesh3(qmesh2)));
+    missing = 0;
+    BOR_LIST_FOR_EACH(borMesh3Edges(borQHullMesh3(qmesh)), item){
+        e = BOR_LIST_ENTRY(item, bor_mesh3_edge_t, list);
+        x = borMesh3VertexCoords(borMesh3EdgeVertex(e, 0)) - qmesh->vecs;
+        y = borMesh3VertexCoords(borMesh3EdgeVertex(e, 1)) - qmesh->vecs;
+        if (!borMesh3VertexCommonEdge(verts2[x], verts2[y]))
+            ++missing;
+    }
+    assertEquals(missing, 0);
+    BOR_FREE(verts2);
+    borQHullMesh3Del(qmesh2);
+
+    BOR_FREE(verts);
+    borQHullMesh3Del(qmesh);
+    borPCDel(pc);
+}
+
+TEST(delaunayDegenerate)
+{
+    bor_pc_t *pc;
+    bor_qhull_mesh3_t *qmesh;
+    bor_mesh3_vertex_t **verts;
+    int i;
+
+    // coplanar points
+    pc = borPCNew(3);
+    for (i = 0; i < 100; i++)
+        addPoint(pc, i % 10, i / 10, 1.);
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh == NULL);
+    borPCDel(pc);
+
+    // duplicate points remain isolated
+    pc = borPCNew(3);
+    addPoint(pc, 0., 0., 0.);
+    addPoint(pc, 0., 0., 0.);
+    addPoint(pc, 1., 0., 0.);
+    addPoint(pc, 0., 1., 0.);
+    addPoint(pc, 0., 0., 1.);
+    addPoint(pc, 1., 0., 0.);
+    qmesh = borDelaunayMesh3(pc);
+    assertTrue(qmesh != NULL);
+    assertEquals(borMesh3VerticesLen(borQHullMesh3(qmesh)), 6);
+    assertEquals(borMesh3EdgesLen(borQHullMesh3(qmesh)), 6);
+
+    verts = vertices(qmesh);
+    assertEquals(borMesh3VertexEdgesLen(verts[0])
+                    + borMesh3VertexEdgesLen(verts[1]), 3);
+    assertEquals(borMesh3VertexEdgesLen(verts[2])
+                    + borMesh3VertexEdgesLen(verts[5]), 3);
+    BOR_FREE(verts);
+
+    borQHullMesh3Del(qmesh);
+    borPCDel(pc);
+}
@@ -0,0 +1,17 @@
+#ifndef TEST_DELAUNAY_H
+#define TEST_DELAUNAY_H
+
+TEST(delaunayCube);
+TEST(delaunayRandom);
+TEST(delaunayGrid);
+TEST(delaunayDegenerate);
+
+TEST_SUITE(TSDelaunay) {
+    TEST_ADD(delaunayCube),
+    TEST_ADD(delaunayRandom),
+    TEST_ADD(delaunayGrid),
+    TEST_ADD(delaunayDegenerate),
+    TEST_SUITE_CLOSURE
+};
+
+#endif
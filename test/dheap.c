@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include "cu.h"
+#include <boruvka/dheap.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
+
+struct _el_t {
+    bor_real_t val;
+    bor_dheap_node_t node;
+    int onheap;
+};
+typedef struct _el_t el_t;
+
+static int d_arr[3] = { 2, 4, 8 };
+
+static void clearEl(bor_dheap_node_t *n, void *data)
+{
+    el_t *el = bor_container_of(n, el_t, node);
+    el->onheap = 0;
+    ++*(int *)data;
+}
+
+/** Returns minimal value of elements on heap (naively) */
+static bor_real_t minVal(const el_t *els, int num)
+{
+    bor_real_t m = BOR_REAL_MAX;
+    int i;
+
+    for (i = 0; i < num; ++i){
+        if (els[i].onheap && els[i].val < m)
+            m = els[i].val;
+    }
+    return m;
+}
+
+TEST(dheapSort)
+{
+    bor_rand_t r;
+    bor_dheap_t *heap;
+    bor_dheap_node_t *n;
+    el_t *els;
+    bor_real_t key, last;
+    int i, j, num = 10000, bad;
+
+    borRandInitSeed(&r, 123);
+    els = BOR_ALLOC_ARR(el_t, num);
+
+    for (j = 0; j < 3; ++j){
+        heap = borDHeapNew(d_arr[j]);
+        for (i = 0; i < num; ++i){
+            els[i].val = (int)borRand(&r, -500., 500.);
+            borDHeapAdd(heap, &els[i].node, els[i].val);
+        }
+        assertEquals(borDHeapSize(heap), num);
+
+        last = -BOR_REAL_MAX;
+        bad = 0;
+        for (i = 0; i < num; ++i){
+            n = borDHeapMin(heap, &key);
+            bad += (n != borDHeapExtractMin(heap, NULL));
+            bad += (key != bor_container_of(n, el_t, node)->val);
+            bad += (key < last);
+            bad += borDHeapHas(n);
+            last = key;
+        }
+        assertEquals(bad, 0);
+        assertTrue(borDHeapEmpty(heap));
+        assertEquals(borDHeapMin(heap, NULL), NULL);
+        assertEquals(borDHeapExtractMin(heap, NULL), NULL);
+        borDHeapDel(heap);
+    }
+
+    BOR_FREE(els);
+}
+
+TEST(dheapOps)
+{
+    bor_rand_t r;
+    bor_dheap_t *heap;
+    bor_dheap_node_t *n;
+    el_t *els, *el;
+    bor_real_t key;
+    int i, j, k, num = 2000, bad, cleared, op;
+
+    borRandInitSeed(&r, 321);
+    els = BOR_ALLOC_ARR(el_t, num);
+
+    for (j = 0; j < 3; ++j){
+        heap = borDHeapNew(d_arr[j]);
+        for (i = 0; i < num; ++i)
+            els[i].onheap = 0;
+
+        bad = 0;
+        for (k = 0; k < 50000; ++k){
+            el = els + BOR_MIN((int)borRand(&r, 0, num), num - 1);
+            op = borRand(&r, 0, 5);
+
+            if (!el->onheap){
+                el->val = borRand(&r, -100., 100.);
+                borDHeapAdd(heap, &el->node, el->val);
+                el->onheap = 1;
+
+            }else if (op == 0){
+                el->val -= borRand(&r, 0., 10.);
+                borDHeapDecreaseKey(heap, &el->node, el->val);
+
+            }else if (op == 1){
+                el->val += borRand(&r, -10., 10.);
+                borDHeapUpdate(heap, &el->node, el->val);
+
+            }else if (op == 2){
+                borDHeapRemove(heap, &el->node);
+                el->onheap = 0;
+                bad += borDHeapHas(&el->node);
+
+            }else{
+                n = borDHeapExtractMin(heap, &key);
+                el = bor_container_of(n, el_t, node);
+                bad += (key != el->val);
+                bad += (key != minVal(els, num));
+                el->onheap = 0;
+            }
+
+            if (!borDHeapEmpty(heap)){
+                borDHeapMin(heap, &key);
+                bad += (key != minVal(els, num));
+            }
+        }
+        assertEquals(bad, 0);
+
+        for (i = 0, k = 0; i < num; ++i){
+            k += els[i].onheap;
+            if (els[i].onheap)
+                bad += (borDHeapKey(heap, &els[i].node) != els[i].val);
+        }
+        assertEquals(bad, 0);
+        assertEquals(borDHeapSize(heap), k);
+
+        cleared = 0;
+        borDHeapClear(heap, clearEl, &cleared);
+        assertEquals(cleared, k);
+        assertTrue(borDHeapEmpty(heap));
+        for (i = 0; i < num; ++i)
+            bad += els[i].onheap;
+        assertEquals(bad, 0);
+
+        borDHeapDel(heap);
+    }
+
+    BOR_FREE(els);
+}
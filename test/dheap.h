@@ -0,0 +1,13 @@
+#ifndef TEST_DHEAP_H
+#define TEST_DHEAP_H
+
+TEST(dheapSort);
+TEST(dheapOps);
+
+TEST_SUITE(TSDHeap) {
+    TEST_ADD(dheapSort),
+    TEST_ADD(dheapOps),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_DHEAP_H */
@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/digraph.h>
+#include <boruvka/scc.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+#include "data.h"
+
+/** Random digraph with labels and colors of nodes and edges */
+static void randLabeledGraph(bor_digraph_t *g, int nodes, int edges,
+                             bor_rand_t *rnd)
+{
+    int i, j, e;
+
+    borDigraphInit(g);
+    for (i = 0; i < nodes; ++i){
+        borDigraphAddNode(g);
+        for (j = testRandIdx(rnd, 3); j > 0; --j)
+            borDigraphNodeAddLabel(g, i, testRandIdx(rnd, 100));
+        g->node[i].color = testRandIdx(rnd, 3);
+    }
+    for (i = 0; i < edges; ++i){
+        e = borDigraphGetOrAddEdge(g, testRandIdx(rnd, nodes), testRandIdx(rnd, nodes));
+        for (j = testRandIdx(rnd, 3); j > 0; --j)
+            borDigraphEdgeAddLabel(g, e, testRandIdx(rnd, 100));
+        g->edge[e].color = testRandIdx(rnd, 3);
+    }
+}
+
+static void randSet(bor_iset_t *s, int size, int num, bor_rand_t *rnd)
+{
+    borISetInit(s);
+    for (; num > 0; --num)
+        borISetAdd(s, testRandIdx(rnd, size));
+}
+
+static int arrEq(const int *a1, const int *a2, int len)
+{
+    return memcmp(a1, a2, sizeof(int) * len) == 0;
+}
+
+static void checkFrozen(const bor_digraph_frozen_t *fg,
+                        const bor_digraph_t *g)
+{
+    const int *label;
+    int i, j, len;
+
+    assertEquals(fg->node_size, g->node_size);
+    assertEquals(fg->edge_size, g->edge_size);
+    for (i = 0; i < g->node_size; ++i){
+        const bor_digraph_node_t *n = g->node + i;
+        assertEquals(fg->node_color[i], n->color);
+        len = borDigraphFrozenNodeLabel(fg, i, &label);
+        assertEquals(len, n->label.size);
+        assertTrue(arrEq(label, n->label.s, len));
+
+        assertEquals(fg->out_start[i + 1] - fg->out_start[i], n->out.size);
+        assertTrue(arrEq(fg->out_edge + fg->out_start[i],
+                         n->out.s, n->out.size));
+        for (j = fg->out_start[i]; j < fg->out_start[i + 1]; ++j){
+            assertEquals(fg->out_node[j], g->edge[fg->out_edge[j]].to);
+        }
+
+        assertEquals(fg->in_start[i + 1] - fg->in_start[i], n->in.size);
+        assertTrue(arrEq(fg->in_edge + fg->in_start[i],
+                         n->in.s, n->in.size));
+        for (j = fg->in_start[i]; j < fg->in_start[i + 1]; ++j){
+            assertEquals(fg->in_node[j], g->edge[fg->in_edge[j]].from);
+        }
+    }
+
+    for (i = 0; i < g->edge_size; ++i){
+        const bor_digraph_edge_t *e = g->edge + i;
+        assertEquals(fg->edge_from[i], e->from);
+        assertEquals(fg->edge_to[i], e->to);
+        assertEquals(fg->edge_color[i], e->color);
+        len = borDigraphFrozenEdgeLabel(fg, i, &label);
+        assertEquals(len, e->label.size);
+        assertTrue(arrEq(label, e->label.s, len));
+    }
+}
+
+TEST(digraphFreeze)
+{
+    bor_digraph_t g, g2;
+    bor_digraph_frozen_t fg, fg2;
+    bor_rand_t rnd;
+    int i;
+
+    borRandInitSeed(&rnd, 47);
+    for (i = 0; i < 10; ++i){
+        randLabeledGraph(&g, 10 + 50 * i, 100 * i, &rnd);
+        borDigraphFreeze(&fg, &g);
+        checkFrozen(&fg, &g);
+
+        borDigraphThaw(&g2, &fg);
+        borDigraphFreeze(&fg2, &g2);
+        checkFrozen(&fg2, &g);
+
+        borDigraphFrozenFree(&fg);
+        borDigraphFrozenFree(&fg2);
+        borDigraphFree(&g);
+        borDigraphFree(&g2);
+    }
+}
+
+TEST(digraphFrozenInduce)
+{
+    bor_digraph_t g, ind;
+    bor_digraph_frozen_t fg, find;
+    bor_iset_t nodes, edges;
+    bor_rand_t rnd;
+    int i;
+
+    borRandInitSeed(&rnd, 4747);
+    for (i = 0; i < 30; ++i){
+        randLabeledGraph(&g, 200, 1000, &rnd);
+        borDigraphFreeze(&fg, &g);
+        randSet(&nodes, g.node_size, 100, &rnd);
+        randSet(&edges, g.edge_size, 500, &rnd);
+
+        borDigraphInduce(&ind, &g, (i % 3 != 1 ? &nodes : NULL),
+                         (i % 3 != 0 ? &edges : NULL));
+        borDigraphFrozenInduce(&find, &fg, (i % 3 != 1 ? &nodes : NULL),
+                               (i % 3 != 0 ? &edges : NULL));
+        checkFrozen(&find, &ind);
+
+        borDigraphFrozenFree(&find);
+        borDigraphFree(&ind);
+        borISetFree(&nodes);
+        borISetFree(&edges);
+        borDigraphFrozenFree(&fg);
+        borDigraphFree(&g);
+    }
+}
+
+static long sccIt(int node, void *ud)
+{
+    const bor_digraph_frozen_t *fg = ud;
+    return fg->out_start[node];
+}
+
+static int sccNext(int node, long *it, void *ud)
+{
+    const bor_digraph_frozen_t *fg = ud;
+    if (*it >= fg->out_start[node + 1])
+        return -1;
+    return fg->out_node[(*it)++];
+}
+
+TEST(digraphFrozenSCC)
+{
+    bor_digraph_t g, dscc;
+    bor_digraph_frozen_t fg;
+    bor_scc_t scc;
+    bor_rand_t rnd;
+    int i, j, *comp, f, t;
+
+    borRandInitSeed(&rnd, 474747);
+    for (i = 0; i < 10; ++i){
+        randLabeledGraph(&g, 300, 150 * (i + 1), &rnd);
+        borDigraphFreeze(&fg, &g);
+        borDigraphSCC(&dscc, &g);
+
+        /* Tarjan's algorithm visits nodes in the same order */
+        borSCCInit(&scc, fg.node_size, sccIt, sccNext, &fg);
+        borSCC(&scc);
+        assertEquals(dscc.node_size, scc.comp_size);
+        comp = BOR_ALLOC_ARR(int, g.node_size);
+        for (j = 0; j < dscc.node_size; ++j){
+            assertEquals(dscc.node[j].label.size, scc.comp[j].node_size);
+            assertTrue(arrEq(dscc.node[j].label.s, scc.comp[j].node,
+                             scc.comp[j].node_size));
+            for (f = 0; f < scc.comp[j].node_size; ++f)
+                comp[scc.comp[j].node[f]] = j;
+        }
+
+        for (j = 0; j < g.edge_size; ++j){
+            f = comp[g.edge[j].from];
+            t = comp[g.edge[j].to];
+            if (f != t){
+                assertTrue(borDigraphGetEdge(&dscc, f, t) >= 0);
+                assertTrue(borISetIsSubset(&g.edge[j].label,
+                            &dscc.edge[borDigraphGetEdge(&dscc, f, t)].label));
+            }
+        }
+
+        BOR_FREE(comp);
+        borSCCFree(&scc);
+        borDigraphFree(&dscc);
+        borDigraphFrozenFree(&fg);
+        borDigraphFree(&g);
+    }
+
+    /* Long path does not overflow the stack */
+    borDigraphInit(&g);
+    for (i = 0; i < 300000; ++i){
+        borDigraphAddNode(&g);
+        if (i > 0)
+            borDigraphAddEdge(&g, i - 1, i);
+    }
+    borDigraphAddEdge(&g, i - 1, 0);
+    borDigraphSCC(&dscc, &g);
+    assertEquals(dscc.node_size, 1);
+    assertEquals(dscc.node[0].label.size, g.node_size);
+    borDigraphFree(&dscc);
+    borDigraphFree(&g);
+}
+
+TEST(digraphFrozenDFS)
+{
+    bor_digraph_t g;
+    bor_digraph_frozen_t fg;
+    bor_iset_t from, ignore;
+    bor_rand_t rnd;
+    int *visited, *visited2, *dist, i, j, reached;
+
+    borRandInitSeed(&rnd, 47474747);
+    for (i = 0; i < 20; ++i){
+        randLabeledGraph(&g, 1000, 1200, &rnd);
+        borDigraphFreeze(&fg, &g);
+        visited = BOR_ALLOC_ARR(int, g.node_size);
+        visited2 = BOR_ALLOC_ARR(int, g.node_size);
+        dist = BOR_ALLOC_ARR(int, g.node_size);
+
+        randSet(&from, g.node_size, 1 + i % 3, &rnd);
+        randSet(&ignore, g.node_size, (i % 2) * 50, &rnd);
+        if (i % 4 == 1)
+            borISetUnion(&ignore, &from);
+        borDigraphDFS(&g, &from, &ignore, visited);
+        borDigraphFrozenDFS(&fg, &from, &ignore, visited2);
+        assertTrue(arrEq(visited, visited2, g.node_size));
+
+        borDigraphFrozenDFS(&fg, &from, NULL, visited);
+        reached = borDigraphFrozenBFS(&fg, borISetGet(&from, 0), dist);
+        for (j = 0; j < g.node_size; ++j){
+            if (dist[j] >= 0){
+                --reached;
+                assertTrue(visited[j]);
+            }
+        }
+        assertEquals(reached, 0);
+        if (borISetSize(&from) == 1){
+            for (j = 0; j < g.node_size; ++j)
+                assertEquals(visited[j], dist[j] >= 0);
+        }
+
+        /* distances satisfy the triangle inequality on each edge */
+        for (j = 0; j < g.edge_size; ++j){
+            if (dist[g.edge[j].from] >= 0){
+                assertTrue(dist[g.edge[j].to] >= 0);
+                assertTrue(dist[g.edge[j].to] <= dist[g.edge[j].from] + 1);
+            }
+        }
+
+        BOR_FREE(visited);
+        BOR_FREE(visited2);
+        BOR_FREE(dist);
+        borISetFree(&from);
+        borISetFree(&ignore);
+        borDigraphFrozenFree(&fg);
+        borDigraphFree(&g);
+    }
+}
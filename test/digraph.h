@@ -0,0 +1,17 @@
+#ifndef TEST_DIGRAPH_H
+#define TEST_DIGRAPH_H
+
+TEST(digraphFreeze);
+TEST(digraphFrozenInduce);
+TEST(digraphFrozenSCC);
+TEST(digraphFrozenDFS);
+
+TEST_SUITE(TSDigraph) {
+    TEST_ADD(digraphFreeze),
+    TEST_ADD(digraphFrozenInduce),
+    TEST_ADD(digraphFrozenSCC),
+    TEST_ADD(digraphFrozenDFS),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_DIGRAPH_H */
@@ -1,6 +1,8 @@
 #include <cu/cu.h>
 #include <boruvka/dij.h>
 #include <boruvka/vec2.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
 
 #define NUM_NODES 20
 
@@ -164,3 +166,300 @@ static void expand(bor_dij_node_t *_n, bor_list_t *list, void *_)
         }
     }
 }
+
+
+#define GRID 30
+#define GRID_NODES (GRID * GRID + 1)
+
+struct _int_node_t {
+    bor_dij_int_node_t dij;
+    int nbs[4];
+    long w[4];
+    int nbs_len;
+};
+typedef struct _int_node_t int_node_t;
+
+static int_node_t *int_nodes;
+
+static void expandInt(bor_dij_int_node_t *_n, bor_list_t *list, void *_)
+{
+    int_node_t *n = bor_container_of(_n, int_node_t, dij);
+    int i;
+
+    for (i = 0; i < n->nbs_len; ++i)
+        borDijIntNodeAdd(&int_nodes[n->nbs[i]].dij, list, n->w[i]);
+}
+
+/** O(n^2) Dijkstra as a reference */
+static void refDist(int src, long *dist)
+{
+    int closed[GRID_NODES], i, u, v;
+
+    for (i = 0; i < GRID_NODES; ++i){
+        dist[i] = -1;
+        closed[i] = 0;
+    }
+    dist[src] = 0;
+    while (1){
+        u = -1;
+        for (i = 0; i < GRID_NODES; ++i){
+            if (!closed[i] && dist[i] >= 0 && (u < 0 || dist[i] < dist[u]))
+                u = i;
+        }
+        if (u < 0)
+            break;
+        closed[u] = 1;
+        for (i = 0; i < int_nodes[u].nbs_len; ++i){
+            v = int_nodes[u].nbs[i];
+            if (dist[v] < 0 || dist[u] + int_nodes[u].w[i] < dist[v])
+                dist[v] = dist[u] + int_nodes[u].w[i];
+        }
+    }
+}
+
+TEST(dijInt)
+{
+    bor_dij_int_t *dij;
+    bor_dij_int_ops_t ops;
+    bor_dij_int_node_t *targets[5];
+    bor_dij_int_node_t *prev;
+    bor_rand_t rnd;
+    long dist[GRID_NODES];
+    int i, x, y, src, run, res;
+
+    borRandInitSeed(&rnd, 43);
+    int_nodes = BOR_ALLOC_ARR(int_node_t, GRID_NODES);
+    for (i = 0; i < GRID_NODES; ++i){
+        borDijIntNodeInit(&int_nodes[i].dij);
+        int_nodes[i].nbs_len = 0;
+    }
+    /* Directed grid with random weights, the last node is isolated */
+    for (y = 0; y < GRID; ++y){
+        for (x = 0; x < GRID; ++x){
+            i = y * GRID + x;
+            if (x > 0)
+                int_nodes[i].nbs[int_nodes[i].nbs_len++] = i - 1;
+            if (x < GRID - 1)
+                int_nodes[i].nbs[int_nodes[i].nbs_len++] = i + 1;
+            if (y > 0)
+                int_nodes[i].nbs[int_nodes[i].nbs_len++] = i - GRID;
+            if (y < GRID - 1)
+                int_nodes[i].nbs[int_nodes[i].nbs_len++] = i + GRID;
+        }
+    }
+    for (i = 0; i < GRID_NODES; ++i){
+        for (x = 0; x < int_nodes[i].nbs_len; ++x){
+            int_nodes[i].w[x] = BOR_MIN((long)borRand(&rnd, 0, 1000), 999);
+            if (i % 7 == 0)
+                int_nodes[i].w[x] += 3000000000L;
+        }
+    }
+
+    borDijIntOpsInit(&ops);
+    ops.expand = expandInt;
+    dij = borDijIntNew(&ops);
+
+    for (run = 0; run < 20; ++run){
+        src = BOR_MIN((int)borRand(&rnd, 0, GRID * GRID), GRID * GRID - 1);
+        refDist(src, dist);
+
+        if (run % 2 == 0){
+            res = borDijIntRun(dij, &int_nodes[src].dij, NULL, 0);
+            assertEquals(res, 0);
+            for (i = 0; i < GRID_NODES; ++i){
+                assertEquals(borDijIntDist(dij, &int_nodes[i].dij), dist[i]);
+                assertEquals(borDijIntNodeClosed(dij, &int_nodes[i].dij),
+                             dist[i] >= 0);
+            }
+
+            /* path is consistent with distances */
+            i = GRID * GRID - 1;
+            while ((prev = borDijIntNodePrev(dij, &int_nodes[i].dij)) != NULL){
+                assertTrue(borDijIntDist(dij, prev)
+                                <= borDijIntDist(dij, &int_nodes[i].dij));
+                i = bor_container_of(prev, int_node_t, dij) - int_nodes;
+            }
+            assertEquals(i, src);
+
+        }else{
+            for (i = 0; i < 4; ++i){
+                x = BOR_MIN((int)borRand(&rnd, 0, 40), 39);
+                targets[i] = &int_nodes[(src + x) % (GRID * GRID)].dij;
+            }
+            targets[4] = targets[0];
+            res = borDijIntRun(dij, &int_nodes[src].dij, targets, 5);
+            assertEquals(res, 0);
+            for (i = 0; i < 5; ++i){
+                assertTrue(borDijIntNodeClosed(dij, targets[i]));
+                assertEquals(borDijIntDist(dij, targets[i]),
+                             dist[bor_container_of(targets[i], int_node_t, dij)
+                                    - int_nodes]);
+            }
+
+            /* unreachable target */
+            targets[4] = &int_nodes[GRID_NODES - 1].dij;
+            res = borDijIntRun(dij, &int_nodes[src].dij, targets + 3, 2);
+            assertEquals(res, -1);
+            assertTrue(borDijIntNodeClosed(dij, targets[3]));
+            assertFalse(borDijIntNodeClosed(dij, targets[4]));
+            assertEquals(borDijIntDist(dij, targets[4]), -1);
+        }
+    }
+
+    borDijIntDel(dij);
+    BOR_FREE(int_nodes);
+}
+
+
+struct _geo_node_t {
+    bor_dij_node_t dij;
+    bor_vec2_t v;
+    int nbs[4];
+    bor_real_t w[4];
+    int nbs_len;
+};
+typedef struct _geo_node_t geo_node_t;
+
+static geo_node_t *geo_nodes;
+
+static void expandGeo(bor_dij_node_t *_n, bor_list_t *list, void *_)
+{
+    geo_node_t *n = bor_container_of(_n, geo_node_t, dij);
+    int i;
+
+    for (i = 0; i < n->nbs_len; ++i){
+        if (!borDijNodeClosed(&geo_nodes[n->nbs[i]].dij))
+            borDijNodeAdd(&geo_nodes[n->nbs[i]].dij, list, n->w[i]);
+    }
+}
+
+static void expandGeoBack(bor_dij_node_t *_n, bor_list_t *list, void *_)
+{
+    geo_node_t *n = bor_container_of(_n, geo_node_t, dij);
+    geo_node_t *p;
+    int i, j;
+
+    /* predecessors are the same nodes, weight of the reverse edge */
+    for (i = 0; i < n->nbs_len; ++i){
+        p = geo_nodes + n->nbs[i];
+        for (j = 0; j < p->nbs_len; ++j){
+            if (geo_nodes + p->nbs[j] == n)
+                borDijNodeAdd(&p->dij, list, p->w[j]);
+        }
+    }
+}
+
+static bor_real_t heurGeo(const bor_dij_node_t *_n,
+                          const bor_dij_node_t *_end, void *_)
+{
+    const geo_node_t *n = bor_container_of(_n, geo_node_t, dij);
+    const geo_node_t *end = bor_container_of(_end, geo_node_t, dij);
+    return borVec2Dist(&n->v, &end->v);
+}
+
+static void geoInit(void)
+{
+    int i;
+
+    for (i = 0; i < GRID * GRID; ++i)
+        borDijNodeInit(&geo_nodes[i].dij);
+}
+
+TEST(dijAStarBidir)
+{
+    bor_dij_t *dij, *dija;
+    bor_dij_ops_t ops;
+    bor_rand_t rnd;
+    bor_list_t path, *item;
+    bor_dij_node_t *n, *last;
+    bor_real_t dist, len;
+    size_t settled, settled_astar = 0, settled_bidir = 0, settled_dij = 0;
+    int i, x, y, src, dst, run, res;
+
+    borRandInitSeed(&rnd, 44);
+    geo_nodes = BOR_ALLOC_ARR(geo_node_t, GRID * GRID);
+    for (y = 0; y < GRID; ++y){
+        for (x = 0; x < GRID; ++x){
+            i = y * GRID + x;
+            borVec2Set(&geo_nodes[i].v, x, y);
+            geo_nodes[i].nbs_len = 0;
+            if (x > 0)
+                geo_nodes[i].nbs[geo_nodes[i].nbs_len++] = i - 1;
+            if (x < GRID - 1)
+                geo_nodes[i].nbs[geo_nodes[i].nbs_len++] = i + 1;
+            if (y > 0)
+                geo_nodes[i].nbs[geo_nodes[i].nbs_len++] = i - GRID;
+            if (y < GRID - 1)
+                geo_nodes[i].nbs[geo_nodes[i].nbs_len++] = i + GRID;
+        }
+    }
+    /* weights are at least euclidean distance so heuristic is consistent */
+    for (i = 0; i < GRID * GRID; ++i){
+        for (x = 0; x < geo_nodes[i].nbs_len; ++x)
+            geo_nodes[i].w[x] = 1. + borRand(&rnd, 0., 1.);
+    }
+
+    borDijOpsInit(&ops);
+    ops.expand = expandGeo;
+    ops.expand_back = expandGeoBack;
+    dij = borDijNew(&ops);
+    ops.heuristic = heurGeo;
+    dija = borDijNew(&ops);
+
+    for (run = 0; run < 30; ++run){
+        src = BOR_MIN((int)borRand(&rnd, 0, GRID * GRID), GRID * GRID - 1);
+        dst = BOR_MIN((int)borRand(&rnd, 0, GRID * GRID), GRID * GRID - 1);
+
+        geoInit();
+        res = borDijRun(dij, &geo_nodes[src].dij, &geo_nodes[dst].dij);
+        assertEquals(res, 0);
+        dist = borDijDist(&geo_nodes[dst].dij);
+        settled_dij += dij->settled;
+
+        geoInit();
+        res = borDijRun(dija, &geo_nodes[src].dij, &geo_nodes[dst].dij);
+        assertEquals(res, 0);
+        assertTrue(fabs(borDijDist(&geo_nodes[dst].dij) - dist) < 1E-3);
+        settled_astar += dija->settled;
+
+        geoInit();
+        res = borDijRunBidir(dij, &geo_nodes[src].dij, &geo_nodes[dst].dij);
+        assertEquals(res, 0);
+        assertTrue(fabs(borDijDist(&geo_nodes[dst].dij) - dist) < 1E-3);
+        settled = dij->settled;
+        settled_bidir += settled;
+
+        /* path goes from src to dst and its length matches */
+        borListInit(&path);
+        borDijPath(&geo_nodes[dst].dij, &path);
+        last = NULL;
+        len = 0.;
+        BOR_LIST_FOR_EACH(&path, item){
+            n = borDijNodeFromList(item);
+            if (last == NULL){
+                assertEquals(n, &geo_nodes[src].dij);
+            }else{
+                len += borDijDist(n) - borDijDist(last);
+                assertTrue(borDijDist(n) >= borDijDist(last));
+            }
+            last = n;
+        }
+        assertEquals(last, &geo_nodes[dst].dij);
+        assertTrue(fabs(len - dist) < 1E-3);
+    }
+
+    assertTrue(settled_astar < settled_dij);
+    assertTrue(settled_bidir < settled_dij);
+    borDijDel(dij);
+
+    /* bidirectional search needs backward expansion */
+    ops.heuristic = NULL;
+    ops.expand_back = NULL;
+    dij = borDijNew(&ops);
+    geoInit();
+    assertEquals(borDijRunBidir(dij, &geo_nodes[0].dij, &geo_nodes[1].dij), -1);
+
+    borDijDel(dij);
+    borDijDel(dija);
+    BOR_FREE(geo_nodes);
+}
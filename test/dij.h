@@ -3,9 +3,13 @@
 
 
 TEST(dij1);
+TEST(dijInt);
+TEST(dijAStarBidir);
 
 TEST_SUITE(TSDij) {
     TEST_ADD(dij1),
+    TEST_ADD(dijInt),
+    TEST_ADD(dijAStarBidir),
 
     TEST_SUITE_CLOSURE
 };
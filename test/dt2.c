@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/dt2.h>
+#include <boruvka/predicates.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+
+/** Returns number of violations of the triangulation: wrong orientation,
+ *  non-symmetric neighbours and (if {delaunay} is true) neighbouring
+ *  vertices lying inside circumcircle */
+static int check(const bor_dt2_t *dt, int delaunay)
+{
+    bor_pred_t pred;
+    const bor_dt2_tri_t *t, *n;
+    int i, j, k, bad = 0;
+
+    borPredInit(&pred);
+    for (i = 0; i < dt->tris_len; i++){
+        t = dt->tris + i;
+        if (borPredOrient2d(&pred, &dt->pts[t->v[0]], &dt->pts[t->v[1]],
+                            &dt->pts[t->v[2]]) <= BOR_ZERO)
+            ++bad;
+
+        for (k = 0; k < 3; k++){
+            if (t->nb[k] < 0)
+                continue;
+            n = dt->tris + t->nb[k];
+            for (j = 0; j < 3 && n->nb[j] != i; j++);
+            if (j == 3){
+                ++bad;
+                continue;
+            }
+
+            if (delaunay
+                    && borPredInCircle(&pred, &dt->pts[t->v[0]],
+                                       &dt->pts[t->v[1]], &dt->pts[t->v[2]],
+                                       &dt->pts[n->v[j]]) > BOR_ZERO)
+                ++bad;
+        }
+    }
+
+    return bad;
+}
+
+/** Returns number of boundary edges */
+static int boundary(const bor_dt2_t *dt)
+{
+    int i, k, len = 0;
+
+    for (i = 0; i < dt->tris_len; i++){
+        for (k = 0; k < 3; k++)
+            len += (dt->tris[i].nb[k] < 0);
+    }
+    return len;
+}
+
+/** Returns true if edge (a, b) is in triangulation */
+static int hasEdge(const bor_dt2_t *dt, int a, int b)
+{
+    int i, k;
+
+    for (i = 0; i < dt->tris_len; i++){
+        for (k = 0; k < 3; k++){
+            if (dt->tris[i].v[k] == a && dt->tris[i].v[(k + 1) % 3] == b)
+                return 1;
+            if (dt->tris[i].v[k] == b && dt->tris[i].v[(k + 1) % 3] == a)
+                return 1;
+        }
+    }
+    return 0;
+}
+
+static bor_real_t area(const bor_dt2_t *dt)
+{
+    bor_vec2_t u, v;
+    bor_real_t a = BOR_ZERO;
+    int i;
+
+    for (i = 0; i < dt->tris_len; i++){
+        borVec2Sub2(&u, &dt->pts[dt->tris[i].v[1]], &dt->pts[dt->tris[i].v[0]]);
+        borVec2Sub2(&v, &dt->pts[dt->tris[i].v[2]], &dt->pts[dt->tris[i].v[0]]);
+        a += (borVec2X(&u) * borVec2Y(&v) - borVec2Y(&u) * borVec2X(&v)) / 2.;
+    }
+    return a;
+}
+
+TEST(dt2Random)
+{
+    bor_dt2_t *dt;
+    bor_rand_t rnd;
+    bor_vec2_t p;
+    int i;
+
+    borRandInitSeed(&rnd, 5);
+    dt = borDT2New();
+    for (i = 0; i < 5000; i++){
+        borVec2Set(&p, borRand(&rnd, -1., 1.), borRand(&rnd, -1., 1.));
+        borDT2AddPoint(dt, &p);
+    }
+
+    assertEquals(borDT2Build(dt, 0), 0);
+    assertEquals(check(dt, 1), 0);
+    // Euler formula for triangulation of points in general position
+    assertEquals(dt->tris_len, 2 * 5000 - 2 - boundary(dt));
+    borDT2Del(dt);
+}
+
+TEST(dt2Grid)
+{
+    bor_dt2_t *dt;
+    bor_vec2_t p;
+    int i;
+
+    // cocircular and collinear points
+    dt = borDT2New();
+    for (i = 0; i < 900; i++){
+        borVec2Set(&p, i % 30, i / 30);
+        borDT2AddPoint(dt, &p);
+    }
+
+    assertEquals(borDT2Build(dt, 0), 0);
+    assertEquals(check(dt, 1), 0);
+    assertEquals(dt->tris_len, 2 * 29 * 29);
+    assertEquals(boundary(dt), 4 * 29);
+    assertTrue(hasEdge(dt, 0, 1));
+    assertTrue(hasEdge(dt, 0, 30));
+    assertFalse(hasEdge(dt, 0, 2));
+    borDT2Del(dt);
+}
+
+TEST(dt2Degenerate)
+{
+    bor_dt2_t *dt;
+    bor_vec2_t p;
+    int i;
+
+    // collinear points
+    dt = borDT2New();
+    for (i = 0; i < 10; i++){
+        borVec2Set(&p, i, 2 * i);
+        borDT2AddPoint(dt, &p);
+    }
+    assertEquals(borDT2Build(dt, 0), -1);
+    assertEquals(dt->tris_len, 0);
+
+    // one more point makes the triangulation possible
+    borVec2Set(&p, 1., 0.);
+    borDT2AddPoint(dt, &p);
+    assertEquals(borDT2Build(dt, 0), 0);
+    assertEquals(dt->tris_len, 9);
+    assertEquals(check(dt, 1), 0);
+    borDT2Del(dt);
+
+    // duplicate points are merged
+    dt = borDT2New();
+    for (i = 0; i < 3; i++){
+        borVec2Set(&p, 0., 0.);
+        borDT2AddPoint(dt, &p);
+        borVec2Set(&p, 1., 0.);
+        borDT2AddPoint(dt, &p);
+        borVec2Set(&p, 0., 1.);
+        borDT2AddPoint(dt, &p);
+    }
+    assertEquals(borDT2Build(dt, 0), 0);
+    assertEquals(dt->tris_len, 1);
+    for (i = 3; i < 9; i++){
+        assertEquals(dt->vert[i], dt->vert[i % 3]);
+        assertEquals(dt->vert[dt->vert[i]], dt->vert[i]);
+    }
+    borDT2Del(dt);
+}
+
+TEST(dt2Constrained)
+{
+    bor_dt2_t *dt;
+    bor_rand_t rnd;
+    bor_vec2_t p;
+    int i, a, b, c;
+
+    borRandInitSeed(&rnd, 7);
+    dt = borDT2New();
+    for (i = 0; i < 1000; i++){
+        borVec2Set(&p, borRand(&rnd, 0., 10.), borRand(&rnd, 0., 10.));
+        borDT2AddPoint(dt, &p);
+    }
+    borVec2Set(&p, -1., 5.);
+    a = borDT2AddPoint(dt, &p);
+    borVec2Set(&p, 11., 5.);
+    b = borDT2AddPoint(dt, &p);
+    // point lying on the segment (a, b) splits it
+    borVec2Set(&p, 4., 5.);
+    c = borDT2AddPoint(dt, &p);
+    borDT2AddSegment(dt, a, b);
+
+    assertEquals(borDT2Build(dt, 0), 0);
+    assertEquals(check(dt, 0), 0);
+    assertTrue(hasEdge(dt, a, c));
+    assertTrue(hasEdge(dt, c, b));
+    assertFalse(hasEdge(dt, a, b));
+    assertEquals(dt->tris_len, 2 * 1003 - 2 - boundary(dt));
+    borDT2Del(dt);
+
+    // crossing segments
+    dt = borDT2New();
+    borVec2Set(&p, 0., 0.);
+    borDT2AddPoint(dt, &p);
+    borVec2Set(&p, 1., 1.);
+    borDT2AddPoint(dt, &p);
+    borVec2Set(&p, 1., 0.);
+    borDT2AddPoint(dt, &p);
+    borVec2Set(&p, 0., 1.);
+    borDT2AddPoint(dt, &p);
+    borDT2AddSegment(dt, 0, 1);
+    borDT2AddSegment(dt, 2, 3);
+    assertEquals(borDT2Build(dt, 0), -1);
+    borDT2Del(dt);
+}
+
+TEST(dt2Poly)
+{
+    bor_dt2_t *dt;
+    bor_poly2_t *outer, *hole;
+    bor_vec2_t corners[4], p;
+    bor_rand_t rnd;
+    int i, first, outside;
+
+    borVec2Set(&corners[0], 0., 0.);
+    borVec2Set(&corners[1], 10., 0.);
+    borVec2Set(&corners[2], 10., 10.);
+    borVec2Set(&corners[3], 0., 10.);
+    outer = borPoly2New(corners, 4);
+    borVec2Set(&corners[0], 3., 3.);
+    borVec2Set(&corners[1], 3., 7.);
+    borVec2Set(&corners[2], 7., 7.);
+    borVec2Set(&corners[3], 7., 3.);
+    hole = borPoly2New(corners, 4);
+
+    borRandInitSeed(&rnd, 9);
+    dt = borDT2New();
+    first = borDT2AddPoly2(dt, outer);
+    assertEquals(first, 0);
+    first = borDT2AddPoly2(dt, hole);
+    assertEquals(first, 4);
+    for (i = 0; i < 2000; i++){
+        borVec2Set(&p, borRand(&rnd, -2., 12.), borRand(&rnd, -2., 12.));
+        borDT2AddPoint(dt, &p);
+    }
+
+    assertEquals(borDT2Build(dt, BOR_DT2_CLIP), 0);
+    assertEquals(check(dt, 0), 0);
+    assertTrue(borEq(area(dt), 100. - 16.));
+
+    // no triangle lies outside or in the hole
+    outside = 0;
+    for (i = 0; i < dt->tris_len; i++){
+        borVec2Add2(&p, &dt->pts[dt->tris[i].v[0]], &dt->pts[dt->tris[i].v[1]]);
+        borVec2Add(&p, &dt->pts[dt->tris[i].v[2]]);
+        borVec2Scale(&p, 1. / 3.);
+        if (!borPoly2PointIn(outer, &p) || borPoly2PointIn(hole, &p))
+            ++outside;
+    }
+    assertEquals(outside, 0);
+
+    for (i = 0; i < 4; i++){
+        assertTrue(hasEdge(dt, i, (i + 1) % 4));
+        assertTrue(hasEdge(dt, 4 + i, 4 + (i + 1) % 4));
+    }
+
+    borDT2Del(dt);
+    borPoly2Del(outer);
+    borPoly2Del(hole);
+}
+
+TEST(dt2Mesh3)
+{
+    bor_dt2_t *dt;
+    bor_mesh3_t *mesh;
+    bor_vec3_t *coords;
+    bor_vec2_t p;
+    int i;
+
+    dt = borDT2New();
+    for (i = 0; i < 100; i++){
+        borVec2Set(&p, i % 10, i / 10);
+        borDT2AddPoint(dt, &p);
+    }
+    borVec2Set(&p, 0., 0.);
+    borDT2AddPoint(dt, &p);
+    assertEquals(borDT2Build(dt, 0), 0);
+
+    coords = BOR_ALLOC_ARR(bor_vec3_t, dt->pts_len);
+    mesh = borDT2Mesh3(dt, coords);
+    assertEquals(borMesh3VerticesLen(mesh), 100);
+    assertEquals(borMesh3FacesLen(mesh), 2 * 9 * 9);
+    assertEquals(borMesh3EdgesLen(mesh), (3 * 2 * 9 * 9 + 4 * 9) / 2);
+    assertTrue(borEq(borVec3X(&coords[99]), 9.));
+    assertTrue(borEq(borVec3Z(&coords[99]), 0.));
+    borDT2Mesh3Del(mesh);
+    BOR_FREE(coords);
+    borDT2Del(dt);
+}
@@ -0,0 +1,21 @@
+#ifndef TEST_DT2_H
+#define TEST_DT2_H
+
+TEST(dt2Random);
+TEST(dt2Grid);
+TEST(dt2Degenerate);
+TEST(dt2Constrained);
+TEST(dt2Poly);
+TEST(dt2Mesh3);
+
+TEST_SUITE(TSDT2) {
+    TEST_ADD(dt2Random),
+    TEST_ADD(dt2Grid),
+    TEST_ADD(dt2Degenerate),
+    TEST_ADD(dt2Constrained),
+    TEST_ADD(dt2Poly),
+    TEST_ADD(dt2Mesh3),
+    TEST_SUITE_CLOSURE
+};
+
+#endif
@@ -248,3 +248,53 @@ TEST(fibo1)
     checkCorrect3(9, 500000);
 }
 
+
+TEST(fiboDecreaseKey)
+{
+    el_t *els, *el;
+    char *in;
+    bor_fibo_t *fibo;
+    bor_rand_t r;
+    int num = 2000;
+    int i, j, round, min, size;
+
+    borRandInitSeed(&r, 4242);
+    els = BOR_ALLOC_ARR(el_t, num);
+    in = BOR_CALLOC_ARR(char, num);
+    fibo = borFiboNew(ltEl, NULL);
+    for (i = 0; i < num; i++){
+        els[i].val = borRand(&r, 0., 1000000.);
+        els[i].id = i;
+        borFiboAdd(fibo, &els[i].node);
+        in[i] = 1;
+    }
+    size = num;
+
+    /* Extraction consolidates the heap into deep trees, the following
+     * decrease-key operations then cut many children of the same parents
+     * which makes the cuts cascade up */
+    for (round = 0; size > 0; ++round){
+        for (j = 0; j < 50; ++j){
+            i = borRand(&r, 0., num);
+            if (i >= num || !in[i])
+                continue;
+            els[i].val -= borRand(&r, 0., 1000000.);
+            borFiboDecreaseKey(fibo, &els[i].node);
+        }
+
+        for (j = 0; j < 1 + round % 20 && size > 0; ++j){
+            el = bor_container_of(borFiboExtractMin(fibo), el_t, node);
+            assertTrue(in[el->id]);
+            min = el->val;
+            for (i = 0; i < num && (!in[i] || min <= els[i].val); ++i);
+            assertEquals(i, num);
+            in[el->id] = 0;
+            --size;
+        }
+    }
+    assertTrue(borFiboEmpty(fibo));
+
+    borFiboDel(fibo);
+    BOR_FREE(els);
+    BOR_FREE(in);
+}
@@ -3,9 +3,11 @@
 
 
 TEST(fibo1);
+TEST(fiboDecreaseKey);
 
 TEST_SUITE(TSFibo) {
     TEST_ADD(fibo1),
+    TEST_ADD(fiboDecreaseKey),
 
     TEST_SUITE_CLOSURE
 };
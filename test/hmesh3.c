@@ -0,0 +1,344 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <cu/cu.h>
+#include <boruvka/hmesh3.h>
+#include <boruvka/alloc.h>
+
+/** Returns number of violations of half-edge invariants: twins must be
+ *  symmetric and opposite and the fan of each vertex traversed from
+ *  .vhe[] must contain all its outgoing half-edges */
+static int check(const bor_hmesh3_t *m)
+{
+    int *out, *bound;
+    int h, t, v, g, start, n, bad = 0;
+
+    out = BOR_CALLOC_ARR(int, m->verts_len);
+    bound = BOR_CALLOC_ARR(int, m->verts_len);
+    for (h = 0; h < 3 * m->faces_len; h++){
+        if (!borHMesh3FaceAlive(m, borHMesh3HEFace(h)))
+            continue;
+
+        v = borHMesh3HEOrigin(m, h);
+        if (!borHMesh3VertexAlive(m, v)){
+            ++bad;
+            continue;
+        }
+        ++out[v];
+
+        t = borHMesh3HETwin(m, h);
+        if (t < 0){
+            bound[v] = 1;
+            continue;
+        }
+        if (!borHMesh3FaceAlive(m, borHMesh3HEFace(t))
+                || borHMesh3HETwin(m, t) != h
+                || borHMesh3HEOrigin(m, t) != borHMesh3HETarget(m, h)
+                || borHMesh3HETarget(m, t) != v)
+            ++bad;
+    }
+
+    for (v = 0; v < m->verts_len; v++){
+        if (!borHMesh3VertexAlive(m, v))
+            continue;
+
+        start = g = borHMesh3VertexHE(m, v);
+        if (g < 0){
+            bad += (out[v] != 0);
+            continue;
+        }
+        if (borHMesh3HEOrigin(m, g) != v
+                || (bound[v] && borHMesh3HETwin(m, g) >= 0))
+            ++bad;
+
+        n = 0;
+        do {
+            ++n;
+            g = borHMesh3HERotCCW(m, g);
+        } while (g >= 0 && g != start && n <= out[v]);
+        bad += (n != out[v]);
+    }
+
+    BOR_FREE(out);
+    BOR_FREE(bound);
+    return bad;
+}
+
+static int boundary(const bor_hmesh3_t *m)
+{
+    int h, len = 0;
+
+    for (h = 0; h < 3 * m->faces_len; h++){
+        if (borHMesh3FaceAlive(m, borHMesh3HEFace(h)))
+            len += (borHMesh3HETwin(m, h) < 0);
+    }
+    return len;
+}
+
+/** Returns V - E + F */
+static int euler(const bor_hmesh3_t *m)
+{
+    int v, verts = 0;
+
+    for (v = 0; v < m->verts_len; v++){
+        if (borHMesh3VertexAlive(m, v) && borHMesh3VertexHE(m, v) >= 0)
+            ++verts;
+    }
+    return verts - (3 * m->faces_num + boundary(m)) / 2 + m->faces_num;
+}
+
+/** Fills n x n grid of vertices and 2 (n - 1)^2 ccw triangles */
+static void grid(int n, bor_vec3_t *coords, int *tris)
+{
+    int x, y, i = 0;
+
+    for (y = 0; y < n; y++){
+        for (x = 0; x < n; x++)
+            borVec3Set(&coords[y * n + x], x, y, BOR_ZERO);
+    }
+
+    for (y = 0; y < n - 1; y++){
+        for (x = 0; x < n - 1; x++){
+            tris[i++] = y * n + x;
+            tris[i++] = y * n + x + 1;
+            tris[i++] = (y + 1) * n + x + 1;
+            tris[i++] = y * n + x;
+            tris[i++] = (y + 1) * n + x + 1;
+            tris[i++] = (y + 1) * n + x;
+        }
+    }
+}
+
+TEST(hmesh3Soup)
+{
+    bor_vec3_t coords[100];
+    int tris[6 * 81];
+    bor_hmesh3_t *m;
+    int h, v, start, n;
+
+    grid(10, coords, tris);
+    m = borHMesh3NewSoup(coords, 100, tris, 162, 0);
+    assertEquals(m->verts_num, 100);
+    assertEquals(m->faces_num, 162);
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 36);
+    assertEquals(euler(m), 1);
+
+    // interior vertex has six neighbours, corner (0, 0) two faces
+    v = 5 * 10 + 5;
+    start = h = borHMesh3VertexHE(m, v);
+    n = 0;
+    do {
+        assertEquals(borHMesh3HEOrigin(m, h), v);
+        ++n;
+        h = borHMesh3HERotCCW(m, h);
+    } while (h >= 0 && h != start);
+    assertEquals(h, start);
+    assertEquals(n, 6);
+
+    h = borHMesh3VertexHE(m, 0);
+    assertEquals(borHMesh3HETwin(m, h), -1);
+    assertEquals(borHMesh3HETarget(m, h), 1);
+    h = borHMesh3HERotCCW(m, h);
+    assertEquals(borHMesh3HETarget(m, h), 11);
+    h = borHMesh3HERotCCW(m, h);
+    assertEquals(h, -1);
+
+    borHMesh3Del(m);
+}
+
+TEST(hmesh3Orient)
+{
+    bor_vec3_t coords[100], u, w, nr;
+    int tris[6 * 81];
+    bor_hmesh3_t *m;
+    int i, f, h, tmp, bad;
+
+    grid(10, coords, tris);
+    for (i = 1; i < 162; i += 2)
+        BOR_SWAP(tris[3 * i + 1], tris[3 * i + 2], tmp);
+
+    // inconsistent neighbours aren't paired
+    m = borHMesh3NewSoup(coords, 100, tris, 162, 0);
+    assertTrue(boundary(m) > 36);
+    borHMesh3Del(m);
+
+    m = borHMesh3NewSoup(coords, 100, tris, 162, BOR_HMESH3_ORIENT);
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 36);
+
+    bad = 0;
+    for (f = 0; f < m->faces_len; f++){
+        h = borHMesh3FaceHE(f);
+        borVec3Sub2(&u, &m->coords[borHMesh3HETarget(m, h)],
+                        &m->coords[borHMesh3HEOrigin(m, h)]);
+        h = borHMesh3HENext(h);
+        borVec3Sub2(&w, &m->coords[borHMesh3HETarget(m, h)],
+                        &m->coords[borHMesh3HEOrigin(m, h)]);
+        borVec3Cross(&nr, &u, &w);
+        bad += (borVec3Z(&nr) <= BOR_ZERO);
+    }
+    assertEquals(bad, 0);
+    borHMesh3Del(m);
+}
+
+TEST(hmesh3AddRemove)
+{
+    bor_vec3_t coords[100];
+    int tris[6 * 81];
+    bor_hmesh3_t *m;
+    int i, f, v;
+
+    grid(10, coords, tris);
+    m = borHMesh3New();
+    for (i = 0; i < 100; i++)
+        assertEquals(borHMesh3AddVertex(m, &coords[i]), i);
+    for (i = 0; i < 162; i++){
+        f = borHMesh3AddFace(m, tris[3 * i], tris[3 * i + 1],
+                             tris[3 * i + 2]);
+        assertEquals(f, i);
+    }
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 36);
+
+    // removing interior face opens fans of its vertices
+    f = 2 * (4 * 9 + 4);
+    borHMesh3RemoveFace(m, f);
+    assertEquals(m->faces_num, 161);
+    assertFalse(borHMesh3FaceAlive(m, f));
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 39);
+
+    // faces around corner
+    borHMesh3RemoveFace(m, 0);
+    assertEquals(check(m), 0);
+    borHMesh3RemoveFace(m, 1);
+    assertEquals(check(m), 0);
+    assertEquals(borHMesh3VertexHE(m, 0), -1);
+    assertEquals(borHMesh3RemoveVertex(m, 1), -1);
+    assertEquals(borHMesh3RemoveVertex(m, 0), 0);
+    assertEquals(m->verts_num, 99);
+    assertFalse(borHMesh3VertexAlive(m, 0));
+
+    // removed elements are reused
+    assertEquals(borHMesh3AddVertex(m, &coords[0]), 0);
+    assertEquals(borHMesh3AddFace(m, tris[3], tris[4], tris[5]), 1);
+    assertEquals(borHMesh3AddFace(m, tris[0], tris[1], tris[2]), 0);
+    i = f / 2;
+    f = borHMesh3AddFace(m, tris[3 * f], tris[3 * f + 1], tris[3 * f + 2]);
+    assertEquals(f, 2 * i);
+    assertEquals(m->faces_len, 162);
+    assertEquals(m->faces_num, 162);
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 36);
+
+    v = borHMesh3AddVertex(m, &coords[5]);
+    assertEquals(v, 100);
+    assertEquals(borHMesh3VertexHE(m, v), -1);
+
+    borHMesh3Del(m);
+}
+
+TEST(hmesh3Collapse)
+{
+    bor_vec3_t coords[400];
+    int tris[6 * 19 * 19];
+    bor_hmesh3_t *m;
+    int i, h, ok, faces, verts;
+
+    srand(1);
+    grid(20, coords, tris);
+    m = borHMesh3NewSoup(coords, 400, tris, 2 * 19 * 19, 0);
+
+    ok = 0;
+    for (i = 0; i < 2000 && m->faces_num > 20; i++){
+        h = rand() % (3 * m->faces_len);
+        if (!borHMesh3FaceAlive(m, borHMesh3HEFace(h)))
+            continue;
+
+        faces = m->faces_num;
+        verts = m->verts_num;
+        if (borHMesh3EdgeCollapse(m, h) == 0){
+            ++ok;
+            assertEquals(m->verts_num, verts - 1);
+            assertTrue(m->faces_num == faces - 2 || m->faces_num == faces - 1);
+        }else{
+            assertEquals(m->verts_num, verts);
+            assertEquals(m->faces_num, faces);
+        }
+    }
+    assertTrue(ok > 100);
+    assertEquals(check(m), 0);
+    assertEquals(euler(m), 1);
+
+    borHMesh3Del(m);
+}
+
+TEST(hmesh3Closed)
+{
+    bor_vec3_t coords[6];
+    int tris[] = { 0, 2, 4,  2, 1, 4,  1, 3, 4,  3, 0, 4,
+                   2, 0, 5,  1, 2, 5,  3, 1, 5,  0, 3, 5 };
+    bor_hmesh3_t *m;
+    int h;
+
+    borVec3Set(&coords[0], 1, 0, 0);
+    borVec3Set(&coords[1], -1, 0, 0);
+    borVec3Set(&coords[2], 0, 1, 0);
+    borVec3Set(&coords[3], 0, -1, 0);
+    borVec3Set(&coords[4], 0, 0, 1);
+    borVec3Set(&coords[5], 0, 0, -1);
+
+    m = borHMesh3NewSoup(coords, 6, tris, 8, 0);
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 0);
+    assertEquals(euler(m), 2);
+
+    // 4 -> 0: opposite vertices 2 and 3 have valence 4
+    h = borHMesh3FaceHE(3) + 1;
+    assertEquals(borHMesh3HEOrigin(m, h), 0);
+    assertEquals(borHMesh3HETarget(m, h), 4);
+    assertEquals(borHMesh3EdgeCollapse(m, h), 0);
+    assertEquals(m->verts_num, 5);
+    assertEquals(m->faces_num, 6);
+    assertEquals(check(m), 0);
+    assertEquals(boundary(m), 0);
+    assertEquals(euler(m), 2);
+    assertFalse(borHMesh3VertexAlive(m, 4));
+
+    // 5 -> 0 would produce degenerate double-sided triangle
+    h = borHMesh3FaceHE(4) + 1;
+    assertEquals(borHMesh3HEOrigin(m, h), 0);
+    assertEquals(borHMesh3HETarget(m, h), 5);
+    assertEquals(borHMesh3EdgeCollapse(m, h), -1);
+    assertEquals(check(m), 0);
+
+    borHMesh3Del(m);
+}
+
+TEST(hmesh3Mesh3)
+{
+    bor_vec3_t coords[100], coords2[100];
+    int tris[6 * 81];
+    bor_hmesh3_t *m, *m2;
+    bor_mesh3_t *mesh;
+
+    grid(10, coords, tris);
+    m = borHMesh3NewSoup(coords, 100, tris, 162, 0);
+    borHMesh3RemoveFace(m, 0);
+
+    mesh = borHMesh3ToMesh3(m, coords2);
+    assertEquals(borMesh3VerticesLen(mesh), 100);
+    assertEquals(borMesh3EdgesLen(mesh), (3 * 161 + 37) / 2);
+    assertEquals(borMesh3FacesLen(mesh), 161);
+
+    m2 = borHMesh3FromMesh3(mesh);
+    assertEquals(m2->verts_num, 100);
+    assertEquals(m2->faces_num, 161);
+    assertEquals(check(m2), 0);
+    assertEquals(boundary(m2), 37);
+    assertEquals(euler(m2), 1);
+
+    borHMesh3Mesh3Del(mesh);
+    borHMesh3Del(m);
+    borHMesh3Del(m2);
+}
@@ -0,0 +1,21 @@
+#ifndef TEST_HMESH3_H
+#define TEST_HMESH3_H
+
+TEST(hmesh3Soup);
+TEST(hmesh3Orient);
+TEST(hmesh3AddRemove);
+TEST(hmesh3Collapse);
+TEST(hmesh3Closed);
+TEST(hmesh3Mesh3);
+
+TEST_SUITE(TSHMesh3) {
+    TEST_ADD(hmesh3Soup),
+    TEST_ADD(hmesh3Orient),
+    TEST_ADD(hmesh3AddRemove),
+    TEST_ADD(hmesh3Collapse),
+    TEST_ADD(hmesh3Closed),
+    TEST_ADD(hmesh3Mesh3),
+    TEST_SUITE_CLOSURE
+};
+
+#endif
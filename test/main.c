@@ -14,6 +14,7 @@
 #include "nearest.h"
 #include "fibo.h"
 #include "pairheap.h"
+#include "dheap.h"
 #include "rbtree.h"
 #include "rbtree_int.h"
 #include "splaytree.h"
@@ -30,8 +31,15 @@
 #include "htable.h"
 #include "hfunc.h"
 #include "segmarr.h"
+#include "pool.h"
 #include "multimap.h"
 #include "fifo.h"
+#include "predicates.h"
+#include "delaunay.h"
+#include "dt2.h"
+#include "hmesh3.h"
+#include "bvh3.h"
+#include "net.h"
 #include "lifo.h"
 #ifdef BOR_HDF5
 #ifdef BOR_GSL
@@ -43,6 +51,9 @@
 #include "lp.h"
 #include "set.h"
 #include "queue.h"
+#include "sssp.h"
+#include "digraph.h"
+#include "reach.h"
 
 TEST_SUITES {
     TEST_SUITE_ADD(TSVec4),
@@ -63,6 +74,7 @@ TEST_SUITES {
     TEST_SUITE_ADD(TSNearest),
     TEST_SUITE_ADD(TSFibo),
     TEST_SUITE_ADD(TSPairHeap),
+    TEST_SUITE_ADD(TSDHeap),
     TEST_SUITE_ADD(TSRBTree),
     TEST_SUITE_ADD(TSRBTreeInt),
     TEST_SUITE_ADD(TSSplayTree),
@@ -76,8 +88,15 @@ TEST_SUITES {
     TEST_SUITE_ADD(TSHTable),
     TEST_SUITE_ADD(TSHFunc),
     TEST_SUITE_ADD(TSSegmArr),
+    TEST_SUITE_ADD(TSPool),
     TEST_SUITE_ADD(TSMultiMap),
     TEST_SUITE_ADD(TSFifo),
+    TEST_SUITE_ADD(TSPredicates),
+    TEST_SUITE_ADD(TSDelaunay),
+    TEST_SUITE_ADD(TSDT2),
+    TEST_SUITE_ADD(TSHMesh3),
+    TEST_SUITE_ADD(TSBVH3),
+    TEST_SUITE_ADD(TSNet),
     TEST_SUITE_ADD(TSLifo),
 #ifdef BOR_HDF5
 #ifdef BOR_GSL
@@ -89,6 +108,9 @@ TEST_SUITES {
     TEST_SUITE_ADD(TSLP),
     TEST_SUITE_ADD(TSSet),
     TEST_SUITE_ADD(TSQueue),
+    TEST_SUITE_ADD(TSSSSP),
+    TEST_SUITE_ADD(TSDigraph),
+    TEST_SUITE_ADD(TSReach),
 
     TEST_SUITES_CLOSURE
 };
@@ -92,3 +92,93 @@ TEST(mat3Tr)
     */
 #endif /* BOR_SSE_SINGLE */
 }
+
+static void checkEigenSym(const bor_mat3_t *m)
+{
+    bor_mat3_t eigen, eigen2;
+    bor_vec3_t eigenvals, col, col2, mcol, minvec;
+    bor_real_t minval, scale;
+    int i, j;
+
+    borMat3EigenSym(m, &eigen, &eigenvals);
+
+    scale = BOR_ONE;
+    for (i = 0; i < 3; ++i){
+        for (j = 0; j < 3; ++j)
+            scale = BOR_FMAX(scale, BOR_FABS(borMat3Get(m, i, j)));
+    }
+
+    assertTrue(borVec3X(&eigenvals) <= borVec3Y(&eigenvals));
+    assertTrue(borVec3Y(&eigenvals) <= borVec3Z(&eigenvals));
+
+    for (i = 0; i < 3; ++i){
+        borMat3CopyCol(&col, &eigen, i);
+        assertTrue(BOR_FABS(borVec3Len(&col) - BOR_ONE) < 1E-4);
+
+        // M * v = l * v
+        borMat3MulVec(&mcol, m, &col);
+        borVec3Scale(&col, borVec3Get(&eigenvals, i));
+        assertTrue(borVec3Dist(&mcol, &col) < 1E-4 * scale);
+
+        for (j = i + 1; j < 3; ++j){
+            borMat3CopyCol(&col, &eigen, i);
+            borMat3CopyCol(&col2, &eigen, j);
+            assertTrue(BOR_FABS(borVec3Dot(&col, &col2)) < 1E-4);
+        }
+    }
+
+    borMat3EigenSymMin(m, &minvec, &minval);
+    assertTrue(BOR_FABS(minval - borVec3X(&eigenvals)) < 1E-4 * scale);
+    borMat3MulVec(&mcol, m, &minvec);
+    borVec3Scale(&minvec, minval);
+    assertTrue(borVec3Dist(&mcol, &minvec) < 1E-4 * scale);
+
+    borMat3EigenSymBatch(m, 1, &eigen2, NULL);
+    for (i = 0; i < 3; ++i)
+        assertTrue(borVec3Eq(&eigen.v[i], &eigen2.v[i]));
+}
+
+TEST(mat3EigenSym)
+{
+    bor_mat3_t m, t, eigen[8];
+    bor_vec3_t eigenvals[8], minvec[8];
+    bor_real_t minval[8];
+    size_t i, j;
+
+    // degenerate cases
+    borMat3SetZero(&m);
+    checkEigenSym(&m);
+    borMat3SetIdentity(&m);
+    checkEigenSym(&m);
+    borMat3Set(&m, 2., 0., 0.,
+                   0., -1., 0.,
+                   0., 0., 1.);
+    checkEigenSym(&m);
+    borMat3Set(&m, 1., 1., 0.,
+                   1., 1., 0.,
+                   0., 0., 2.);
+    checkEigenSym(&m);
+    borMat3Set(&m, 2., 1., 1.,
+                   1., 2., 1.,
+                   1., 1., 2.);
+    checkEigenSym(&m);
+
+    // covariance-like matrices M^T * M
+    for (i = 0; i < mat3s_len; ++i){
+        borMat3MulTrans2(&m, &mat3s[i], &mat3s[i]);
+        checkEigenSym(&m);
+
+        // general symmetric (indefinite) matrices
+        borMat3Trans2(&t, &mat3s[i]);
+        borMat3Add2(&m, &mat3s[i], &t);
+        checkEigenSym(&m);
+    }
+
+    for (i = 0; i + 8 <= mat3s_len; i += 8){
+        borMat3EigenSymBatch(mat3s + i, 8, eigen, eigenvals);
+        borMat3EigenSymMinBatch(mat3s + i, 8, minvec, minval);
+        for (j = 0; j < 8; ++j){
+            assertTrue(BOR_FABS(minval[j] - borVec3X(&eigenvals[j])) < 1E-4);
+        }
+    }
+}
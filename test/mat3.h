@@ -8,6 +8,7 @@ TEST(mat3TearDown);
 TEST(mat3Alloc);
 
 TEST(mat3Tr);
+TEST(mat3EigenSym);
 
 TEST_SUITE(TSMat3) {
     TEST_ADD(mat3SetUp),
@@ -15,6 +16,7 @@ TEST_SUITE(TSMat3) {
     TEST_ADD(mat3Alloc),
 
     TEST_ADD(mat3Tr),
+    TEST_ADD(mat3EigenSym),
 
     TEST_ADD(mat3TearDown),
     TEST_SUITE_CLOSURE
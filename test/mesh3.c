@@ -464,3 +464,255 @@ TEST_SUITE(testSuiteMesh){
     TEST_SUITE_CLOSURE
 };
 #endif
+
+static void testMeshPoolDel(bor_mesh3_vertex_t *v, void *data)
+{
+    ++*(int *)data;
+}
+
+TEST(testMeshPool)
+{
+    bor_mesh3_t *mesh;
+    bor_vec3_t coords[2 * 101];
+    bor_mesh3_vertex_t *v[2 * 101];
+    bor_mesh3_edge_t *e[3], *e2;
+    bor_mesh3_face_t *f;
+    int i, j, k, num;
+
+    for (k = 0; k < 2; k++){
+        mesh = borMesh3New();
+
+        // strip of triangles
+        for (i = 0; i < 2 * 101; i++){
+            borVec3Set(&coords[i], i / 2, i % 2, 0.);
+            v[i] = borMesh3VertexAlloc(mesh);
+            borMesh3VertexSetCoords(v[i], &coords[i]);
+            borMesh3AddVertex(mesh, v[i]);
+        }
+        for (i = 0; i + 2 < 2 * 101; i++){
+            for (j = 0; j < 3; j++){
+                e[j] = borMesh3VertexCommonEdge(v[i + j], v[i + (j + 1) % 3]);
+                if (!e[j]){
+                    e[j] = borMesh3EdgeAlloc(mesh);
+                    borMesh3AddEdge(mesh, e[j], v[i + j], v[i + (j + 1) % 3]);
+                }
+            }
+            f = borMesh3FaceAlloc(mesh);
+            assertEquals(borMesh3AddFace(mesh, f, e[0], e[1], e[2]), 0);
+        }
+        assertEquals(borMesh3VerticesLen(mesh), 202);
+        assertEquals(borMesh3EdgesLen(mesh), 401);
+        assertEquals(borMesh3FacesLen(mesh), 200);
+        assertEquals(borPoolLen(mesh->edges_pool), 401);
+
+        // removed elements can be returned to the pool and reused
+        e2 = borMesh3VertexCommonEdge(v[0], v[1]);
+        f = borMesh3EdgeFace(e2, 0);
+        borMesh3RemoveFace(mesh, f);
+        borMesh3FaceFree(mesh, f);
+        assertEquals(borMesh3RemoveEdge(mesh, e2), 0);
+        borMesh3EdgeFree(mesh, e2);
+        assertEquals(borPoolLen(mesh->edges_pool), 400);
+        assertEquals(borPoolLen(mesh->faces_pool), 199);
+        assertEquals(borMesh3EdgeAlloc(mesh), e2);
+        borMesh3EdgeFree(mesh, e2);
+
+        if (k == 0){
+            // released at once
+            borMesh3Del(mesh);
+        }else{
+            // callbacks are still called
+            num = 0;
+            borMesh3Del2(mesh, testMeshPoolDel, &num, NULL, NULL, NULL, NULL);
+            assertEquals(num, 202);
+        }
+    }
+}
+
+static void testMeshIOCheck(bor_mesh3_t *m, bor_mesh3_t *m2,
+                            const bor_vec3_t *coords, size_t verts_len,
+                            int wires)
+{
+    bor_list_t *item, *item2;
+    bor_mesh3_vertex_t *v, *v2;
+    bor_mesh3_face_t *f, *f2;
+    bor_mesh3_vertex_t *vs[3], *vs2[3];
+    int i, id[3], id2[3], found;
+
+    assertEquals(borMesh3VerticesLen(m2), verts_len);
+    assertEquals(borMesh3FacesLen(m2), borMesh3FacesLen(m));
+
+    i = 0;
+    item2 = borListNext(&m2->verts);
+    BOR_LIST_FOR_EACH(&m->verts, item){
+        v = BOR_LIST_ENTRY(item, bor_mesh3_vertex_t, list);
+        v2 = BOR_LIST_ENTRY(item2, bor_mesh3_vertex_t, list);
+        assertEquals(v->_id, i);
+        assertTrue(borMesh3VertexCoords(v2) == coords + i);
+        assertTrue(borVec3Eq(borMesh3VertexCoords(v), coords + i));
+        if (wires){
+            assertEquals(borMesh3VertexEdgesLen(v),
+                         borMesh3VertexEdgesLen(v2));
+        }
+        v2->_id = i++;
+        item2 = borListNext(item2);
+    }
+
+    item2 = borListNext(&m2->faces);
+    BOR_LIST_FOR_EACH(&m->faces, item){
+        f = BOR_LIST_ENTRY(item, bor_mesh3_face_t, list);
+        f2 = BOR_LIST_ENTRY(item2, bor_mesh3_face_t, list);
+        borMesh3FaceVertices(f, vs);
+        borMesh3FaceVertices(f2, vs2);
+        for (i = 0; i < 3; i++){
+            id[i] = vs[i]->_id;
+            id2[i] = vs2[i]->_id;
+        }
+        found = 0;
+        for (i = 0; i < 3; i++){
+            if (id2[i] == id[0] || id2[i] == id[1] || id2[i] == id[2])
+                ++found;
+        }
+        assertEquals(found, 3);
+        item2 = borListNext(item2);
+    }
+}
+
+TEST(testMeshIO)
+{
+    bor_mesh3_t *mesh, *mesh2;
+    bor_vec3_t coords[11 * 11], *coords2;
+    bor_mesh3_vertex_t *v[11 * 11], *w[3];
+    bor_mesh3_edge_t *e[3];
+    bor_mesh3_face_t *f;
+    FILE *fout;
+    int i, j, k, tri[6] = { 0, 1, 12, 0, 12, 11 };
+    float fl[3];
+    int idx[4];
+    unsigned char cnt, color;
+
+    // grid with two triangles in each cell, one wire edge and one isolated
+    // vertex
+    mesh = borMesh3New();
+    for (i = 0; i < 11 * 11; i++){
+        borVec3Set(&coords[i], i % 11, i / 11, 0.1 * i);
+        v[i] = borMesh3VertexAlloc(mesh);
+        borMesh3VertexSetCoords(v[i], &coords[i]);
+        borMesh3AddVertex(mesh, v[i]);
+    }
+    for (i = 0; i < 10 * 10; i++){
+        if (i / 10 == 9)
+            continue;
+        for (k = 0; k < 2; k++){
+            for (j = 0; j < 3; j++)
+                w[j] = v[i + i / 10 + tri[3 * k + j]];
+            for (j = 0; j < 3; j++){
+                e[j] = borMesh3VertexCommonEdge(w[j], w[(j + 1) % 3]);
+                if (!e[j]){
+                    e[j] = borMesh3EdgeAlloc(mesh);
+                    borMesh3AddEdge(mesh, e[j], w[j], w[(j + 1) % 3]);
+                }
+            }
+            f = borMesh3FaceAlloc(mesh);
+            assertEquals(borMesh3AddFace(mesh, f, e[0], e[1], e[2]), 0);
+        }
+    }
+    e[0] = borMesh3EdgeAlloc(mesh);
+    borMesh3AddEdge(mesh, e[0], v[110], v[111]);
+    assertEquals(borMesh3FacesLen(mesh), 180);
+    assertEquals(borMesh3EdgesLen(mesh), 290);
+
+    fout = fopen("reg/tmp.TSMesh3.io.ply", "wb");
+    assertEquals(borMesh3DumpPLY(mesh, fout), 0);
+    fclose(fout);
+    mesh2 = borMesh3LoadPLY("reg/tmp.TSMesh3.io.ply", &coords2);
+    assertNotEquals(mesh2, NULL);
+    if (mesh2){
+        // wire edge is lost
+        assertEquals(borMesh3EdgesLen(mesh2), 289);
+        v[0] = BOR_LIST_ENTRY(borListPrev(&mesh2->verts),
+                              bor_mesh3_vertex_t, list);
+        assertEquals(borMesh3VertexEdgesLen(v[0]), 0);
+        testMeshIOCheck(mesh, mesh2, coords2, 11 * 11, 0);
+        borMesh3Del(mesh2);
+        borVec3ArrDel(coords2);
+    }
+
+    fout = fopen("reg/tmp.TSMesh3.io.bin", "wb");
+    assertEquals(borMesh3DumpBin(mesh, fout), 0);
+    fclose(fout);
+    mesh2 = borMesh3LoadBin("reg/tmp.TSMesh3.io.bin", &coords2);
+    assertNotEquals(mesh2, NULL);
+    if (mesh2){
+        assertEquals(borMesh3EdgesLen(mesh2), 290);
+        testMeshIOCheck(mesh, mesh2, coords2, 11 * 11, 1);
+        borMesh3Del(mesh2);
+        borVec3ArrDel(coords2);
+    }
+    borMesh3Del(mesh);
+
+    // foreign PLY with additional properties and elements and a quad
+    fout = fopen("reg/tmp.TSMesh3.io2.ply", "wb");
+    fprintf(fout, "ply\r\nformat binary_little_endian 1.0\r\n"
+                  "comment test\r\n"
+                  "element vertex 4\r\n"
+                  "property float x\r\nproperty uchar red\r\n"
+                  "property float y\r\nproperty float z\r\n"
+                  "element face 2\r\n"
+                  "property uchar flags\r\n"
+                  "property list uchar int vertex_indices\r\n"
+                  "element material 1\r\n"
+                  "property list uint8 float32 data\r\n"
+                  "end_header\r\n");
+    color = 7;
+    for (i = 0; i < 4; i++){
+        fl[0] = i % 2;
+        fl[1] = i / 2;
+        fl[2] = i;
+        fwrite(fl, sizeof(float), 1, fout);
+        fwrite(&color, 1, 1, fout);
+        fwrite(fl + 1, sizeof(float), 2, fout);
+    }
+    // quad and a degenerate face
+    idx[0] = 0; idx[1] = 1; idx[2] = 3; idx[3] = 2;
+    fwrite(&color, 1, 1, fout);
+    cnt = 4;
+    fwrite(&cnt, 1, 1, fout);
+    fwrite(idx, sizeof(int), 4, fout);
+    idx[0] = 0; idx[1] = 1; idx[2] = 1;
+    fwrite(&color, 1, 1, fout);
+    cnt = 3;
+    fwrite(&cnt, 1, 1, fout);
+    fwrite(idx, sizeof(int), 3, fout);
+    cnt = 2;
+    fwrite(&cnt, 1, 1, fout);
+    fwrite(fl, sizeof(float), 2, fout);
+    fclose(fout);
+
+    mesh2 = borMesh3LoadPLY("reg/tmp.TSMesh3.io2.ply", &coords2);
+    assertNotEquals(mesh2, NULL);
+    if (mesh2){
+        assertEquals(borMesh3VerticesLen(mesh2), 4);
+        assertEquals(borMesh3EdgesLen(mesh2), 5);
+        assertEquals(borMesh3FacesLen(mesh2), 2);
+        assertTrue(borVec3Eq2(&coords2[3], 1., 1., 3.));
+        borMesh3Del(mesh2);
+        borVec3ArrDel(coords2);
+    }
+
+    // index out of range and truncated file
+    fout = fopen("reg/tmp.TSMesh3.io3.ply", "wb");
+    fprintf(fout, "ply\nformat binary_little_endian 1.0\n"
+                  "element vertex 1\n"
+                  "property float x\nproperty float y\nproperty float z\n"
+                  "element face 1\n"
+                  "property list uchar int vertex_indices\n"
+                  "end_header\n");
+    fwrite(fl, sizeof(float), 3, fout);
+    cnt = 3;
+    fwrite(&cnt, 1, 1, fout);
+    fwrite(idx, sizeof(int), 3, fout);
+    fclose(fout);
+    assertEquals(borMesh3LoadPLY("reg/tmp.TSMesh3.io3.ply", &coords2), NULL);
+    assertEquals(borMesh3LoadBin("reg/tmp.TSMesh3.io3.ply", &coords2), NULL);
+}
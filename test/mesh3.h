@@ -6,12 +6,16 @@ TEST(testMesh3TearDown);
 
 TEST(testMesh);
 TEST(testMesh2);
+TEST(testMeshPool);
+TEST(testMeshIO);
 
 TEST_SUITE(TSMesh3){
     TEST_ADD(testMesh3SetUp),
 
     TEST_ADD(testMesh),
     TEST_ADD(testMesh2),
+    TEST_ADD(testMeshPool),
+    TEST_ADD(testMeshIO),
 
     TEST_ADD(testMesh3TearDown),
     TEST_SUITE_CLOSURE
@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/net.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+#include <boruvka/fifo.h>
+#include "data.h"
+
+struct _graph_t {
+    bor_net_t *net;
+    bor_net_node_t **nodes;
+    int nodes_len;
+    bor_net_edge_t **edges;
+    int edges_len;
+    int alloc;
+};
+typedef struct _graph_t graph_t;
+
+static void addNode(graph_t *g)
+{
+    bor_net_node_t *n;
+
+    n = borNetNodeAlloc(g->net);
+    borNetAddNode(g->net, n);
+    g->nodes[g->nodes_len++] = n;
+}
+
+static void addEdge(graph_t *g, bor_rand_t *rnd)
+{
+    bor_net_node_t *n1, *n2;
+    bor_net_edge_t *e;
+
+    n1 = g->nodes[testRandIdx(rnd, g->nodes_len)];
+    n2 = g->nodes[testRandIdx(rnd, g->nodes_len)];
+    e = borNetEdgeAlloc(g->net);
+    borNetAddEdge(g->net, e, n1, n2);
+    g->edges[g->edges_len++] = e;
+}
+
+static void removeEdge(graph_t *g, int i)
+{
+    borNetRemoveEdge(g->net, g->edges[i]);
+    borNetEdgeFree(g->net, g->edges[i]);
+    g->edges[i] = g->edges[--g->edges_len];
+}
+
+static void removeNode(graph_t *g, int i)
+{
+    if (borNetRemoveNode(g->net, g->nodes[i]) != 0)
+        return;
+    borNetNodeFree(g->net, g->nodes[i]);
+    g->nodes[i] = g->nodes[--g->nodes_len];
+}
+
+static int cmpInt(const void *a, const void *b)
+{
+    return *(const int *)a - *(const int *)b;
+}
+
+static void checkCSR(graph_t *g, const bor_net_csr_t *csr)
+{
+    bor_list_t *item;
+    bor_net_edge_t *e;
+    bor_net_node_t *n;
+    int i, j, id, live, *adj, bad = 0;
+
+    live = 0;
+    for (id = 0; id < csr->nodes_len; ++id)
+        live += (csr->node[id] != NULL);
+    assertEquals(live, g->nodes_len);
+
+    adj = BOR_ALLOC_ARR(int, g->edges_len * 2 + 1);
+    for (i = 0; i < g->nodes_len; ++i){
+        n = g->nodes[i];
+        id = borNetNodeId(n);
+        if (id < 0 || id >= csr->nodes_len || csr->node[id] != n
+                || csr->deg[id] != (int)borNetNodeEdgesLen(n)){
+            ++bad;
+            continue;
+        }
+
+        j = 0;
+        BOR_LIST_FOR_EACH(borNetNodeEdges(n), item){
+            e = borNetEdgeFromNodeList(item);
+            adj[j++] = borNetNodeId(borNetEdgeOtherNode(e, n));
+        }
+        qsort(adj, j, sizeof(int), cmpInt);
+        qsort(csr->adj + csr->start[id], j, sizeof(int), cmpInt);
+        for (j = 0; j < csr->deg[id]; ++j)
+            bad += (adj[j] != csr->adj[csr->start[id] + j]);
+    }
+    assertEquals(bad, 0);
+    BOR_FREE(adj);
+}
+
+/** BFS over the linked net */
+static void bfsNet(const bor_net_csr_t *csr, int src, int *dist)
+{
+    bor_fifo_t fifo;
+    bor_list_t *item;
+    bor_net_node_t *n, *o;
+    int i;
+
+    for (i = 0; i < csr->nodes_len; ++i)
+        dist[i] = -1;
+    borFifoInit(&fifo, sizeof(bor_net_node_t *));
+    dist[src] = 0;
+    n = csr->node[src];
+    borFifoPush(&fifo, &n);
+    while (!borFifoEmpty(&fifo)){
+        n = *(bor_net_node_t **)borFifoFront(&fifo);
+        borFifoPop(&fifo);
+        BOR_LIST_FOR_EACH(borNetNodeEdges(n), item){
+            o = borNetEdgeOtherNode(borNetEdgeFromNodeList(item), n);
+            if (dist[borNetNodeId(o)] < 0){
+                dist[borNetNodeId(o)] = dist[borNetNodeId(n)] + 1;
+                borFifoPush(&fifo, &o);
+            }
+        }
+    }
+    borFifoFree(&fifo);
+}
+
+static void checkAlgs(graph_t *g, const bor_net_csr_t *csr)
+{
+    int *dist, *dist2, *comp, *comp2, i, j, len, bad, src;
+
+    dist = BOR_ALLOC_ARR(int, csr->nodes_len);
+    dist2 = BOR_ALLOC_ARR(int, csr->nodes_len);
+    comp = BOR_ALLOC_ARR(int, csr->nodes_len);
+    comp2 = BOR_ALLOC_ARR(int, csr->nodes_len);
+
+    for (i = 0; i < 3; ++i){
+        src = borNetNodeId(g->nodes[i * 7]);
+        bfsNet(csr, src, dist);
+        len = borNetCSRBFS(csr, src, dist2, 1);
+        bad = 0;
+        for (j = 0; j < csr->nodes_len; ++j){
+            bad += (dist[j] != dist2[j]);
+            len -= (dist[j] >= 0);
+        }
+        assertEquals(bad, 0);
+        assertEquals(len, 0);
+
+        borNetCSRBFS(csr, src, dist2, 4);
+        for (j = 0, bad = 0; j < csr->nodes_len; ++j)
+            bad += (dist[j] != dist2[j]);
+        assertEquals(bad, 0);
+    }
+
+    /* two nodes are in the same component iff one is reachable from the
+     * other, components are numbered by their smallest ids */
+    len = borNetCSRComponents(csr, comp, 1);
+    assertEquals(borNetCSRComponents(csr, comp2, 3), len);
+    for (i = 0, j = 0, bad = 0; i < csr->nodes_len; ++i){
+        bad += (comp[i] != comp2[i]);
+        if (csr->node[i] == NULL){
+            bad += (comp[i] != -1);
+        }else if (comp[i] == j){
+            ++j;
+        }else if (comp[i] > j){
+            ++bad;
+        }
+    }
+    assertEquals(bad, 0);
+    assertEquals(j, len);
+
+    src = borNetNodeId(g->nodes[0]);
+    bfsNet(csr, src, dist);
+    for (i = 0, bad = 0; i < csr->nodes_len; ++i){
+        if (csr->node[i] != NULL)
+            bad += ((dist[i] >= 0) != (comp[i] == comp[src]));
+    }
+    assertEquals(bad, 0);
+
+    BOR_FREE(dist);
+    BOR_FREE(dist2);
+    BOR_FREE(comp);
+    BOR_FREE(comp2);
+}
+
+TEST(netCSR)
+{
+    bor_rand_t rnd;
+    graph_t g;
+    bor_net_csr_t *csr, *csr2;
+    int i, j, *ids, bad;
+
+    borRandInitSeed(&rnd, 1111);
+    g.net = borNetNew();
+    g.alloc = 100000;
+    g.nodes = BOR_ALLOC_ARR(bor_net_node_t *, g.alloc);
+    g.edges = BOR_ALLOC_ARR(bor_net_edge_t *, g.alloc);
+    g.nodes_len = g.edges_len = 0;
+    ids = BOR_ALLOC_ARR(int, g.alloc);
+
+    for (i = 0; i < 20000; ++i)
+        addNode(&g);
+    for (i = 0; i < 22000; ++i)
+        addEdge(&g, &rnd);
+
+    csr = borNetToCSR(g.net);
+    checkCSR(&g, csr);
+    checkAlgs(&g, csr);
+
+    for (i = 0; i < 30; ++i){
+        /* a few random changes: growing or shrinking */
+        for (j = 0; j < 200; ++j){
+            if (borRand(&rnd, 0, 1) < 0.3){
+                addNode(&g);
+            }else if (borRand(&rnd, 0, 1) < 0.5 + (i % 3) * 0.2){
+                addEdge(&g, &rnd);
+            }else if (g.edges_len > 0){
+                removeEdge(&g, testRandIdx(&rnd, g.edges_len));
+            }
+            if (borRand(&rnd, 0, 1) < 0.1)
+                removeNode(&g, testRandIdx(&rnd, g.nodes_len - 20));
+        }
+
+        for (j = 0; j < g.nodes_len; ++j)
+            ids[j] = borNetNodeId(g.nodes[j]);
+        borNetCSRUpdate(csr);
+        for (j = 0, bad = 0; j < g.nodes_len; ++j)
+            bad += (ids[j] >= 0 && ids[j] != borNetNodeId(g.nodes[j]));
+        assertEquals(bad, 0);
+
+        checkCSR(&g, csr);
+        if (i % 10 == 0)
+            checkAlgs(&g, csr);
+    }
+
+    /* deleting the attached snapshot resets ids of all nodes, also of
+     * nodes removed since the last update */
+    for (j = 0; j < 10; ++j)
+        removeNode(&g, testRandIdx(&rnd, g.nodes_len - 20));
+    borNetCSRDel(csr);
+    assertEquals(g.net->csr, NULL);
+    for (j = 0, bad = 0; j < g.nodes_len; ++j)
+        bad += (borNetNodeId(g.nodes[j]) != -1);
+    assertEquals(bad, 0);
+
+    /* a new snapshot replaces the attached one, deleting the detached one
+     * does not touch ids */
+    csr = borNetToCSR(g.net);
+    csr2 = borNetToCSR(g.net);
+    assertEquals(csr->net, NULL);
+    borNetCSRDel(csr);
+    checkCSR(&g, csr2);
+    borNetCSRDel(csr2);
+    assertEquals(g.net->csr, NULL);
+    csr = borNetToCSR(g.net);
+    checkCSR(&g, csr);
+
+    borNetDel(g.net);
+    assertEquals(csr->net, NULL);
+    borNetCSRDel(csr);
+
+    BOR_FREE(g.nodes);
+    BOR_FREE(g.edges);
+    BOR_FREE(ids);
+}
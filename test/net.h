@@ -0,0 +1,11 @@
+#ifndef TEST_NET_H
+#define TEST_NET_H
+
+TEST(netCSR);
+
+TEST_SUITE(TSNet) {
+    TEST_ADD(netCSR),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_NET_H */
@@ -6,6 +6,7 @@
 #include "cu.h"
 #include "boruvka/poly2.h"
 #include "boruvka/rand-mt.h"
+#include "boruvka/alloc.h"
 
 static bor_poly2_t *poly[32];
 int poly_size = 32;
@@ -10124,6 +10125,77 @@ TEST(poly2Test)
 
 
 
+static void checkGrid(const bor_poly2_t *p, int cells, bor_rand_mt_t *rnd)
+{
+    bor_poly2_grid_t *g;
+    bor_vec2_t pt, *pts;
+    int i, *in, len;
+
+    g = borPoly2GridNew(p, cells);
+
+    for (i = 0; i < test_pts_size; ++i){
+        assertEquals(borPoly2GridPointIn(g, &test_pts[i].v),
+                     borPoly2PointIn(p, &test_pts[i].v));
+    }
+
+    /* vertices and midpoints of edges are the hardest cases */
+    for (i = 0; i < p->size; ++i){
+        borVec2Set(&pt, p->px[i], p->py[i]);
+        assertEquals(borPoly2GridPointIn(g, &pt), borPoly2PointIn(p, &pt));
+        borVec2Set(&pt, (p->px[i] + p->px[(i + 1) % p->size]) / 2.,
+                        (p->py[i] + p->py[(i + 1) % p->size]) / 2.);
+        assertEquals(borPoly2GridPointIn(g, &pt), borPoly2PointIn(p, &pt));
+    }
+
+    len = 2000;
+    pts = BOR_ALLOC_ARR(bor_vec2_t, len);
+    in = BOR_ALLOC_ARR(int, len);
+    for (i = 0; i < len; ++i){
+        borVec2Set(pts + i, borRandMT(rnd, -10., 2010.),
+                            borRandMT(rnd, -10., 2010.));
+    }
+    borPoly2GridPointsIn(g, pts, len, in, 3);
+    for (i = 0; i < len; ++i)
+        assertEquals(in[i], borPoly2PointIn(p, pts + i));
+
+    BOR_FREE(pts);
+    BOR_FREE(in);
+    borPoly2GridDel(g);
+}
+
+TEST(poly2Grid)
+{
+    bor_rand_mt_t *rnd;
+    bor_vec2_t *star;
+    bor_poly2_t *p;
+    int i, len;
+
+    rnd = borRandMTNew(1234);
+
+    for (i = 0; i < poly_size; ++i){
+        checkGrid(poly[i], 0, rnd);
+        checkGrid(poly[i], 1, rnd);
+        checkGrid(poly[i], 37, rnd);
+        checkGrid(poly[i], 10000, rnd);
+    }
+
+    /* large self-intersecting polygon */
+    len = 5000;
+    star = BOR_ALLOC_ARR(bor_vec2_t, len);
+    for (i = 0; i < len; ++i){
+        borVec2Set(star + i, borRandMT(rnd, 0., 2000.),
+                             borRandMT(rnd, 0., 2000.));
+    }
+    p = borPoly2New(star, len);
+    checkGrid(p, 0, rnd);
+    checkGrid(p, 100, rnd);
+    borPoly2Del(p);
+    BOR_FREE(star);
+
+    borRandMTDel(rnd);
+}
+
+
 static bor_vec2_t pts0[] = {
     BOR_VEC2_STATIC(362.281, 523.81),
     BOR_VEC2_STATIC(271.746, 489.283),
@@ -7,12 +7,14 @@ TEST(poly2SetUp);
 TEST(poly2TearDown);
 
 TEST(poly2Test);
+TEST(poly2Grid);
 
 TEST_SUITE(TSPoly2)
 {
     TEST_ADD(poly2SetUp),
 
     TEST_ADD(poly2Test),
+    TEST_ADD(poly2Grid),
 
     TEST_ADD(poly2TearDown),
     TEST_SUITE_CLOSURE
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/pool.h>
+#include <boruvka/alloc.h>
+
+struct _el_t {
+    char c;
+    double d;
+    int i;
+};
+typedef struct _el_t el_t;
+
+TEST(poolTest)
+{
+    bor_pool_t *pool;
+    el_t **els, *el;
+    int i, bad, num = 100000;
+
+    pool = borPoolNew(sizeof(el_t), 1000);
+    els = BOR_ALLOC_ARR(el_t *, num);
+
+    bad = 0;
+    for (i = 0; i < num; i++){
+        els[i] = borPoolAlloc(pool);
+        els[i]->c = i % 128;
+        els[i]->d = i;
+        els[i]->i = -i;
+        bad += (((unsigned long)els[i]) % 16 != 0);
+    }
+    assertEquals(bad, 0);
+    assertEquals(borPoolLen(pool), num);
+
+    // elements never move and don't overlap
+    bad = 0;
+    for (i = 0; i < num; i++){
+        if (els[i]->c != i % 128 || els[i]->d != i || els[i]->i != -i)
+            ++bad;
+    }
+    assertEquals(bad, 0);
+
+    for (i = 0; i < num; i += 2)
+        borPoolFree(pool, els[i]);
+    assertEquals(borPoolLen(pool), num / 2);
+
+    // freed elements are reused first
+    el = borPoolAlloc(pool);
+    assertEquals(el, els[num - 2]);
+    borPoolFree(pool, el);
+
+    for (i = 0; i < num; i += 2)
+        els[i] = borPoolAlloc(pool);
+    assertEquals(borPoolLen(pool), num);
+    assertEquals(pool->used, num);
+
+    bad = 0;
+    for (i = 1; i < num; i += 2){
+        if (els[i]->c != i % 128 || els[i]->d != i || els[i]->i != -i)
+            ++bad;
+    }
+    assertEquals(bad, 0);
+
+    BOR_FREE(els);
+    borPoolDel(pool);
+}
@@ -0,0 +1,11 @@
+#ifndef TEST_POOL_H
+#define TEST_POOL_H
+
+TEST(poolTest);
+
+TEST_SUITE(TSPool) {
+    TEST_ADD(poolTest),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_POOL_H */
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <string.h>
+#include <cu/cu.h>
+#include <boruvka/predicates.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+
+#define LEN 5000
+
+static int sign(bor_real_t v)
+{
+    if (v > BOR_ZERO)
+        return 1;
+    if (v < BOR_ZERO)
+        return -1;
+    return 0;
+}
+
+TEST(predBatch2)
+{
+    bor_pred_t pred;
+    bor_pred_stat_t stat;
+    bor_rand_t rnd;
+    bor_vec2_t *pts, a, b, c;
+    bor_real_t *res;
+    int i;
+
+    borPredInit(&pred);
+    borRandInitSeed(&rnd, 2);
+    pts = BOR_ALLOC_ARR(bor_vec2_t, LEN);
+    res = BOR_ALLOC_ARR(bor_real_t, LEN);
+
+    borVec2Set(&a, 0., 0.);
+    borVec2Set(&b, 1., 1.);
+    borVec2Set(&c, 0., 1.);
+
+    // random points and points exactly on the line/circle
+    for (i = 0; i < LEN; ++i){
+        if (i % 2 == 0){
+            borVec2Set(&pts[i], borRand(&rnd, -2., 2.), borRand(&rnd, -2., 2.));
+        }else if (i % 4 == 1){
+            borVec2Set(&pts[i], i / (bor_real_t)LEN, i / (bor_real_t)LEN);
+        }else{
+            borVec2Set(&pts[i], (i % 3) == 0, ((i / 3) % 2) == 0);
+        }
+    }
+
+    memset(&stat, 0, sizeof(stat));
+    borPredOrient2dBatch(&pred, &a, &b, pts, LEN, res, &stat);
+    for (i = 0; i < LEN; ++i){
+        assertEquals(sign(res[i]),
+                     sign(borPredOrient2d(&pred, &a, &b, &pts[i])));
+    }
+    assertEquals(stat.tests, LEN);
+    assertTrue(stat.fallback >= LEN / 4);
+    assertTrue(stat.fallback < LEN);
+
+    memset(&stat, 0, sizeof(stat));
+    borPredInCircleBatch(&pred, &a, &b, &c, pts, LEN, res, &stat);
+    for (i = 0; i < LEN; ++i){
+        assertEquals(sign(res[i]),
+                     sign(borPredInCircle(&pred, &a, &b, &c, &pts[i])));
+    }
+    assertEquals(stat.tests, LEN);
+    assertTrue(stat.fallback > 0);
+    assertTrue(stat.fallback < LEN);
+
+    BOR_FREE(pts);
+    BOR_FREE(res);
+}
+
+TEST(predBatch3)
+{
+    bor_pred_t pred;
+    bor_pred_stat_t stat;
+    bor_rand_t rnd;
+    bor_vec3_t *pts, a, b, c, d;
+    bor_real_t *res;
+    int i;
+
+    borPredInit(&pred);
+    borRandInitSeed(&rnd, 3);
+    pts = BOR_ALLOC_ARR(bor_vec3_t, LEN);
+    res = BOR_ALLOC_ARR(bor_real_t, LEN);
+
+    borVec3Set(&a, 0., 0., 0.);
+    borVec3Set(&b, 1., 0., 0.);
+    borVec3Set(&c, 0., 1., 0.);
+    borVec3Set(&d, 0., 0., 1.);
+
+    // random points and points exactly on the plane/sphere
+    for (i = 0; i < LEN; ++i){
+        if (i % 2 == 0){
+            borVec3Set(&pts[i], borRand(&rnd, -2., 2.), borRand(&rnd, -2., 2.),
+                                borRand(&rnd, -2., 2.));
+        }else if (i % 4 == 1){
+            borVec3Set(&pts[i], borRand(&rnd, -2., 2.), borRand(&rnd, -2., 2.),
+                                0.);
+        }else{
+            borVec3Set(&pts[i], (i % 3) == 0, ((i / 3) % 2) == 0,
+                                ((i / 6) % 2) == 0);
+        }
+    }
+
+    memset(&stat, 0, sizeof(stat));
+    borPredOrient3dBatch(&pred, &a, &b, &c, pts, LEN, res, &stat);
+    for (i = 0; i < LEN; ++i){
+        assertEquals(sign(res[i]),
+                     sign(borPredOrient3d(&pred, &a, &b, &c, &pts[i])));
+    }
+    assertEquals(stat.tests, LEN);
+    assertTrue(stat.fallback >= LEN / 4);
+    assertTrue(stat.fallback < LEN);
+
+    memset(&stat, 0, sizeof(stat));
+    borPredInSphereBatch(&pred, &a, &b, &c, &d, pts, LEN, res, &stat);
+    for (i = 0; i < LEN; ++i){
+        assertEquals(sign(res[i]),
+                     sign(borPredInSphere(&pred, &a, &b, &c, &d, &pts[i])));
+    }
+    assertEquals(stat.tests, LEN);
+    assertTrue(stat.fallback > 0);
+    assertTrue(stat.fallback < LEN);
+
+    BOR_FREE(pts);
+    BOR_FREE(res);
+}
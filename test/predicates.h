@@ -0,0 +1,13 @@
+#ifndef TEST_PREDICATES_H
+#define TEST_PREDICATES_H
+
+TEST(predBatch2);
+TEST(predBatch3);
+
+TEST_SUITE(TSPredicates) {
+    TEST_ADD(predBatch2),
+    TEST_ADD(predBatch3),
+    TEST_SUITE_CLOSURE
+};
+
+#endif
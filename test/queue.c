@@ -1,3 +1,4 @@
+#include <limits.h>
 #include <cu/cu.h>
 #include <boruvka/ibucketq.h>
 #include <boruvka/lbucketq.h>
@@ -5,6 +6,13 @@
 #include <boruvka/iadaq.h>
 #include <boruvka/padaq.h>
 #include <boruvka/apq.h>
+#include <boruvka/iradixq.h>
+#include <boruvka/pradixq.h>
+#include <boruvka/imultiq.h>
+#include <boruvka/rmultiq.h>
+#include <boruvka/tasks.h>
+#include <boruvka/rand.h>
+#include <boruvka/alloc.h>
 
 TEST(testIBucketQ)
 {
@@ -54,6 +62,53 @@ TEST(testIBucketQ)
     borIBucketQFree(&iq);
 }
 
+TEST(testIBucketQSparse)
+{
+    bor_ibucketq_t q;
+    bor_rand_t rnd;
+    int *keys, *vals, len, i, j, min, key, val, step;
+
+    borRandInitSeed(&rnd, 2017);
+    keys = BOR_ALLOC_ARR(int, 2000);
+    vals = BOR_ALLOC_ARR(int, 2000);
+    len = 0;
+
+    borIBucketQInit(&q);
+    for (step = 0; step < 20000; ++step){
+        if (len < 2000 && (len == 0 || borRand(&rnd, 0, 1) < 0.55)){
+            if (borRand(&rnd, 0, 1) < 0.1){
+                key = BOR_MIN((int)borRand(&rnd, 0, 5000000), 4999999);
+            }else{
+                key = BOR_MIN((int)borRand(&rnd, 0, 100), 99) * 4099;
+            }
+            keys[len] = key;
+            vals[len] = step;
+            ++len;
+            borIBucketQPush(&q, key, step);
+        }else{
+            val = borIBucketQPop(&q, &key);
+            min = keys[0];
+            for (i = 1; i < len; ++i)
+                min = BOR_MIN(min, keys[i]);
+            assertEquals(key, min);
+
+            for (j = 0; j < len && vals[j] != val; ++j);
+            assertTrue(j < len);
+            if (j < len){
+                assertEquals(keys[j], key);
+                keys[j] = keys[--len];
+                vals[j] = vals[len];
+            }
+        }
+        assertEquals(borIBucketQIsEmpty(&q), len == 0);
+    }
+    assertTrue(q.bucket_size >= 5000000);
+    borIBucketQFree(&q);
+
+    BOR_FREE(keys);
+    BOR_FREE(vals);
+}
+
 TEST(testLBucketQ)
 {
     bor_lbucketq_t lq;
@@ -406,3 +461,238 @@ TEST(testAPQ)
     assertTrue(borAPQIsEmpty(&q));
     borAPQFree(&q);
 }
+
+TEST(testAPQRand)
+{
+    bor_apq_t q;
+    bor_rand_t rnd;
+    struct apq_el els[500];
+    int in[500], i, j, min, key, step;
+    bor_apq_el_t *el;
+    struct apq_el *e;
+
+    borRandInitSeed(&rnd, 1024);
+    for (i = 0; i < 500; ++i){
+        els[i].val = i;
+        in[i] = 0;
+    }
+
+    borAPQInit(&q);
+    for (step = 0; step < 20000; ++step){
+        i = BOR_MIN((int)borRand(&rnd, 0, 500), 499);
+        key = BOR_MIN((int)borRand(&rnd, 0, 16), 15) * 67;
+        if (!in[i]){
+            borAPQPush(&q, key, &els[i].el);
+            in[i] = 1;
+
+        }else if (borRand(&rnd, 0, 1) < 0.5){
+            borAPQUpdate(&q, key, &els[i].el);
+            assertEquals(els[i].el.key, key);
+
+        }else{
+            min = INT_MAX;
+            for (j = 0; j < 500; ++j){
+                if (in[j])
+                    min = BOR_MIN(min, els[j].el.key);
+            }
+            el = borAPQPop(&q, &key);
+            e = bor_container_of(el, struct apq_el, el);
+            assertEquals(key, min);
+            assertEquals(e->el.key, key);
+            assertTrue(in[e->val]);
+            in[e->val] = 0;
+        }
+    }
+    assertTrue(q.bucket);
+    borAPQFree(&q);
+}
+
+TEST(testIRadixQ)
+{
+    bor_iradixq_t q;
+    long key;
+    int ival, h;
+
+    borIRadixQInit(&q);
+    assertTrue(borIRadixQIsEmpty(&q));
+    borIRadixQPush(&q, 10, 1234);
+    borIRadixQPush(&q, 2, -89);
+    borIRadixQPush(&q, 8, 91);
+    h = borIRadixQPush(&q, 80000000000L, -240);
+    assertFalse(borIRadixQIsEmpty(&q));
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, -89);
+    assertEquals(key, 2);
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, 91);
+    assertEquals(key, 8);
+
+    borIRadixQPush(&q, 125, 111);
+    borIRadixQPush(&q, 8, 99);
+    borIRadixQDecreaseKey(&q, h, 100);
+    assertEquals(borIRadixQKey(&q, h), 100);
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, 99);
+    assertEquals(key, 8);
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, 1234);
+    assertEquals(key, 10);
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, -240);
+    assertEquals(key, 100);
+
+    ival = borIRadixQPop(&q, &key);
+    assertEquals(ival, 111);
+    assertEquals(key, 125);
+
+    assertTrue(borIRadixQIsEmpty(&q));
+    borIRadixQFree(&q);
+}
+
+TEST(testPRadixQ)
+{
+    bor_pradixq_t q;
+    bor_rand_t rnd;
+    long key, last, *keys, min;
+    int *handle, num = 3000, i, j, k, bad = 0;
+    void *val;
+
+    /* Dijkstra-like usage: keys pushed and decreased are never lower than
+     * the last popped key */
+    borRandInitSeed(&rnd, 765);
+    keys = BOR_ALLOC_ARR(long, num);
+    handle = BOR_ALLOC_ARR(int, num);
+    for (i = 0; i < num; ++i)
+        handle[i] = -1;
+
+    borPRadixQInit(&q);
+    last = 0;
+    for (k = 0; k < 20 * num; ++k){
+        i = BOR_MIN((int)borRand(&rnd, 0, num), num - 1);
+        if (handle[i] == -1){
+            keys[i] = last + (long)borRand(&rnd, 0, 1 << 20);
+            if (borRand(&rnd, 0, 1) < 0.1)
+                keys[i] += 1L << (int)borRand(&rnd, 20, 50);
+            handle[i] = borPRadixQPush(&q, keys[i], keys + i);
+
+        }else if (handle[i] >= 0 && borRand(&rnd, 0, 1) < 0.5){
+            keys[i] = last + (keys[i] - last) / 3;
+            borPRadixQDecreaseKey(&q, handle[i], keys[i]);
+            bad += (borPRadixQKey(&q, handle[i]) != keys[i]);
+
+        }else if (!borPRadixQIsEmpty(&q)){
+            min = -1;
+            for (j = 0; j < num; ++j){
+                if (handle[j] >= 0 && (min < 0 || keys[j] < min))
+                    min = keys[j];
+            }
+
+            val = borPRadixQPop(&q, &key);
+            j = (long *)val - keys;
+            bad += (key != keys[j]);
+            bad += (key != min);
+            bad += (key < last);
+            last = key;
+            handle[j] = -2;
+        }
+    }
+    assertEquals(bad, 0);
+
+    while (!borPRadixQIsEmpty(&q)){
+        val = borPRadixQPop(&q, &key);
+        bad += (key < last || key != *(long *)val);
+        last = key;
+    }
+    assertEquals(bad, 0);
+
+    borPRadixQFree(&q);
+    BOR_FREE(keys);
+    BOR_FREE(handle);
+}
+
+TEST(testIMultiQ)
+{
+    bor_imultiq_t *q;
+    bor_rand_t rnd;
+    int keys[1000], i, key, last;
+    void *data;
+
+    borRandInitSeed(&rnd, 41);
+    for (i = 0; i < 1000; ++i)
+        keys[i] = BOR_MIN((int)borRand(&rnd, 0, 300), 299);
+
+    /* One thread with one heap must return exact order */
+    q = borIMultiQNew(1, 1);
+    assertEquals(borIMultiQPop(q, 0, &key, &data), -1);
+    for (i = 0; i < 1000; ++i)
+        borIMultiQPush(q, 0, keys[i], keys + i);
+    last = -1;
+    for (i = 0; i < 1000; ++i){
+        assertEquals(borIMultiQPop(q, 0, &key, &data), 0);
+        assertTrue(key >= last);
+        assertEquals(*(int *)data, key);
+        last = key;
+    }
+    assertEquals(borIMultiQPop(q, 0, &key, &data), -1);
+    assertEquals(borIMultiQSize(q), 0);
+    borIMultiQDel(q);
+}
+
+struct multiq_task {
+    bor_rmultiq_t *q;
+    int *popped;
+    int len;
+};
+
+static void multiqTask(int id, void *_d, const bor_tasks_thinfo_t *th)
+{
+    struct multiq_task *d = _d;
+    bor_real_t key;
+    void *data;
+    int i;
+
+    for (i = id; i < d->len; i += 4){
+        borRMultiQPush(d->q, id, (bor_real_t)((i * 7919) % 1000), d->popped + i);
+        if (i % 3 == 0 && borRMultiQPop(d->q, id, &key, &data) == 0)
+            __sync_fetch_and_add((int *)data, 1);
+    }
+    borRMultiQFlush(d->q, id);
+    while (borRMultiQPop(d->q, id, &key, &data) == 0)
+        __sync_fetch_and_add((int *)data, 1);
+}
+
+TEST(testRMultiQPar)
+{
+    struct multiq_task d;
+    bor_tasks_t *tasks;
+    void *data;
+    int i;
+
+    d.q = borRMultiQNew(4, 2);
+    d.len = 20000;
+    d.popped = BOR_CALLOC_ARR(int, d.len);
+
+    tasks = borTasksNew(4);
+    for (i = 0; i < 4; ++i)
+        borTasksAdd(tasks, multiqTask, i, &d);
+    borTasksRun(tasks);
+    borTasksDel(tasks);
+
+    /* Everything flushed, so whatever was left is in heaps */
+    while (borRMultiQPop(d.q, 0, NULL, &data) == 0)
+        ++*(int *)data;
+    for (i = 0; i < d.len; ++i){
+        if (d.popped[i] != 1)
+            break;
+    }
+    assertEquals(i, d.len);
+    assertEquals(borRMultiQSize(d.q), 0);
+
+    BOR_FREE(d.popped);
+    borRMultiQDel(d.q);
+}
@@ -2,18 +2,30 @@
 #define TEST_QUEUE_H
 
 TEST(testIBucketQ);
+TEST(testIBucketQSparse);
 TEST(testLBucketQ);
 TEST(testPBucketQ);
 TEST(testIAdaQ);
 TEST(testPAdaQ);
 TEST(testAPQ);
+TEST(testAPQRand);
+TEST(testIRadixQ);
+TEST(testPRadixQ);
+TEST(testIMultiQ);
+TEST(testRMultiQPar);
 TEST_SUITE(TSQueue){
     TEST_ADD(testIBucketQ),
+    TEST_ADD(testIBucketQSparse),
     TEST_ADD(testLBucketQ),
     TEST_ADD(testPBucketQ),
     TEST_ADD(testIAdaQ),
     TEST_ADD(testPAdaQ),
     TEST_ADD(testAPQ),
+    TEST_ADD(testAPQRand),
+    TEST_ADD(testIRadixQ),
+    TEST_ADD(testPRadixQ),
+    TEST_ADD(testIMultiQ),
+    TEST_ADD(testRMultiQPar),
     TEST_SUITE_CLOSURE
 };
 #endif
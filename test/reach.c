@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/reach.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+#include "data.h"
+
+static void checkReach(const bor_digraph_t *g, unsigned flags,
+                       int num_threads)
+{
+    bor_digraph_frozen_t fg;
+    bor_reach_t r;
+    int *dist, u, v;
+
+    borDigraphFreeze(&fg, g);
+    borReachInitFrozen(&r, &fg, flags, num_threads);
+    assertEquals(r.node_size, g->node_size);
+    if (flags & BOR_REACH_INTERVAL){
+        assertTrue(r.bits == NULL);
+    }else{
+        assertTrue(r.ival == NULL);
+    }
+
+    dist = BOR_ALLOC_ARR(int, BOR_MAX(g->node_size, 1));
+    for (u = 0; u < g->node_size; ++u){
+        borDigraphFrozenBFS(&fg, u, dist);
+        for (v = 0; v < g->node_size; ++v){
+            assertEquals(borReach(&r, u, v), (dist[v] >= 0));
+        }
+    }
+    BOR_FREE(dist);
+    borReachFree(&r);
+    borDigraphFrozenFree(&fg);
+}
+
+static void testReach(unsigned flags, int seed)
+{
+    static const int threads[] = { 1, 3 };
+    bor_digraph_t g;
+    bor_rand_t rnd;
+    int i, t;
+
+    borRandInitSeed(&rnd, seed);
+    for (i = 0; i < 12; ++i){
+        testRandDigraph(&g, 50 + 50 * (i % 4), 40 * (i + 1), i % 2, &rnd);
+        for (t = 0; t < 2; ++t)
+            checkReach(&g, flags, threads[t]);
+        borDigraphFree(&g);
+    }
+
+    /* wide DAG so that levels are closed in parallel */
+    testRandDigraph(&g, 800, 1200, 1, &rnd);
+    for (t = 0; t < 2; ++t)
+        checkReach(&g, flags, threads[t]);
+    borDigraphFree(&g);
+
+    /* chain of cycles */
+    borDigraphInit(&g);
+    for (i = 0; i < 300; ++i)
+        borDigraphAddNode(&g);
+    for (i = 0; i + 1 < 300; ++i){
+        borDigraphAddEdge(&g, i, i + 1);
+        if (i % 3 == 2)
+            borDigraphAddEdge(&g, i, i - 2);
+    }
+    checkReach(&g, flags, 2);
+    borDigraphFree(&g);
+
+    borDigraphInit(&g);
+    checkReach(&g, flags, 1);
+    borDigraphAddNode(&g);
+    checkReach(&g, flags, 1);
+    borDigraphFree(&g);
+}
+
+TEST(reachBits)
+{
+    testReach(0, 48);
+}
+
+TEST(reachInterval)
+{
+    testReach(BOR_REACH_INTERVAL, 4848);
+}
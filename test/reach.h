@@ -0,0 +1,13 @@
+#ifndef TEST_REACH_H
+#define TEST_REACH_H
+
+TEST(reachBits);
+TEST(reachInterval);
+
+TEST_SUITE(TSReach) {
+    TEST_ADD(reachBits),
+    TEST_ADD(reachInterval),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_REACH_H */
@@ -1,8 +1,11 @@
 #include <stdio.h>
 #include <cu/cu.h>
 #include <boruvka/scc.h>
+#include <boruvka/scc-inc.h>
 #include <boruvka/alloc.h>
 #include <boruvka/dbg.h>
+#include <boruvka/rand.h>
+#include "data.h"
 
 struct _graph_t {
     int *graph;
@@ -73,3 +76,282 @@ TEST(testSCC)
     print(&scc, stdout, "graph1 - 5");
     borSCCFree(&scc);
 }
+
+
+struct _adj_graph_t {
+    int size;
+    int *start;
+    int *adj;
+};
+typedef struct _adj_graph_t adj_graph_t;
+
+static long adjIter(int node_id, void *ud)
+{
+    const adj_graph_t *g = ud;
+    return g->start[node_id];
+}
+
+static int adjNext(int node_id, long *iter, void *ud)
+{
+    const adj_graph_t *g = ud;
+    if (*iter >= g->start[node_id + 1])
+        return -1;
+    return g->adj[(*iter)++];
+}
+
+/** Random graph with {deg} random successors per node and a few long
+ *  paths, or a single path (with a back edge) if {deg} is zero */
+static void adjGraphInit(adj_graph_t *g, int size, int deg, bor_rand_t *rnd)
+{
+    int i, j;
+
+    g->size = size;
+    g->start = BOR_ALLOC_ARR(int, size + 1);
+    g->adj = BOR_ALLOC_ARR(int, size * (deg + 1));
+    g->start[0] = 0;
+    for (i = 0; i < size; ++i){
+        g->start[i + 1] = g->start[i];
+        if (deg == 0){
+            g->adj[g->start[i + 1]++] = (i + 1) % size;
+            continue;
+        }
+
+        if (i + 1 < size && i % 1000 != 999)
+            g->adj[g->start[i + 1]++] = i + 1;
+        for (j = 0; j < deg; ++j)
+            g->adj[g->start[i + 1]++] = testRandIdx(rnd, size);
+    }
+}
+
+static void adjGraphFree(adj_graph_t *g)
+{
+    BOR_FREE(g->start);
+    BOR_FREE(g->adj);
+}
+
+/** Checks that components partition nodes, node IDs are sorted and
+ *  components are in reverse topological order */
+static void checkComps(const bor_scc_t *scc, const adj_graph_t *g)
+{
+    int *comp, i, j, node;
+
+    comp = BOR_ALLOC_ARR(int, g->size);
+    for (i = 0; i < g->size; ++i)
+        comp[i] = -1;
+    for (i = 0; i < scc->comp_size; ++i){
+        for (j = 0; j < scc->comp[i].node_size; ++j){
+            node = scc->comp[i].node[j];
+            assertEquals(comp[node], -1);
+            comp[node] = i;
+            if (j > 0){
+                assertTrue(scc->comp[i].node[j - 1] < node);
+            }
+        }
+    }
+
+    for (i = 0; i < g->size; ++i){
+        assertTrue(comp[i] >= 0);
+        for (j = g->start[i]; j < g->start[i + 1]; ++j)
+            assertTrue(comp[g->adj[j]] <= comp[i]);
+    }
+    BOR_FREE(comp);
+}
+
+static int sameComps(const bor_scc_t *s1, const bor_scc_t *s2)
+{
+    int i;
+
+    if (s1->comp_size != s2->comp_size)
+        return 0;
+    for (i = 0; i < s1->comp_size; ++i){
+        if (s1->comp[i].node_size != s2->comp[i].node_size)
+            return 0;
+        if (memcmp(s1->comp[i].node, s2->comp[i].node,
+                   sizeof(int) * s1->comp[i].node_size) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+TEST(testSCCDeep)
+{
+    adj_graph_t g;
+    bor_scc_t scc;
+
+    /* Recursive implementation would overflow the stack here */
+    adjGraphInit(&g, 3000000, 0, NULL);
+    borSCCInit(&scc, g.size, adjIter, adjNext, &g);
+    borSCC(&scc);
+    assertEquals(scc.comp_size, 1);
+    assertEquals(scc.comp[0].node_size, g.size);
+    borSCCFree(&scc);
+
+    /* remove the back edge, each node is then a component */
+    g.start[g.size] = g.start[g.size - 1];
+    borSCCInit(&scc, g.size, adjIter, adjNext, &g);
+    borSCC(&scc);
+    assertEquals(scc.comp_size, g.size);
+    assertEquals(scc.comp[0].node[0], g.size - 1);
+    assertEquals(scc.comp[g.size - 1].node[0], 0);
+    borSCCFree(&scc);
+    adjGraphFree(&g);
+}
+
+TEST(testSCCParallel)
+{
+    adj_graph_t g;
+    bor_scc_t seq, par, par1;
+    bor_rand_t rnd;
+    int i, j, size;
+
+    borRandInitSeed(&rnd, 46);
+    for (i = 0; i < 6; ++i){
+        size = (i < 3 ? 500 : 20000);
+        adjGraphInit(&g, size, i % 3, &rnd);
+        if (i % 3 == 0){
+            /* redirect some edges of the cycle to random nodes */
+            for (j = 0; j < size; j += 97)
+                g.adj[j] = testRandIdx(&rnd, size);
+        }
+
+        borSCCInit(&seq, g.size, adjIter, adjNext, &g);
+        borSCC(&seq);
+        checkComps(&seq, &g);
+
+        borSCCInitFlags(&par1, g.size, adjIter, adjNext, &g,
+                        BOR_SCC_PARALLEL, 1);
+        borSCC(&par1);
+        checkComps(&par1, &g);
+        assertEquals(par1.comp_size, seq.comp_size);
+
+        for (j = 2; j <= 4; ++j){
+            borSCCInitFlags(&par, g.size, adjIter, adjNext, &g,
+                            BOR_SCC_PARALLEL, j);
+            borSCC(&par);
+            assertTrue(sameComps(&par, &par1));
+            borSCCFree(&par);
+        }
+
+        borSCCFree(&par1);
+        borSCCFree(&seq);
+        adjGraphFree(&g);
+    }
+}
+
+/** Compares components with borDigraphSCC() and checks the order */
+static void checkInc(bor_scc_inc_t *inc, const bor_digraph_t *g)
+{
+    bor_digraph_t scc;
+    int *pos, *nodes, i, j, len, from, to;
+
+    borDigraphSCC(&scc, g);
+    assertEquals(inc->comp_size, scc.node_size);
+    nodes = BOR_ALLOC_ARR(int, g->node_size);
+    for (i = 0; i < scc.node_size; ++i){
+        len = borSCCIncCompNodes(inc, scc.node[i].label.s[0], nodes);
+        assertEquals(len, scc.node[i].label.size);
+        assertEquals(len, borSCCIncCompSize(inc, nodes[0]));
+        for (j = 0; j < len; ++j)
+            assertEquals(nodes[j], scc.node[i].label.s[j]);
+    }
+    BOR_FREE(nodes);
+    borDigraphFree(&scc);
+
+    nodes = BOR_ALLOC_ARR(int, inc->comp_size);
+    pos = BOR_ALLOC_ARR(int, g->node_size);
+    borSCCIncTopo(inc, nodes);
+    for (i = 0; i < g->node_size; ++i)
+        pos[i] = -1;
+    for (i = 0; i < inc->comp_size; ++i)
+        pos[nodes[i]] = i;
+    for (i = 0; i < g->edge_size; ++i){
+        from = borSCCIncComp(inc, g->edge[i].from);
+        to = borSCCIncComp(inc, g->edge[i].to);
+        assertTrue(pos[from] >= 0 && pos[to] >= 0);
+        assertTrue(from == to || pos[from] < pos[to]);
+    }
+    BOR_FREE(nodes);
+    BOR_FREE(pos);
+}
+
+TEST(testSCCInc)
+{
+    bor_scc_inc_t inc;
+    bor_digraph_t g;
+    bor_rand_t rnd;
+    int i, j, from, to, merged, comp_size;
+
+    borRandInitSeed(&rnd, 49);
+    for (i = 0; i < 4; ++i){
+        borDigraphInit(&g);
+        borSCCIncInit(&inc, 0);
+        for (j = 0; j < 200; ++j){
+            borDigraphAddNode(&g);
+            assertEquals(borSCCIncAddNode(&inc), j);
+        }
+        for (j = 0; j < 150 * (i + 1); ++j){
+            from = testRandIdx(&rnd, 200);
+            to = testRandIdx(&rnd, 200);
+            /* mostly acyclic graphs with occasional back edges */
+            if (i < 2 && from > to && borRand(&rnd, 0, 1) < 0.9)
+                BOR_SWAP(from, to, merged);
+            borDigraphAddEdge(&g, from, to);
+            comp_size = inc.comp_size;
+            merged = borSCCIncAddEdge(&inc, from, to);
+            assertEquals(comp_size - merged, inc.comp_size);
+            if (j % 10 == 0)
+                checkInc(&inc, &g);
+        }
+        checkInc(&inc, &g);
+
+        /* nodes added after the edges reuse empty positions */
+        for (j = 0; j < 100; ++j){
+            borDigraphAddNode(&g);
+            borSCCIncAddNode(&inc);
+            borDigraphAddEdge(&g, 200 + j, j);
+            borDigraphAddEdge(&g, 2 * j, 200 + j);
+            borSCCIncAddEdge(&inc, 200 + j, j);
+            borSCCIncAddEdge(&inc, 2 * j, 200 + j);
+        }
+        checkInc(&inc, &g);
+
+        borSCCIncFree(&inc);
+        borDigraphFree(&g);
+    }
+}
+
+TEST(testSCCIncBatch)
+{
+    static const int batch[] = { 1, 5, 40, 300 };
+    bor_scc_inc_t inc;
+    bor_digraph_t g;
+    bor_rand_t rnd;
+    int from[300], to[300];
+    int i, j, k, b, comp_size, merged;
+
+    borRandInitSeed(&rnd, 4949);
+    for (b = 0; b < 4; ++b){
+        testRandDigraph(&g, 500, 100, 0, &rnd);
+        borSCCIncInitDigraph(&inc, &g);
+        checkInc(&inc, &g);
+
+        for (i = 0; i < 600 / batch[b]; ++i){
+            for (k = 0; k < batch[b]; ++k){
+                from[k] = testRandIdx(&rnd, 500);
+                to[k] = testRandIdx(&rnd, 500);
+                if (from[k] > to[k] && borRand(&rnd, 0, 1) < 0.95)
+                    BOR_SWAP(from[k], to[k], j);
+                borDigraphAddEdge(&g, from[k], to[k]);
+            }
+            comp_size = inc.comp_size;
+            merged = borSCCIncAddEdges(&inc, from, to, batch[b]);
+            assertEquals(comp_size - merged, inc.comp_size);
+            if (i % 5 == 0)
+                checkInc(&inc, &g);
+        }
+        checkInc(&inc, &g);
+
+        borSCCIncFree(&inc);
+        borDigraphFree(&g);
+    }
+}
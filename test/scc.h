@@ -2,9 +2,17 @@
 #define TEST_SCC_H
 
 TEST(testSCC);
+TEST(testSCCDeep);
+TEST(testSCCParallel);
+TEST(testSCCInc);
+TEST(testSCCIncBatch);
 
 TEST_SUITE(TSSCC) {
     TEST_ADD(testSCC),
+    TEST_ADD(testSCCDeep),
+    TEST_ADD(testSCCParallel),
+    TEST_ADD(testSCCInc),
+    TEST_ADD(testSCCIncBatch),
     TEST_SUITE_CLOSURE
 };
 
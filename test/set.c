@@ -5,6 +5,8 @@
 #include "boruvka/lset.h"
 #include "boruvka/cset.h"
 #include "boruvka/hashset.h"
+#include "boruvka/bset.h"
+#include "boruvka/hset.h"
 
 bor_rand_t rnd;
 
@@ -243,3 +245,224 @@ TEST(testHashSet)
     borHashSetFree(&hs);
     borCSetFree(&cset);
 }
+
+/** Random set of size elements from [0, range) */
+static void randISet(bor_iset_t *s, int size, int range)
+{
+    borISetEmpty(s);
+    for (int i = 0; i < size; ++i)
+        borISetAdd(s, BOR_MIN((int)borRand(&rnd, 0, range), range - 1));
+}
+
+static int bsetEqISet(const bor_bset_t *b, const bor_iset_t *s)
+{
+    BOR_ISET(tmp);
+    int eq, i, v;
+
+    borBSetToISet(b, &tmp);
+    eq = borISetEq(&tmp, s);
+    borISetFree(&tmp);
+
+    i = 0;
+    BOR_BSET_FOR_EACH(b, v){
+        if (i >= s->size || s->s[i++] != v)
+            eq = 0;
+    }
+    return eq && i == s->size && borBSetSize(b) == s->size;
+}
+
+TEST(testBSet)
+{
+    static const int range[] = { 10, 64, 130, 1000, 5000 };
+    BOR_ISET(s1);
+    BOR_ISET(s2);
+    BOR_ISET(s3);
+    BOR_BSET(b1);
+    BOR_BSET(b2);
+    BOR_BSET(b3);
+    int r, i, v;
+
+    borRandInitSeed(&rnd, 50);
+    assertTrue(borBSetIsEmpty(&b1));
+    assertEquals(borBSetNext(&b1, 0), -1);
+    borBSetAdd(&b1, 200);
+    borBSetAdd(&b1, 3);
+    borBSetAdd(&b1, 63);
+    borBSetAdd(&b1, 64);
+    assertEquals(borBSetSize(&b1), 4);
+    assertEquals(borBSetUsedWords(&b1), 4);
+    assertEquals(borBSetNext(&b1, 0), 3);
+    assertEquals(borBSetNext(&b1, 4), 63);
+    assertEquals(borBSetNext(&b1, 64), 64);
+    assertEquals(borBSetNext(&b1, 65), 200);
+    assertEquals(borBSetNext(&b1, 201), -1);
+    assertEquals(borBSetNext(&b1, 1000), -1);
+    assertTrue(borBSetRm(&b1, 200));
+    assertFalse(borBSetRm(&b1, 200));
+    assertFalse(borBSetRm(&b1, 100000));
+    assertFalse(borBSetIn(100000, &b1));
+    assertEquals(borBSetUsedWords(&b1), 2);
+    borBSetEmpty(&b1);
+    assertTrue(borBSetIsEmpty(&b1));
+
+    for (r = 0; r < 5; ++r){
+        for (i = 0; i < 40; ++i){
+            randISet(&s1, (int)borRand(&rnd, 0, 2 * range[r]), range[r]);
+            randISet(&s2, (int)borRand(&rnd, 0, range[r] / 2), range[r]);
+            if (i % 4 == 0)
+                randISet(&s2, (int)borRand(&rnd, 0, 5), range[r] / 3 + 1);
+            borBSetFromISet(&b1, &s1);
+            borBSetFromISet(&b2, &s2);
+            assertTrue(bsetEqISet(&b1, &s1));
+            assertTrue(bsetEqISet(&b2, &s2));
+            for (v = 0; v < range[r]; ++v)
+                assertEquals(borBSetIn(v, &b1), borISetIn(v, &s1));
+
+            assertEquals(borBSetIsSubset(&b1, &b2), borISetIsSubset(&s1, &s2));
+            assertEquals(borBSetIsSubset(&b2, &b1), borISetIsSubset(&s2, &s1));
+            assertEquals(borBSetIsDisjoint(&b1, &b2),
+                         borISetIsDisjoint(&s1, &s2));
+            assertEquals(borBSetIntersectionSize(&b1, &b2),
+                         borISetIntersectionSize(&s1, &s2));
+            assertEquals(borBSetEq(&b1, &b2), borISetEq(&s1, &s2));
+
+            borISetUnion2(&s3, &s1, &s2);
+            borBSetUnion2(&b3, &b1, &b2);
+            assertTrue(bsetEqISet(&b3, &s3));
+            assertTrue(borBSetIsSubset(&b1, &b3));
+            assertTrue(borBSetIsSubset(&b2, &b3));
+            borBSetSet(&b3, &b2);
+            borBSetUnion(&b3, &b1);
+            assertTrue(bsetEqISet(&b3, &s3));
+
+            borISetIntersect2(&s3, &s1, &s2);
+            borBSetIntersect2(&b3, &b1, &b2);
+            assertTrue(bsetEqISet(&b3, &s3));
+            borBSetSet(&b3, &b2);
+            borBSetIntersect(&b3, &b1);
+            assertTrue(bsetEqISet(&b3, &s3));
+
+            borISetMinus2(&s3, &s1, &s2);
+            borBSetMinus2(&b3, &b1, &b2);
+            assertTrue(bsetEqISet(&b3, &s3));
+            assertTrue(borBSetIsDisjoint(&b3, &b2));
+            borBSetSet(&b3, &b2);
+            borBSetMinus2(&b3, &b1, &b3);
+            assertTrue(bsetEqISet(&b3, &s3));
+            borBSetSet(&b3, &b1);
+            borBSetMinus(&b3, &b2);
+            assertTrue(bsetEqISet(&b3, &s3));
+        }
+    }
+
+    borISetFree(&s1);
+    borISetFree(&s2);
+    borISetFree(&s3);
+    borBSetFree(&b1);
+    borBSetFree(&b2);
+    borBSetFree(&b3);
+}
+
+static int hsetEqISet(const bor_hset_t *h, const bor_iset_t *s)
+{
+    BOR_ISET(tmp);
+    int eq, i, v;
+
+    borHSetToISet(h, &tmp);
+    eq = borISetEq(&tmp, s);
+    borISetFree(&tmp);
+
+    i = 0;
+    BOR_HSET_FOR_EACH(h, v){
+        if (i >= s->size || s->s[i++] != v)
+            eq = 0;
+    }
+    return eq && i == s->size && borHSetSize(h) == s->size;
+}
+
+TEST(testHSet)
+{
+    static const int range[] = { 64, 1000, 100000 };
+    BOR_ISET(s1);
+    BOR_ISET(s2);
+    BOR_ISET(s3);
+    bor_iset_t tmp;
+    bor_hset_t h1, h2, h3;
+    int r, i, v, dense[2] = { 0, 0 };
+
+    borRandInitSeed(&rnd, 5050);
+    borHSetInit(&h1);
+    borHSetInit(&h2);
+    borHSetInit(&h3);
+
+    /* representation follows density */
+    for (v = 0; v < 1000; v += 2)
+        borHSetAdd(&h1, v);
+    assertTrue(h1.dense);
+    assertEquals(borHSetSize(&h1), 500);
+    borHSetAdd(&h1, 1000000);
+    assertFalse(h1.dense);
+    assertTrue(borHSetIn(1000000, &h1));
+    assertTrue(borHSetRm(&h1, 1000000));
+    assertTrue(h1.dense);
+    for (v = 0; v < 990; v += 2)
+        assertTrue(borHSetRm(&h1, v));
+    assertFalse(h1.dense);
+    assertEquals(borHSetSize(&h1), 5);
+    assertFalse(borHSetRm(&h1, 1));
+    borHSetEmpty(&h1);
+    assertEquals(borHSetSize(&h1), 0);
+
+    for (r = 0; r < 3; ++r){
+        for (i = 0; i < 60; ++i){
+            randISet(&s1, (int)borRand(&rnd, 0, range[r]), range[r]);
+            randISet(&s2, (int)borRand(&rnd, 0, range[r] / 10), range[r]);
+            if (i % 2 == 0)
+                BOR_SWAP(s1, s2, tmp);
+            borHSetFromISet(&h1, &s1);
+            borHSetFromISet(&h2, &s2);
+            dense[h1.dense] = 1;
+            assertTrue(hsetEqISet(&h1, &s1));
+            assertTrue(hsetEqISet(&h2, &s2));
+            for (v = 0; v < 100; ++v){
+                assertEquals(borHSetIn(v, &h1), borISetIn(v, &s1));
+            }
+
+            assertEquals(borHSetIsSubset(&h1, &h2), borISetIsSubset(&s1, &s2));
+            assertEquals(borHSetIsSubset(&h2, &h1), borISetIsSubset(&s2, &s1));
+            assertEquals(borHSetIntersectionSize(&h1, &h2),
+                         borISetIntersectionSize(&s1, &s2));
+            assertEquals(borHSetEq(&h1, &h2), borISetEq(&s1, &s2));
+
+            borISetUnion2(&s3, &s1, &s2);
+            borHSetSet(&h3, &h1);
+            borHSetUnion(&h3, &h2);
+            assertTrue(hsetEqISet(&h3, &s3));
+            assertTrue(borHSetIsSubset(&h2, &h3));
+            assertTrue(borHSetIsSubset(&h1, &h3));
+
+            borISetIntersect2(&s3, &s1, &s2);
+            borHSetSet(&h3, &h1);
+            borHSetIntersect(&h3, &h2);
+            assertTrue(hsetEqISet(&h3, &s3));
+
+            borISetMinus2(&s3, &s1, &s2);
+            borHSetSet(&h3, &h1);
+            borHSetMinus(&h3, &h2);
+            assertTrue(hsetEqISet(&h3, &s3));
+
+            borISetMinus2(&s3, &s2, &s1);
+            borHSetSet(&h3, &h2);
+            borHSetMinus(&h3, &h1);
+            assertTrue(hsetEqISet(&h3, &s3));
+        }
+    }
+    assertTrue(dense[0] && dense[1]);
+
+    borISetFree(&s1);
+    borISetFree(&s2);
+    borISetFree(&s3);
+    borHSetFree(&h1);
+    borHSetFree(&h2);
+    borHSetFree(&h3);
+}
@@ -3,9 +3,13 @@
 
 TEST(testISet);
 TEST(testHashSet);
+TEST(testBSet);
+TEST(testHSet);
 TEST_SUITE(TSSet){
     TEST_ADD(testISet),
     TEST_ADD(testHashSet),
+    TEST_ADD(testBSet),
+    TEST_ADD(testHSet),
     TEST_SUITE_CLOSURE
 };
 #endif
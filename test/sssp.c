@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <cu/cu.h>
+#include <boruvka/sssp.h>
+#include <boruvka/alloc.h>
+#include <boruvka/rand.h>
+#include "data.h"
+
+/** Random digraph with weights in [0, max_weight] */
+static int *randGraph(bor_digraph_t *g, int nodes, int edges,
+                      int max_weight, bor_rand_t *rnd)
+{
+    int i, *weight;
+
+    testRandDigraph(g, nodes, edges, 0, rnd);
+    weight = BOR_ALLOC_ARR(int, edges);
+    for (i = 0; i < edges; ++i)
+        weight[i] = testRandIdx(rnd, max_weight + 1);
+    return weight;
+}
+
+/** Grid with edges in both directions and weights in [1, max_weight] */
+static int *gridGraph(bor_digraph_t *g, int size, int max_weight,
+                      bor_rand_t *rnd)
+{
+    int i, *weight;
+
+    testGridDigraph(g, size);
+    weight = BOR_ALLOC_ARR(int, g->edge_size);
+    for (i = 0; i < g->edge_size; ++i)
+        weight[i] = 1 + testRandIdx(rnd, max_weight);
+    return weight;
+}
+
+static int bellmanFord(const bor_digraph_t *g, const int *weight,
+                       int src, long *dist)
+{
+    const bor_digraph_edge_t *e;
+    int i, changed, reached;
+
+    for (i = 0; i < g->node_size; ++i)
+        dist[i] = -1;
+    dist[src] = 0;
+
+    do {
+        changed = 0;
+        for (i = 0; i < g->edge_size; ++i){
+            e = g->edge + i;
+            if (dist[e->from] < 0)
+                continue;
+            if (dist[e->to] < 0 || dist[e->from] + weight[i] < dist[e->to]){
+                dist[e->to] = dist[e->from] + weight[i];
+                changed = 1;
+            }
+        }
+    } while (changed);
+
+    reached = 0;
+    for (i = 0; i < g->node_size; ++i)
+        reached += (dist[i] >= 0);
+    return reached;
+}
+
+TEST(ssspDijkstra)
+{
+    bor_digraph_t dg;
+    bor_sssp_graph_t g;
+    bor_rand_t rnd;
+    long *dist, *dist2;
+    int *weight, i, j, src, len;
+
+    borRandInitSeed(&rnd, 45);
+    for (i = 0; i < 10; ++i){
+        weight = randGraph(&dg, 300, 300 * (i + 1) / 3, 20, &rnd);
+        borSSSPGraphInit(&g, &dg, weight);
+        assertEquals(g.node_size, 300);
+        assertEquals(g.edge_size, dg.edge_size);
+        assertTrue(g.max_weight <= 20);
+        for (j = 0; j < g.node_size; ++j){
+            if (g.start[j + 1] - g.start[j] > 1){
+                assertTrue(g.edge[g.start[j]].weight
+                            <= g.edge[g.start[j + 1] - 1].weight);
+            }
+        }
+
+        dist = BOR_ALLOC_ARR(long, g.node_size);
+        dist2 = BOR_ALLOC_ARR(long, g.node_size);
+        for (j = 0; j < 5; ++j){
+            src = testRandIdx(&rnd, g.node_size);
+            len = borSSSPDijkstra(&g, src, dist);
+            assertEquals(len, bellmanFord(&dg, weight, src, dist2));
+            assertEquals(memcmp(dist, dist2, sizeof(long) * g.node_size), 0);
+        }
+        assertEquals(borSSSPDijkstra(&g, -1, dist), 0);
+
+        BOR_FREE(dist);
+        BOR_FREE(dist2);
+        BOR_FREE(weight);
+        borSSSPGraphFree(&g);
+        borDigraphFree(&dg);
+    }
+}
+
+static void checkDeltaStep(const bor_sssp_graph_t *g, bor_rand_t *rnd)
+{
+    static const int deltas[] = { 0, 1, 7, 100, 100000 };
+    static const int threads[] = { 1, 3, 4 };
+    long *dist, *dist2;
+    int i, j, src, len;
+
+    dist = BOR_ALLOC_ARR(long, g->node_size);
+    dist2 = BOR_ALLOC_ARR(long, g->node_size);
+    for (i = 0; i < 3; ++i){
+        src = testRandIdx(rnd, g->node_size);
+        len = borSSSPDijkstra(g, src, dist);
+        for (j = 0; j < 5 * 3; ++j){
+            assertEquals(borSSSPDeltaStep(g, src, deltas[j / 3],
+                                          threads[j % 3], dist2), len);
+            assertEquals(memcmp(dist, dist2, sizeof(long) * g->node_size), 0);
+        }
+    }
+    BOR_FREE(dist);
+    BOR_FREE(dist2);
+}
+
+TEST(ssspDeltaStep)
+{
+    bor_digraph_t dg;
+    bor_sssp_graph_t g;
+    bor_rand_t rnd;
+    long dist[4];
+    int *weight;
+
+    borRandInitSeed(&rnd, 4545);
+
+    weight = gridGraph(&dg, 120, 100, &rnd);
+    borSSSPGraphInit(&g, &dg, weight);
+    checkDeltaStep(&g, &rnd);
+    BOR_FREE(weight);
+    borSSSPGraphFree(&g);
+    borDigraphFree(&dg);
+
+    /* zero weights and unreachable nodes */
+    weight = randGraph(&dg, 20000, 50000, 1000, &rnd);
+    borSSSPGraphInit(&g, &dg, weight);
+    checkDeltaStep(&g, &rnd);
+    BOR_FREE(weight);
+    borSSSPGraphFree(&g);
+    borDigraphFree(&dg);
+
+    /* unit weights */
+    weight = randGraph(&dg, 10000, 40000, 1, &rnd);
+    borSSSPGraphInit(&g, &dg, NULL);
+    assertEquals(g.max_weight, 1);
+    checkDeltaStep(&g, &rnd);
+    BOR_FREE(weight);
+    borSSSPGraphFree(&g);
+    borDigraphFree(&dg);
+
+    borDigraphInit(&dg);
+    borDigraphAddNode(&dg);
+    borDigraphAddNode(&dg);
+    borDigraphAddNode(&dg);
+    borDigraphAddNode(&dg);
+    borDigraphAddEdge(&dg, 0, 1);
+    borDigraphAddEdge(&dg, 1, 2);
+    borDigraphAddEdge(&dg, 0, 2);
+    borSSSPGraphInit(&g, &dg, (int []){ 2, 3, 6 });
+    assertEquals(borSSSPDeltaStep(&g, 0, 0, 2, dist), 3);
+    assertEquals(dist[0], 0);
+    assertEquals(dist[1], 2);
+    assertEquals(dist[2], 5);
+    assertEquals(dist[3], -1);
+    assertEquals(borSSSPDeltaStep(&g, 4, 0, 2, dist), 0);
+    assertEquals(dist[0], -1);
+    borSSSPGraphFree(&g);
+    borDigraphFree(&dg);
+}
@@ -0,0 +1,13 @@
+#ifndef TEST_SSSP_H
+#define TEST_SSSP_H
+
+TEST(ssspDijkstra);
+TEST(ssspDeltaStep);
+
+TEST_SUITE(TSSSSP) {
+    TEST_ADD(ssspDijkstra),
+    TEST_ADD(ssspDeltaStep),
+    TEST_SUITE_CLOSURE
+};
+
+#endif /* TEST_SSSP_H */